@@ -3044,6 +3044,8 @@ void NumeReWindow::EvaluateCommandLine(wxArrayString& wxArgV)
             || ext == ".xls"
             || ext == ".xlsx"
             || ext == ".labx"
+            || ext == ".arrow"
+            || ext == ".feather"
             || ext == ".ndat")
             m_terminal->pass_command("append \"" + replacePathSeparator(wxArgV[i].ToStdString()) + "\"", false);
     }
@@ -6606,7 +6608,7 @@ void NumeReWindow::OnTreeDragDrop(wxTreeEvent& event)
             return;
 
         wxFileName pathname = data->filename;
-        wxString dragableExtensions = ";nscr;nprc;ndat;nlyt;txt;dat;log;tex;csv;xls;xlsx;ods;jdx;jcm;dx;labx;ibw;png;jpg;jpeg;gif;bmp;eps;svg;m;cpp;cxx;c;hpp;hxx;h;";
+        wxString dragableExtensions = ";nscr;nprc;ndat;nlyt;txt;dat;log;tex;csv;xls;xlsx;ods;jdx;jcm;dx;labx;ibw;arrow;feather;png;jpg;jpeg;gif;bmp;eps;svg;m;cpp;cxx;c;hpp;hxx;h;";
 
         if (dragableExtensions.find(";" + pathname.GetExt().Lower() + ";") != std::string::npos)
         {
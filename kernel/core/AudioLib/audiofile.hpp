@@ -23,6 +23,10 @@
 #include <string>
 #include <cmath>
 
+// Number of frames, which are read or written as a
+// single block
+#define AUDIO_BLOCK_SIZE 65536
+
 namespace Audio
 {
     /////////////////////////////////////////////////
@@ -54,6 +58,7 @@ namespace Audio
             virtual void newFile() = 0;
             virtual void setChannels(size_t channels) = 0;
             virtual void setSampleRate(size_t freq) = 0;
+            virtual void setSampleFormat(size_t bitsPerSample, bool isFloat) = 0;
             virtual void write(const Sample& frame) = 0;
 
             virtual size_t getChannels() const = 0;
@@ -104,6 +109,9 @@ namespace Audio
 
             virtual std::vector<Sample> readSome(size_t len) const = 0;
             virtual void writeSome(const std::vector<Sample> vFrames) = 0;
+
+            virtual size_t readBlock(std::vector<float>& vFrames, size_t nFrames) const = 0;
+            virtual void writeBlock(const std::vector<float>& vFrames) = 0;
     };
 
 
@@ -18,53 +18,239 @@
 
 #include "wavfile.hpp"
 #include <cstring>
+#include <algorithm>
 
 #define PCM 0x0001
+#define IEEE_FLOAT 0x0003
+#define EXTENSIBLE 0xFFFE
+
+// Size of the ds64 chunk of RF64 files, which is
+// reserved as JUNK chunk in new files
+#define DS64_SIZE 28
+// Size of the fmt chunk in extensible format
+#define EXTENSIBLE_FMT_SIZE 40
 
 namespace Audio
 {
     /////////////////////////////////////////////////
-    /// \brief Applies the necessary conversion to
-    /// obtain a signed floating point value from an
-    /// unsigned integer.
+    /// \brief Converts a block of raw samples into
+    /// normalized floating point values. The loops
+    /// are kept free of branches, so that they can
+    /// be vectorized by the compiler.
     ///
-    /// \param val float
-    /// \return float
+    /// \param raw const char*
+    /// \param data float*
+    /// \param nSamples size_t
+    /// \param formatTag uint16_t
+    /// \param bytesPerSample uint16_t
+    /// \return void
     ///
     /////////////////////////////////////////////////
-    static float convertFromUnsigned(float val)
+    static void convertToFloat(const char* raw, float* data, size_t nSamples, uint16_t formatTag, uint16_t bytesPerSample)
     {
-        return val > 1.0 ? val-2.0 : val;
+        if (formatTag == IEEE_FLOAT)
+        {
+            if (bytesPerSample == 4)
+                memcpy(data, raw, nSamples * sizeof(float));
+            else
+            {
+                #pragma omp simd
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    double val;
+                    memcpy(&val, raw + i*8, 8);
+                    data[i] = val;
+                }
+            }
+
+            return;
+        }
+
+        switch (bytesPerSample)
+        {
+            case 1:
+            {
+                // 8 bit PCM is stored as unsigned value
+                const uint8_t* src = reinterpret_cast<const uint8_t*>(raw);
+
+                #pragma omp simd
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    data[i] = (src[i] - 128) / 127.0f;
+                }
+
+                break;
+            }
+            case 2:
+            {
+                #pragma omp simd
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    int16_t val;
+                    memcpy(&val, raw + i*2, 2);
+                    data[i] = val / 32767.0f;
+                }
+
+                break;
+            }
+            case 3:
+            {
+                const uint8_t* src = reinterpret_cast<const uint8_t*>(raw);
+
+                #pragma omp simd
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    int32_t val = src[i*3] | (src[i*3+1] << 8) | ((int8_t)src[i*3+2] * 65536);
+                    data[i] = val / 8388607.0f;
+                }
+
+                break;
+            }
+            case 4:
+            {
+                #pragma omp simd
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    int32_t val;
+                    memcpy(&val, raw + i*4, 4);
+                    data[i] = val / 2147483647.0f;
+                }
+
+                break;
+            }
+        }
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief Calculates the maximal value available
-    /// with the current bitdepth.
+    /// \brief Converts a block of normalized floating
+    /// point values into raw samples. Invalid values
+    /// are replaced by zero. Values outside of
+    /// [-1,1] are clipped for PCM samples.
     ///
-    /// \param bitdepth uint16_t
-    /// \return float
+    /// \param data const float*
+    /// \param raw char*
+    /// \param nSamples size_t
+    /// \param formatTag uint16_t
+    /// \param bytesPerSample uint16_t
+    /// \return void
     ///
     /////////////////////////////////////////////////
-    static float getMaxVal(uint16_t bitdepth)
+    static void convertFromFloat(const float* data, char* raw, size_t nSamples, uint16_t formatTag, uint16_t bytesPerSample)
     {
-        return (1 << (bitdepth-1)) - 1;
+        if (formatTag == IEEE_FLOAT)
+        {
+            if (bytesPerSample == 4)
+            {
+                #pragma omp simd
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    float val = data[i] == data[i] ? data[i] : 0.0f;
+                    memcpy(raw + i*4, &val, 4);
+                }
+            }
+            else
+            {
+                #pragma omp simd
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    double val = data[i] == data[i] ? data[i] : 0.0;
+                    memcpy(raw + i*8, &val, 8);
+                }
+            }
+
+            return;
+        }
+
+        std::vector<float> vClipped(nSamples);
+
+        #pragma omp simd
+        for (size_t i = 0; i < nSamples; i++)
+        {
+            float val = data[i] == data[i] ? data[i] : 0.0f;
+            vClipped[i] = val > 1.0f ? 1.0f : (val < -1.0f ? -1.0f : val);
+        }
+
+        switch (bytesPerSample)
+        {
+            case 1:
+            {
+                // 8 bit PCM is stored as unsigned value
+                uint8_t* dst = reinterpret_cast<uint8_t*>(raw);
+
+                #pragma omp simd
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    dst[i] = (int)(vClipped[i] * 127.0f) + 128;
+                }
+
+                break;
+            }
+            case 2:
+            {
+                #pragma omp simd
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    int16_t val = vClipped[i] * 32767.0f;
+                    memcpy(raw + i*2, &val, 2);
+                }
+
+                break;
+            }
+            case 3:
+            {
+                uint8_t* dst = reinterpret_cast<uint8_t*>(raw);
+
+                #pragma omp simd
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    int32_t val = vClipped[i] * 8388607.0f;
+                    dst[i*3] = val & 0xFF;
+                    dst[i*3+1] = (val >> 8) & 0xFF;
+                    dst[i*3+2] = (val >> 16) & 0xFF;
+                }
+
+                break;
+            }
+            case 4:
+            {
+                #pragma omp simd
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    int32_t val = vClipped[i] * 2147483647.0;
+                    memcpy(raw + i*4, &val, 4);
+                }
+
+                break;
+            }
+        }
     }
 
+
     /////////////////////////////////////////////////
     /// \brief Constructor. Tries to open the wave
-    /// file, if it exists.
+    /// file, if it exists. Readable files are mapped
+    /// into memory, if possible.
     ///
     /// \param sFileName const std::string&
     ///
     /////////////////////////////////////////////////
-    WavFile::WavFile(const std::string& sFileName)
+    WavFile::WavFile(const std::string& sFileName) : m_DataBlockLength(0), m_StreamOffset(44), m_Position(0), isNewFile(false)
     {
         m_WavFileStream.open(sFileName.c_str(), std::ios_base::in | std::ios_base::binary);
         sName = sFileName;
 
         if (!readHeader())
+        {
             m_WavFileStream.close();
+            return;
+        }
+
+        m_mapping.reset(new mu::FileMapping(sFileName));
+
+        // Use the stream, if the file cannot be mapped
+        if (!m_mapping->isValid() || m_mapping->size() < m_StreamOffset + m_DataBlockLength)
+            m_mapping.reset();
     }
 
 
@@ -82,86 +268,200 @@ namespace Audio
     /// \brief Private member function to read the
     /// wave file header to memory. It will
     /// ensure that the current file is actually a
-    /// RIFF WAVE file.
+    /// RIFF WAVE (or RF64) file in a supported
+    /// encoding. The chunks are traversed until the
+    /// data chunk is found.
     ///
     /// \return bool
     ///
     /////////////////////////////////////////////////
     bool WavFile::readHeader()
     {
+        m_DataBlockLength = 0;
+        m_Position = 0;
+
         if (!m_WavFileStream.good())
-        {
-            m_DataBlockLength = 0;
             return false;
-        }
-        else
+
+        char chunkId[5] = {0,0,0,0,0};
+        uint32_t chunkSize = 0;
+        uint64_t rf64DataSize = 0;
+        bool hasFormat = false;
+        bool hasData = false;
+
+        m_WavFileStream.read(chunkId, 4);
+        bool isRF64 = !strcmp(chunkId, "RF64");
+
+        if (strcmp(chunkId, "RIFF") && !isRF64)
+            return false;
+
+        m_WavFileStream.read((char*)&chunkSize, 4);
+        m_WavFileStream.read(chunkId, 4);
+
+        if (strcmp(chunkId, "WAVE"))
+            return false;
+
+        while (m_WavFileStream.read(chunkId, 4) && m_WavFileStream.read((char*)&chunkSize, 4))
         {
-            char headerInfo[5] = {0,0,0,0,0};
-            m_WavFileStream.read(headerInfo, 4);
+            long long int chunkStart = m_WavFileStream.tellg();
 
-            if (strcmp(headerInfo, "RIFF"))
+            if (!strcmp(chunkId, "ds64"))
             {
-                m_DataBlockLength = 0;
-                return false;
+                // RF64 files store the 64 bit sizes in
+                // a separate chunk
+                uint64_t riffSize;
+                m_WavFileStream.read((char*)&riffSize, 8);
+                m_WavFileStream.read((char*)&rf64DataSize, 8);
             }
+            else if (!strcmp(chunkId, "fmt "))
+            {
+                if (chunkSize < sizeof(WavFileHeader))
+                    return false;
+
+                m_WavFileStream.read((char*)&m_Header, sizeof(WavFileHeader));
 
-            m_WavFileStream.read(headerInfo, 4);
-            m_WavFileStream.read(headerInfo, 4);
+                // The extensible format stores the actual
+                // format in the first two bytes of the sub
+                // format GUID
+                if (m_Header.formatTag == EXTENSIBLE && chunkSize >= 40)
+                {
+                    m_WavFileStream.seekg(chunkStart + 24);
+                    m_WavFileStream.read((char*)&m_Header.formatTag, 2);
+                }
 
-            if (strcmp(headerInfo, "WAVE"))
+                hasFormat = true;
+            }
+            else if (!strcmp(chunkId, "data"))
             {
-                m_DataBlockLength = 0;
-                return false;
+                m_StreamOffset = chunkStart;
+                m_DataBlockLength = isRF64 && chunkSize == 0xFFFFFFFF ? rf64DataSize : chunkSize;
+                hasData = true;
+                break;
             }
 
-            m_WavFileStream.seekg(20);
-            m_WavFileStream.read((char*)&m_Header, sizeof(WavFileHeader));
+            // Chunks are aligned to two bytes
+            m_WavFileStream.seekg(chunkStart + chunkSize + (chunkSize & 1));
+        }
 
-            if (m_Header.formatTag != PCM)
-            {
-                m_DataBlockLength = 0;
-                return false;
-            }
+        if (!hasFormat || !hasData || !m_Header.channels || m_Header.blockAlign % m_Header.channels)
+            return false;
 
-            m_WavFileStream.seekg(40);
-            m_WavFileStream.read((char*)&m_DataBlockLength, 4);
+        uint16_t bytesPerSample = m_Header.blockAlign / m_Header.channels;
 
-            m_maxVal = getMaxVal(m_Header.bitsPerSample);
-        }
+        if (!((m_Header.formatTag == PCM && bytesPerSample >= 1 && bytesPerSample <= 4)
+              || (m_Header.formatTag == IEEE_FLOAT && (bytesPerSample == 4 || bytesPerSample == 8))))
+            return false;
 
-        return true;
+        // Ensure that the data block is not larger than
+        // the file (e.g. for truncated files)
+        m_WavFileStream.seekg(0, std::ios_base::end);
+        m_DataBlockLength = std::min(m_DataBlockLength, (uint64_t)(m_WavFileStream.tellg() - m_StreamOffset));
+        m_WavFileStream.seekg(m_StreamOffset);
+
+        return m_WavFileStream.good();
     }
 
 
     /////////////////////////////////////////////////
-    /// \brief Updates the wave file header, which is
-    /// currently open, and closes the file afterwards.
+    /// \brief Updates the wave file header, if the
+    /// file has been created, and closes the file
+    /// afterwards. Files, whose sizes exceed the
+    /// 32 bit size fields, are converted to RF64 by
+    /// replacing the reserved JUNK chunk with a ds64
+    /// chunk.
     ///
     /// \return void
     ///
     /////////////////////////////////////////////////
     void WavFile::closeFile()
     {
+        m_mapping.reset();
+
         if (m_WavFileStream.is_open())
         {
-            m_WavFileStream.seekp(0, std::ios_base::end);
-            uint32_t pos = m_WavFileStream.tellp()-8LL;
-            m_WavFileStream.seekp(4);
-            m_WavFileStream.write((char*)&pos, 4);
-            m_WavFileStream.seekp(40);
-            pos -= 36;
-            m_WavFileStream.write((char*)&pos, 4);
+            if (isNewFile)
+            {
+                m_WavFileStream.seekp(0, std::ios_base::end);
+                uint64_t dataSize = (uint64_t)m_WavFileStream.tellp() - m_StreamOffset;
+
+                // Chunks are aligned to two bytes
+                if (dataSize & 1)
+                    m_WavFileStream.write("", 1);
+
+                uint64_t riffSize = (uint64_t)m_WavFileStream.tellp() - 8;
+
+                if (riffSize > 0xFFFFFFFFull)
+                {
+                    uint32_t sizePlaceholder = 0xFFFFFFFF;
+                    uint64_t sampleCount = m_Header.blockAlign ? dataSize / m_Header.blockAlign : 0;
+                    uint32_t tableLength = 0;
+
+                    m_WavFileStream.seekp(0);
+                    m_WavFileStream.write("RF64", 4);
+                    m_WavFileStream.write((char*)&sizePlaceholder, 4);
+                    m_WavFileStream.seekp(12);
+                    m_WavFileStream.write("ds64", 4);
+                    m_WavFileStream.seekp(20);
+                    m_WavFileStream.write((char*)&riffSize, 8);
+                    m_WavFileStream.write((char*)&dataSize, 8);
+                    m_WavFileStream.write((char*)&sampleCount, 8);
+                    m_WavFileStream.write((char*)&tableLength, 4);
+                    m_WavFileStream.seekp(m_StreamOffset - 4);
+                    m_WavFileStream.write((char*)&sizePlaceholder, 4);
+                }
+                else
+                {
+                    uint32_t size = riffSize;
+                    m_WavFileStream.seekp(4);
+                    m_WavFileStream.write((char*)&size, 4);
+                    size = dataSize;
+                    m_WavFileStream.seekp(m_StreamOffset - 4);
+                    m_WavFileStream.write((char*)&size, 4);
+                }
+            }
+
             m_WavFileStream.close();
         }
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Set the sample format, which shall be
+    /// used in the new file. PCM supports 8, 16, 24
+    /// and 32 bits, IEEE float 32 and 64 bits.
+    /// Unsupported formats fall back to 16 bit PCM.
+    ///
+    /// \param bitsPerSample size_t
+    /// \param isFloat bool
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void WavFile::setSampleFormat(size_t bitsPerSample, bool isFloat)
+    {
+        if ((isFloat && (bitsPerSample == 32 || bitsPerSample == 64))
+            || (!isFloat && bitsPerSample >= 8 && bitsPerSample <= 32 && !(bitsPerSample % 8)))
+        {
+            m_Header.formatTag = isFloat ? IEEE_FLOAT : PCM;
+            m_Header.bitsPerSample = bitsPerSample;
+        }
+        else
+        {
+            m_Header.formatTag = PCM;
+            m_Header.bitsPerSample = 16;
+        }
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Prepares the wave file header for a
     /// new file, opens the stream and writes the
-    /// header to the file. Set number of channels
-    /// and sample frequency before calling this
-    /// member function.
+    /// header to the file. Set number of channels,
+    /// sample frequency and sample format before
+    /// calling this member function. The extensible
+    /// format is used for more than two channels or
+    /// more than 16 bits. A JUNK chunk reserves the
+    /// space for the ds64 chunk, in case the file
+    /// has to be converted to RF64.
     ///
     /// \return void
     ///
@@ -170,24 +470,64 @@ namespace Audio
     {
         closeFile();
 
+        // The format might have been read from an
+        // existing file before
+        setSampleFormat(m_Header.bitsPerSample, m_Header.formatTag == IEEE_FLOAT);
+
         // prepare header
-        m_Header.formatTag = PCM;
-        m_Header.bitsPerSample = 16;
         m_Header.bytesPerSecond = m_Header.sampleRate * m_Header.bitsPerSample / 8 * m_Header.channels;
         m_Header.blockAlign = m_Header.bitsPerSample / 8 * m_Header.channels;
-        m_maxVal = getMaxVal(m_Header.bitsPerSample);
+
+        bool isExtensible = m_Header.channels > 2 || m_Header.bitsPerSample > 16;
+        uint32_t nFmtSize = isExtensible ? EXTENSIBLE_FMT_SIZE : sizeof(WavFileHeader);
+
+        m_StreamOffset = 12 + 8 + DS64_SIZE + 8 + nFmtSize + 8;
+        m_DataBlockLength = 0;
+        m_Position = 0;
+        isNewFile = true;
 
         m_WavFileStream.open(sName.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
-        m_WavFileStream.write("RIFF    WAVEfmt ", 16);
-        uint32_t nSize = 16;
+        m_WavFileStream.write("RIFF    WAVEJUNK", 16);
+
+        uint32_t nSize = DS64_SIZE;
+        char junk[DS64_SIZE] = {0};
         m_WavFileStream.write((char*)&nSize, 4);
-        m_WavFileStream.write((char*)&m_Header, sizeof(WavFileHeader));
+        m_WavFileStream.write(junk, DS64_SIZE);
+
+        m_WavFileStream.write("fmt ", 4);
+        m_WavFileStream.write((char*)&nFmtSize, 4);
+
+        if (isExtensible)
+        {
+            WavFileHeader header = m_Header;
+            header.formatTag = EXTENSIBLE;
+            m_WavFileStream.write((char*)&header, sizeof(WavFileHeader));
+
+            uint16_t cbSize = EXTENSIBLE_FMT_SIZE - sizeof(WavFileHeader) - 2;
+            uint16_t validBits = m_Header.bitsPerSample;
+            uint32_t channelMask = 0; // No speaker positions assigned
+
+            // The sub format GUID starts with the
+            // actual format tag
+            const char subFormatGuid[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, (char)0x80, 0x00,
+                                            0x00, (char)0xAA, 0x00, 0x38, (char)0x9B, 0x71};
+
+            m_WavFileStream.write((char*)&cbSize, 2);
+            m_WavFileStream.write((char*)&validBits, 2);
+            m_WavFileStream.write((char*)&channelMask, 4);
+            m_WavFileStream.write((char*)&m_Header.formatTag, 2);
+            m_WavFileStream.write(subFormatGuid, 14);
+        }
+        else
+            m_WavFileStream.write((char*)&m_Header, sizeof(WavFileHeader));
+
         m_WavFileStream.write("data    ", 8);
     }
 
 
     /////////////////////////////////////////////////
     /// \brief Write a sample to the audio stream.
+    /// Additional channels are filled with zeros.
     ///
     /// \param sample const Sample&
     /// \return void
@@ -195,43 +535,34 @@ namespace Audio
     /////////////////////////////////////////////////
     void WavFile::write(const Sample& sample)
     {
-        if (m_WavFileStream.is_open() && m_WavFileStream.good())
-        {
-            int16_t channelvalue = sample.leftOrMono * m_maxVal;
-            m_WavFileStream.write((char*)&channelvalue, 2);
+        std::vector<float> vFrame(m_Header.channels, 0.0f);
+        vFrame[0] = sample.leftOrMono;
 
-            if (m_Header.channels > 1 && !std::isnan(sample.right))
-            {
-                channelvalue = sample.right * m_maxVal;
-                m_WavFileStream.write((char*)&channelvalue, 2);
-            }
-        }
+        if (m_Header.channels > 1 && !std::isnan(sample.right))
+            vFrame[1] = sample.right;
+
+        writeBlock(vFrame);
     }
 
 
     /////////////////////////////////////////////////
     /// \brief Read a sample from the audio stream.
+    /// Only the first two channels are returned.
     ///
     /// \return Sample
     ///
     /////////////////////////////////////////////////
     Sample WavFile::read() const
     {
-        uint32_t samples[2] = {0,0};
+        std::vector<float> vFrame;
+
+        if (!readBlock(vFrame, 1))
+            return Sample(NAN);
 
         if (m_Header.channels == 1)
-        {
-            m_WavFileStream.read((char*)samples, m_Header.blockAlign);
-            return Sample(convertFromUnsigned(samples[0] / m_maxVal));
-        }
-        else
-        {
-            m_WavFileStream.read((char*)&samples[0], m_Header.blockAlign/m_Header.channels);
-            m_WavFileStream.read((char*)&samples[1], m_Header.blockAlign/m_Header.channels);
-            return Sample(convertFromUnsigned(samples[0] / m_maxVal), convertFromUnsigned(samples[1] / m_maxVal));
-        }
+            return Sample(vFrame[0]);
 
-        return Sample(NAN);
+        return Sample(vFrame[0], vFrame[1]);
     }
 
 
@@ -246,13 +577,16 @@ namespace Audio
     std::vector<Sample> WavFile::readSome(size_t len) const
     {
         std::vector<Sample> vSamples;
+        std::vector<float> vFrames;
+        size_t nFrames = readBlock(vFrames, len);
+        vSamples.reserve(nFrames);
 
-        for (size_t i = 0; i < len; i++)
+        for (size_t i = 0; i < nFrames; i++)
         {
-            if (m_WavFileStream.eof() || !m_WavFileStream.good())
-                break;
-
-            vSamples.push_back(read());
+            if (m_Header.channels == 1)
+                vSamples.push_back(Sample(vFrames[i]));
+            else
+                vSamples.push_back(Sample(vFrames[i*m_Header.channels], vFrames[i*m_Header.channels+1]));
         }
 
         return vSamples;
@@ -274,5 +608,74 @@ namespace Audio
             write(s);
         }
     }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reads a block of frames from the
+    /// current position and converts them into
+    /// normalized floating point values. The frames
+    /// are stored interleaved, i.e. the values of
+    /// all channels of a frame are consecutive.
+    /// Returns the number of read frames.
+    ///
+    /// \param vFrames std::vector<float>&
+    /// \param nFrames size_t
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t WavFile::readBlock(std::vector<float>& vFrames, size_t nFrames) const
+    {
+        size_t nLength = getLength();
+        nFrames = std::min(nFrames, nLength - std::min(m_Position, nLength));
+        vFrames.resize(nFrames * m_Header.channels);
+
+        if (!nFrames)
+            return 0;
+
+        uint16_t bytesPerSample = m_Header.blockAlign / m_Header.channels;
+        uint64_t offset = m_StreamOffset + (uint64_t)m_Position * m_Header.blockAlign;
+
+        if (m_mapping)
+            convertToFloat(m_mapping->data() + offset, &vFrames[0], vFrames.size(), m_Header.formatTag, bytesPerSample);
+        else
+        {
+            std::vector<char> vRaw(nFrames * m_Header.blockAlign);
+            m_WavFileStream.seekg(offset);
+            m_WavFileStream.read(&vRaw[0], vRaw.size());
+
+            if (!m_WavFileStream.good())
+            {
+                vFrames.clear();
+                return 0;
+            }
+
+            convertToFloat(&vRaw[0], &vFrames[0], vFrames.size(), m_Header.formatTag, bytesPerSample);
+        }
+
+        m_Position += nFrames;
+        return nFrames;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Writes a block of interleaved frames
+    /// of normalized floating point values to the
+    /// audio stream using the selected sample
+    /// format.
+    ///
+    /// \param vFrames const std::vector<float>&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void WavFile::writeBlock(const std::vector<float>& vFrames)
+    {
+        if (m_WavFileStream.is_open() && m_WavFileStream.good() && vFrames.size())
+        {
+            uint16_t bytesPerSample = m_Header.bitsPerSample / 8;
+            std::vector<char> vRaw(vFrames.size() * bytesPerSample);
+            convertFromFloat(&vFrames[0], &vRaw[0], vFrames.size(), m_Header.formatTag, bytesPerSample);
+            m_WavFileStream.write(&vRaw[0], vRaw.size());
+        }
+    }
 }
 
@@ -20,7 +20,9 @@
 #define WAVFILE_HPP
 
 #include "audiofile.hpp"
+#include "../ParserLib/muFileMapping.hpp"
 #include <fstream>
+#include <memory>
 
 namespace Audio
 {
@@ -47,18 +49,27 @@ namespace Audio
     /// \brief This class implements the wave file
     /// type using PCM encoding (the simplest
     /// encoding). Due to its simplicity it is a
-    /// seekable file type.
+    /// seekable file type. Reading supports PCM with
+    /// 8, 16, 24 and 32 bits, IEEE float, an
+    /// arbitrary number of channels and RF64 files.
+    /// Existing files are memory-mapped, if
+    /// possible. New files are written in the same
+    /// formats. They use the extensible format for
+    /// more than two channels or more than 16 bits
+    /// and are converted to RF64, if their size
+    /// exceeds the limits of RIFF files.
     /////////////////////////////////////////////////
     class WavFile : public SeekableFile
     {
         private:
             std::string sName;
             mutable std::fstream m_WavFileStream;
+            std::unique_ptr<mu::FileMapping> m_mapping;
             WavFileHeader m_Header;
-            uint32_t m_DataBlockLength;
-            const long long int m_StreamOffset = 44;
+            uint64_t m_DataBlockLength;
+            long long int m_StreamOffset;
+            mutable size_t m_Position;
             bool isNewFile;
-            float m_maxVal;
 
             bool readHeader();
             void closeFile();
@@ -107,6 +118,8 @@ namespace Audio
                 m_Header.sampleRate = freq;
             }
 
+            virtual void setSampleFormat(size_t bitsPerSample, bool isFloat) override;
+
             virtual void write(const Sample& sample) override;
 
             /////////////////////////////////////////////////
@@ -142,7 +155,10 @@ namespace Audio
             /////////////////////////////////////////////////
             virtual size_t getLength() const override
             {
-                return m_DataBlockLength / (m_Header.channels * m_Header.bitsPerSample/8);
+                if (!m_Header.blockAlign)
+                    return 0;
+
+                return m_DataBlockLength / m_Header.blockAlign;
             }
 
             virtual Sample read() const override;
@@ -156,10 +172,7 @@ namespace Audio
             /////////////////////////////////////////////////
             virtual size_t getPosition() const override
             {
-                if (m_WavFileStream.good())
-                    return (m_WavFileStream.tellg() - m_StreamOffset) / (m_Header.channels * m_Header.bitsPerSample/8);
-
-                return 0;
+                return m_Position;
             }
 
             /////////////////////////////////////////////////
@@ -172,12 +185,15 @@ namespace Audio
             /////////////////////////////////////////////////
             virtual void setPosition(size_t pos) override
             {
-                if (m_WavFileStream.good() && pos * (m_Header.channels * m_Header.bitsPerSample/8) < m_DataBlockLength)
-                    m_WavFileStream.seekg(pos * (m_Header.channels * m_Header.bitsPerSample/8) + m_StreamOffset);
+                if (pos < getLength())
+                    m_Position = pos;
             }
 
             virtual std::vector<Sample> readSome(size_t len) const override;
             virtual void writeSome(const std::vector<Sample> vSamples) override;
+
+            virtual size_t readBlock(std::vector<float>& vFrames, size_t nFrames) const override;
+            virtual void writeBlock(const std::vector<float>& vFrames) override;
     };
 }
 
@@ -30,6 +30,11 @@
 #include <fstream>
 #include <filesystem>
 #include <sstream>
+#include <cstring>
+
+// Minimal number of elements for converting memory-
+// mapped data in parallel
+#define MUP_MAPPED_PARALLEL_LIMIT 100000
 
 namespace mu
 {
@@ -1688,7 +1693,7 @@ namespace mu
     /////////////////////////////////////////////////
     /// \brief Empty default constructor.
     /////////////////////////////////////////////////
-    File::File()
+    File::File() : m_mapPos(0)
     { }
 
 
@@ -1698,9 +1703,16 @@ namespace mu
     /// \param other const File&
     ///
     /////////////////////////////////////////////////
-    File::File(const File& other)
+    File::File(const File& other) : m_mapPos(0)
     {
-        if (other.is_open())
+        if (other.m_mapping)
+        {
+            m_mapping = other.m_mapping;
+            m_mapPos = other.m_mapPos;
+            m_fileName = other.m_fileName;
+            m_openMode = other.m_openMode;
+        }
+        else if (other.is_open())
             open(other.m_fileName, other.m_openMode);
     }
 
@@ -1708,14 +1720,23 @@ namespace mu
     /////////////////////////////////////////////////
     /// \brief Move constructor. Closes the
     /// moved-from file and re-opens the stream in
-    /// this instance.
+    /// this instance. Memory mappings are moved
+    /// directly.
     ///
     /// \param other File&&
     ///
     /////////////////////////////////////////////////
-    File::File(File&& other)
+    File::File(File&& other) : m_mapPos(0)
     {
-        if (other.is_open())
+        if (other.m_mapping)
+        {
+            m_mapping = std::move(other.m_mapping);
+            m_mapPos = other.m_mapPos;
+            m_fileName = other.m_fileName;
+            m_openMode = other.m_openMode;
+            other.close();
+        }
+        else if (other.is_open())
         {
             other.m_stream.close();
             open(other.m_fileName, other.m_openMode);
@@ -1732,9 +1753,19 @@ namespace mu
     /////////////////////////////////////////////////
     File& File::operator=(const File& other)
     {
+        if (this == &other)
+            return *this;
+
         close();
 
-        if (other.is_open())
+        if (other.m_mapping)
+        {
+            m_mapping = other.m_mapping;
+            m_mapPos = other.m_mapPos;
+            m_fileName = other.m_fileName;
+            m_openMode = other.m_openMode;
+        }
+        else if (other.is_open())
             open(other.m_fileName, other.m_openMode);
 
         return *this;
@@ -1750,9 +1781,20 @@ namespace mu
     /////////////////////////////////////////////////
     File& File::operator=(File&& other)
     {
+        if (this == &other)
+            return *this;
+
         close();
 
-        if (other.is_open())
+        if (other.m_mapping)
+        {
+            m_mapping = std::move(other.m_mapping);
+            m_mapPos = other.m_mapPos;
+            m_fileName = other.m_fileName;
+            m_openMode = other.m_openMode;
+            other.close();
+        }
+        else if (other.is_open())
         {
             other.m_stream.close();
             open(other.m_fileName, other.m_openMode);
@@ -1775,6 +1817,12 @@ namespace mu
         if (!is_open())
             return 0;
 
+        if (m_mapping)
+        {
+            m_mapPos = std::min(p ? p-1 : 0, m_mapping->size());
+            return m_mapPos+1;
+        }
+
         m_stream.seekg(p-1, std::ios_base::beg);
         return p;
     }
@@ -1792,6 +1840,9 @@ namespace mu
         if (!is_open())
             return 0;
 
+        if (m_mapping)
+            return m_mapPos+1;
+
         return m_stream.tellg()+std::streamoff(1u);
     }
 
@@ -1806,7 +1857,7 @@ namespace mu
     /////////////////////////////////////////////////
     size_t File::set_write_pos(size_t p)
     {
-        if (!is_open())
+        if (!is_open() || m_mapping)
             return 0;
 
         m_stream.seekp(p-1, std::ios_base::beg);
@@ -1823,7 +1874,7 @@ namespace mu
     /////////////////////////////////////////////////
     size_t File::get_write_pos() const
     {
-        if (!is_open())
+        if (!is_open() || m_mapping)
             return 0;
 
         return m_stream.tellp()+std::streamoff(1u);
@@ -1842,6 +1893,9 @@ namespace mu
         if (!is_open())
             return 0;
 
+        if (m_mapping)
+            return m_mapping->size();
+
         return std::filesystem::file_size(std::filesystem::path(m_fileName));
     }
 
@@ -1855,10 +1909,26 @@ namespace mu
     /////////////////////////////////////////////////
     bool File::is_open() const
     {
+        if (m_mapping)
+            return m_mapping->isValid();
+
         return m_stream.is_open() && m_stream.good();
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Determine, whether the file is
+    /// memory-mapped.
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool File::is_mapped() const
+    {
+        return m_mapping != nullptr;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Overload to make use of the Path class.
     ///
@@ -1878,7 +1948,9 @@ namespace mu
     /// selected file name using the open mode. The
     /// supported open modes resemble the C interface:
     /// "r", "r+", "w", "w+", "a", "a+" and "b" for
-    /// binary mode.
+    /// binary mode. The mode "m" maps the file
+    /// read-only into the memory and implies binary
+    /// mode.
     ///
     /// \param sFileName const std::string&
     /// \param sOpenMode const std::string&
@@ -1890,17 +1962,35 @@ namespace mu
         if (m_stream.is_open())
             m_stream.close();
 
+        m_mapping.reset();
+        m_mapPos = 0;
+
 #ifndef PARSERSTANDALONE
         FileSystem& _fSys = NumeReKernel::getInstance()->getFileSystem();
         m_fileName = _fSys.ValidFileName(sFileName, "", false, true);
 
-        if (sOpenMode.find('r') != std::string::npos && !fileExists(m_fileName))
+        if (sOpenMode.find_first_of("rm") != std::string::npos && !fileExists(m_fileName))
             throw SyntaxError(SyntaxError::FILE_NOT_EXIST, "object.file.open(\"" + sFileName + "\")", sFileName);
 #else
         m_fileName = sFileName;
 #endif
         m_openMode = sOpenMode;
 
+        // Memory-mapped files are read-only
+        if (m_openMode.find('m') != std::string::npos)
+        {
+            if (m_openMode.find_first_of("wa+") == std::string::npos)
+                m_mapping.reset(new FileMapping(m_fileName));
+
+            if (!m_mapping || !m_mapping->isValid())
+            {
+                close();
+                return false;
+            }
+
+            return true;
+        }
+
         int mode = 0;
 
         if (m_openMode.find('b') != std::string::npos)
@@ -1941,9 +2031,13 @@ namespace mu
     /////////////////////////////////////////////////
     bool File::close()
     {
-        if (m_stream.is_open())
+        if (m_stream.is_open() || m_mapping)
         {
-            m_stream.close();
+            if (m_stream.is_open())
+                m_stream.close();
+
+            m_mapping.reset();
+            m_mapPos = 0;
             m_fileName.clear();
             m_openMode.clear();
         }
@@ -2038,6 +2132,7 @@ namespace mu
     static ArrValue* convertToArray(const std::unique_ptr<T[]>& data, size_t n)
     {
         Array arr;
+        arr.reserve(n);
 
         for (size_t i = 0; i < n; i++)
         {
@@ -2048,6 +2143,111 @@ namespace mu
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Template function to convert n
+    /// objects of type T from a memory-mapped byte
+    /// range into a mu::Array instance. The target
+    /// is allocated once and larger ranges are
+    /// converted in parallel. The data does not have
+    /// to be aligned.
+    ///
+    /// \param data const char*
+    /// \param n size_t
+    /// \return BaseValue*
+    ///
+    /////////////////////////////////////////////////
+    template<class T>
+    static BaseValue* convertMapped(const char* data, size_t n)
+    {
+        if (!n)
+            return new NumValue(Numerical(NAN));
+
+        if (n == 1)
+        {
+            T val;
+            memcpy(&val, data, sizeof(T));
+            return new NumValue(Numerical(val));
+        }
+
+        ArrValue* arrVal = new ArrValue;
+        Array& arr = arrVal->get();
+        arr.resize(n);
+
+        #pragma omp parallel for if(n > MUP_MAPPED_PARALLEL_LIMIT)
+        for (size_t i = 0; i < n; i++)
+        {
+            T val;
+            memcpy(&val, data + i*sizeof(T), sizeof(T));
+            arr[i] = Numerical(val);
+        }
+
+        return arrVal;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Read n objects of the selected type
+    /// from a memory-mapped byte range. The number
+    /// of objects is limited by the available bytes
+    /// and the position is advanced accordingly.
+    ///
+    /// \param mapping const FileMapping&
+    /// \param pos size_t&
+    /// \param type const std::string&
+    /// \param n size_t
+    /// \return BaseValue*
+    ///
+    /////////////////////////////////////////////////
+    static BaseValue* readMapped(const FileMapping& mapping, size_t& pos, const std::string& type, size_t n)
+    {
+        size_t typeSize = 0;
+
+        if (type == "value.i8" || type == "value.ui8" || type == "char" || type == "string")
+            typeSize = 1;
+        else if (type == "value.i16" || type == "value.ui16")
+            typeSize = 2;
+        else if (type == "value.i32" || type == "value.ui32" || type == "value.f32")
+            typeSize = 4;
+        else if (type == "value.i64" || type == "value.ui64" || type == "value.f64" || type == "value.cf32")
+            typeSize = 8;
+        else if (type == "value.cf64")
+            typeSize = 16;
+        else
+            return nullptr;
+
+        n = std::min(n, (mapping.size() - pos) / typeSize);
+        const char* data = mapping.data() + pos;
+        pos += n * typeSize;
+
+        if (type == "value.i8")
+            return convertMapped<int8_t>(data, n);
+        else if (type == "value.ui8")
+            return convertMapped<uint8_t>(data, n);
+        else if (type == "value.i16")
+            return convertMapped<int16_t>(data, n);
+        else if (type == "value.ui16")
+            return convertMapped<uint16_t>(data, n);
+        else if (type == "value.i32")
+            return convertMapped<int32_t>(data, n);
+        else if (type == "value.ui32")
+            return convertMapped<uint32_t>(data, n);
+        else if (type == "value.i64")
+            return convertMapped<int64_t>(data, n);
+        else if (type == "value.ui64")
+            return convertMapped<uint64_t>(data, n);
+        else if (type == "value.f32")
+            return convertMapped<float>(data, n);
+        else if (type == "value.f64")
+            return convertMapped<double>(data, n);
+        else if (type == "value.cf32")
+            return convertMapped<std::complex<float>>(data, n);
+        else if (type == "value.cf64")
+            return convertMapped<std::complex<double>>(data, n);
+
+        return new StrValue(std::string(data, n));
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Read something from the stream in
     /// binary mode. The object type is string
@@ -2404,6 +2604,9 @@ namespace mu
     /////////////////////////////////////////////////
     BaseValue* File::read(const std::string& type, size_t n)
     {
+        if (m_mapping && is_open())
+            return readMapped(*m_mapping, m_mapPos, type, n);
+
         if (!is_open() || m_openMode.find_first_of("r+") == std::string::npos)
             return nullptr;
 
@@ -2422,6 +2625,22 @@ namespace mu
     /////////////////////////////////////////////////
     std::string File::read_line()
     {
+        if (m_mapping && is_open())
+        {
+            if (m_mapPos >= m_mapping->size())
+                return "";
+
+            const char* data = m_mapping->data() + m_mapPos;
+            size_t len = m_mapping->size() - m_mapPos;
+            const char* lineEnd = static_cast<const char*>(memchr(data, '\n', len));
+
+            if (lineEnd)
+                len = lineEnd - data;
+
+            m_mapPos += std::min(len+1, m_mapping->size() - m_mapPos);
+            return std::string(data, len);
+        }
+
         if (!is_open() || m_openMode.find_first_of("r+") == std::string::npos)
             return "";
 
@@ -2645,5 +2864,26 @@ namespace mu
 
         return true;
     }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns a pointer to nBytes bytes at
+    /// the selected (zero-based) byte position of a
+    /// memory-mapped file without copying. Returns a
+    /// nullptr, if the file is not mapped or the
+    /// range exceeds the file.
+    ///
+    /// \param pos size_t
+    /// \param nBytes size_t
+    /// \return const char*
+    ///
+    /////////////////////////////////////////////////
+    const char* File::view(size_t pos, size_t nBytes) const
+    {
+        if (!m_mapping || !m_mapping->data() || pos > m_mapping->size() || nBytes > m_mapping->size() - pos)
+            return nullptr;
+
+        return m_mapping->data() + pos;
+    }
 }
 
@@ -24,6 +24,9 @@
 #include <string>
 #include <memory>
 #include <fstream>
+#include <cstdint>
+
+#include "muFileMapping.hpp"
 
 namespace mu
 {
@@ -235,12 +238,16 @@ namespace mu
 
     /////////////////////////////////////////////////
     /// \brief This class allows for arbitrary file
-    /// accesses using test and binary modes.
+    /// accesses using test and binary modes. Files
+    /// may also be memory-mapped for fast read-only
+    /// binary accesses.
     /////////////////////////////////////////////////
     class File
     {
         private:
             mutable std::fstream m_stream;
+            std::shared_ptr<FileMapping> m_mapping;
+            size_t m_mapPos;
             std::string m_fileName;
             std::string m_openMode;
 
@@ -258,6 +265,7 @@ namespace mu
             size_t get_write_pos() const;
             size_t length() const;
             bool is_open() const;
+            bool is_mapped() const;
             bool open(const Path& path, const std::string& sOpenMode = "r");
             bool open(const std::string& sFileName, const std::string& sOpenMode = "r");
             bool close();
@@ -269,6 +277,32 @@ namespace mu
             BaseValue* read(const std::string& type, size_t n = 1);
             std::string read_line();
             bool write(const BaseValue& val, const std::string& sSeparator = "");
+
+            const char* view(size_t pos, size_t nBytes) const;
+
+            /////////////////////////////////////////////////
+            /// \brief Returns a typed view on n objects of
+            /// type T at the selected byte position of a
+            /// memory-mapped file without copying. Returns a
+            /// nullptr, if the file is not mapped, the range
+            /// exceeds the file or the position is not
+            /// aligned for T.
+            ///
+            /// \param pos size_t
+            /// \param n size_t
+            /// \return const T*
+            ///
+            /////////////////////////////////////////////////
+            template<class T>
+            const T* view(size_t pos, size_t n) const
+            {
+                const char* data = view(pos, n*sizeof(T));
+
+                if (!data || reinterpret_cast<uintptr_t>(data) % alignof(T))
+                    return nullptr;
+
+                return reinterpret_cast<const T*>(data);
+            }
     };
 }
 
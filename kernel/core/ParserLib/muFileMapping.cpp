@@ -0,0 +1,133 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "muFileMapping.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace mu
+{
+    /////////////////////////////////////////////////
+    /// \brief Constructor. Maps the selected file
+    /// read-only into the memory. Use isValid() to
+    /// determine, whether the mapping succeeded.
+    ///
+    /// \param sFileName const std::string&
+    ///
+    /////////////////////////////////////////////////
+    FileMapping::FileMapping(const std::string& sFileName) : m_data(nullptr), m_size(0), m_fileHandle(nullptr), m_mapHandle(nullptr), m_isValid(false)
+    {
+#ifdef _WIN32
+        HANDLE hFile = CreateFileA(sFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (hFile == INVALID_HANDLE_VALUE)
+            return;
+
+        m_fileHandle = hFile;
+        LARGE_INTEGER fileSize;
+
+        if (!GetFileSizeEx(hFile, &fileSize))
+            return;
+
+        m_size = fileSize.QuadPart;
+
+        // Empty files cannot be mapped
+        if (!m_size)
+        {
+            m_isValid = true;
+            return;
+        }
+
+        HANDLE hMap = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (!hMap)
+            return;
+
+        m_mapHandle = hMap;
+        m_data = static_cast<const char*>(MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0));
+        m_isValid = m_data != nullptr;
+#else
+        int fd = ::open(sFileName.c_str(), O_RDONLY);
+
+        if (fd < 0)
+            return;
+
+        struct stat fileStat;
+
+        if (fstat(fd, &fileStat) < 0)
+        {
+            ::close(fd);
+            return;
+        }
+
+        m_size = fileStat.st_size;
+
+        // Empty files cannot be mapped
+        if (!m_size)
+        {
+            ::close(fd);
+            m_isValid = true;
+            return;
+        }
+
+        void* mem = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // The mapping stays valid after closing
+        // the file descriptor
+        ::close(fd);
+
+        if (mem == MAP_FAILED)
+            return;
+
+        madvise(mem, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(mem);
+        m_isValid = true;
+#endif
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Destructor. Releases the mapping and
+    /// the file.
+    /////////////////////////////////////////////////
+    FileMapping::~FileMapping()
+    {
+#ifdef _WIN32
+        if (m_data)
+            UnmapViewOfFile(m_data);
+
+        if (m_mapHandle)
+            CloseHandle(m_mapHandle);
+
+        if (m_fileHandle)
+            CloseHandle(m_fileHandle);
+#else
+        if (m_data)
+            munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+}
+
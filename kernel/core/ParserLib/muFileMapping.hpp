@@ -0,0 +1,90 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef MUFILEMAPPING_HPP
+#define MUFILEMAPPING_HPP
+
+#include <string>
+#include <cstddef>
+
+namespace mu
+{
+    /////////////////////////////////////////////////
+    /// \brief This class maps a whole file read-only
+    /// into the address space of the process. The
+    /// contents are loaded lazily by the operating
+    /// system, once they are accessed. Instances
+    /// cannot be copied and are therefore shared
+    /// between File instances.
+    /////////////////////////////////////////////////
+    class FileMapping
+    {
+        private:
+            const char* m_data;
+            size_t m_size;
+            void* m_fileHandle;
+            void* m_mapHandle;
+            bool m_isValid;
+
+        public:
+            FileMapping(const std::string& sFileName);
+            FileMapping(const FileMapping&) = delete;
+            FileMapping& operator=(const FileMapping&) = delete;
+            ~FileMapping();
+
+            /////////////////////////////////////////////////
+            /// \brief Returns true, if the file could be
+            /// mapped. Empty files are valid but do not
+            /// provide any data.
+            ///
+            /// \return bool
+            ///
+            /////////////////////////////////////////////////
+            bool isValid() const
+            {
+                return m_isValid;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the size of the mapped file
+            /// in bytes.
+            ///
+            /// \return size_t
+            ///
+            /////////////////////////////////////////////////
+            size_t size() const
+            {
+                return m_size;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Returns a pointer to the first byte
+            /// of the mapped file.
+            ///
+            /// \return const char*
+            ///
+            /////////////////////////////////////////////////
+            const char* data() const
+            {
+                return m_data;
+            }
+    };
+}
+
+#endif // MUFILEMAPPING_HPP
+
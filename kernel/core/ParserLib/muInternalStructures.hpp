@@ -118,6 +118,21 @@ namespace mu
                 m_alias = var;
             }
 
+            /////////////////////////////////////////////////
+            /// \brief Reference the array contained in
+            /// another StackItem instance. If the other
+            /// instance is a reference itself, its target is
+            /// referenced instead.
+            ///
+            /// \param other StackItem&
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void aliasOf(StackItem& other)
+            {
+                m_alias = other.m_alias ? other.m_alias : &other;
+            }
+
             /////////////////////////////////////////////////
             /// \brief Check, whether this StackItem
             /// references the passed array.
@@ -131,6 +146,20 @@ namespace mu
                 return m_alias == var;
             }
 
+            /////////////////////////////////////////////////
+            /// \brief Check, whether this StackItem
+            /// references the array contained in the passed
+            /// StackItem.
+            ///
+            /// \param other const StackItem&
+            /// \return bool
+            ///
+            /////////////////////////////////////////////////
+            bool isAliasOf(const StackItem& other)
+            {
+                return m_alias == &other;
+            }
+
             /////////////////////////////////////////////////
             /// \brief Mark this stack item as an index.
             ///
@@ -523,6 +552,48 @@ namespace mu
                 }
             }
 
+            /////////////////////////////////////////////////
+            /// \brief Implementation for the cmPOWN byte
+            /// code. Raises the contained array to the
+            /// passed positive integer power by repeated
+            /// multiplication. As the multiplication keeps
+            /// the type of the base, whereas the power
+            /// operator promotes integers and single
+            /// precision values, other bases than F64 and
+            /// CF64 use the power operator instead.
+            ///
+            /// \param exponent const Array&
+            /// \param N int
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void powN(const Array& exponent, int N)
+            {
+                const Array& current = get();
+
+                for (size_t i = 0; i < current.size(); i++)
+                {
+                    if (!current.get(i).isNumerical()
+                        || (current.get(i).getNum().getType() != F64 && current.get(i).getNum().getType() != CF64))
+                    {
+                        operator=(current ^ exponent);
+                        return;
+                    }
+                }
+
+                Array base(current);
+
+                if (m_alias)
+                    operator=(base);
+
+                ensureConst();
+
+                for (int n = 1; n < N; n++)
+                {
+                    Array::operator*=(base);
+                }
+            }
+
             /////////////////////////////////////////////////
             /// \brief Implementaton for the cmVARMUL byte
             /// code.
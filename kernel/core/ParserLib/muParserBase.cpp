@@ -28,6 +28,8 @@
 #include "muHelpers.hpp"
 #include "../utils/tools.hpp"
 #include "../utils/timer.hpp"
+#include "../utils/kernelstats.hpp"
+#include "../utils/counterrandgen.hpp"
 #include "../structures.hpp"
 
 //--- Standard includes ------------------------------------------------------------------------
@@ -128,6 +130,7 @@ namespace mu
 		, m_OprtDef()
 		, m_ConstDef()
 		, m_bBuiltInOp(true)
+		, m_bEnableJit(true)
 		, m_sNameChars()
 		, m_sOprtChars()
 		, m_sInfixOprtChars()
@@ -193,9 +196,11 @@ namespace mu
 		// Don't copy bytecode instead cause the parser to create new bytecode
 		// by resetting the parse function.
 		ReInit();
+		m_stateCache.clear();
 
 		m_ConstDef = a_Parser.m_ConstDef;         // Copy user define constants
 		m_bBuiltInOp = a_Parser.m_bBuiltInOp;
+		m_bEnableJit = a_Parser.m_bEnableJit;
 		m_nIfElseCounter = a_Parser.m_nIfElseCounter;
 		m_factory = a_Parser.m_factory; // Get a reference to the original var factory
 		m_pTokenReader.reset(a_Parser.m_pTokenReader->Clone(this)); // Needs the correct factory
@@ -406,6 +411,7 @@ namespace mu
 		CheckOprt(a_strName, a_Callback, a_szCharSet);
 		a_Storage[a_strName] = a_Callback;
 		ReInit();
+		m_stateCache.clear();
 	}
 
 	//---------------------------------------------------------------------------
@@ -465,13 +471,28 @@ namespace mu
 		// -> Return, if that is true
 		// -> Invalidate the bytecode for this formula, if necessary
 		if (IsAlreadyParsed(a_sExpr))
+		{
+			g_kernelStats.count(KC_PARSER_BYTECODE_HITS);
 			return;
+		}
 		else if (bMakeLoopByteCode
                  && !bPauseLoopByteCode
                  && this->GetExpr().length()
                  && m_state->m_valid)
 			m_state->m_valid = 0;
 
+		bool useStateCache = !bMakeLoopByteCode || bPauseLoopByteCode;
+
+		// Outside of the loop mode, the expression might
+		// have been compiled already before
+		if (useStateCache && RestoreCachedState(a_sExpr))
+        {
+            g_kernelStats.count(KC_PARSER_STATECACHE_HITS);
+            return;
+        }
+
+        g_kernelStats.count(KC_PARSER_MISSES);
+
         // Pass the formula to the token reader
 		m_pTokenReader->SetFormula(a_sExpr);
 
@@ -480,6 +501,50 @@ namespace mu
 
 		// Convert the string directly to bytecode
 		ParseString();
+
+		if (useStateCache)
+            m_stateCache.store(m_compilingState);
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Restore the compiled state of the
+    /// passed expression from the state cache, if it
+    /// is available. The cached state is only used,
+    /// if all of its variables still refer to the
+    /// same storage (which also considers changed
+    /// variable aliases).
+    ///
+    /// \param sExpr StringView
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	bool ParserBase::RestoreCachedState(StringView sExpr)
+	{
+	    State* cached = m_stateCache.find(sExpr);
+
+	    if (!cached)
+            return false;
+
+        for (const auto& iter : cached->m_usedVar)
+        {
+            if (m_factory->Get(iter.first) != iter.second)
+            {
+                m_stateCache.discard();
+                return false;
+            }
+        }
+
+        // The token reader is still needed for error
+        // messages and the list of used variables
+        m_pTokenReader->SetFormula(sExpr);
+        m_pTokenReader->GetUsedVar() = cached->m_usedVar;
+
+        m_compilingState = *cached;
+        m_state = &m_compilingState;
+        m_pParseFormula = &ParserBase::ParseCmdCode;
+
+        return true;
 	}
 
 
@@ -507,6 +572,322 @@ namespace mu
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Determines, whether the passed range
+    /// of the bytecode only consists of element-wise
+    /// operations and computes the size of its
+    /// result, which is the common size of all
+    /// non-scalar leaves in this range.
+    ///
+    /// \param first const SToken*
+    /// \param last const SToken*
+    /// \param nElems size_t&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool getElementwiseSize(const SToken* first, const SToken* last, size_t& nElems)
+    {
+        nElems = 1;
+
+        // Scalars are broadcasted, all other leaves
+        // have to share the same size
+        auto addLeaf = [&nElems](size_t leafSize)
+        {
+            if (leafSize == 1 || leafSize == nElems)
+                return true;
+
+            if (!leafSize || nElems != 1)
+                return false;
+
+            nElems = leafSize;
+            return true;
+        };
+
+        for (const SToken* pTok = first; pTok < last; ++pTok)
+        {
+            switch (pTok->Cmd)
+            {
+                case cmLE:
+                case cmGE:
+                case cmNEQ:
+                case cmEQ:
+                case cmLT:
+                case cmGT:
+                case cmADD:
+                case cmSUB:
+                case cmMUL:
+                case cmDIV:
+                case cmPOW:
+                case cmLAND:
+                case cmLOR:
+                case cmPOWN:
+                case cmMULADD:
+                case cmREVMULADD:
+                    continue;
+
+                case cmVAL:
+                    if (!addLeaf(pTok->Val().data2.size()))
+                        return false;
+
+                    continue;
+
+                case cmVAR:
+                case cmVARPOW2:
+                case cmVARPOW3:
+                case cmVARPOW4:
+                case cmVARPOWN:
+                    if (!addLeaf(pTok->Val().var->size()))
+                        return false;
+
+                    continue;
+
+                case cmVARMUL:
+                case cmREVVARMUL:
+                case cmDIVVAR:
+                    if (!addLeaf(pTok->Val().var->size())
+                        || !addLeaf(pTok->Val().data.size())
+                        || (!pTok->Val().data2.isDefault() && !addLeaf(pTok->Val().data2.size())))
+                        return false;
+
+                    continue;
+
+                case cmFUNC:
+                    if (pTok->Fun().argc == 1 && pTok->Fun().isPure && pTok->Fun().isElementwise)
+                        continue;
+
+                    return false;
+
+                default:
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Gathers the selected elements of the
+    /// passed array. Scalars are returned unchanged.
+    ///
+    /// \param arr const Array&
+    /// \param idx const std::vector<size_t>&
+    /// \return Array
+    ///
+    /////////////////////////////////////////////////
+    static Array gatherElements(const Array& arr, const std::vector<size_t>& idx)
+    {
+        if (arr.size() == 1)
+            return arr;
+
+        Array ret(idx.size());
+
+        for (size_t i = 0; i < idx.size(); i++)
+        {
+            ret.get(i) = arr.get(idx[i]);
+        }
+
+        return ret;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Evaluates a range of the bytecode,
+    /// which only consists of element-wise
+    /// operations (see getElementwiseSize()), on the
+    /// selected elements of its leaves only.
+    ///
+    /// \param first SToken*
+    /// \param last SToken*
+    /// \param idx const std::vector<size_t>&
+    /// \return Array
+    ///
+    /////////////////////////////////////////////////
+    static Array evalElementwise(SToken* first, SToken* last, const std::vector<size_t>& idx)
+    {
+        std::vector<StackItem> Stack(last - first + 1);
+        int sidx(0);
+
+        for (SToken* pTok = first; pTok < last; ++pTok)
+        {
+            switch (pTok->Cmd)
+            {
+                case  cmLE:
+                    --sidx;
+                    Stack[sidx]  = Stack[sidx] <= Stack[sidx + 1];
+                    continue;
+                case  cmGE:
+                    --sidx;
+                    Stack[sidx]  = Stack[sidx] >= Stack[sidx + 1];
+                    continue;
+                case  cmNEQ:
+                    --sidx;
+                    Stack[sidx]  = Stack[sidx] != Stack[sidx + 1];
+                    continue;
+                case  cmEQ:
+                    --sidx;
+                    Stack[sidx]  = Stack[sidx] == Stack[sidx + 1];
+                    continue;
+                case  cmLT:
+                    --sidx;
+                    Stack[sidx]  = Stack[sidx] < Stack[sidx + 1];
+                    continue;
+                case  cmGT:
+                    --sidx;
+                    Stack[sidx]  = Stack[sidx] > Stack[sidx + 1];
+                    continue;
+                case  cmADD:
+                    --sidx;
+                    Stack[sidx]  += Stack[1 + sidx];
+                    continue;
+                case  cmSUB:
+                    --sidx;
+                    Stack[sidx]  -= Stack[1 + sidx];
+                    continue;
+                case  cmMUL:
+                    --sidx;
+                    Stack[sidx]  *= Stack[1 + sidx];
+                    continue;
+                case  cmDIV:
+                    --sidx;
+                    Stack[sidx]  /= Stack[1 + sidx];
+                    continue;
+                case  cmPOW:
+                    --sidx;
+                    Stack[sidx]  ^= Stack[1 + sidx];
+                    continue;
+                case  cmLAND:
+                    --sidx;
+                    Stack[sidx]  = Stack[sidx] && Stack[sidx + 1];
+                    continue;
+                case  cmLOR:
+                    --sidx;
+                    Stack[sidx]  = Stack[sidx] || Stack[sidx + 1];
+                    continue;
+
+                case  cmPOWN:
+                    Stack[sidx].powN(pTok->Oprt().val, pTok->Oprt().offset);
+                    continue;
+                case  cmMULADD:
+                    sidx -= 2;
+                    Stack[sidx]  *= Stack[sidx + 1];
+                    Stack[sidx]  += Stack[sidx + 2];
+                    continue;
+                case  cmREVMULADD:
+                    sidx -= 2;
+                    Stack[sidx + 1]  *= Stack[sidx + 2];
+                    Stack[sidx]  += Stack[sidx + 1];
+                    continue;
+
+                // Only the leaves have to be gathered
+                case  cmVAL:
+                    if (pTok->Val().data2.size() == 1)
+                        Stack[++sidx].aliasOf(&pTok->Val().data2);
+                    else
+                        Stack[++sidx] = gatherElements(pTok->Val().data2, idx);
+                    continue;
+                case  cmVAR:
+                    if (pTok->Val().var->size() == 1)
+                        Stack[++sidx].aliasOf(pTok->Val().var);
+                    else
+                        Stack[++sidx] = gatherElements(*pTok->Val().var, idx);
+                    continue;
+                case  cmVARPOW2:
+                    Stack[++sidx].varPowN(Variable(gatherElements(*pTok->Val().var, idx)), 2);
+                    continue;
+                case  cmVARPOW3:
+                    Stack[++sidx].varPowN(Variable(gatherElements(*pTok->Val().var, idx)), 3);
+                    continue;
+                case  cmVARPOW4:
+                    Stack[++sidx].varPowN(Variable(gatherElements(*pTok->Val().var, idx)), 4);
+                    continue;
+                case  cmVARPOWN:
+                    Stack[++sidx].varPowN(Variable(gatherElements(*pTok->Val().var, idx)),
+                                          pTok->Val().data.getAsScalarInt());
+                    continue;
+                case  cmVARMUL:
+                    Stack[++sidx].varMul(gatherElements(pTok->Val().data, idx),
+                                         Variable(gatherElements(*pTok->Val().var, idx)),
+                                         pTok->Val().data2.isDefault() ? pTok->Val().data2 : gatherElements(pTok->Val().data2, idx));
+                    continue;
+                case  cmREVVARMUL:
+                    Stack[++sidx].revVarMul(gatherElements(pTok->Val().data, idx),
+                                            Variable(gatherElements(*pTok->Val().var, idx)),
+                                            pTok->Val().data2.isDefault() ? pTok->Val().data2 : gatherElements(pTok->Val().data2, idx));
+                    continue;
+                case  cmDIVVAR:
+                    Stack[++sidx].divVar(gatherElements(pTok->Val().data, idx),
+                                         Variable(gatherElements(*pTok->Val().var, idx)),
+                                         pTok->Val().data2.isDefault() ? pTok->Val().data2 : gatherElements(pTok->Val().data2, idx));
+                    continue;
+
+                case  cmFUNC:
+                    Stack[sidx] = (*(fun_type1)pTok->Fun().ptr)(Stack[sidx].get());
+                    continue;
+
+                default:
+                    throw ParserError(ecINTERNAL_ERROR);
+            }
+        }
+
+        return Stack[1].get();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Implements the inline conditional
+    /// operator for a vector condition with
+    /// element-wise branches. Each branch is only
+    /// evaluated on the elements, which select it,
+    /// and the results are scattered into the
+    /// combined result afterwards.
+    ///
+    /// \param cond const Array&
+    /// \param pIf SToken*
+    /// \param pElse SToken*
+    /// \param pEndIf SToken*
+    /// \return Array
+    ///
+    /////////////////////////////////////////////////
+    static Array evalMaskedIfElse(const Array& cond, SToken* pIf, SToken* pElse, SToken* pEndIf)
+    {
+        std::vector<size_t> trueIdx;
+        std::vector<size_t> falseIdx;
+
+        for (size_t i = 0; i < cond.size(); i++)
+        {
+            if (cond.get(i))
+                trueIdx.push_back(i);
+            else
+                falseIdx.push_back(i);
+        }
+
+        Array ret(cond.size());
+
+        if (trueIdx.size())
+        {
+            Array res = evalElementwise(pIf+1, pElse, trueIdx);
+
+            for (size_t i = 0; i < trueIdx.size(); i++)
+            {
+                ret.get(trueIdx[i]) = res.get(i);
+            }
+        }
+
+        if (falseIdx.size())
+        {
+            Array res = evalElementwise(pElse+1, pEndIf, falseIdx);
+
+            for (size_t i = 0; i < falseIdx.size(); i++)
+            {
+                ret.get(falseIdx[i]) = res.get(i);
+            }
+        }
+
+        return ret;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Internal alias function to construct a
     /// vector from a list of elements.
@@ -649,8 +1030,12 @@ namespace mu
 									   fun_type1 a_pFun,
 									   bool optimizeAway)
 	{
+		// Postfix operators act on every element separately
+		ParserCallback callback(a_pFun, optimizeAway, 0, prPOSTFIX, cmOPRT_POSTFIX);
+		callback.MakeElementwise();
+
 		AddCallback(a_sName,
-					ParserCallback(a_pFun, optimizeAway, 0, prPOSTFIX, cmOPRT_POSTFIX),
+					callback,
 					m_PostOprtDef,
 					ValidOprtChars() );
 	}
@@ -682,13 +1067,38 @@ namespace mu
 									 int a_iPrec,
 									 bool optimizeAway)
 	{
+		// Infix operators act on every element separately
+		ParserCallback callback(a_pFun, optimizeAway, 0, a_iPrec, cmOPRT_INFIX);
+		callback.MakeElementwise();
+
 		AddCallback(a_sName,
-					ParserCallback(a_pFun, optimizeAway, 0, a_iPrec, cmOPRT_INFIX),
+					callback,
 					m_InfixOprtDef,
 					ValidInfixOprtChars() );
 	}
 
 
+	/////////////////////////////////////////////////
+	/// \brief Define a pure function with a single
+	/// argument, which maps every element of its
+	/// argument independently. Its results may be
+	/// computed on a subset of the elements only,
+	/// e.g. in the branches of the ternary operator.
+	///
+	/// \param a_strName const string_type&
+	/// \param a_pFun fun_type1
+	/// \return void
+	///
+	/////////////////////////////////////////////////
+	void ParserBase::DefineElementwiseFun(const string_type& a_strName, fun_type1 a_pFun)
+	{
+		ParserCallback callback(a_pFun, true, 0);
+		callback.MakeElementwise();
+
+		AddCallback(a_strName, callback, m_FunDef, ValidNameChars());
+	}
+
+
 	//---------------------------------------------------------------------------
 	/** \brief Define a binary operator.
 	    \param [in] a_sName The identifier of the operator.
@@ -803,6 +1213,7 @@ namespace mu
 		CheckName(a_sName, ValidNameChars());
 		m_ConstDef[a_sName] = a_fVal;
 		ReInit();
+		m_stateCache.clear();
 	}
 
 	//---------------------------------------------------------------------------
@@ -1055,7 +1466,12 @@ namespace mu
                 m_compilingState.m_byteCode.AddFun(funTok.GetFuncAddr(),
                                                    (funTok.GetArgCount() == -1) ? -iArgCount : iArgRequired,
                                                    funTok.IsOptimizable(),
-                                                   funTok.GetAsString());
+                                                   funTok.GetAsString(),
+                                                   cmFUNC,
+                                                   funTok.IsElementwise(),
+                                                   funTok.IsRandom()
+                                                       ? getRandCallSite(m_pTokenReader->GetExpr().to_string(), m_pTokenReader->GetPos())
+                                                       : 0);
 				break;
 			case  cmIDX:
 			case  cmSQIDX:
@@ -1118,33 +1534,38 @@ namespace mu
 	}
 
 	//---------------------------------------------------------------------------
+	/** \brief Closes all pending if-then-else clauses, whose false branch is
+	           complete. Both branches are already part of the bytecode, only
+	           the end marker is missing.
+	    \param a_stOpt The operator stack
+	    \param a_stVal The value stack
+	    \param a_stArgCount The argument counter stack
+	*/
 	void ParserBase::ApplyIfElse(ParserStack<token_type>& a_stOpt,
-								 ParserStack<token_type>& a_stVal) const
+								 ParserStack<token_type>& a_stVal,
+								 ParserStack<int>& a_stArgCount) const
 	{
 		// Check if there is an if Else clause to be calculated
-		while (a_stOpt.size() && a_stOpt.top().GetCode() == cmELSE)
+		while (a_stOpt.size() && a_stOpt.top().GetCode() == cmIF && a_stArgCount.top() == 3)
 		{
-			token_type opElse = a_stOpt.pop();
-			MUP_ASSERT(a_stOpt.size() > 0);
+			a_stArgCount.pop();
+			a_stOpt.pop();
 
-			// Take the value associated with the else branch from the value stack
-			token_type vVal2 = a_stVal.pop();
+			// Pop the condition and both branches from the value stack
+			// and push a dummy value representing the result
+			MUP_ASSERT(a_stVal.size() >= 3);
+			a_stVal.pop();
+			a_stVal.pop();
+			a_stVal.pop();
 
-			MUP_ASSERT(a_stOpt.size() > 0);
-			MUP_ASSERT(a_stVal.size() >= 2);
-
-			// it then else is a ternary operator Pop all three values from the value s
-			// tack and just return the right value
-			token_type vVal1 = a_stVal.pop();
-			token_type vExpr = a_stVal.pop();
-
-			a_stVal.push(std::move(all(vExpr.GetVal() != Array(Value(0.0))) ? vVal1 : vVal2));
-
-			token_type opIf = a_stOpt.pop();
-			MUP_ASSERT(opElse.GetCode() == cmELSE);
-			MUP_ASSERT(opIf.GetCode() == cmIF);
+			token_type resTok;
+			resTok.MoveVal(Array(Value(1.0)));
+			a_stVal.push(std::move(resTok));
 
 			m_compilingState.m_byteCode.AddIfElse(cmENDIF);
+
+			// Operators below the clause are complete now as well
+			ApplyRemainingOprt(a_stOpt, a_stVal);
 		} // while pending if-else-clause found
 	}
 
@@ -1250,10 +1671,6 @@ namespace mu
 						ApplyBinOprt(stOpt, stVal);
 					break;
 
-				case cmELSE:
-					ApplyIfElse(stOpt, stVal);
-					break;
-
                 case cmVAL2STR:
                     ApplyVal2Str(stOpt, stVal);
                     break;
@@ -1275,9 +1692,18 @@ namespace mu
 	void ParserBase::ParseCmdCode()
 	{
 		int sidx(0);
+		uint64_t ifElseMask(0);
+		size_t nElems;
 		std::vector<StackItem>& Stack = m_state->m_stackBuffer;
 		//return;
 
+		// Use the native code for purely numerical
+		// expressions, if it is available
+		if (m_bEnableJit
+            && m_state->m_numResults == 1
+            && m_state->m_jit.evaluate(m_state->m_byteCode, Stack[1]))
+            return;
+
         for (SToken* pTok = m_state->m_byteCode.GetBase(); pTok->Cmd != cmEND ; ++pTok)
         {
             //continue;
@@ -1339,11 +1765,61 @@ namespace mu
                     Stack[sidx]  = Stack[sidx] || Stack[sidx + 1];
                     continue;
 
+                case  cmSHORTCUT_LAND:
+                    // Skip the right operand, if the scalar left one is false
+                    // and the shape of the right one is known in advance. The
+                    // result is broadcasted to this shape
+                    if (Stack[sidx].get().isScalar()
+                        && !all(Stack[sidx].get())
+                        && getElementwiseSize(pTok+1, pTok + pTok->Oprt().offset, nElems))
+                    {
+                        Stack[sidx] = Array(nElems, Value(false));
+                        pTok += pTok->Oprt().offset;
+                    }
+                    continue;
+                case  cmSHORTCUT_LOR:
+                    // Skip the right operand, if the scalar left one is true
+                    // and the shape of the right one is known in advance. The
+                    // result is broadcasted to this shape
+                    if (Stack[sidx].get().isScalar()
+                        && all(Stack[sidx].get())
+                        && getElementwiseSize(pTok+1, pTok + pTok->Oprt().offset, nElems))
+                    {
+                        Stack[sidx] = Array(nElems, Value(true));
+                        pTok += pTok->Oprt().offset;
+                    }
+                    continue;
+
                 case  cmVAL2STR:
                     --sidx;
                     Stack[sidx]  = val2Str(Stack[sidx].get(), Stack[sidx+1].get().front().getNum().asUI64());
                     continue;
 
+                case  cmPOWN:
+                    Stack[sidx].powN(pTok->Oprt().val, pTok->Oprt().offset);
+                    continue;
+
+                case  cmMULADD:
+                    sidx -= 2;
+                    Stack[sidx]  *= Stack[sidx + 1];
+                    Stack[sidx]  += Stack[sidx + 2];
+                    continue;
+                case  cmREVMULADD:
+                    sidx -= 2;
+                    Stack[sidx + 1]  *= Stack[sidx + 2];
+                    Stack[sidx]  += Stack[sidx + 1];
+                    continue;
+
+                case  cmSTORE:
+                    // Move the common subexpression into its slot
+                    // and reference it from the current position
+                    Stack[pTok->Oprt().offset] = std::move(Stack[sidx]);
+                    Stack[sidx].aliasOf(Stack[pTok->Oprt().offset]);
+                    continue;
+                case  cmLOAD:
+                    Stack[++sidx].aliasOf(Stack[pTok->Oprt().offset]);
+                    continue;
+
                 case  cmASSIGN:
                     --sidx;
                     if (pTok->Oprt().var.isNull())
@@ -1422,16 +1898,59 @@ namespace mu
                         Stack[sidx] = pTok->Oprt().var-= Value(1);
                     continue;
 
-                case  cmIF: // Not needed right now, operator converted to a function
-                    if (!all(Stack[sidx--].get()))
-                        pTok += pTok->Oprt().offset;
+                case  cmIF:
+                    // A scalar condition evaluates only the selected
+                    // branch. A vector condition evaluates element-wise
+                    // branches only on the elements selecting them.
+                    // Otherwise, it remains on the stack and both
+                    // branches are evaluated and combined element-wise
+                    // at cmENDIF. The lowest bit of the mask marks
+                    // vector conditions
+                    if (!Stack[sidx].get().isScalar())
+                    {
+                        SToken* pElse = pTok + pTok->Oprt().offset;
+                        SToken* pEndIf = pElse + pElse->Oprt().offset;
+                        size_t nCondElems = Stack[sidx].get().size();
+
+                        if (getElementwiseSize(pTok+1, pElse, nElems)
+                            && (nElems == 1 || nElems == nCondElems)
+                            && getElementwiseSize(pElse+1, pEndIf, nElems)
+                            && (nElems == 1 || nElems == nCondElems))
+                        {
+                            Stack[sidx] = evalMaskedIfElse(Stack[sidx].get(), pTok, pElse, pEndIf);
+                            pTok = pEndIf;
+                            continue;
+                        }
+
+                        ifElseMask = (ifElseMask << 1) | 1;
+                    }
+                    else
+                    {
+                        ifElseMask <<= 1;
+
+                        if (!all(Stack[sidx--].get()))
+                            pTok += pTok->Oprt().offset;
+                    }
                     continue;
 
-                case  cmELSE: // Not needed right now, operator converted to a function
-                    pTok += pTok->Oprt().offset;
+                case  cmELSE:
+                    // Jump over the false branch, if the condition was a scalar
+                    if (!(ifElseMask & 1))
+                    {
+                        ifElseMask >>= 1;
+                        pTok += pTok->Oprt().offset;
+                    }
                     continue;
 
-                case  cmENDIF: // Not needed right now, operator converted to a function
+                case  cmENDIF:
+                    // Combine both branches, if the condition was a vector
+                    if (ifElseMask & 1)
+                    {
+                        sidx -= 2;
+                        Stack[sidx] = evalIfElse(Stack[sidx].get(), Stack[sidx+1].get(), Stack[sidx+2].get());
+                    }
+
+                    ifElseMask >>= 1;
                     continue;
 
                 // value and variable tokens
@@ -1515,6 +2034,12 @@ namespace mu
                     {
                         int iArgCount = pTok->Fun().argc;
 
+                        // Announce the call site to the random
+                        // functions. It was identified during
+                        // compilation
+                        if (pTok->Fun().randSite)
+                            setRandCallSite(pTok->Fun().randSite, reserveRandDraw(), 0);
+
                         // switch according to argument count
                         switch (iArgCount)
                         {
@@ -1728,6 +2253,8 @@ namespace mu
             int nThreadID = omp_get_thread_num();
             StackItem* Stack = &m_state->m_stackBuffer[nThreadID * nBufferOffset];
             int sidx(0);
+            uint64_t ifElseMask(0);
+            size_t nElems;
 
             // Run the bytecode
             for (SToken* pTok = m_state->m_byteCode.GetBase(); pTok->Cmd != cmEND ; ++pTok)
@@ -1790,11 +2317,55 @@ namespace mu
                         Stack[sidx]  = Stack[sidx] || Stack[sidx + 1];
                         continue;
 
+                    case  cmSHORTCUT_LAND:
+                        if (Stack[sidx].get().isScalar()
+                            && !all(Stack[sidx].get())
+                            && getElementwiseSize(pTok+1, pTok + pTok->Oprt().offset, nElems))
+                        {
+                            Stack[sidx] = Array(nElems, Value(false));
+                            pTok += pTok->Oprt().offset;
+                        }
+                        continue;
+                    case  cmSHORTCUT_LOR:
+                        if (Stack[sidx].get().isScalar()
+                            && all(Stack[sidx].get())
+                            && getElementwiseSize(pTok+1, pTok + pTok->Oprt().offset, nElems))
+                        {
+                            Stack[sidx] = Array(nElems, Value(true));
+                            pTok += pTok->Oprt().offset;
+                        }
+                        continue;
+
                     case  cmVAL2STR:
                         --sidx;
                         Stack[sidx]  = val2Str(Stack[sidx].get(), Stack[sidx+1].get().front().getNum().asUI64());
                         continue;
 
+                    case  cmPOWN:
+                        Stack[sidx].powN(pTok->Oprt().val, pTok->Oprt().offset);
+                        continue;
+
+                    case  cmMULADD:
+                        sidx -= 2;
+                        Stack[sidx]  *= Stack[sidx + 1];
+                        Stack[sidx]  += Stack[sidx + 2];
+                        continue;
+                    case  cmREVMULADD:
+                        sidx -= 2;
+                        Stack[sidx + 1]  *= Stack[sidx + 2];
+                        Stack[sidx]  += Stack[sidx + 1];
+                        continue;
+
+                    case  cmSTORE:
+                        // Move the common subexpression into its slot
+                        // and reference it from the current position
+                        Stack[pTok->Oprt().offset] = std::move(Stack[sidx]);
+                        Stack[sidx].aliasOf(Stack[pTok->Oprt().offset]);
+                        continue;
+                    case  cmLOAD:
+                        Stack[++sidx].aliasOf(Stack[pTok->Oprt().offset]);
+                        continue;
+
                     case  cmASSIGN:
                         --sidx;
                         if (pTok->Oprt().var.isScalar())
@@ -1851,16 +2422,34 @@ namespace mu
                         pTok->Oprt().var -= Value(1);
                         continue;
 
-                    case  cmIF: // Not needed right now, operator converted to a function
-                        if (!all(Stack[sidx--].get()))
-                            pTok += pTok->Oprt().offset;
+                    case  cmIF:
+                        if (!Stack[sidx].get().isScalar())
+                            ifElseMask = (ifElseMask << 1) | 1;
+                        else
+                        {
+                            ifElseMask <<= 1;
+
+                            if (!all(Stack[sidx--].get()))
+                                pTok += pTok->Oprt().offset;
+                        }
                         continue;
 
-                    case  cmELSE: // Not needed right now, operator converted to a function
-                        pTok += pTok->Oprt().offset;
+                    case  cmELSE:
+                        if (!(ifElseMask & 1))
+                        {
+                            ifElseMask >>= 1;
+                            pTok += pTok->Oprt().offset;
+                        }
                         continue;
 
-                    case  cmENDIF: // Not needed right now, operator converted to a function
+                    case  cmENDIF:
+                        if (ifElseMask & 1)
+                        {
+                            sidx -= 2;
+                            Stack[sidx] = evalIfElse(Stack[sidx].get(), Stack[sidx+1].get(), Stack[sidx+2].get());
+                        }
+
+                        ifElseMask >>= 1;
                         continue;
 
                     // value and variable tokens
@@ -2053,6 +2642,8 @@ namespace mu
 	//---------------------------------------------------------------------------
 	void ParserBase::CreateRPN()
 	{
+	    g_kernelStats.count(KC_PARSER_RPN_COMPILATIONS);
+
 	    if (g_DbgDumpStack)
             print("Parsing: \"" + m_pTokenReader->GetExpr() + "\"");
 
@@ -2129,6 +2720,15 @@ namespace mu
 						}
                     }
 
+                    // Complete the true branch including all nested
+                    // clauses and mark the beginning of the false branch
+                    ApplyRemainingOprt(stOpt, stVal);
+                    ApplyIfElse(stOpt, stVal, stArgCount);
+
+                    if (!stOpt.size() || stOpt.top().GetCode() != cmIF || stArgCount.top() != 2)
+                        Error(ecMISPLACED_COLON, m_pTokenReader->GetPos());
+
+                    m_compilingState.m_byteCode.AddIfElse(cmELSE);
 					m_nIfElseCounter--;
 
 					if (m_nIfElseCounter < 0) // zweiter noetiger check
@@ -2139,6 +2739,21 @@ namespace mu
 					if (stArgCount.empty())
 						Error(ecUNEXPECTED_ARG_SEP, m_pTokenReader->GetPos());
 
+                    // An argument separator terminates all pending
+                    // if-then-else clauses
+                    if (opt.GetCode() == cmARG_SEP && stOpt.size())
+                    {
+                        ApplyRemainingOprt(stOpt, stVal);
+
+                        if (stOpt.size() && stOpt.top().GetCode() == cmIF)
+                        {
+                            if (stArgCount.top() != 3)
+                                Error(ecUNEXPECTED_CONDITIONAL, m_pTokenReader->GetPos(), "?");
+
+                            ApplyIfElse(stOpt, stVal, stArgCount);
+                        }
+                    }
+
 					++stArgCount.top();
 
 				// fallthrough intentional (no break!)
@@ -2206,9 +2821,10 @@ namespace mu
 
                         if (stOpt.size() && stOpt.top().GetCode() == cmIF)
                         {
-                            stArgCount.pop();
-                            stOpt.top().Set(m_FunDef.at(MU_IF_ELSE), MU_IF_ELSE);
-                            ApplyFunc(stOpt, stVal, 3);
+                            if (stArgCount.top() != 3)
+                                Error(ecUNEXPECTED_CONDITIONAL, m_pTokenReader->GetPos(), "?");
+
+                            ApplyIfElse(stOpt, stVal, stArgCount);
                         }
 
                         ECmdCode topCode = stOpt.top().GetCode();
@@ -2347,8 +2963,21 @@ namespace mu
 					} // while ( ... )
 
 					if (opt.GetCode() == cmIF)
+                    {
+                        // The evaluation tracks the nested clauses in a bit mask
+                        if (m_compilingState.m_byteCode.GetIfElseDepth() >= MUP_MAX_IF_NESTING)
+                            Error(ecUNEXPECTED_CONDITIONAL, m_pTokenReader->GetPos(), "?");
+
                         stArgCount.push(2); // This operator separates already two values
 
+                        // The condition is complete: add the conditional jump
+                        m_compilingState.m_byteCode.AddIfElse(cmIF);
+                    }
+                    else if (opt.GetCode() == cmLAND)
+                        m_compilingState.m_byteCode.AddShortCircuit(cmSHORTCUT_LAND);
+                    else if (opt.GetCode() == cmLOR)
+                        m_compilingState.m_byteCode.AddShortCircuit(cmSHORTCUT_LOR);
+
 					// The operator can't be evaluated right now, push back to the operator stack
 					stOpt.push(opt);
 					break;
@@ -2439,15 +3068,13 @@ namespace mu
                         if (stArgCount.top() != 3)
                             Error(ecUNEXPECTED_CONDITIONAL, m_pTokenReader->GetPos(), "?");
 
-                        stArgCount.pop();
-                        stOpt.top().Set(m_FunDef.at(MU_IF_ELSE), MU_IF_ELSE);
-                        ApplyFunc(stOpt, stVal, 3);
+                        ApplyIfElse(stOpt, stVal, stArgCount);
                     }
                     else
                         ApplyRemainingOprt(stOpt, stVal);
                 }
 
-				m_compilingState.m_byteCode.Finalize();
+				m_compilingState.m_byteCode.Finalize(ParserBase::g_DbgDumpCmdCode);
 				break;
 			}
 
@@ -2583,6 +3210,7 @@ namespace mu
 	{
 		m_FunDef.clear();
 		ReInit();
+		m_stateCache.clear();
 	}
 
 	//------------------------------------------------------------------------------
@@ -2596,6 +3224,7 @@ namespace mu
 	{
 		m_ConstDef.clear();
 		ReInit();
+		m_stateCache.clear();
 	}
 
 	//------------------------------------------------------------------------------
@@ -2607,6 +3236,7 @@ namespace mu
 	{
 		m_PostOprtDef.clear();
 		ReInit();
+		m_stateCache.clear();
 	}
 
 	//------------------------------------------------------------------------------
@@ -2618,6 +3248,7 @@ namespace mu
 	{
 		m_OprtDef.clear();
 		ReInit();
+		m_stateCache.clear();
 	}
 
 	//------------------------------------------------------------------------------
@@ -2629,6 +3260,7 @@ namespace mu
 	{
 		m_InfixOprtDef.clear();
 		ReInit();
+		m_stateCache.clear();
 	}
 
 	//------------------------------------------------------------------------------
@@ -2640,6 +3272,7 @@ namespace mu
 	{
 		m_compilingState.m_byteCode.EnableOptimizer(a_bIsOn);
 		ReInit();
+		m_stateCache.clear();
 	}
 
 	//---------------------------------------------------------------------------
@@ -2669,6 +3302,20 @@ namespace mu
 	{
 		m_bBuiltInOp = a_bIsOn;
 		ReInit();
+		m_stateCache.clear();
+	}
+
+	//------------------------------------------------------------------------------
+	/** \brief Enable or disable the native code tier.
+	    \throw nothrow
+
+	  If enabled, numerical expressions, which are evaluated repeatedly, are
+	  translated into native code. Unsupported expressions are still evaluated
+	  by the bytecode interpreter.
+	*/
+	void ParserBase::EnableJit(bool a_bIsOn)
+	{
+		m_bEnableJit = a_bIsOn;
 	}
 
 	//------------------------------------------------------------------------------
@@ -2696,6 +3343,7 @@ namespace mu
 	void ParserBase::SetArgSep(char_type cArgSep)
 	{
 		m_pTokenReader->SetArgSep(cArgSep);
+		m_stateCache.clear();
 	}
 
 	//------------------------------------------------------------------------------
@@ -3332,6 +3980,48 @@ namespace mu
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Check, whether the last evaluated
+    /// expression only consists of element-wise
+    /// operations, i.e. every element of its results
+    /// only depends on the corresponding elements of
+    /// its variables. Aggregating, impure and
+    /// multi-argument functions as well as methods
+    /// and indices are not element-wise.
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool ParserBase::IsElementwise()
+    {
+        size_t nElems;
+
+        for (const SToken* pTok = m_state->m_byteCode.GetBase(); pTok->Cmd != cmEND; ++pTok)
+        {
+            switch (pTok->Cmd)
+            {
+                // Vector conditions select element-wise
+                // and common subexpressions are only
+                // references
+                case cmIF:
+                case cmELSE:
+                case cmENDIF:
+                case cmSHORTCUT_LAND:
+                case cmSHORTCUT_LOR:
+                case cmSTORE:
+                case cmLOAD:
+                    continue;
+
+                default:
+                    if (!getElementwiseSize(pTok, pTok+1, nElems))
+                        return false;
+            }
+        }
+
+        return true;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief This member function copies the passed
     /// vector into the internal storage referencing
@@ -117,6 +117,7 @@ namespace mu
 			void PauseLoopMode(bool _bPause = true);
 			bool IsAlreadyParsed(StringView sNewEquation);
 			bool IsNotLastStackItem() const;
+			bool IsElementwise();
 
 			static void EnableDebugDump(bool bDumpCmd, bool bDumpStack);
 
@@ -138,6 +139,7 @@ namespace mu
 
 			void EnableOptimizer(bool a_bIsOn = true);
 			void EnableBuiltInOprt(bool a_bIsOn = true);
+			void EnableJit(bool a_bIsOn = true);
 
 			bool HasBuiltInOprt() const;
 			void AddValIdent(identfun_type a_pCallback);
@@ -154,6 +156,22 @@ namespace mu
 				AddCallback( a_strName, ParserCallback(a_pFun, optimizeAway, numOpt), m_FunDef, ValidNameChars() );
 			}
 
+			/** \brief Define a parser function, which draws random numbers. Its
+			           call sites are identified during compilation.
+			    \param a_strName Name of the function
+			    \param a_pFun Pointer to the callback function
+			    \param numOpt Number of optional arguments
+			*/
+			template<typename T>
+			void DefineRandomFun(const string_type& a_strName, T a_pFun, int numOpt = 0)
+			{
+				ParserCallback callback(a_pFun, false, numOpt);
+				callback.MakeRandom();
+
+				AddCallback(a_strName, callback, m_FunDef, ValidNameChars());
+			}
+
+			void DefineElementwiseFun(const string_type& a_strName, fun_type1 a_pFun);
 			void DefineOprt(const string_type& a_strName,
 							fun_type2 a_pFun,
 							unsigned a_iPri = 0,
@@ -276,6 +294,7 @@ namespace mu
 			void Assign(const ParserBase& a_Parser);
 			void InitTokenReader();
 			void ReInit();
+			bool RestoreCachedState(StringView sExpr);
             //ExpressionTarget& getTarget() const;
 
 			void AddCallback( const string_type& a_strName,
@@ -291,7 +310,8 @@ namespace mu
 							  ParserStack<token_type>& a_stVal) const;
 
 			void ApplyIfElse(ParserStack<token_type>& a_stOpt,
-							 ParserStack<token_type>& a_stVal) const;
+							 ParserStack<token_type>& a_stVal,
+							 ParserStack<int>& a_stArgCount) const;
 
 			void ApplyFunc(ParserStack<token_type>& a_stOpt,
 						   ParserStack<token_type>& a_stVal,
@@ -322,6 +342,7 @@ namespace mu
 			mutable State m_compilingState;
 			//mutable ExpressionTarget m_compilingTarget;
 			mutable StateStacks m_stateStacks;
+			StateCache m_stateCache;
 			State* m_state;
 
 			mutable varmap_type mInternalVars;
@@ -346,6 +367,7 @@ namespace mu
 			std::shared_ptr<VarFactory> m_factory;
 
 			bool m_bBuiltInOp;             ///< Flag that can be used for switching built in operators on and off
+			bool m_bEnableJit;             ///< Flag that can be used for switching the native code tier on and off
 
 			string_type m_sNameChars;      ///< Charset for names
 			string_type m_sOprtChars;      ///< Charset for postfix/ binary operator tokens
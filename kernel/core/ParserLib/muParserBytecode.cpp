@@ -32,6 +32,9 @@
 #include <stack>
 #include <vector>
 #include <iostream>
+#include <algorithm>
+#include <complex>
+#include <cmath>
 
 #include "muParserDef.h"
 #include "muParserError.h"
@@ -46,6 +49,8 @@ namespace mu
 	ParserByteCode::ParserByteCode()
 		: m_iStackPos(0)
 		, m_iMaxStackSize(0)
+		, m_iIfElseDepth(0)
+		, m_iTempCount(0)
 		, m_vRPN()
 		, m_bEnableOptimizer(true)
 	{
@@ -92,6 +97,8 @@ namespace mu
 		m_iStackPos = a_ByteCode.m_iStackPos;
 		m_vRPN = a_ByteCode.m_vRPN;
 		m_iMaxStackSize = a_ByteCode.m_iMaxStackSize;
+		m_iIfElseDepth = a_ByteCode.m_iIfElseDepth;
+		m_iTempCount = a_ByteCode.m_iTempCount;
 		m_bEnableOptimizer = a_ByteCode.m_bEnableOptimizer;
 	}
 
@@ -269,6 +276,21 @@ namespace mu
             size_t prev = sz-2;
             size_t curr = sz-1;
 
+            // Remove the short-circuit jump between two constant
+            // operands of a logical operator, because the whole
+            // operation will be folded
+            if ((a_Oprt == cmLAND || a_Oprt == cmLOR)
+                && sz >= 3
+                && (m_vRPN[prev].Cmd == cmSHORTCUT_LAND || m_vRPN[prev].Cmd == cmSHORTCUT_LOR)
+                && m_vRPN[sz-3].Cmd == cmVAL
+                && m_vRPN[curr].Cmd == cmVAL)
+            {
+                m_vRPN.erase(m_vRPN.begin()+prev);
+                sz--;
+                prev--;
+                curr--;
+            }
+
 			// Check for foldable constants like:
 			//   cmVAL cmVAL cmADD
 			// where cmADD can stand fopr any binary operator applied to
@@ -303,6 +325,25 @@ namespace mu
 							m_vRPN.pop_back();
 							bOptimized = true;
 						}
+						else if (m_vRPN[curr].Cmd == cmVAL
+                                 && m_vRPN[curr].Val().data2.isScalar()
+                                 && m_vRPN[curr].Val().data2.getCommonType() == TYPE_NUMERICAL)
+                        {
+                            // Optimization: (a+b)^3 -> (a+b)*(a+b)*(a+b)
+                            int64_t nExp = m_vRPN[curr].Val().data2.getAsScalarInt();
+
+                            if (nExp < 2
+                                || nExp > MUP_MAX_POWN
+                                || !all(m_vRPN[curr].Val().data2 == Array(Value(nExp))))
+                                break;
+
+                            // Keep the exponent for bases, which are
+                            // not double precision values
+                            m_vRPN[curr].Cmd = cmPOWN;
+                            m_vRPN[curr].m_data = SOprtData{.val{m_vRPN[curr].Val().data2}, .offset{(int)nExp}};
+                            --m_iStackPos;
+							bOptimized = true;
+                        }
 						break;
 
 					case  cmSUB:
@@ -402,6 +443,26 @@ namespace mu
                             m_vRPN.pop_back();
 							bOptimized = true;
                         }
+                        else if (a_Oprt == cmADD
+                                 && m_vRPN[prev].Cmd == cmMUL
+                                 && ((m_vRPN[curr].Cmd >= cmVAL && m_vRPN[curr].Cmd <= cmDIVVAR && m_vRPN[curr].Cmd != cmVARARRAY)
+                                     || m_vRPN[curr].Cmd == cmDIMVAR))
+                        {
+                            // Optimization: a*b+c -> MULADD(a,b,c). The
+                            // third operand has to be a single token,
+                            // because it is moved in front of the
+                            // multiplication
+                            m_vRPN.erase(m_vRPN.begin()+prev);
+                            m_iMaxStackSize = std::max(m_iMaxStackSize, (size_t)m_iStackPos+1);
+                            a_Oprt = cmMULADD;
+                        }
+                        else if (a_Oprt == cmADD && m_vRPN[curr].Cmd == cmMUL)
+                        {
+                            // Optimization: c+a*b -> REVMULADD(c,a,b)
+                            m_vRPN[curr].Cmd = cmREVMULADD;
+                            --m_iStackPos;
+							bOptimized = true;
+                        }
 
 						break;
 
@@ -540,6 +601,24 @@ namespace mu
 							m_vRPN.pop_back();
 							bOptimized = true;
 						}
+                        else if (m_vRPN[curr].Cmd == cmVAL
+                                 && m_vRPN[curr].Val().data2.isScalar()
+                                 && m_vRPN[curr].Val().data2.getCommonType() == TYPE_NUMERICAL)
+                        {
+                            // Optimization: a/4 -> a*0.25. Only applied for
+                            // powers of two, because only their reciprocal
+                            // is exact and the result is unchanged
+                            std::complex<double> divisor = m_vRPN[curr].Val().data2.front().getNum().asCF64();
+                            int nExp;
+
+                            if (divisor.imag() != 0.0
+                                || !std::isfinite(divisor.real())
+                                || std::abs(std::frexp(divisor.real(), &nExp)) != 0.5)
+                                break;
+
+                            m_vRPN[curr].Val().data2 = Array(Value(1.0 / divisor.real()));
+                            a_Oprt = cmMUL;
+                        }
 						break;
 
                     default:
@@ -560,8 +639,73 @@ namespace mu
 		}
 	}
 
-	//---------------------------------------------------------------------------
+    /////////////////////////////////////////////////
+    /// \brief Add a token of the ternary
+    /// if-then-else operator. The condition remains
+    /// on the stack while both branches are
+    /// evaluated, if it is a vector. Therefore, the
+    /// stack position is only decremented at the
+    /// cmENDIF token. Conditional clauses with
+    /// constant scalar condition and constant
+    /// branches are folded.
+    ///
+    /// \param a_Oprt ECmdCode
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
 	void ParserByteCode::AddIfElse(ECmdCode a_Oprt)
+	{
+	    if (a_Oprt == cmIF)
+            m_iIfElseDepth++;
+	    else if (a_Oprt == cmENDIF)
+        {
+            m_iStackPos -= 2;
+            m_iIfElseDepth--;
+
+            std::size_t sz = m_vRPN.size();
+
+            // Check for foldable constants like:
+            //   cmVAL cmIF cmVAL cmELSE cmVAL
+            if (m_bEnableOptimizer
+                && sz >= 5
+                && m_vRPN[sz-5].Cmd == cmVAL
+                && m_vRPN[sz-4].Cmd == cmIF
+                && m_vRPN[sz-3].Cmd == cmVAL
+                && m_vRPN[sz-2].Cmd == cmELSE
+                && m_vRPN[sz-1].Cmd == cmVAL
+                && m_vRPN[sz-5].Val().data2.isScalar())
+            {
+                if (all(m_vRPN[sz-5].Val().data2))
+                    m_vRPN[sz-5].Val().data2 = m_vRPN[sz-3].Val().data2;
+                else
+                    m_vRPN[sz-5].Val().data2 = m_vRPN[sz-1].Val().data2;
+
+                m_vRPN.resize(sz-4);
+                return;
+            }
+        }
+
+		SToken tok;
+		tok.Cmd = a_Oprt;
+		tok.m_data = SOprtData{.offset{0}};
+		m_vRPN.push_back(tok);
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Add a short-circuit jump for the
+    /// logical operators. The jump is placed
+    /// between the left and the right operand and
+    /// skips the evaluation of the right operand, if
+    /// the left one is a scalar and already
+    /// determines the result. The jump offset is
+    /// calculated in ParserByteCode::Finalize().
+    ///
+    /// \param a_Oprt ECmdCode
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+	void ParserByteCode::AddShortCircuit(ECmdCode a_Oprt)
 	{
 		SToken tok;
 		tok.Cmd = a_Oprt;
@@ -643,11 +787,17 @@ namespace mu
     /// \param optimizeAway bool
     /// \param funcName const std::string&
     /// \param code ECmdCode
+    /// \param isElementwise bool
+    /// \param randSite uint64_t
     /// \return void
     ///
     /////////////////////////////////////////////////
-	void ParserByteCode::AddFun(generic_fun_type a_pFun, int a_iArgc, bool optimizeAway, const std::string& funcName, ECmdCode code)
+	void ParserByteCode::AddFun(generic_fun_type a_pFun, int a_iArgc, bool optimizeAway, const std::string& funcName, ECmdCode code, bool isElementwise, uint64_t randSite)
 	{
+	    // Functions, which may be folded, do not have any
+	    // side effects and may be reused
+	    bool isPure = optimizeAway;
+
 	    // Shall we try to optimize?
 		if (m_bEnableOptimizer && optimizeAway)
 		{
@@ -821,7 +971,7 @@ namespace mu
 
             SToken tok;
             tok.Cmd = code;
-            tok.m_data = SFunData{.ptr{a_pFun}, .name{funcName}, .argc{a_iArgc}, .idx{0}};
+            tok.m_data = SFunData{.ptr{a_pFun}, .name{funcName}, .argc{a_iArgc}, .idx{0}, .isPure{isPure}, .isElementwise{isElementwise}, .randSite{randSite}};
             m_vRPN.push_back(tok);
 		}
 	}
@@ -843,7 +993,7 @@ namespace mu
 
         SToken tok;
         tok.Cmd = cmMETHOD;
-        tok.m_data = SFunData{.name{a_method}, .argc{a_iArgc}, .idx{0}};
+        tok.m_data = SFunData{.ptr{nullptr}, .name{a_method}, .argc{a_iArgc}, .idx{0}, .isPure{false}, .isElementwise{false}, .randSite{0}};
         m_vRPN.push_back(tok);
 	}
 
@@ -860,20 +1010,360 @@ namespace mu
             m_vRPN.pop_back();
 	}
 
+    /////////////////////////////////////////////////
+    /// \brief Returns the number of operands of the
+    /// passed token, if it may take part in the
+    /// common subexpression elimination. Returns -1
+    /// otherwise.
+    ///
+    /// \param tok const SToken&
+    /// \return int
+    ///
+    /////////////////////////////////////////////////
+	static int getCseOperandCount(const SToken& tok)
+	{
+	    switch (tok.Cmd)
+	    {
+            case cmVAL:
+            case cmVAR:
+            case cmDIMVAR:
+            case cmVARPOW2:
+            case cmVARPOW3:
+            case cmVARPOW4:
+            case cmVARPOWN:
+            case cmVARMUL:
+            case cmREVVARMUL:
+            case cmDIVVAR:
+                return 0;
+
+            case cmPOWN:
+                return 1;
+
+            case cmLE:
+            case cmGE:
+            case cmNEQ:
+            case cmEQ:
+            case cmLT:
+            case cmGT:
+            case cmADD:
+            case cmSUB:
+            case cmMUL:
+            case cmDIV:
+            case cmPOW:
+            case cmIDX:
+                return 2;
+
+            case cmMULADD:
+            case cmREVMULADD:
+                return 3;
+
+            case cmFUNC:
+                if (!tok.Fun().isPure)
+                    return -1;
+
+                return std::abs(tok.Fun().argc);
+
+            default:
+                return -1;
+	    }
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Compares two constant arrays within
+    /// the bytecode. Only numerical and string
+    /// arrays are compared, all others are treated
+    /// as different.
+    ///
+    /// \param a const Array&
+    /// \param b const Array&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool isEqualConstant(const Array& a, const Array& b)
+	{
+	    if (a.size() != b.size() || a.getCommonType() != b.getCommonType())
+            return false;
+
+	    if (!a.size())
+            return true;
+
+        if (a.getCommonType() != TYPE_NUMERICAL && a.getCommonType() != TYPE_STRING)
+            return false;
+
+        return all(a == b);
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Compares two tokens, which may take
+    /// part in the common subexpression elimination.
+    ///
+    /// \param a const SToken&
+    /// \param b const SToken&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	static bool isEqualToken(const SToken& a, const SToken& b)
+	{
+	    if (a.Cmd != b.Cmd)
+            return false;
+
+        switch (a.Cmd)
+        {
+            case cmVAL:
+                return isEqualConstant(a.Val().data2, b.Val().data2);
+
+            case cmVAR:
+            case cmDIMVAR:
+            case cmVARPOW2:
+            case cmVARPOW3:
+            case cmVARPOW4:
+                return a.Val().var == b.Val().var;
+
+            case cmVARPOWN:
+                return a.Val().var == b.Val().var
+                    && isEqualConstant(a.Val().data, b.Val().data);
+
+            case cmVARMUL:
+            case cmREVVARMUL:
+            case cmDIVVAR:
+                return a.Val().var == b.Val().var
+                    && isEqualConstant(a.Val().data, b.Val().data)
+                    && isEqualConstant(a.Val().data2, b.Val().data2);
+
+            case cmPOWN:
+                return a.Oprt().offset == b.Oprt().offset
+                    && isEqualConstant(a.Oprt().val, b.Oprt().val);
+
+            case cmFUNC:
+                return a.Fun().ptr == b.Fun().ptr
+                    && a.Fun().argc == b.Fun().argc
+                    && a.Fun().idx == b.Fun().idx
+                    && a.Fun().name == b.Fun().name;
+
+            default:
+                return true;
+        }
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Calculates a hash of a single token
+    /// without its operands. Equal tokens result in
+    /// equal hashes.
+    ///
+    /// \param tok const SToken&
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+	static size_t getTokenHash(const SToken& tok)
+	{
+	    size_t hash = std::hash<int>()(tok.Cmd);
+
+	    if ((tok.Cmd >= cmVAR && tok.Cmd <= cmDIVVAR && tok.Cmd != cmVARARRAY) || tok.Cmd == cmDIMVAR)
+            hash ^= std::hash<const void*>()(tok.Val().var) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        else if (tok.Cmd == cmFUNC)
+            hash ^= std::hash<std::string>()(tok.Fun().name) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        else if (tok.Cmd == cmPOWN)
+            hash ^= std::hash<int>()(tok.Oprt().offset) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+        return hash;
+	}
+
+
+    /////////////////////////////////////////////////
+    /// \brief Removes common subexpressions from
+    /// the bytecode. The first occurrence of a
+    /// repeated subexpression (e.g. sin(x) or an
+    /// indexed access) stores its result in a
+    /// temporary slot after the actual stack and all
+    /// further occurrences are replaced by loading
+    /// this slot. Only straight-line bytecode
+    /// consisting of operators, variables, constants
+    /// and pure functions is considered. Returns
+    /// true, if the bytecode was changed.
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+	bool ParserByteCode::EliminateCommonSubexpressions()
+	{
+	    // The last token is always cmEND
+	    size_t nTokens = m_vRPN.size()-1;
+	    std::vector<size_t> vStart(nTokens);
+	    std::vector<size_t> vHash(nTokens);
+	    std::vector<size_t> vRoots;
+
+	    // Reconstruct the expression tree: determine the
+	    // first token and the hash of every subexpression
+	    for (size_t i = 0; i < nTokens; i++)
+        {
+            int nOperands = getCseOperandCount(m_vRPN[i]);
+
+            if (nOperands < 0 || vRoots.size() < (size_t)nOperands)
+                return false;
+
+            vStart[i] = i;
+            vHash[i] = getTokenHash(m_vRPN[i]);
+
+            if (nOperands)
+            {
+                size_t firstOperand = vRoots.size()-nOperands;
+                vStart[i] = vStart[vRoots[firstOperand]];
+
+                for (size_t n = firstOperand; n < vRoots.size(); n++)
+                {
+                    vHash[i] ^= vHash[vRoots[n]] + 0x9e3779b9 + (vHash[i] << 6) + (vHash[i] >> 2);
+                }
+
+                vRoots.resize(firstOperand);
+            }
+
+            vRoots.push_back(i);
+        }
+
+        // Only non-trivial subexpressions are candidates
+        std::vector<size_t> vCandidates;
+
+        for (size_t i = 0; i < nTokens; i++)
+        {
+            if (vStart[i] < i)
+                vCandidates.push_back(i);
+        }
+
+        if (vCandidates.size() < 2)
+            return false;
+
+        // Handle the largest subexpressions first. The
+        // stable sort keeps the evaluation order for
+        // subexpressions of equal length
+        std::stable_sort(vCandidates.begin(), vCandidates.end(),
+                         [&vStart](size_t a, size_t b){return a - vStart[a] > b - vStart[b];});
+
+        std::vector<bool> vRemoved(nTokens, false);
+        std::vector<int> vStore(nTokens, -1);
+        std::vector<int> vLoad(nTokens, -1);
+        size_t nTemps = 0;
+
+        for (size_t c = 0; c < vCandidates.size(); c++)
+        {
+            size_t first = vCandidates[c];
+            size_t len = first - vStart[first];
+
+            if (vRemoved[first] || vStore[first] >= 0)
+                continue;
+
+            for (size_t n = c+1; n < vCandidates.size(); n++)
+            {
+                size_t other = vCandidates[n];
+
+                if (other - vStart[other] != len)
+                    break;
+
+                if (vRemoved[other] || vHash[other] != vHash[first])
+                    continue;
+
+                bool isEqual = true;
+
+                for (size_t t = 0; t <= len; t++)
+                {
+                    if (!isEqualToken(m_vRPN[vStart[first]+t], m_vRPN[vStart[other]+t]))
+                    {
+                        isEqual = false;
+                        break;
+                    }
+                }
+
+                if (!isEqual)
+                    continue;
+
+                // The slots are located after the actual stack
+                if (vStore[first] < 0)
+                    vStore[first] = m_iMaxStackSize + 1 + nTemps++;
+
+                vLoad[other] = vStore[first];
+
+                for (size_t t = vStart[other]; t <= other; t++)
+                {
+                    vRemoved[t] = true;
+                }
+            }
+        }
+
+        if (!nTemps)
+            return false;
+
+        // Rebuild the bytecode
+        rpn_type vRPN;
+        vRPN.reserve(m_vRPN.size());
+
+        for (size_t i = 0; i < nTokens; i++)
+        {
+            if (vLoad[i] >= 0)
+            {
+                SToken tok;
+                tok.Cmd = cmLOAD;
+                tok.m_data = SOprtData{.offset{vLoad[i]}};
+                vRPN.push_back(tok);
+                continue;
+            }
+
+            if (vRemoved[i])
+                continue;
+
+            vRPN.push_back(m_vRPN[i]);
+
+            if (vStore[i] >= 0)
+            {
+                SToken tok;
+                tok.Cmd = cmSTORE;
+                tok.m_data = SOprtData{.offset{vStore[i]}};
+                vRPN.push_back(tok);
+            }
+        }
+
+        vRPN.push_back(m_vRPN.back());
+        m_vRPN.swap(vRPN);
+        m_iTempCount = nTemps;
+
+        return true;
+	}
+
+
 	//---------------------------------------------------------------------------
 	/** \brief Add end marker to bytecode.
 
+	    The common subexpression elimination is applied afterwards, if the
+	    optimizer is active. The unoptimized bytecode is dumped, if requested.
+
 	    \throw nothrow
 	*/
-	void ParserByteCode::Finalize()
+	void ParserByteCode::Finalize(bool bDumpOptimization)
 	{
 		SToken tok;
 		tok.Cmd = cmEND;
 		m_vRPN.push_back(tok);
+
+		if (m_bEnableOptimizer)
+        {
+            ParserByteCode unoptimized;
+
+            if (bDumpOptimization)
+                unoptimized.Assign(*this);
+
+            if (EliminateCommonSubexpressions() && bDumpOptimization)
+            {
+                print("Bytecode before common subexpression elimination:");
+                unoptimized.AsciiDump();
+                print("Bytecode after common subexpression elimination:");
+            }
+        }
+
 		rpn_type(m_vRPN).swap(m_vRPN);     // shrink bytecode vector to fit
 
-		// Determine the if-then-else jump offsets
-		ParserStack<int> stIf, stElse;
+		// Determine the if-then-else and short-circuit jump offsets
+		ParserStack<int> stIf, stElse, stShortCircuit;
 		int idx;
 		for (int i = 0; i < (int)m_vRPN.size(); ++i)
 		{
@@ -894,6 +1384,17 @@ namespace mu
 					m_vRPN[idx].Oprt().offset = i - idx;
 					break;
 
+				case cmSHORTCUT_LAND:
+				case cmSHORTCUT_LOR:
+					stShortCircuit.push(i);
+					break;
+
+				case cmLAND:
+				case cmLOR:
+					idx = stShortCircuit.pop();
+					m_vRPN[idx].Oprt().offset = i - idx;
+					break;
+
 				default:
 					break;
 			}
@@ -938,7 +1439,21 @@ namespace mu
 	//---------------------------------------------------------------------------
 	std::size_t ParserByteCode::GetMaxStackSize() const
 	{
-		return m_iMaxStackSize + 1;
+		return m_iMaxStackSize + 1 + m_iTempCount;
+	}
+
+	//---------------------------------------------------------------------------
+	/** \brief Returns the number of currently open if-then-else clauses. */
+	std::size_t ParserByteCode::GetIfElseDepth() const
+	{
+		return m_iIfElseDepth;
+	}
+
+	//---------------------------------------------------------------------------
+	/** \brief Returns the number of temporary slots for common subexpressions. */
+	std::size_t ParserByteCode::GetTempCount() const
+	{
+		return m_iTempCount;
 	}
 
 	//---------------------------------------------------------------------------
@@ -962,6 +1477,8 @@ namespace mu
 		m_vRPN.clear();
 		m_iStackPos = 0;
 		m_iMaxStackSize = 0;
+		m_iIfElseDepth = 0;
+		m_iTempCount = 0;
 	}
 
 	//---------------------------------------------------------------------------
@@ -1088,6 +1605,21 @@ namespace mu
 				case cmVAL2STR:
 					printFormatted("VAL2STR\n");
 					break;
+				case cmPOWN:
+					printFormatted("POWN      \t[EXP: " + toString(m_vRPN[i].Oprt().offset) + "]\n");
+					break;
+				case cmMULADD:
+					printFormatted("MULADD\n");
+					break;
+				case cmREVMULADD:
+					printFormatted("REVMULADD\n");
+					break;
+				case cmSTORE:
+					printFormatted("STORE     \t[SLOT: " + toString(m_vRPN[i].Oprt().offset) + "]\n");
+					break;
+				case cmLOAD:
+					printFormatted("LOAD      \t[SLOT: " + toString(m_vRPN[i].Oprt().offset) + "]\n");
+					break;
 
 				case cmIF:
 				    printFormatted("IF        \t[OFFSET: " + toString(m_vRPN[i].Oprt().offset) + "]\n");
@@ -1101,6 +1633,14 @@ namespace mu
 					printFormatted("ENDIF\n");
 					break;
 
+				case cmSHORTCUT_LAND:
+				    printFormatted("SC_AND    \t[OFFSET: " + toString(m_vRPN[i].Oprt().offset) + "]\n");
+					break;
+
+				case cmSHORTCUT_LOR:
+				    printFormatted("SC_OR     \t[OFFSET: " + toString(m_vRPN[i].Oprt().offset) + "]\n");
+					break;
+
                 case cmVARCOPY:
 					printFormatted("VARCOPY   \t[" + m_vRPN[i].Oprt().var.print() + "] <- [" + m_vRPN[i].Oprt().src->printOverview() + "]\n");
 					break;
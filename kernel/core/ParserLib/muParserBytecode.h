@@ -26,6 +26,7 @@
 #define MU_PARSER_BYTECODE_H
 
 #include <cassert>
+#include <cstdint>
 #include <string>
 #include <stack>
 #include <vector>
@@ -68,6 +69,9 @@ namespace mu
         std::string name;
         int   argc;
         int   idx;
+        bool  isPure;
+        bool  isElementwise;
+        uint64_t randSite; ///< Call site of a random function or zero
     };
 
     /////////////////////////////////////////////////
@@ -154,12 +158,19 @@ namespace mu
 			/** \brief Maximum size needed for the stack. */
 			std::size_t m_iMaxStackSize;
 
+			/** \brief Number of currently open if-then-else clauses. */
+			unsigned m_iIfElseDepth;
+
+			/** \brief Number of temporary slots for common subexpressions. */
+			std::size_t m_iTempCount;
+
 			/** \brief The actual rpn storage. */
 			rpn_type  m_vRPN;
 
 			bool m_bEnableOptimizer;
 
 			void ConstantFolding(ECmdCode a_Oprt);
+			bool EliminateCommonSubexpressions();
 
 		public:
 
@@ -174,19 +185,22 @@ namespace mu
 			void AddVal(Array&& a_fVal);
 			void AddOp(ECmdCode a_Oprt);
 			void AddIfElse(ECmdCode a_Oprt);
+			void AddShortCircuit(ECmdCode a_Oprt);
 			void AddAssignOp(Variable* a_pVar, ECmdCode assignmentCode);
 			void AddAssignOp(const VarArray& a_varArray, ECmdCode assignmentCode);
-			void AddFun(generic_fun_type a_pFun, int a_iArgc, bool optimizeAway, const std::string& funcName, ECmdCode code = cmFUNC);
+			void AddFun(generic_fun_type a_pFun, int a_iArgc, bool optimizeAway, const std::string& funcName, ECmdCode code = cmFUNC, bool isElementwise = false, uint64_t randSite = 0);
 			void AddMethod(const std::string& a_method, int a_iArgc);
 
 			void pop();
 
 			void EnableOptimizer(bool bStat);
 
-			void Finalize();
+			void Finalize(bool bDumpOptimization = false);
 			void ChangeVar(Variable* a_pOldVar, Variable* a_pNewVar, bool isVect);
 			void clear();
 			std::size_t GetMaxStackSize() const;
+			std::size_t GetIfElseDepth() const;
+			std::size_t GetTempCount() const;
 			std::size_t GetSize() const;
 
 			SToken* GetBase();
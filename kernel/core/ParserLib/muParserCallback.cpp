@@ -42,6 +42,8 @@ namespace mu
         , m_iCode(cmFUNC)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {}
 
     //---------------------------------------------------------------------------
@@ -54,6 +56,8 @@ namespace mu
         , m_iCode(a_iCode)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {
         m_iOptArgC = std::min(m_iArgc, m_iOptArgC);
     }
@@ -72,6 +76,8 @@ namespace mu
         , m_iCode(cmFUNC)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {
         m_iOptArgC = std::min(m_iArgc, m_iOptArgC);
     }
@@ -96,6 +102,8 @@ namespace mu
         , m_iCode(cmOPRT_BIN)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {
         m_iOptArgC = std::min(m_iArgc, m_iOptArgC);
     }
@@ -110,6 +118,8 @@ namespace mu
         , m_iCode(cmFUNC)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {
         m_iOptArgC = std::min(m_iArgc, m_iOptArgC);
     }
@@ -125,6 +135,8 @@ namespace mu
         , m_iCode(cmFUNC)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {
         m_iOptArgC = std::min(m_iArgc, m_iOptArgC);
     }
@@ -140,6 +152,8 @@ namespace mu
         , m_iCode(cmFUNC)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {
         m_iOptArgC = std::min(m_iArgc, m_iOptArgC);
     }
@@ -154,6 +168,8 @@ namespace mu
         , m_iCode(cmFUNC)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {
         m_iOptArgC = std::min(m_iArgc, m_iOptArgC);
     }
@@ -168,6 +184,8 @@ namespace mu
         , m_iCode(cmFUNC)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {
         m_iOptArgC = std::min(m_iArgc, m_iOptArgC);
     }
@@ -182,6 +200,8 @@ namespace mu
         , m_iCode(cmFUNC)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {
         m_iOptArgC = std::min(m_iArgc, m_iOptArgC);
     }
@@ -196,6 +216,8 @@ namespace mu
         , m_iCode(cmFUNC)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {
         m_iOptArgC = std::min(m_iArgc, m_iOptArgC);
     }
@@ -210,6 +232,8 @@ namespace mu
         , m_iCode(cmFUNC)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {
         m_iOptArgC = std::min(m_iArgc, m_iOptArgC);
     }
@@ -224,6 +248,8 @@ namespace mu
         , m_iCode(cmFUNC)
         , m_iType(tpDBL)
         , m_bAllowOpti(optimizeAway)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {}
 
 
@@ -240,6 +266,8 @@ namespace mu
         , m_iCode(cmUNKNOWN)
         , m_iType(tpVOID)
         , m_bAllowOpti(0)
+        , m_bElementwise(false)
+        , m_bRandom(false)
     {}
 
 
@@ -253,6 +281,8 @@ namespace mu
         m_iArgc      = ref.m_iArgc;
         m_iOptArgC   = ref.m_iOptArgC;
         m_bAllowOpti = ref.m_bAllowOpti;
+        m_bElementwise = ref.m_bElementwise;
+        m_bRandom    = ref.m_bRandom;
         m_iCode      = ref.m_iCode;
         m_iType      = ref.m_iType;
         m_iPri       = ref.m_iPri;
@@ -277,6 +307,53 @@ namespace mu
         return m_bAllowOpti;
     }
 
+    //---------------------------------------------------------------------------
+    /** \brief Return true if the function maps every element of its single
+               argument independently of the others.
+
+        Element-wise functions may be evaluated on a subset of the elements
+        only, e.g. in the branches of the ternary operator.
+        \throw nothrow
+    */
+    bool ParserCallback::IsElementwise() const
+    {
+        return m_bElementwise;
+    }
+
+    //---------------------------------------------------------------------------
+    /** \brief Mark this function as element-wise.
+
+        Only pure functions with a single argument may be marked.
+        \throw nothrow
+    */
+    void ParserCallback::MakeElementwise()
+    {
+        m_bElementwise = m_bAllowOpti && m_iArgc == 1;
+    }
+
+    //---------------------------------------------------------------------------
+    /** \brief Return true if the function draws random numbers.
+
+        The parser announces the call sites of random functions, before
+        calling them.
+        \throw nothrow
+    */
+    bool ParserCallback::IsRandom() const
+    {
+        return m_bRandom;
+    }
+
+    //---------------------------------------------------------------------------
+    /** \brief Mark this function as a random function.
+
+        Only functions, which may not be optimized away, may be marked.
+        \throw nothrow
+    */
+    void ParserCallback::MakeRandom()
+    {
+        m_bRandom = !m_bAllowOpti;
+    }
+
     //---------------------------------------------------------------------------
     /** \brief Get the callback address for the parser function.
 
@@ -70,6 +70,10 @@ namespace mu
             ParserCallback* Clone() const;
 
             bool  IsOptimizable() const;
+            bool  IsElementwise() const;
+            void  MakeElementwise();
+            bool  IsRandom() const;
+            void  MakeRandom();
             void* GetAddr() const;
             ECmdCode  GetCode() const;
             ETypeCode GetType() const;
@@ -93,6 +97,8 @@ namespace mu
             ECmdCode  m_iCode;
             ETypeCode m_iType;
             bool  m_bAllowOpti;             ///< Flag indication optimizeability
+            bool  m_bElementwise;           ///< Flag indicating an element-wise function
+            bool  m_bRandom;                ///< Flag indicating a random function
     };
 
 //------------------------------------------------------------------------------
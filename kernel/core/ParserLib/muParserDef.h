@@ -48,6 +48,12 @@
 #define MU_VECTOR_EXP3 "_~vect~exp3"
 #define MU_IF_ELSE "_~ifelse"
 
+// Maximal number of nested if-then-else clauses within a single expression
+#define MUP_MAX_IF_NESTING 64
+
+// Maximal integer exponent, which is replaced by repeated multiplication
+#define MUP_MAX_POWN 8
+
 /** \brief If this macro is defined mathematical exceptions (div by zero) will be thrown as exceptions. */
 //#define MUP_MATH_EXCEPTIONS
 
@@ -153,6 +159,8 @@ namespace mu
         cmIF,                  ///< For use in the ternary if-then-else operator
         cmELSE,                ///< For use in the ternary if-then-else operator
         cmENDIF,               ///< For use in the ternary if-then-else operator
+        cmSHORTCUT_LAND,       ///< Short-circuit jump of the logical and
+        cmSHORTCUT_LOR,        ///< Short-circuit jump of the logical or
         cmIDX,                 ///< Operator item:  opening vector brace/index
         cmIDXASGN,             ///< Operator item:  opening vector brace/index for assignment
         cmSQIDX,               ///< Operator item:  opening square bracket index
@@ -184,6 +192,11 @@ namespace mu
         cmOPRT_POSTFIX,        ///< code for postfix operators
         cmOPRT_INFIX,          ///< code for infix operators
         cmVAL2STR,             ///< code for special var2str operator
+        cmPOWN,                ///< Integer power by repeated multiplication
+        cmMULADD,              ///< Fused multiply-add: x*y+z
+        cmREVMULADD,           ///< Reverse fused multiply-add: z+x*y
+        cmSTORE,               ///< Store the topmost stack item in a temporary slot
+        cmLOAD,                ///< Load a common subexpression from a temporary slot
         cmPATHPLACEHOLDER,     ///< code for path placeholder-operator
         cmDIMVAR,              ///< code for an automatic dimension variable
         cmEND,                 ///< end of formula
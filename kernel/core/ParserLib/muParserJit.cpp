@@ -0,0 +1,815 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "muParserJit.hpp"
+#include "muParserBytecode.h"
+#include "muInternalStructures.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <algorithm>
+#include <initializer_list>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MUP_JIT_X64
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace mu
+{
+    /// Set by the called functions, if the real-valued
+    /// result differs from the one of the interpreter
+    /// (e.g. sqrt(-1), which is complex)
+    static thread_local bool jitDomainError = false;
+
+    static double jitSin(double x)
+    {
+        return std::sin(x);
+    }
+
+    static double jitCos(double x)
+    {
+        return std::cos(x);
+    }
+
+    static double jitTan(double x)
+    {
+        return std::tan(x);
+    }
+
+    static double jitExp(double x)
+    {
+        return std::exp(x);
+    }
+
+    static double jitSqrt(double x)
+    {
+        if (x < 0.0)
+            jitDomainError = true;
+
+        return std::sqrt(x);
+    }
+
+    static double jitLn(double x)
+    {
+        if (x <= 0.0)
+            jitDomainError = true;
+
+        return std::log(x);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the native implementation of
+    /// the passed single-argument function or a
+    /// nullptr, if there's none.
+    ///
+    /// \param sName const std::string&
+    /// \return void*
+    ///
+    /////////////////////////////////////////////////
+    static void* getNativeFunction(const std::string& sName)
+    {
+        if (sName == "sin")
+            return (void*)&jitSin;
+
+        if (sName == "cos")
+            return (void*)&jitCos;
+
+        if (sName == "tan")
+            return (void*)&jitTan;
+
+        if (sName == "exp")
+            return (void*)&jitExp;
+
+        if (sName == "sqrt")
+            return (void*)&jitSqrt;
+
+        if (sName == "ln")
+            return (void*)&jitLn;
+
+        return nullptr;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Extracts a real-valued scalar constant
+    /// from the passed array. Returns false, if the
+    /// array is not a real-valued scalar or if its
+    /// value cannot be represented exactly as a
+    /// double. The flag isF64 tells, whether the
+    /// constant already is a F64 value.
+    ///
+    /// \param arr const Array&
+    /// \param val double&
+    /// \param isF64 bool&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool getRealConstant(const Array& arr, double& val, bool& isF64)
+    {
+        if (!arr.isScalar() || arr.getCommonType() != TYPE_NUMERICAL)
+            return false;
+
+        const Numerical& num = arr.front().getNum();
+        NumericalType type = num.getType();
+
+        // F32 values would be promoted differently
+        // by the interpreter
+        if (type == F64)
+        {
+            val = num.asF64();
+            isF64 = true;
+            return true;
+        }
+        else if (type >= F32)
+            return false;
+
+        val = num.asF64();
+        isF64 = false;
+
+        // Integers larger than 2^53 are not exact
+        if (type >= UI8 && type <= UI64)
+            return num.asUI64() <= MUP_JIT_MAX_EXACT_INT;
+
+        return num.asI64() <= (int64_t)MUP_JIT_MAX_EXACT_INT
+            && num.asI64() >= -(int64_t)MUP_JIT_MAX_EXACT_INT;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class emits the x86-64 machine
+    /// code. All values are kept in a buffer of
+    /// doubles, whose address is held in RBX. Only
+    /// SSE2 instructions and the registers XMM0 and
+    /// XMM1 are used, which are volatile in the
+    /// Windows and the System V calling convention.
+    /////////////////////////////////////////////////
+    class JitEmitter
+    {
+        private:
+            std::vector<uint8_t> m_code;
+
+            void emit(std::initializer_list<uint8_t> bytes)
+            {
+                m_code.insert(m_code.end(), bytes);
+            }
+
+            void emit32(int32_t val)
+            {
+                for (int i = 0; i < 4; i++)
+                    m_code.push_back((uint8_t)(val >> (8*i)));
+            }
+
+            void emit64(uint64_t val)
+            {
+                for (int i = 0; i < 8; i++)
+                    m_code.push_back((uint8_t)(val >> (8*i)));
+            }
+
+            // SSE2 operation with a [rbx+disp32] operand
+            void sseMem(uint8_t prefix, uint8_t opcode, int xmm, int32_t offset)
+            {
+                emit({prefix, 0x0F, opcode, (uint8_t)(0x83 | (xmm << 3))});
+                emit32(offset);
+            }
+
+            // SSE2 operation with a register operand
+            void sseReg(uint8_t prefix, uint8_t opcode, int dst, int src)
+            {
+                emit({prefix, 0x0F, opcode, (uint8_t)(0xC0 | (dst << 3) | src)});
+            }
+
+        public:
+            enum Operation
+            {
+                OP_ADD = 0x58,
+                OP_MUL = 0x59,
+                OP_SUB = 0x5C,
+                OP_DIV = 0x5E
+            };
+
+            /////////////////////////////////////////////////
+            /// \brief Saves RBX, moves the buffer address
+            /// (first argument) into it and reserves the
+            /// shadow space for calls. Keeps the stack
+            /// aligned to 16 bytes.
+            ///
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void prologue()
+            {
+                emit({0x53});                   // push rbx
+#ifdef _WIN32
+                emit({0x48, 0x89, 0xCB});       // mov rbx, rcx
+#else
+                emit({0x48, 0x89, 0xFB});       // mov rbx, rdi
+#endif
+                emit({0x48, 0x83, 0xEC, 0x20}); // sub rsp, 32
+            }
+
+            void epilogue()
+            {
+                emit({0x48, 0x83, 0xC4, 0x20}); // add rsp, 32
+                emit({0x5B});                   // pop rbx
+                emit({0xC3});                   // ret
+            }
+
+            void load(int xmm, int32_t offset)
+            {
+                sseMem(0xF2, 0x10, xmm, offset); // movsd xmm, [rbx+offset]
+            }
+
+            void store(int32_t offset, int xmm)
+            {
+                sseMem(0xF2, 0x11, xmm, offset); // movsd [rbx+offset], xmm
+            }
+
+            void operation(Operation op, int xmm, int32_t offset)
+            {
+                sseMem(0xF2, op, xmm, offset);
+            }
+
+            void operationReg(Operation op, int dst, int src)
+            {
+                sseReg(0xF2, op, dst, src);
+            }
+
+            void copy(int dst, int src)
+            {
+                sseReg(0x66, 0x28, dst, src); // movapd dst, src
+            }
+
+            void constant(int xmm, double val)
+            {
+                uint64_t bits;
+                std::memcpy(&bits, &val, sizeof(bits));
+                emit({0x48, 0xB8});           // mov rax, imm64
+                emit64(bits);
+                emit({0x66, 0x48, 0x0F, 0x6E, (uint8_t)(0xC0 | (xmm << 3))}); // movq xmm, rax
+            }
+
+            void negate()
+            {
+                emit({0x66, 0x48, 0x0F, 0x7E, 0xC0}); // movq rax, xmm0
+                emit({0x48, 0x0F, 0xBA, 0xF8, 0x3F}); // btc rax, 63
+                emit({0x66, 0x48, 0x0F, 0x6E, 0xC0}); // movq xmm0, rax
+            }
+
+            void call(void* fn)
+            {
+                emit({0x48, 0xB8});           // mov rax, imm64
+                emit64((uint64_t)fn);
+                emit({0xFF, 0xD0});           // call rax
+            }
+
+            const std::vector<uint8_t>& getCode() const
+            {
+                return m_code;
+            }
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class owns the executable memory
+    /// of a translated bytecode together with the
+    /// layout of the corresponding buffer: the
+    /// values of the variables are followed by the
+    /// stack of the bytecode.
+    /////////////////////////////////////////////////
+    class JitCode
+    {
+        private:
+            typedef void (*jit_fun_type)(double*);
+
+            void* m_memory;
+            size_t m_size;
+            std::vector<Variable*> m_vars;
+            size_t m_bufferSize;
+            size_t m_resultPos;
+
+        public:
+            JitCode(const std::vector<uint8_t>& code, const std::vector<Variable*>& vars, size_t bufferSize, size_t resultPos)
+                : m_memory(nullptr), m_size(code.size()), m_vars(vars), m_bufferSize(bufferSize), m_resultPos(resultPos)
+            {
+#ifdef _WIN32
+                m_memory = VirtualAlloc(nullptr, m_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+
+                if (!m_memory)
+                    return;
+
+                std::memcpy(m_memory, code.data(), m_size);
+                DWORD oldProtection;
+
+                if (!VirtualProtect(m_memory, m_size, PAGE_EXECUTE_READ, &oldProtection))
+                {
+                    VirtualFree(m_memory, 0, MEM_RELEASE);
+                    m_memory = nullptr;
+                    return;
+                }
+
+                FlushInstructionCache(GetCurrentProcess(), m_memory, m_size);
+#else
+                m_memory = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+                if (m_memory == MAP_FAILED)
+                {
+                    m_memory = nullptr;
+                    return;
+                }
+
+                std::memcpy(m_memory, code.data(), m_size);
+
+                if (mprotect(m_memory, m_size, PROT_READ | PROT_EXEC))
+                {
+                    munmap(m_memory, m_size);
+                    m_memory = nullptr;
+                }
+#endif
+            }
+
+            ~JitCode()
+            {
+                if (!m_memory)
+                    return;
+
+#ifdef _WIN32
+                VirtualFree(m_memory, 0, MEM_RELEASE);
+#else
+                munmap(m_memory, m_size);
+#endif
+            }
+
+            JitCode(const JitCode&) = delete;
+            JitCode& operator=(const JitCode&) = delete;
+
+            bool isValid() const
+            {
+                return m_memory != nullptr;
+            }
+
+            void run(double* buffer) const
+            {
+                ((jit_fun_type)m_memory)(buffer);
+            }
+
+            const std::vector<Variable*>& getVars() const
+            {
+                return m_vars;
+            }
+
+            size_t getBufferSize() const
+            {
+                return m_bufferSize;
+            }
+
+            size_t getResultPos() const
+            {
+                return m_resultPos;
+            }
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief Constructor.
+    /////////////////////////////////////////////////
+    JitFunction::JitFunction() : m_evalCount(0), m_state(JIT_PENDING)
+    {
+        //
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Removes the native code and resets the
+    /// evaluation counter.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void JitFunction::clear()
+    {
+        m_code.reset();
+        m_buffer.clear();
+        m_evalCount = 0;
+        m_state = JIT_PENDING;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Translates the passed bytecode into
+    /// native code. Returns false, if the bytecode
+    /// contains unsupported tokens or the platform
+    /// is not supported.
+    ///
+    /// \param byteCode const ParserByteCode&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool JitFunction::compile(const ParserByteCode& byteCode)
+    {
+#ifndef MUP_JIT_X64
+        return false;
+#else
+        const std::vector<SToken>& vRPN = byteCode.GetRPN();
+        std::vector<Variable*> vVars;
+
+        // Collect the variables first, because they are
+        // located in front of the stack
+        for (const SToken& tok : vRPN)
+        {
+            if (tok.Cmd >= cmVAR && tok.Cmd <= cmDIVVAR && tok.Cmd != cmVARARRAY)
+            {
+                bool found = false;
+
+                for (Variable* var : vVars)
+                {
+                    if (var == tok.Val().var)
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+
+                if (!found)
+                    vVars.push_back(tok.Val().var);
+            }
+        }
+
+        size_t nVars = vVars.size();
+        auto slot = [nVars](int pos){return (int32_t)(sizeof(double) * (nVars + pos));};
+        auto varSlot = [&vVars](Variable* var)
+        {
+            for (size_t i = 0; i < vVars.size(); i++)
+            {
+                if (vVars[i] == var)
+                    return (int32_t)(sizeof(double) * i);
+            }
+
+            return (int32_t)0;
+        };
+
+        JitEmitter emitter;
+        emitter.prologue();
+        int sidx = 0;
+
+        // Tracks, whether a stack position holds a F64
+        // value or an integer constant. The interpreter
+        // returns a F64 value only, if every operation
+        // involves at least one F64 operand
+        std::vector<bool> vIsF64(byteCode.GetMaxStackSize() + 2, true);
+        auto setF64 = [&vIsF64](int pos, bool isF64)
+        {
+            if (pos < 0 || pos >= (int)vIsF64.size())
+                return false;
+
+            vIsF64[pos] = isF64;
+            return true;
+        };
+
+        for (const SToken& tok : vRPN)
+        {
+            if (tok.Cmd == cmEND)
+                break;
+
+            switch (tok.Cmd)
+            {
+                case cmVAL:
+                {
+                    double val;
+                    bool isF64;
+
+                    if (!getRealConstant(tok.Val().data2, val, isF64) || !setF64(sidx+1, isF64))
+                        return false;
+
+                    emitter.constant(0, val);
+                    emitter.store(slot(++sidx), 0);
+                    break;
+                }
+
+                case cmVAR:
+                    if (!setF64(sidx+1, true))
+                        return false;
+
+                    emitter.load(0, varSlot(tok.Val().var));
+                    emitter.store(slot(++sidx), 0);
+                    break;
+
+                case cmVARPOW2:
+                case cmVARPOW3:
+                case cmVARPOW4:
+                case cmVARPOWN:
+                {
+                    int N = tok.Cmd == cmVARPOWN ? tok.Val().data.getAsScalarInt() : 2 + tok.Cmd - cmVARPOW2;
+
+                    if (N < 1 || N > MUP_JIT_MAX_POWN || !setF64(sidx+1, true))
+                        return false;
+
+                    emitter.load(0, varSlot(tok.Val().var));
+                    emitter.copy(1, 0);
+
+                    for (int n = 1; n < N; n++)
+                        emitter.operationReg(JitEmitter::OP_MUL, 0, 1);
+
+                    emitter.store(slot(++sidx), 0);
+                    break;
+                }
+
+                case cmVARMUL:
+                case cmREVVARMUL:
+                case cmDIVVAR:
+                {
+                    double fact, add = 0.0;
+                    bool isF64;
+
+                    // The variable makes the result a F64 value
+                    if (!getRealConstant(tok.Val().data, fact, isF64)
+                        || (!tok.Val().data2.isDefault() && !getRealConstant(tok.Val().data2, add, isF64))
+                        || !setF64(sidx+1, true))
+                        return false;
+
+                    if (tok.Cmd == cmDIVVAR)
+                    {
+                        emitter.constant(0, fact);
+                        emitter.operation(JitEmitter::OP_DIV, 0, varSlot(tok.Val().var));
+                    }
+                    else
+                    {
+                        emitter.load(0, varSlot(tok.Val().var));
+                        emitter.constant(1, fact);
+                        emitter.operationReg(JitEmitter::OP_MUL, 0, 1);
+                    }
+
+                    if (!tok.Val().data2.isDefault())
+                    {
+                        emitter.constant(1, add);
+                        emitter.operationReg(JitEmitter::OP_ADD, 0, 1);
+                    }
+
+                    emitter.store(slot(++sidx), 0);
+                    break;
+                }
+
+                case cmADD:
+                case cmSUB:
+                case cmMUL:
+                case cmDIV:
+                {
+                    JitEmitter::Operation op = JitEmitter::OP_ADD;
+
+                    if (tok.Cmd == cmSUB)
+                        op = JitEmitter::OP_SUB;
+                    else if (tok.Cmd == cmMUL)
+                        op = JitEmitter::OP_MUL;
+                    else if (tok.Cmd == cmDIV)
+                        op = JitEmitter::OP_DIV;
+
+                    --sidx;
+
+                    if (sidx < 1 || (!vIsF64[sidx] && !vIsF64[sidx+1]))
+                        return false;
+
+                    vIsF64[sidx] = true;
+                    emitter.load(0, slot(sidx));
+                    emitter.operation(op, 0, slot(sidx+1));
+                    emitter.store(slot(sidx), 0);
+                    break;
+                }
+
+                case cmPOWN:
+                {
+                    if (tok.Oprt().offset < 1 || tok.Oprt().offset > MUP_JIT_MAX_POWN || sidx < 1 || !vIsF64[sidx])
+                        return false;
+
+                    emitter.load(0, slot(sidx));
+                    emitter.copy(1, 0);
+
+                    for (int n = 1; n < tok.Oprt().offset; n++)
+                        emitter.operationReg(JitEmitter::OP_MUL, 0, 1);
+
+                    emitter.store(slot(sidx), 0);
+                    break;
+                }
+
+                case cmMULADD:
+                    sidx -= 2;
+
+                    if (sidx < 1 || (!vIsF64[sidx] && !vIsF64[sidx+1]))
+                        return false;
+
+                    vIsF64[sidx] = true;
+                    emitter.load(0, slot(sidx));
+                    emitter.operation(JitEmitter::OP_MUL, 0, slot(sidx+1));
+                    emitter.operation(JitEmitter::OP_ADD, 0, slot(sidx+2));
+                    emitter.store(slot(sidx), 0);
+                    break;
+
+                case cmREVMULADD:
+                    sidx -= 2;
+
+                    if (sidx < 1 || (!vIsF64[sidx+1] && !vIsF64[sidx+2]))
+                        return false;
+
+                    vIsF64[sidx] = true;
+                    emitter.load(0, slot(sidx+1));
+                    emitter.operation(JitEmitter::OP_MUL, 0, slot(sidx+2));
+                    emitter.operation(JitEmitter::OP_ADD, 0, slot(sidx));
+                    emitter.store(slot(sidx), 0);
+                    break;
+
+                case cmSTORE:
+                    if (sidx < 1 || !setF64(tok.Oprt().offset, vIsF64[sidx]))
+                        return false;
+
+                    emitter.load(0, slot(sidx));
+                    emitter.store(slot(tok.Oprt().offset), 0);
+                    break;
+
+                case cmLOAD:
+                    if (tok.Oprt().offset < 0 || tok.Oprt().offset >= (int)vIsF64.size()
+                        || !setF64(sidx+1, vIsF64[tok.Oprt().offset]))
+                        return false;
+
+                    emitter.load(0, slot(tok.Oprt().offset));
+                    emitter.store(slot(++sidx), 0);
+                    break;
+
+                case cmFUNC:
+                {
+                    // Functions of integers may return integers
+                    if (tok.Fun().argc != 1 || sidx < 1 || !vIsF64[sidx])
+                        return false;
+
+                    emitter.load(0, slot(sidx));
+
+                    if (tok.Fun().name == "-")
+                        emitter.negate();
+                    else
+                    {
+                        void* fn = getNativeFunction(tok.Fun().name);
+
+                        if (!fn)
+                            return false;
+
+                        emitter.call(fn);
+                    }
+
+                    emitter.store(slot(sidx), 0);
+                    break;
+                }
+
+                default:
+                    return false;
+            }
+        }
+
+        // Only expressions with a single F64 result are
+        // supported
+        if (sidx != 1 || !vIsF64[1])
+            return false;
+
+        emitter.epilogue();
+
+        m_code.reset(new JitCode(emitter.getCode(), vVars, nVars + byteCode.GetMaxStackSize(), nVars + 1));
+
+        if (!m_code->isValid())
+        {
+            m_code.reset();
+            return false;
+        }
+
+        m_buffer.assign(m_code->getBufferSize(), 0.0);
+        return true;
+#endif // MUP_JIT_X64
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Evaluates the passed bytecode using
+    /// its native code. The bytecode is translated,
+    /// once it has been evaluated MUP_JIT_THRESHOLD
+    /// times. Vector variables are evaluated element
+    /// by element. Returns false, if the interpreter
+    /// has to be used instead.
+    ///
+    /// \param byteCode const ParserByteCode&
+    /// \param result StackItem&
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool JitFunction::evaluate(const ParserByteCode& byteCode, StackItem& result)
+    {
+        if (m_state == JIT_UNSUPPORTED)
+            return false;
+
+        if (m_state == JIT_PENDING)
+        {
+            if (++m_evalCount < MUP_JIT_THRESHOLD)
+                return false;
+
+            if (!compile(byteCode))
+            {
+                m_state = JIT_UNSUPPORTED;
+                return false;
+            }
+
+            m_state = JIT_COMPILED;
+        }
+
+        // The copied instance shares the code but not
+        // the buffer
+        if (m_buffer.size() != m_code->getBufferSize())
+            m_buffer.assign(m_code->getBufferSize(), 0.0);
+
+        const std::vector<Variable*>& vVars = m_code->getVars();
+        size_t nElems = 1;
+
+        // Only F64 values can be handled by the native
+        // code without changing the type of the result.
+        // All vectors have to share their length
+        for (const Variable* var : vVars)
+        {
+            if (!var->size() || (var->size() > 1 && nElems > 1 && var->size() != nElems))
+                return false;
+
+            nElems = std::max(nElems, var->size());
+
+            for (size_t j = 0; j < var->size(); j++)
+            {
+                if (!var->get(j).isNumerical() || var->get(j).getNum().getType() != F64)
+                    return false;
+            }
+        }
+
+        if (nElems == 1)
+        {
+            for (size_t i = 0; i < vVars.size(); i++)
+            {
+                m_buffer[i] = vVars[i]->front().getNum().asF64();
+            }
+
+            jitDomainError = false;
+            m_code->run(m_buffer.data());
+
+            if (jitDomainError)
+                return false;
+
+            result = Array(Value(m_buffer[m_code->getResultPos()]));
+            return true;
+        }
+
+        std::vector<double> vResults(nElems);
+        bool domainError = false;
+
+        // Every thread needs its own buffer. Scalar
+        // variables are broadcasted by get()
+        #pragma omp parallel if(nElems > MUP_JIT_PARALLEL_LIMIT) reduction(||:domainError)
+        {
+            std::vector<double> vBuffer(m_code->getBufferSize(), 0.0);
+            jitDomainError = false;
+
+            #pragma omp for
+            for (size_t n = 0; n < nElems; n++)
+            {
+                for (size_t i = 0; i < vVars.size(); i++)
+                {
+                    vBuffer[i] = vVars[i]->get(n).getNum().asF64();
+                }
+
+                m_code->run(vBuffer.data());
+                vResults[n] = vBuffer[m_code->getResultPos()];
+            }
+
+            domainError = jitDomainError;
+        }
+
+        if (domainError)
+            return false;
+
+        result = Array(vResults);
+        return true;
+    }
+}
+
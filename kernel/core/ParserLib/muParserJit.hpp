@@ -0,0 +1,86 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef MUPARSERJIT_HPP
+#define MUPARSERJIT_HPP
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+// Number of interpreted evaluations of a bytecode before
+// it is translated into native code
+#define MUP_JIT_THRESHOLD 64
+// Maximal integer exponent, which is translated into
+// repeated multiplications
+#define MUP_JIT_MAX_POWN 32
+// Largest integer constant, which can be represented
+// exactly as a double (2^53)
+#define MUP_JIT_MAX_EXACT_INT 9007199254740992ull
+// Minimal number of vector elements, which are evaluated
+// in parallel
+#define MUP_JIT_PARALLEL_LIMIT 10000
+
+namespace mu
+{
+    class ParserByteCode;
+    class StackItem;
+    class Variable;
+    class JitCode;
+
+    /////////////////////////////////////////////////
+    /// \brief This class represents the native
+    /// (x86-64) tier of a bytecode. Bytecodes, which
+    /// consist only of real-valued arithmetics,
+    /// numerical variables and elementary functions
+    /// are translated into machine code, once they
+    /// have been evaluated often enough. The native
+    /// code operates on a plain buffer of doubles.
+    /// Vector variables are evaluated element by
+    /// element. If the bytecode contains unsupported
+    /// tokens or the variables are not F64 values
+    /// during an evaluation, the evaluation is
+    /// rejected and the interpreter is used instead.
+    /////////////////////////////////////////////////
+    class JitFunction
+    {
+        private:
+            enum JitState
+            {
+                JIT_PENDING,
+                JIT_COMPILED,
+                JIT_UNSUPPORTED
+            };
+
+            std::shared_ptr<JitCode> m_code;
+            std::vector<double> m_buffer;
+            size_t m_evalCount;
+            JitState m_state;
+
+            bool compile(const ParserByteCode& byteCode);
+
+        public:
+            JitFunction();
+
+            void clear();
+            bool evaluate(const ParserByteCode& byteCode, StackItem& result);
+    };
+}
+
+#endif // MUPARSERJIT_HPP
+
@@ -20,9 +20,68 @@
 #include "../utils/tools.hpp"
 #include "../io/logger.hpp"
 
+// Maximal number of compiled states in the cache
+#define MUP_STATE_CACHE_SIZE 16
+
 
 namespace mu
 {
+    /////////////////////////////////////////////////
+    /// \brief Find the compiled state of the passed
+    /// expression. If it is found, it is moved to
+    /// the front of the cache.
+    ///
+    /// \param sExpr StringView
+    /// \return State*
+    ///
+    /////////////////////////////////////////////////
+    State* StateCache::find(StringView sExpr)
+    {
+        sExpr.strip();
+
+        for (auto iter = m_states.begin(); iter != m_states.end(); ++iter)
+        {
+            if (sExpr == iter->m_expr)
+            {
+                if (iter != m_states.begin())
+                    m_states.splice(m_states.begin(), m_states, iter);
+
+                return &m_states.front();
+            }
+        }
+
+        return nullptr;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Store a copy of the passed compiled
+    /// state at the front of the cache. The least
+    /// recently used state is removed, if the cache
+    /// is full.
+    ///
+    /// \param state const State&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void StateCache::store(const State& state)
+    {
+        for (auto iter = m_states.begin(); iter != m_states.end(); ++iter)
+        {
+            if (iter->m_expr == state.m_expr)
+            {
+                m_states.erase(iter);
+                break;
+            }
+        }
+
+        m_states.push_front(state);
+
+        if (m_states.size() > MUP_STATE_CACHE_SIZE)
+            m_states.pop_back();
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Create a expression target made up
     /// from multiple variables.
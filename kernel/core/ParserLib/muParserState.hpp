@@ -21,10 +21,12 @@
 #define MUPARSERSTATE_HPP
 
 #include <vector>
+#include <list>
 #include <string>
 #include <utility>
 #include "muParserDef.h"
 #include "muParserBytecode.h"
+#include "muParserJit.hpp"
 
 class StringView;
 
@@ -141,6 +143,7 @@ namespace mu
 	    valbuf_type m_stackBuffer;
 	    varmap_type m_usedVar;
 	    VectorEvaluation m_vectEval;
+	    JitFunction m_jit;
 
 	    State() : m_valid(1), m_numResults(0) {}
 	    State(const State& other)
@@ -163,6 +166,7 @@ namespace mu
 	        m_stackBuffer = other.m_stackBuffer;
 	        m_usedVar = other.m_usedVar;
 	        m_vectEval = other.m_vectEval;
+	        m_jit = other.m_jit;
 
 	        // Update the contained pointers in the
 	        // stack buffer
@@ -184,6 +188,23 @@ namespace mu
                     }
                 }
             }
+
+            // Common subexpressions are referenced within
+            // the stack buffer itself
+            if (m_byteCode.GetTempCount())
+            {
+                for (size_t j = 0; j < m_stackBuffer.size(); j++)
+                {
+                    for (size_t k = 0; k < other.m_stackBuffer.size(); k++)
+                    {
+                        if (m_stackBuffer[j].isAliasOf(other.m_stackBuffer[k]))
+                        {
+                            m_stackBuffer[j].aliasOf(m_stackBuffer[k]);
+                            break;
+                        }
+                    }
+                }
+            }
 	    }
 
 	    void clear()
@@ -195,6 +216,7 @@ namespace mu
 	        m_stackBuffer.clear();
 	        m_usedVar.clear();
 	        m_vectEval.clear();
+	        m_jit.clear();
 	    }
 	};
 
@@ -310,6 +332,33 @@ namespace mu
 	        return m_stacks.size();
 	    }
 	};
+
+
+    /////////////////////////////////////////////////
+    /// \brief This is a least-recently-used cache of
+    /// already compiled parser states. It is used
+    /// outside of the loop mode to avoid re-parsing
+    /// expressions, which are set repeatedly in
+    /// alternation.
+    /////////////////////////////////////////////////
+	struct StateCache
+	{
+	    std::list<State> m_states;
+
+	    State* find(StringView sExpr);
+	    void store(const State& state);
+
+	    void discard()
+	    {
+	        if (m_states.size())
+                m_states.pop_front();
+	    }
+
+	    void clear()
+	    {
+	        m_states.clear();
+	    }
+	};
 }
 
 #endif // MUPARSERSTATE_HPP
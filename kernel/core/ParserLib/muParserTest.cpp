@@ -24,6 +24,8 @@
 */
 
 #include "muParserTest.h"
+#include "muParserJit.hpp"
+#include "../maths/functionimplementation.hpp"
 
 #include <cstdio>
 #include <cmath>
@@ -57,6 +59,8 @@ namespace mu
       AddTest(&ParserTester::TestMultiArg);
       AddTest(&ParserTester::TestExpression);
       AddTest(&ParserTester::TestIfThenElse);
+      AddTest(&ParserTester::TestElementwise);
+      AddTest(&ParserTester::TestJit);
       AddTest(&ParserTester::TestInterface);
       AddTest(&ParserTester::TestBinOprt);
       AddTest(&ParserTester::TestException);
@@ -974,6 +978,71 @@ namespace mu
       return iStat;
     }
 
+    //---------------------------------------------------------------------------
+    int ParserTester::TestElementwise()
+    {
+      int iStat = 0;
+      cerr << "\r                                                                              \r";
+      mu::console() << _nrT(" -> Teste elementweise Ausdruecke ... ");
+
+      iStat += ElementwiseTest(_nrT("a*b+c"), true);
+      iStat += ElementwiseTest(_nrT("-sqr(a)/b"), true);
+      iStat += ElementwiseTest(_nrT("(a)m+sqr(b)^2"), true);
+      iStat += ElementwiseTest(_nrT("a<b ? sqr(c) : -c"), true);
+      iStat += ElementwiseTest(_nrT("a<b && c>0"), true);
+
+      // Aggregating and not explicitly element-wise functions,
+      // e.g. the normalisation "x/max(abs(x))" in plots
+      iStat += ElementwiseTest(_nrT("a/sum(sqr(a))"), false);
+      iStat += ElementwiseTest(_nrT("a/max(a,b)"), false);
+      iStat += ElementwiseTest(_nrT("f1of1(a)"), false);
+      iStat += ElementwiseTest(_nrT("a<b ? c : sum(a,b)"), false);
+
+      if (iStat==0)
+        mu::console() << _nrT("Abgeschlossen.");
+      else
+        mu::console() << _nrT("\n -> Elementweise Ausdruecke fehlgeschlagen mit ") << iStat << _nrT(" Fehlern.") << endl;
+
+      return iStat;
+    }
+
+    //---------------------------------------------------------------------------
+    int ParserTester::TestJit()
+    {
+      int iStat = 0;
+      cerr << "\r                                                                              \r";
+      mu::console() << _nrT(" -> Teste nativen Code ... ");
+
+      // Arithmetics and the fused operations
+      iStat += JitTest(_nrT("a*b+c"), false);
+      iStat += JitTest(_nrT("(a-b)/(c+4)-a*3"), false);
+      iStat += JitTest(_nrT("2*a+b/4-c"), false);
+
+      // Integer powers (cmPOWN and cmVARPOWN)
+      iStat += JitTest(_nrT("(a+b)^3"), false);
+      iStat += JitTest(_nrT("a^2+b^4-c^7"), false);
+      iStat += JitTest(_nrT("(a*c)^1"), false);
+
+      // Domain errors, which have to be evaluated
+      // by the interpreter
+      iStat += JitTest(_nrT("sqrt(a)"), false);
+      iStat += JitTest(_nrT("ln(a*b)"), false);
+      iStat += JitTest(_nrT("ln(c-c)"), false);
+
+      // Multiple variables and vectors
+      iStat += JitTest(_nrT("exp(-a^2)*sqrt(b*b+c*c)+ln(c*c+1)"), false);
+      iStat += JitTest(_nrT("a*b+c"), true);
+      iStat += JitTest(_nrT("(a+b)^3-exp(c)"), true);
+      iStat += JitTest(_nrT("sqrt(a)+ln(b)"), true);
+
+      if (iStat==0)
+        mu::console() << _nrT("Abgeschlossen.");
+      else
+        mu::console() << _nrT("\n -> Nativer Code fehlgeschlagen mit ") << iStat << _nrT(" Fehlern.") << endl;
+
+      return iStat;
+    }
+
     //---------------------------------------------------------------------------
     int ParserTester::TestException()
     {
@@ -1149,6 +1218,120 @@ namespace mu
       return bRet;
     }
 
+    //---------------------------------------------------------------------------
+    /** \brief Check, whether an expression is detected as element-wise.
+
+        \return 1 in case of a failure, 0 otherwise.
+    */
+    int ParserTester::ElementwiseTest(const string_type& a_str, bool a_bElementwise)
+    {
+      ParserTester::c_iCount++;
+      value_type vVarVal[] = {1, 2, 3};
+
+      try
+      {
+        Parser p;
+        p.DefineVar( _nrT("a"), &vVarVal[0]);
+        p.DefineVar( _nrT("b"), &vVarVal[1]);
+        p.DefineVar( _nrT("c"), &vVarVal[2]);
+        p.DefineFun( _nrT("f1of1"), f1of1);
+        p.DefineFun( _nrT("max"), Max);
+        p.DefineFun( _nrT("sum"), Sum);
+        p.DefineElementwiseFun( _nrT("sqr"), sqr);
+        p.DefinePostfixOprt( _nrT("m"), Milli);
+        p.SetExpr(a_str);
+        p.Eval();
+
+        if (p.IsElementwise() == a_bElementwise)
+          return 0;
+
+        mu::console() << _nrT("\n  fail: ") << a_str.c_str()
+                      << _nrT(" (element-wise detection; expected: ") << a_bElementwise << _nrT(").");
+      }
+      catch(Parser::exception_type &e)
+      {
+        mu::console() << _nrT("\n  fail: ") << a_str.c_str() << _nrT(" (") << e.GetMsg() << _nrT(")");
+      }
+
+      return 1;
+    }
+
+    //---------------------------------------------------------------------------
+    /** \brief Compare the native code with the interpreter. The expression is
+               evaluated often enough to be translated into native code.
+
+        \return 1 in case of a failure, 0 otherwise.
+    */
+    int ParserTester::JitTest(const string_type& a_str, bool a_bVector)
+    {
+      ParserTester::c_iCount++;
+
+      try
+      {
+        Variable a, b, c;
+
+        if (a_bVector)
+        {
+          a = Array(std::vector<double>({-1.5, 0.25, 2.0, 3.75}));
+          b = Array(std::vector<double>({2.0, -0.5, 1.5, 0.125}));
+          c = Array(std::vector<double>({0.75, 3.0, -2.25, 1.0}));
+        }
+        else
+        {
+          a = Value(-1.5);
+          b = Value(2.0);
+          c = Value(0.75);
+        }
+
+        Parser pInterpreter, pJit;
+        pInterpreter.EnableJit(false);
+
+        for (Parser* p : {&pInterpreter, &pJit})
+        {
+          p->DefineVar( _nrT("a"), &a);
+          p->DefineVar( _nrT("b"), &b);
+          p->DefineVar( _nrT("c"), &c);
+          p->DefineElementwiseFun( _nrT("sqrt"), numfnc_sqrt);
+          p->DefineElementwiseFun( _nrT("ln"), numfnc_ln);
+          p->DefineElementwiseFun( _nrT("exp"), numfnc_exp);
+          p->SetExpr(a_str);
+        }
+
+        Array vInterpreted = pInterpreter.Eval();
+        Array vNative;
+
+        for (int i = 0; i <= MUP_JIT_THRESHOLD; i++)
+          vNative = pJit.Eval();
+
+        bool bEqual = vNative.size() == vInterpreted.size();
+
+        for (size_t i = 0; bEqual && i < vNative.size(); i++)
+        {
+          if (!vNative[i].isNumerical()
+              || !vInterpreted[i].isNumerical()
+              || vNative[i].getNum().getType() != vInterpreted[i].getNum().getType()
+              || std::abs(vNative[i].getNum().asCF64() - vInterpreted[i].getNum().asCF64()) > 1e-10 * std::max(1.0, std::abs(vInterpreted[i].getNum().asCF64())))
+            bEqual = false;
+        }
+
+        if (bEqual)
+          return 0;
+
+        mu::console() << _nrT("\n  fail: ") << a_str.c_str()
+                      << _nrT(" (native code differs from the interpreter).");
+      }
+      catch(Parser::exception_type &e)
+      {
+        mu::console() << _nrT("\n  fail: ") << a_str.c_str() << _nrT(" (") << e.GetMsg() << _nrT(")");
+      }
+      catch(...)
+      {
+        mu::console() << _nrT("\n  fail: ") << a_str.c_str() <<  _nrT(" (unexpected exception)");
+      }
+
+      return 1;
+    }
+
     //---------------------------------------------------------------------------
     /** \brief Evaluate a tet expression.
 
@@ -177,6 +177,8 @@ namespace mu
 	      int TestException();
         int TestStrArg();
         int TestIfThenElse();
+        int TestElementwise();
+        int TestJit();
 
         void Abort() const;
 
@@ -198,6 +200,8 @@ namespace mu
                                  double a_fRes2,
                                  double a_fVar2);
         int ThrowTest(const string_type& a_str, int a_iErrc, bool a_bFail = true);
+        int ElementwiseTest(const string_type& a_str, bool a_bElementwise);
+        int JitTest(const string_type& a_str, bool a_bVector);
 
         // Test Int Parser
         int EqnTestInt(const string_type& a_str, double a_fRes, bool a_fPass);
@@ -489,6 +489,35 @@ namespace mu
                 return m_pCallback->IsOptimizable();
             }
 
+            /////////////////////////////////////////////////
+            /// \brief Is this function element-wise?
+            ///
+            /// \return bool
+            ///
+            /////////////////////////////////////////////////
+            bool IsElementwise() const
+            {
+                if (!m_pCallback)
+                    throw ParserError(ecINTERNAL_ERROR);
+
+                return m_pCallback->IsElementwise();
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Does this function draw random
+            /// numbers?
+            ///
+            /// \return bool
+            ///
+            /////////////////////////////////////////////////
+            bool IsRandom() const
+            {
+                if (!m_pCallback)
+                    throw ParserError(ecINTERNAL_ERROR);
+
+                return m_pCallback->IsRandom();
+            }
+
             //------------------------------------------------------------------------------
             /** \brief Return the address of the callback function assoziated with
                        function and operator tokens.
@@ -0,0 +1,593 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
+#include <cstdlib>
+#include <omp.h>
+
+#include "muParser.h"
+#include "../ui/language.hpp"
+#include "../maths/functionimplementation.hpp"
+#include "../strings/functionimplementation.hpp"
+#include "../utils/stringtools.hpp"
+#include "../maths/matdatastructures.hpp"
+#include "../maths/mateigen.hpp"
+
+// Default number of timed repetitions of each benchmark
+#define BENCHMARK_REPETITIONS 5
+// Seed of all random inputs to make the runs reproducible
+#define BENCHMARK_SEED 42
+// Dimension of the banded sparse matrix
+#define BENCHMARK_SPARSE_SIZE 50000
+// Dimension of the dense matrices
+#define BENCHMARK_MATRIX_SIZE 300
+// Number of right-hand sides of the linear systems
+#define BENCHMARK_MATRIX_RHS 8
+
+Language _lang;
+
+/// Counters of the global allocations
+static std::atomic<size_t> nAllocations(0);
+static std::atomic<size_t> nAllocatedBytes(0);
+/// Prevents that results are optimized away
+static volatile size_t nSink = 0;
+
+
+/////////////////////////////////////////////////
+/// \brief Replaced global allocation function to
+/// count the number and the size of the heap
+/// allocations.
+///
+/// \param nSize size_t
+/// \return void*
+///
+/////////////////////////////////////////////////
+void* operator new(size_t nSize)
+{
+    nAllocations.fetch_add(1, std::memory_order_relaxed);
+    nAllocatedBytes.fetch_add(nSize, std::memory_order_relaxed);
+
+    if (void* ptr = std::malloc(nSize ? nSize : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+
+void* operator new[](size_t nSize)
+{
+    return operator new(nSize);
+}
+
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This structure contains the result of
+/// a single benchmark.
+/////////////////////////////////////////////////
+struct BenchmarkResult
+{
+    std::string sName;
+    size_t nElements;
+    double dMedian;
+    double dMin;
+    double dAllocations;
+    double dBytes;
+};
+
+
+/////////////////////////////////////////////////
+/// \brief This class runs the registered
+/// benchmarks and reports their results on the
+/// terminal and as JSON.
+/////////////////////////////////////////////////
+class BenchmarkSuite
+{
+    private:
+        std::vector<BenchmarkResult> m_results;
+        std::string m_sFilter;
+        size_t m_nRepetitions;
+
+    public:
+        BenchmarkSuite(const std::string& sFilter, size_t nRepetitions) : m_sFilter(sFilter), m_nRepetitions(nRepetitions) {}
+
+        /////////////////////////////////////////////////
+        /// \brief Runs the passed benchmark once for
+        /// warming up and afterwards the selected
+        /// number of times. The median and the minimal
+        /// run time and the allocations per run are
+        /// stored.
+        ///
+        /// \param sName const std::string&
+        /// \param nElements size_t
+        /// \param func const std::function<void()>&
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void run(const std::string& sName, size_t nElements, const std::function<void()>& func)
+        {
+            if (m_sFilter.length() && sName.find(m_sFilter) == std::string::npos)
+                return;
+
+            func();
+
+            std::vector<double> vTimes;
+            size_t nAllocStart = nAllocations;
+            size_t nBytesStart = nAllocatedBytes;
+
+            for (size_t i = 0; i < m_nRepetitions; i++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                func();
+                vTimes.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            }
+
+            std::sort(vTimes.begin(), vTimes.end());
+
+            BenchmarkResult res;
+            res.sName = sName;
+            res.nElements = nElements;
+            res.dMedian = vTimes[vTimes.size() / 2];
+            res.dMin = vTimes.front();
+            res.dAllocations = (nAllocations - nAllocStart) / (double)m_nRepetitions;
+            res.dBytes = (nAllocatedBytes - nBytesStart) / (double)m_nRepetitions;
+            m_results.push_back(res);
+
+            std::cout << sName << ": " << toString(res.dMedian * 1e3, 5) << " ms, "
+                      << toString(nElements / res.dMedian, 5) << " elem/s, "
+                      << toString(res.dAllocations, 7) << " allocs ("
+                      << toString(res.dBytes, 7) << " bytes) per run" << std::endl;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Writes the results of all benchmarks
+        /// to the selected JSON file.
+        ///
+        /// \param sFileName const std::string&
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool writeJson(const std::string& sFileName) const
+        {
+            std::ofstream json(sFileName);
+
+            if (!json.good())
+                return false;
+
+            json << "{\n  \"threads\": " << omp_get_max_threads()
+                 << ",\n  \"repetitions\": " << m_nRepetitions
+                 << ",\n  \"benchmarks\": [";
+
+            for (size_t i = 0; i < m_results.size(); i++)
+            {
+                const BenchmarkResult& res = m_results[i];
+
+                json << (i ? ",\n" : "\n")
+                     << "    {\"name\": \"" << res.sName
+                     << "\", \"elements\": " << res.nElements
+                     << ", \"median_s\": " << toString(res.dMedian, 9)
+                     << ", \"min_s\": " << toString(res.dMin, 9)
+                     << ", \"throughput\": " << toString(res.nElements / res.dMedian, 9)
+                     << ", \"allocations\": " << toString(res.dAllocations, 12)
+                     << ", \"allocated_bytes\": " << toString(res.dBytes, 12) << "}";
+            }
+
+            json << "\n  ]\n}\n";
+            return json.good();
+        }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Creates a new parser instance with the
+/// functions needed by the benchmarks.
+///
+/// \return std::unique_ptr<mu::Parser>
+///
+/////////////////////////////////////////////////
+static std::unique_ptr<mu::Parser> createParser()
+{
+    std::unique_ptr<mu::Parser> _parser(new mu::Parser);
+
+    _parser->DefineElementwiseFun("sin", numfnc_sin);
+    _parser->DefineElementwiseFun("cos", numfnc_cos);
+    _parser->DefineElementwiseFun("tan", numfnc_tan);
+    _parser->DefineElementwiseFun("exp", numfnc_exp);
+    _parser->DefineElementwiseFun("sqrt", numfnc_sqrt);
+    _parser->DefineElementwiseFun("abs", numfnc_abs);
+    _parser->DefineElementwiseFun("ln", numfnc_ln);
+    _parser->DefineFun("strlen", strfnc_strlen);
+    _parser->DefineFun("to_string", strfnc_to_string);
+    _parser->DefinePostfixOprt("i", numfnc_imaginaryUnit);
+    _parser->DefineConst("nan", mu::Value(NAN));
+    _parser->DefineConst("inf", mu::Value(INFINITY));
+
+    return _parser;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns reproducible random values in
+/// the interval [-10,10).
+///
+/// \param nElements size_t
+/// \return std::vector<double>
+///
+/////////////////////////////////////////////////
+static std::vector<double> getRandomValues(size_t nElements)
+{
+    std::mt19937_64 gen(BENCHMARK_SEED);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    std::vector<double> vValues(nElements);
+
+    for (double& val : vValues)
+    {
+        val = dist(gen);
+    }
+
+    return vValues;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Benchmarks of the expression
+/// evaluation.
+///
+/// \param suite BenchmarkSuite&
+/// \return void
+///
+/////////////////////////////////////////////////
+static void benchmarkParser(BenchmarkSuite& suite)
+{
+    const size_t nScalar = 200000;
+    const size_t nVector = 1000000;
+    const std::string sExpr = "sin(x)^2+cos(x)*exp(-abs(x)/10)+sqrt(abs(x))";
+    std::vector<double> vValues = getRandomValues(nVector);
+
+    std::unique_ptr<mu::Parser> _parser = createParser();
+    mu::Variable x(mu::Value(0.0));
+    _parser->DefineVar("x", &x);
+
+    // Repeated evaluation of a scalar expression
+    suite.run("parser.scalar", nScalar, [&]()
+        {
+            _parser->SetExpr(sExpr);
+
+            for (size_t i = 0; i < nScalar; i++)
+            {
+                x = mu::Value(vValues[i]);
+                _parser->Eval();
+            }
+        });
+
+    // Parsing and first evaluation of new expressions
+    suite.run("parser.compile", 1000, [&]()
+        {
+            for (size_t i = 0; i < 1000; i++)
+            {
+                _parser->SetExpr(sExpr + "+" + toString(i));
+                _parser->Eval();
+            }
+        });
+
+    // Single evaluation of a large vector
+    mu::Variable xVect{mu::Array(vValues)};
+    _parser->DefineVar("xv", &xVect);
+
+    suite.run("parser.vector", nVector, [&]()
+        {
+            _parser->SetExpr(std::string("sin(xv)^2+cos(xv)*exp(-abs(xv)/10)+sqrt(abs(xv))"));
+            _parser->Eval();
+        });
+
+    // Independent parsers evaluating scalar expressions
+    // on all threads
+    int nThreads = std::max(1, omp_get_max_threads());
+    std::vector<std::unique_ptr<mu::Parser>> vParsers;
+    std::vector<mu::Variable> vVars(nThreads, mu::Variable(mu::Value(0.0)));
+
+    for (int t = 0; t < nThreads; t++)
+    {
+        vParsers.push_back(createParser());
+        vParsers.back()->DefineVar("x", &vVars[t]);
+        vParsers.back()->SetExpr(sExpr);
+    }
+
+    suite.run("parser.bulk_parallel", nScalar * nThreads, [&]()
+        {
+            #pragma omp parallel for num_threads(nThreads)
+            for (int t = 0; t < nThreads; t++)
+            {
+                for (size_t i = 0; i < nScalar; i++)
+                {
+                    vVars[t] = mu::Value(vValues[(i + t * nScalar) % nVector]);
+                    vParsers[t]->Eval();
+                }
+            }
+        });
+
+    // String concatenation in expressions
+    mu::Variable str(mu::Value(std::string("Hello")));
+    _parser->DefineVar("str", &str);
+
+    suite.run("parser.strings", nScalar / 10, [&]()
+        {
+            _parser->SetExpr(std::string("strlen(str + \"-\" + to_string(x))"));
+
+            for (size_t i = 0; i < nScalar / 10; i++)
+            {
+                x = mu::Value(vValues[i]);
+                _parser->Eval();
+            }
+        });
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Benchmarks of the array arithmetics
+/// and the number formatting.
+///
+/// \param suite BenchmarkSuite&
+/// \return void
+///
+/////////////////////////////////////////////////
+static void benchmarkTypes(BenchmarkSuite& suite)
+{
+    const size_t nElements = 1000000;
+    std::vector<double> vValues = getRandomValues(nElements);
+    mu::Array a(vValues);
+    mu::Array b(vValues);
+
+    suite.run("array.arithmetics", nElements, [&]()
+        {
+            mu::Array c = a + b * a - b / a;
+            nSink = c.size();
+        });
+
+    suite.run("format.tostring", nElements, [&]()
+        {
+            size_t nLen = 0;
+
+            for (double val : vValues)
+            {
+                nLen += toString(val, 7).length();
+            }
+
+            nSink = nLen;
+        });
+
+    suite.run("format.buffered", nElements, [&]()
+        {
+            std::string sBuffer;
+
+            for (double val : vValues)
+            {
+                appendNumber(sBuffer, val, 7);
+                sBuffer += ',';
+            }
+
+            nSink = sBuffer.length();
+        });
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Benchmarks of the sparse matrix. A
+/// tridiagonal matrix of FEM-style size is
+/// assembled from triplets and multiplied with a
+/// dense vector. The allocated bytes per run
+/// scale with the number of non-zeros (the dense
+/// matrix would need n*n*16 bytes).
+///
+/// \param suite BenchmarkSuite&
+/// \return void
+///
+/////////////////////////////////////////////////
+static void benchmarkSparse(BenchmarkSuite& suite)
+{
+    const size_t nSize = BENCHMARK_SPARSE_SIZE;
+    const size_t nNonZeros = 3*nSize-2;
+    Matrix mTriplets(nNonZeros, 3);
+    size_t n = 0;
+
+    for (size_t i = 0; i < nSize; i++)
+    {
+        for (size_t j = (i ? i-1 : 0); j <= std::min(i+1, nSize-1); j++)
+        {
+            mTriplets(n, 0) = i+1;
+            mTriplets(n, 1) = j+1;
+            mTriplets(n, 2) = i == j ? 2.0 : -1.0;
+            n++;
+        }
+    }
+
+    SparseMatrix mSparse;
+    Matrix mVector(nSize, 1, std::complex<double>(1.0));
+
+    suite.run("sparse.assemble", nNonZeros, [&]()
+        {
+            mSparse.assignTriplets(mTriplets, nSize, nSize);
+            nSink = mSparse.nonZeros();
+        });
+
+    suite.run("sparse.multiply", nNonZeros, [&]()
+        {
+            Matrix mResult = mSparse * mVector;
+            nSink = mResult.rows();
+        });
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns a reproducible random matrix.
+/// The diagonal is dominant, so that the matrix
+/// is well-conditioned, if it is square.
+///
+/// \param r size_t
+/// \param c size_t
+/// \return Matrix
+///
+/////////////////////////////////////////////////
+static Matrix getRandomMatrix(size_t r, size_t c)
+{
+    std::vector<double> vValues = getRandomValues(r*c);
+    Matrix mat(r, c);
+
+    for (size_t j = 0; j < c; j++)
+    {
+        for (size_t i = 0; i < r; i++)
+        {
+            mat(i, j) = vValues[i + j*r] + (i == j ? 10.0 * r : 0.0);
+        }
+    }
+
+    return mat;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Benchmarks of the dense matrix
+/// operations. The linear systems and the
+/// inversion use the same conversions and
+/// decompositions as "linsolve()" and "invert()"
+/// in matfuncs.hpp, which itself depends on the
+/// kernel.
+///
+/// \param suite BenchmarkSuite&
+/// \return void
+///
+/// \c __attribute__((force_align_arg_pointer))
+/// fixes TDM-GCC Bug for wrong stack alignment.
+/////////////////////////////////////////////////
+__attribute__((force_align_arg_pointer)) static void benchmarkMatrix(BenchmarkSuite& suite)
+{
+    const size_t nSize = BENCHMARK_MATRIX_SIZE;
+    Matrix mA = getRandomMatrix(nSize, nSize);
+    Matrix mB = getRandomMatrix(nSize, BENCHMARK_MATRIX_RHS);
+
+    // Number of multiply-add operations
+    suite.run("matrix.multiply", nSize*nSize*nSize, [&]()
+        {
+            Matrix mResult = mA * mA;
+            nSink = mResult.rows();
+        });
+
+    suite.run("matrix.linsolve", nSize*nSize, [&]()
+        {
+            Eigen::PartialPivLU<Eigen::MatrixXcd> lu(toEigenMatrix(mA));
+            Matrix mResult = fromEigenMatrix(lu.solve(toEigenMatrix(mB)));
+            nSink = mResult.rows();
+        });
+
+    suite.run("matrix.invert", nSize*nSize, [&]()
+        {
+            Eigen::PartialPivLU<Eigen::MatrixXcd> lu(toEigenMatrix(mA));
+            Matrix mResult = fromEigenMatrix(lu.inverse());
+            nSink = mResult.rows();
+        });
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Entry point of the benchmark suite.
+/// Supported arguments: "--json FILE" to write
+/// the results as JSON, "--filter TEXT" to run
+/// only matching benchmarks and "--repetitions N"
+/// to change the number of timed runs.
+///
+/// \param argc int
+/// \param argv char**
+/// \return int
+///
+/////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    std::string sJsonFile;
+    std::string sFilter;
+    size_t nRepetitions = BENCHMARK_REPETITIONS;
+
+    for (int i = 1; i+1 < argc; i += 2)
+    {
+        std::string sArg = argv[i];
+
+        if (sArg == "--json")
+            sJsonFile = argv[i+1];
+        else if (sArg == "--filter")
+            sFilter = argv[i+1];
+        else if (sArg == "--repetitions")
+            nRepetitions = std::max(1, std::atoi(argv[i+1]));
+    }
+
+    BenchmarkSuite suite(sFilter, nRepetitions);
+
+    try
+    {
+        benchmarkParser(suite);
+        benchmarkTypes(suite);
+        benchmarkSparse(suite);
+        benchmarkMatrix(suite);
+    }
+    catch (mu::ParserError& err)
+    {
+        std::cout << " >> ERROR: " << err.GetMsg() << std::endl;
+        return 1;
+    }
+
+    if (sJsonFile.length() && !suite.writeJson(sJsonFile))
+    {
+        std::cout << " >> ERROR: Cannot write " << sJsonFile << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
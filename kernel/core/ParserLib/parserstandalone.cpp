@@ -262,44 +262,44 @@ int main()
     _parser.EnableDebugDump(true, false);
 
     // trigonometric functions
-    _parser.DefineFun("sin", numfnc_sin);
-    _parser.DefineFun("cos", numfnc_cos);
-    _parser.DefineFun("tan", numfnc_tan);
+    _parser.DefineElementwiseFun("sin", numfnc_sin);
+    _parser.DefineElementwiseFun("cos", numfnc_cos);
+    _parser.DefineElementwiseFun("tan", numfnc_tan);
     // arcus functions
-    _parser.DefineFun("asin", numfnc_asin);
-    _parser.DefineFun("arcsin", numfnc_asin);
-    _parser.DefineFun("acos", numfnc_acos);
-    _parser.DefineFun("arccos", numfnc_acos);
-    _parser.DefineFun("atan", numfnc_atan);
-    _parser.DefineFun("arctan", numfnc_atan);
+    _parser.DefineElementwiseFun("asin", numfnc_asin);
+    _parser.DefineElementwiseFun("arcsin", numfnc_asin);
+    _parser.DefineElementwiseFun("acos", numfnc_acos);
+    _parser.DefineElementwiseFun("arccos", numfnc_acos);
+    _parser.DefineElementwiseFun("atan", numfnc_atan);
+    _parser.DefineElementwiseFun("arctan", numfnc_atan);
     //DefineFun("atan2", ATan2);
     // hyperbolic functions
-    _parser.DefineFun("sinh", numfnc_sinh);
-    _parser.DefineFun("cosh", numfnc_cosh);
-    _parser.DefineFun("tanh", numfnc_tanh);
+    _parser.DefineElementwiseFun("sinh", numfnc_sinh);
+    _parser.DefineElementwiseFun("cosh", numfnc_cosh);
+    _parser.DefineElementwiseFun("tanh", numfnc_tanh);
     // arcus hyperbolic functions
-    _parser.DefineFun("asinh", numfnc_asinh);
-    _parser.DefineFun("arsinh", numfnc_asinh);
-    _parser.DefineFun("acosh", numfnc_acosh);
-    _parser.DefineFun("arcosh", numfnc_acosh);
-    _parser.DefineFun("atanh", numfnc_atanh);
-    _parser.DefineFun("artanh", numfnc_atanh);
+    _parser.DefineElementwiseFun("asinh", numfnc_asinh);
+    _parser.DefineElementwiseFun("arsinh", numfnc_asinh);
+    _parser.DefineElementwiseFun("acosh", numfnc_acosh);
+    _parser.DefineElementwiseFun("arcosh", numfnc_acosh);
+    _parser.DefineElementwiseFun("atanh", numfnc_atanh);
+    _parser.DefineElementwiseFun("artanh", numfnc_atanh);
     // Logarithm functions
-    _parser.DefineFun("log2", numfnc_log2);
-    _parser.DefineFun("log10", numfnc_log10);
-    _parser.DefineFun("log", numfnc_log10);
-    _parser.DefineFun("ln", numfnc_ln);
+    _parser.DefineElementwiseFun("log2", numfnc_log2);
+    _parser.DefineElementwiseFun("log10", numfnc_log10);
+    _parser.DefineElementwiseFun("log", numfnc_log10);
+    _parser.DefineElementwiseFun("ln", numfnc_ln);
     // misc
-    _parser.DefineFun("exp", numfnc_exp);
-    _parser.DefineFun("sqrt", numfnc_sqrt);
-    _parser.DefineFun("sign", numfnc_sign);
-    _parser.DefineFun("rint", numfnc_rint);
-    _parser.DefineFun("abs", numfnc_abs);
+    _parser.DefineElementwiseFun("exp", numfnc_exp);
+    _parser.DefineElementwiseFun("sqrt", numfnc_sqrt);
+    _parser.DefineElementwiseFun("sign", numfnc_sign);
+    _parser.DefineElementwiseFun("rint", numfnc_rint);
+    _parser.DefineElementwiseFun("abs", numfnc_abs);
     _parser.DefineFun("time", timfnc_time, false);
     _parser.DefineFun("date", timfnc_date, true, 2);
     _parser.DefineFun("as_date", timfnc_as_date, true, 2);
-    _parser.DefineFun("seconds", cast_seconds);
-    _parser.DefineFun("weeks", cast_weeks);
+    _parser.DefineElementwiseFun("seconds", cast_seconds);
+    _parser.DefineElementwiseFun("weeks", cast_weeks);
 
     _parser.DefineFun("logtoidx", numfnc_logtoidx);
     _parser.DefineFun("idxtolog", numfnc_idxtolog);
@@ -311,7 +311,7 @@ int main()
     _parser.DefineFun("to_string", strfnc_to_string);
     _parser.DefineFun("strjoin", strfnc_strjoin, true, 2);
     _parser.DefineFun("valtostr", strfnc_valtostr, true, 2);
-    _parser.DefineFun("landau_rd", rndfnc_landau_rd, false, 1);
+    _parser.DefineRandomFun("landau_rd", rndfnc_landau_rd, 1);
     _parser.DefineFun("textparse", strfnc_textparse, true, 2);
     _parser.DefineFun("bswap", bswap);
     _parser.DefineFun("dict", create_dictstruct, true, 2);
@@ -31,6 +31,8 @@
 #include "io/logger.hpp"
 #include "utils/tools.hpp"
 #include "utils/filecheck.hpp"
+#include "utils/kernelstats.hpp"
+#include "utils/kernelbenchmark.hpp"
 #include "io/archive.hpp"
 #include "io/qrcode.hpp"
 #include "../../database/database.hpp"
@@ -4903,6 +4905,190 @@ static CommandReturnValues cmd_execute(string& sCmd)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This static function implements the
+/// "benchmark" command, which runs the kernel
+/// benchmarks matching the optional filter and
+/// shows or exports their results.
+///
+/// \param sCmd string&
+/// \return CommandReturnValues
+///
+/////////////////////////////////////////////////
+static CommandReturnValues cmd_benchmark(string& sCmd)
+{
+    CommandLineParser cmdParser(sCmd, "benchmark", CommandLineParser::CMD_EXPR_set_PAR);
+    Settings& _option = NumeReKernel::getInstance()->getSettings();
+
+    std::string sFilter = cmdParser.getExpr();
+    StripSpaces(sFilter);
+
+    size_t nRepetitions = KERNELBENCHMARK_REPETITIONS;
+    auto vParVal = cmdParser.getParsedParameterValue("reps");
+
+    if (vParVal.size())
+        nRepetitions = std::max<int64_t>(1, vParVal.getAsScalarInt());
+
+    KernelBenchmark _benchmark(sFilter, nRepetitions);
+    _benchmark.runAll();
+
+    if (cmdParser.hasParam("file"))
+    {
+        std::string sFileName = cmdParser.getFileParameterValueForSaving(".json", "<savepath>", "benchmark");
+        std::ofstream jsonFile(sFileName, std::ios_base::out | std::ios_base::trunc);
+
+        if (!jsonFile.good())
+            throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sCmd, sFileName, sFileName);
+
+        jsonFile << _benchmark.toJson();
+
+        if (_option.systemPrints())
+            NumeReKernel::print(_lang.get("BUILTIN_CHECKKEYWORD_SAVEDATA_SUCCESS", sFileName));
+    }
+
+    NumeReKernel::toggleTableStatus();
+    make_hline();
+    NumeReKernel::print("NUMERE: KERNEL BENCHMARKS");
+    make_hline();
+
+    for (const std::string& sLine : _benchmark.getReport())
+    {
+        NumeReKernel::printPreFmt("|   " + sLine + "\n");
+    }
+
+    NumeReKernel::toggleTableStatus();
+    make_hline();
+
+    return COMMAND_PROCESSED;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This static function implements the
+/// "counters" command, which shows, resets or
+/// exports the kernel event counters.
+///
+/// \param sCmd string&
+/// \return CommandReturnValues
+///
+/////////////////////////////////////////////////
+static CommandReturnValues cmd_counters(string& sCmd)
+{
+    CommandLineParser cmdParser(sCmd, "counters", CommandLineParser::CMD_EXPR_set_PAR);
+    Settings& _option = NumeReKernel::getInstance()->getSettings();
+
+    std::string sAction = cmdParser.getExpr();
+    StripSpaces(sAction);
+
+    if (sAction == "reset")
+        g_kernelStats.reset();
+    else if (sAction == "export")
+    {
+        std::string sFileName = cmdParser.getFileParameterValueForSaving(".json", "<savepath>", "counters");
+        std::ofstream jsonFile(sFileName, std::ios_base::out | std::ios_base::trunc);
+
+        if (!jsonFile.good())
+            throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sCmd, sFileName, sFileName);
+
+        jsonFile << g_kernelStats.toJson();
+
+        if (_option.systemPrints())
+            NumeReKernel::print(_lang.get("BUILTIN_CHECKKEYWORD_SAVEDATA_SUCCESS", sFileName));
+    }
+    else
+    {
+        NumeReKernel::toggleTableStatus();
+        make_hline();
+        NumeReKernel::print("NUMERE: KERNEL COUNTERS");
+        make_hline();
+
+        for (const std::string& sLine : g_kernelStats.getReport())
+        {
+            NumeReKernel::printPreFmt("|   " + sLine + "\n");
+        }
+
+        NumeReKernel::toggleTableStatus();
+        make_hline();
+    }
+
+    return COMMAND_PROCESSED;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This static function implements the
+/// "profile" command, which controls the
+/// profiler of scripts and procedures.
+///
+/// \param sCmd string&
+/// \return CommandReturnValues
+///
+/////////////////////////////////////////////////
+static CommandReturnValues cmd_profile(string& sCmd)
+{
+    CommandLineParser cmdParser(sCmd, "profile", CommandLineParser::CMD_EXPR_set_PAR);
+    NumeReProfiler& _profiler = NumeReKernel::getInstance()->getProfiler();
+    Settings& _option = NumeReKernel::getInstance()->getSettings();
+
+    std::string sAction = cmdParser.getExpr();
+    StripSpaces(sAction);
+
+    if (sAction == "start")
+    {
+        _profiler.reset();
+        _profiler.start();
+    }
+    else if (sAction == "stop")
+        _profiler.stop();
+    else if (sAction == "reset")
+        _profiler.reset();
+    else if (sAction == "report")
+    {
+        std::vector<std::string> vReport;
+
+        if (cmdParser.hasParam("calltree"))
+            vReport = _profiler.getCallTreeReport();
+        else
+        {
+            size_t nEntries = PROFILER_REPORT_ENTRIES;
+            auto vParVal = cmdParser.getParsedParameterValue("entries");
+
+            if (vParVal.size())
+                nEntries = std::max<int64_t>(1, vParVal.getAsScalarInt());
+
+            vReport = _profiler.getFlatReport(nEntries);
+        }
+
+        NumeReKernel::toggleTableStatus();
+        make_hline();
+        NumeReKernel::print("NUMERE: PROFILER");
+        make_hline();
+
+        for (const std::string& sLine : vReport)
+        {
+            NumeReKernel::printPreFmt("|   " + toSystemCodePage(sLine) + "\n");
+        }
+
+        NumeReKernel::toggleTableStatus();
+        make_hline();
+    }
+    else if (sAction == "export")
+    {
+        std::string sFileName = cmdParser.getFileParameterValueForSaving(".txt", "<savepath>", "profile");
+
+        if (!_profiler.exportFoldedStacks(sFileName))
+            throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sCmd, sFileName, sFileName);
+
+        if (_option.systemPrints())
+            NumeReKernel::print(_lang.get("BUILTIN_CHECKKEYWORD_SAVEDATA_SUCCESS", sFileName));
+    }
+    else
+        doc_Help("profile", _option);
+
+    return COMMAND_PROCESSED;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This static function implements the
 /// "progress" command.
@@ -5205,6 +5391,7 @@ static std::map<std::string, CommandFunc> getCommandFunctions()
 
     mCommandFuncMap["about"] = cmd_credits;
     mCommandFuncMap["audio"] = cmd_audio;
+    mCommandFuncMap["benchmark"] = cmd_benchmark;
     mCommandFuncMap["clc"] = cmd_clc;
     mCommandFuncMap["clear"] = cmd_clear;
     mCommandFuncMap["close"] = cmd_close;
@@ -5213,6 +5400,7 @@ static std::map<std::string, CommandFunc> getCommandFunctions()
     mCommandFuncMap["contour"] = cmd_plotting;
     mCommandFuncMap["contour3d"] = cmd_plotting;
     mCommandFuncMap["copy"] = cmd_copy;
+    mCommandFuncMap["counters"] = cmd_counters;
     mCommandFuncMap["credits"] = cmd_credits;
     mCommandFuncMap["datagrid"] = cmd_datagrid;
     mCommandFuncMap["del"] = cmd_delete;
@@ -5264,6 +5452,7 @@ static std::map<std::string, CommandFunc> getCommandFunctions()
     mCommandFuncMap["plot3d"] = cmd_plotting;
     mCommandFuncMap["plotcompose"] = cmd_plotting;
     mCommandFuncMap["print"] = cmd_print;
+    mCommandFuncMap["profile"] = cmd_profile;
     mCommandFuncMap["progress"] = cmd_progress;
     mCommandFuncMap["qrcode"] = cmd_qrcode;
     mCommandFuncMap["quit"] = cmd_quit;
@@ -18,6 +18,7 @@
 
 #include "dataaccess.hpp"
 #include "../utils/tools.hpp"
+#include "../utils/kernelstats.hpp"
 #include "../../kernel.hpp"
 #include <vector>
 
@@ -340,6 +341,10 @@ size_t findAssignmentOperator(StringView sCmd)
 /////////////////////////////////////////////////
 std::string getDataElements(std::string& sLine, mu::Parser& _parser, MemoryManager& _data, int options)
 {
+    // Measure the run time of the table access,
+    // if the profiler is active
+    ProfilerTableScope _tableScope(NumeReKernel::getInstance()->getProfiler());
+
     // Evaluate possible cached equations
     if ((_parser.HasCachedAccess() || _parser.GetCachedEquation().length()) && !_parser.IsCompiling())
         return handleCachedDataAccess(sLine, _parser, _data);
@@ -698,7 +703,11 @@ static std::string handleCachedDataAccess(std::string& sLine, mu::Parser& _parse
             _idx.col.setRange(0, _data.getCols(_access.sCacheName, false) - 1);
 
         // Get new data (Parser::GetVectorVar returns a pointer to the vector var) and update the stored elements in the internal representation
-        _data.copyElementsInto(_parser.GetInternalVar(_access.sVectorName), _idx.row, _idx.col, _access.sCacheName);
+        mu::Variable* vectorVar = _parser.GetInternalVar(_access.sVectorName);
+        _data.copyElementsInto(vectorVar, _idx.row, _idx.col, _access.sCacheName);
+
+        g_kernelStats.count(KC_CACHEDACCESS_COPIES);
+        g_kernelStats.count(KC_CACHEDACCESS_BYTES, vectorVar->size() * sizeof(mu::Value));
     }
 
     // Update the equation (probably there are cached elements, which could not be cached)
@@ -1678,6 +1687,69 @@ static std::string tableMethod_anova(const std::string& sTableName, std::string
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Realizes the "groupstatsof()" table
+/// method.
+///
+/// \param sTableName const std::string&
+/// \param sMethodArguments std::string
+/// \param sResultVectorName const std::string&
+/// \return std::string
+///
+/////////////////////////////////////////////////
+static std::string tableMethod_groupstats(const std::string& sTableName, std::string sMethodArguments, const std::string& sResultVectorName)
+{
+    NumeReKernel* _kernel = NumeReKernel::getInstance();
+
+    int nResults = 0;
+    _kernel->getMemoryManager().updateDimensionVariables(sTableName);
+    _kernel->getParser().SetExpr(sMethodArguments);
+    const mu::StackItem* v = _kernel->getParser().Eval(nResults);
+
+    if (nResults < 2)
+        throw SyntaxError(SyntaxError::TOO_FEW_COLS, sTableName + "().groupstatsof()", ".groupstatsof(", ".groupstatsof(");
+
+    VectorIndex keyCols = _kernel->getMemoryManager().arrayToIndex(v[0].get(), sTableName);
+    VectorIndex valCols = _kernel->getMemoryManager().arrayToIndex(v[1].get(), sTableName);
+
+    VectorIndex vIndex(0, VectorIndex::OPEN_END);
+
+    if (nResults > 2)
+        vIndex = VectorIndex(v[2].get());
+
+    GroupStatsResult res = _kernel->getMemoryManager().getGroupStatistics(sTableName, keyCols, valCols.front(), vIndex);
+
+    mu::Array results;
+
+    for (size_t g = 0; g < res.names.size(); g++)
+    {
+        mu::Array groupSet;
+
+        groupSet.push_back("Count");
+        groupSet.push_back(res.stats.m_count[g]);
+        groupSet.push_back("Sum");
+        groupSet.push_back(res.stats.m_sum[g]);
+        groupSet.push_back("Mean");
+        groupSet.push_back(res.stats.mean(g));
+        groupSet.push_back("Std");
+        groupSet.push_back(std::sqrt(res.stats.var(g)));
+        groupSet.push_back("Min");
+        groupSet.push_back(res.stats.m_count[g] ? res.stats.m_min[g] : NAN);
+        groupSet.push_back("Max");
+        groupSet.push_back(res.stats.m_count[g] ? res.stats.m_max[g] : NAN);
+
+        results.push_back("[" + res.names[g] + "]");
+        results.push_back(groupSet);
+    }
+
+    if (!results.size())
+        results.push_back(NAN);
+
+    _kernel->getParser().SetInternalVar(sResultVectorName, results);
+    return sResultVectorName;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Realizes the "kmeansof()" table method.
 ///
@@ -1705,6 +1777,7 @@ static std::string tableMethod_kmeans(const std::string& sTableName, std::string
     size_t maxIterations = 100;
     Memory::KmeansInit init_method = Memory::KmeansInit::INIT_RANDOM;
     size_t n_init = 10;
+    size_t batchSize = 0;
 
     if (nResults > 2)
     {
@@ -1715,7 +1788,13 @@ static std::string tableMethod_kmeans(const std::string& sTableName, std::string
             init_method = Memory::stringToKmeansInit(v[3].get().front().getStr());
 
             if (nResults > 4)
+            {
                 n_init = v[4].get().getAsScalarInt();
+
+                // A batch size enables the mini-batch mode
+                if (nResults > 5)
+                    batchSize = v[5].get().getAsScalarInt();
+            }
             else
             {
                 // scikit: When n_init='auto', the number of runs depends on the value
@@ -1726,15 +1805,7 @@ static std::string tableMethod_kmeans(const std::string& sTableName, std::string
         }
     }
 
-    KMeansResult bestRes = _kernel->getMemoryManager().getKMeans(sTableName, cols, nClusters, maxIterations, init_method);
-
-    for (size_t re_inits = 1; re_inits < n_init; re_inits++)
-    {
-        KMeansResult res = _kernel->getMemoryManager().getKMeans(sTableName, cols, nClusters, maxIterations, init_method);
-
-        if (res.inertia < bestRes.inertia)
-            bestRes = res;
-    }
+    KMeansResult bestRes = _kernel->getMemoryManager().getKMeans(sTableName, cols, nClusters, maxIterations, init_method, n_init, batchSize);
 
     _kernel->getParser().SetInternalVar(sResultVectorName, bestRes.cluster_labels);
     return sResultVectorName;
@@ -2126,6 +2197,7 @@ static std::map<std::string, TableMethod> getInplaceTableMethods()
     mTableMethods["rankof"] = tableMethod_rank;
     mTableMethods["zscoreof"] = tableMethod_zscore;
     mTableMethods["anovaof"] = tableMethod_anova;
+    mTableMethods["groupstatsof"] = tableMethod_groupstats;
     mTableMethods["kmeansof"] = tableMethod_kmeans;
     mTableMethods["binsof"] = tableMethod_binsof;
     mTableMethods["insertcells"] = tableMethod_insertBlock;
@@ -158,14 +158,11 @@ void append_data(CommandLineParser& cmdParser)
         if (!vFilelist.size())
             throw SyntaxError(SyntaxError::FILE_NOT_EXIST, cmdParser.getCommandLine(), SyntaxError::invalid_position, sFileList);
 
-        // Go through all elements in the vFilelist list
-        for (size_t i = 0; i < vFilelist.size(); i++)
-        {
-            // Load the data. The melting of multiple files
-            // is processed automatically
-            _data.setbLoadEmptyColsInNextFile(cmdParser.hasParam("keepdim") || cmdParser.hasParam("complete"));
-            _data.openFile(vFilelist[i], false, false, 0, "", sFileFormat);
-        }
+        // Load the data. The files are read in parallel,
+        // the melting is processed in the order of the
+        // file list
+        _data.setbLoadEmptyColsInNextFile(cmdParser.hasParam("keepdim") || cmdParser.hasParam("complete"));
+        _data.openFiles(vFilelist, sFileFormat);
 
         // Inform the user and return
         if (!_data.isEmpty("data") && _option.systemPrints())
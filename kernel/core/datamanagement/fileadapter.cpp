@@ -19,8 +19,11 @@
 #include "fileadapter.hpp"
 #include "../utils/tools.hpp"
 #include "../io/logger.hpp"
+#include "../utils/kernelstats.hpp"
 #include "memory.hpp"
 
+#include <exception>
+
 using namespace std;
 
 namespace NumeRe
@@ -60,20 +63,15 @@ namespace NumeRe
     /// table.
     ///
     /// \param _mem Memory*
+    /// \param keepEmptyCols bool
     /// \return void
     ///
     /////////////////////////////////////////////////
-    void FileAdapter::condenseDataSet(Memory* _mem)
+    void FileAdapter::condenseDataSet(Memory* _mem, bool keepEmptyCols)
     {
-        if (!_mem || !_mem->isValid())
-            return;
-
         // Shall we ignore empty columns?
-        if (bLoadEmptyCols || bLoadEmptyColsInNextFile)
-        {
-            bLoadEmptyColsInNextFile = false;
+        if (!_mem || !_mem->isValid() || keepEmptyCols)
             return;
-        }
 
         // Remove all obsolete cells and columns
         _mem->shrink();
@@ -93,26 +91,17 @@ namespace NumeRe
 
 
     /////////////////////////////////////////////////
-    /// \brief This member function loads the
-    /// contents of the selected file to a new Memory
-    /// class instance. This instance is either
-    /// appended to the already existing instances or
-    /// melted with an existing one, if the existing
-    /// one has the same name.
+    /// \brief This member function resolves the
+    /// passed file name and tries to detect the
+    /// extension, if the user did not provide it.
     ///
-    /// \param _sFile std::string
-    /// \param loadToCache bool
-    /// \param overrideTarget bool
-    /// \param _nHeadline int
-    /// \param sTargetTable const std::string&
-    /// \param sFileFormat std::string
-    /// \return FileHeaderInfo
+    /// \param _sFile const std::string&
+    /// \param sFileFormat const std::string&
+    /// \return std::string
     ///
     /////////////////////////////////////////////////
-    FileHeaderInfo FileAdapter::openFile(std::string _sFile, bool loadToCache, bool overrideTarget, int _nHeadline, const std::string& sTargetTable, std::string sFileFormat)
+    std::string FileAdapter::resolveFileName(const std::string& _sFile, const std::string& sFileFormat)
     {
-        FileHeaderInfo info;
-
         // Ensure that the file name is valid
         std::string sFile = ValidFileName(_sFile, ".dat", !sFileFormat.length());
 
@@ -124,12 +113,34 @@ namespace NumeRe
 
         g_logger.info("Loading file '" + _sFile + "'. (Resolved as '" + sFile + "')");
 
+        return sFile;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This member function reads the
+    /// contents of the selected (already resolved)
+    /// file into a new Memory instance, converts and
+    /// condenses it. It does not modify the state of
+    /// this class and may therefore be called from
+    /// multiple threads at once.
+    ///
+    /// \param sFile const std::string&
+    /// \param _nHeadline int
+    /// \param sFileFormat const std::string&
+    /// \param keepEmptyCols bool
+    /// \param info FileHeaderInfo&
+    /// \return Memory*
+    ///
+    /////////////////////////////////////////////////
+    Memory* FileAdapter::readFileToMemory(const std::string& sFile, int _nHeadline, const std::string& sFileFormat, bool keepEmptyCols, FileHeaderInfo& info)
+    {
         // Get an instance of the desired file type
         GenericFile* file = getFileByType(sFile, sFileFormat);
 
         // Ensure that the instance is valid
         if (!file)
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, _sFile, SyntaxError::invalid_position, _sFile);
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
 
         // Try to read the contents of the file. This may
         // either result in a read error or the read method
@@ -144,6 +155,8 @@ namespace NumeRe
             // Read the file
             if (!file->read())
                 throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
+
+            g_kernelStats.countFileIo(toLowerCase(file->getExtension()), sFile, false);
         }
         catch (...)
         {
@@ -168,57 +181,84 @@ namespace NumeRe
         // If the dimensions were valid and the internal
         // memory was created, copy the data to this
         // memory
-        if (_mem->memArray.size())
+        if (!_mem->memArray.size())
         {
-            // Copy them and delete the file instance
-            // afterwards
-            file->getData(&_mem->memArray);
             delete file;
-            g_logger.debug("Data copied.");
+            delete _mem;
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
+        }
 
-            // Is it actually necessary to apply some automatic
-            // conversion to the data?
-            if (info.needsConversion)
-            {
-                _mem->convert();
-                g_logger.debug("Data converted.");
-            }
+        // Move them and delete the file instance
+        // afterwards
+        file->moveData(&_mem->memArray);
+        delete file;
+        g_logger.debug("Data moved.");
 
-            condenseDataSet(_mem);
-            _mem->createTableHeaders();
-            _mem->setSaveStatus(false);
+        // Is it actually necessary to apply some automatic
+        // conversion to the data?
+        if (info.needsConversion)
+        {
+            _mem->convert();
+            g_logger.debug("Data converted.");
+        }
+
+        condenseDataSet(_mem, keepEmptyCols);
+        _mem->createTableHeaders();
+        _mem->setSaveStatus(false);
 
-            NumeRe::TableMetaData meta;
-            meta.comment = info.sComment;
-            meta.source = sFile;
-            meta.save();
+        NumeRe::TableMetaData meta;
+        meta.comment = info.sComment;
+        meta.source = sFile;
+        meta.save();
 
-            _mem->setMetaData(meta);
+        _mem->setMetaData(meta);
 
-            // Melt or append the new instance. The
-            // melt() member function is responsible
-            // for freeing the passed memory.
-            if (loadToCache)
+        return _mem;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This member function loads the
+    /// contents of the selected file to a new Memory
+    /// class instance. This instance is either
+    /// appended to the already existing instances or
+    /// melted with an existing one, if the existing
+    /// one has the same name.
+    ///
+    /// \param _sFile std::string
+    /// \param loadToCache bool
+    /// \param overrideTarget bool
+    /// \param _nHeadline int
+    /// \param sTargetTable const std::string&
+    /// \param sFileFormat std::string
+    /// \return FileHeaderInfo
+    ///
+    /////////////////////////////////////////////////
+    FileHeaderInfo FileAdapter::openFile(std::string _sFile, bool loadToCache, bool overrideTarget, int _nHeadline, const std::string& sTargetTable, std::string sFileFormat)
+    {
+        FileHeaderInfo info;
+
+        std::string sFile = resolveFileName(_sFile, sFileFormat);
+        Memory* _mem = readFileToMemory(sFile, _nHeadline, sFileFormat, bLoadEmptyCols || bLoadEmptyColsInNextFile, info);
+        bLoadEmptyColsInNextFile = false;
+
+        // Melt or append the new instance. The
+        // melt() member function is responsible
+        // for freeing the passed memory.
+        if (loadToCache)
+        {
+            if (sTargetTable.length())
             {
-                if (sTargetTable.length())
-                {
-                    melt(_mem, sTargetTable, overrideTarget);
-                    info.sTableName = sTargetTable;
-                }
-                else
-                    melt(_mem, info.sTableName, overrideTarget);
+                melt(_mem, sTargetTable, overrideTarget);
+                info.sTableName = sTargetTable;
             }
             else
-                melt(_mem, "data");
-
-            g_logger.info("File successfully loaded. Data file dimensions = {" + toString(info.nRows) + ", " + toString(info.nCols) + "}");
+                melt(_mem, info.sTableName, overrideTarget);
         }
         else
-        {
-            delete file;
-            delete _mem;
-            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFile, SyntaxError::invalid_position, sFile);
-        }
+            melt(_mem, "data");
+
+        g_logger.info("File successfully loaded. Data file dimensions = {" + toString(info.nRows) + ", " + toString(info.nCols) + "}");
 
         if (!loadToCache)
         {
@@ -234,6 +274,80 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief This member function loads a list of
+    /// files into the "data" table. The files are
+    /// read and converted concurrently, but melted
+    /// in the order of the passed list. The result
+    /// is therefore identical to opening the files
+    /// one after another. If a file cannot be read,
+    /// all files preceding it are melted before the
+    /// error is rethrown.
+    ///
+    /// \param vFiles const std::vector<std::string>&
+    /// \param sFileFormat const std::string&
+    /// \return std::vector<FileHeaderInfo>
+    ///
+    /////////////////////////////////////////////////
+    std::vector<FileHeaderInfo> FileAdapter::openFiles(const std::vector<std::string>& vFiles, const std::string& sFileFormat)
+    {
+        std::vector<FileHeaderInfo> vInfo(vFiles.size());
+        std::vector<std::string> vResolved(vFiles.size());
+        std::vector<Memory*> vMemory(vFiles.size(), nullptr);
+        std::vector<std::exception_ptr> vErrors(vFiles.size());
+        bool keepEmptyCols = bLoadEmptyCols || bLoadEmptyColsInNextFile;
+        bLoadEmptyColsInNextFile = false;
+
+        // Resolving the file names depends on the
+        // current path and is therefore done serially
+        for (size_t i = 0; i < vFiles.size(); i++)
+        {
+            vResolved[i] = resolveFileName(vFiles[i], sFileFormat);
+        }
+
+        // Read, convert and condense the files in
+        // parallel. Exceptions must not leave the
+        // parallel region and are stored instead
+        #pragma omp parallel for schedule(dynamic) if(vFiles.size() > 1)
+        for (size_t i = 0; i < vFiles.size(); i++)
+        {
+            try
+            {
+                vMemory[i] = readFileToMemory(vResolved[i], 0, sFileFormat, keepEmptyCols, vInfo[i]);
+            }
+            catch (...)
+            {
+                vErrors[i] = std::current_exception();
+            }
+        }
+
+        // Melt the instances in the order of the file
+        // list
+        for (size_t i = 0; i < vFiles.size(); i++)
+        {
+            if (vErrors[i])
+            {
+                for (size_t j = i+1; j < vFiles.size(); j++)
+                {
+                    delete vMemory[j];
+                }
+
+                std::rethrow_exception(vErrors[i]);
+            }
+
+            melt(vMemory[i], "data");
+            g_logger.info("File successfully loaded. Data file dimensions = {" + toString(vInfo[i].nRows) + ", " + toString(vInfo[i].nCols) + "}");
+
+            if (sDataFile.length())
+                sDataFile += ";" + vResolved[i];
+            else
+                sDataFile = vResolved[i];
+        }
+
+        return vInfo;
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief This member function wraps the saving
     /// functionality of the Memory class. The passed
@@ -24,6 +24,7 @@
 #include "../settings.hpp"
 
 #include <string>
+#include <vector>
 
 class Memory;
 
@@ -46,7 +47,9 @@ namespace NumeRe
             bool bLoadEmptyColsInNextFile;
 
             std::string getDate();
-            void condenseDataSet(Memory* _mem);
+            void condenseDataSet(Memory* _mem, bool keepEmptyCols);
+            std::string resolveFileName(const std::string& _sFile, const std::string& sFileFormat);
+            Memory* readFileToMemory(const std::string& sFile, int _nHeadline, const std::string& sFileFormat, bool keepEmptyCols, FileHeaderInfo& info);
             virtual bool saveLayer(std::string _sFileName, const std::string& _sCache, unsigned short nPrecision, std::string sExt = "") = 0;
 
         public:
@@ -54,6 +57,7 @@ namespace NumeRe
             virtual ~FileAdapter() {}
 
             FileHeaderInfo openFile(std::string _sFile, bool loadToCache = false, bool overrideTarget = false, int _nHeadline = 0, const std::string& sTargetTable = "", std::string sFileFormat = "");
+            std::vector<FileHeaderInfo> openFiles(const std::vector<std::string>& vFiles, const std::string& sFileFormat = "");
             bool saveFile(const std::string& sTable, std::string _sFileName, unsigned short nPrecision = 7, std::string sFileFormat = "");
             std::string getDataFileName(const std::string& sTable) const;
             std::string getDataFileNameShort() const;
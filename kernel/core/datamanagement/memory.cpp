@@ -21,6 +21,7 @@
 #include <gsl/gsl_sort.h>
 
 #include <regex>
+#include <unordered_map>
 
 #include "memory.hpp"
 #include "tablecolumnimpl.hpp"
@@ -29,10 +30,13 @@
 #include "../ui/error.hpp"
 #include "../settings.hpp"
 #include "../utils/tools.hpp"
+#include "../utils/counterrandgen.hpp"
+#include "../utils/kernelstats.hpp"
 #include "../maths/resampler.h"
 #include "../maths/statslogic.hpp"
 #include "../maths/matdatastructures.hpp"
 #include "../maths/units.hpp"
+#include "../maths/kmeans.hpp"
 #include "../procedure/mangler.hpp"
 
 #ifdef __GNUWIN64__
@@ -901,7 +905,10 @@ void Memory::convert()
             // Only valid conversions return a non-zero
             // pointer
             if (col && col != memArray[i].get())
+            {
                 memArray[i].reset(col);
+                g_kernelStats.count(KC_COLUMN_CONVERSIONS);
+            }
         }
     }
 }
@@ -942,7 +949,10 @@ bool Memory::convertColumns(const VectorIndex& _vCol, const std::string& _sType)
             // Only valid conversions return a non-zero
             // pointer
             if (col && col != memArray[_vCol[i]].get())
+            {
                 memArray[_vCol[i]].reset(col);
+                g_kernelStats.count(KC_COLUMN_CONVERSIONS);
+            }
             else
                 success = _type == TableColumn::TYPE_NONE; // Auto conversions do not flag errors
         }
@@ -950,7 +960,7 @@ bool Memory::convertColumns(const VectorIndex& _vCol, const std::string& _sType)
 
     // If successful: mark the whole table as modified
     if (success)
-        m_meta.modify();
+        markModified();
 
     return success;
 }
@@ -991,7 +1001,7 @@ bool Memory::convertEmptyColumns(const VectorIndex& _vCol, const std::string& _s
 
     // If successful: mark the whole table as modified
     if (success)
-        m_meta.modify();
+        markModified();
 
     return success;
 }
@@ -1039,7 +1049,7 @@ bool Memory::setCategories(const VectorIndex& _vCol, const std::vector<std::stri
     }
 
     if (success)
-        m_meta.modify();
+        markModified();
 
     return success;
 }
@@ -1187,6 +1197,7 @@ bool Memory::setHeadLineElement(size_t _i, const std::string& _sHead)
         memArray[_i].reset(new DEFAULT_COL_TYPE);
 
     memArray[_i]->m_sHeadLine = _sHead;
+    memArray[_i]->markModified();
     m_meta.modify();
 
     return true;
@@ -1216,6 +1227,7 @@ bool Memory::setUnit(int nCol, const std::string& sUnit)
     }
 
     memArray[nCol]->m_sUnit = sUnit;
+    memArray[nCol]->markModified();
     m_meta.modify();
 
     return true;
@@ -1245,6 +1257,8 @@ std::vector<std::string> Memory::toSiUnits(const VectorIndex& _vCols, UnitConver
             memArray[_vCols[i]]->setValue(VectorIndex(0, VectorIndex::OPEN_END), asSiUnits(_vCols[i], mode));
             std::string sUnit = getUnitConversion(memArray[_vCols[i]]->m_sUnit, mode).formatUnit(mode);
             memArray[_vCols[i]]->m_sUnit = sUnit;
+            memArray[_vCols[i]]->markModified();
+            m_meta.modify();
             vUnits.push_back(sUnit);
         }
         else
@@ -1285,7 +1299,8 @@ void Memory::setMetaData(const NumeRe::TableMetaData& meta)
 
 
 /////////////////////////////////////////////////
-/// \brief Mark this table as modified.
+/// \brief Mark this table and all of its
+/// columns as modified.
 ///
 /// \return void
 ///
@@ -1294,6 +1309,12 @@ void Memory::markModified()
 {
     m_meta.modify();
     nCalcLines = -1;
+
+    for (TblColPtr& col : memArray)
+    {
+        if (col)
+            col->markModified();
+    }
 }
 
 
@@ -1399,6 +1420,7 @@ void Memory::writeData(int _nLine, int _nCol, const mu::Value& _dData, TableColu
 
     promote_if_needed(memArray[_nCol], _nCol, type != TableColumn::TYPE_NONE ? type : to_column_type(_dData));
     memArray[_nCol]->set(_nLine, _dData);
+    memArray[_nCol]->markModified();
 
     if (nCalcLines != -1 && (!_dData.isValid() || _nLine >= nCalcLines))
         nCalcLines = -1;
@@ -1423,6 +1445,7 @@ void Memory::writeDataDirect(int _nLine, int _nCol, const std::complex<double>&
 {
     promote_if_needed(memArray[_nCol], _nCol, TableColumn::TYPE_VALUE);
     memArray[_nCol]->setValue(_nLine, _dData);
+    memArray[_nCol]->markModified();
 }
 
 
@@ -1444,6 +1467,116 @@ void Memory::writeDataDirect(int _nLine, int _nCol, const std::complex<double>&
 void Memory::writeDataDirectUnsafe(int _nLine, int _nCol, const std::complex<double>& _dData)
 {
     memArray[_nCol]->setValue(_nLine, _dData);
+    memArray[_nCol]->markModified();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function writes a block of
+/// consecutive values to the selected column
+/// starting at the selected line. The values are
+/// read from the passed buffer with the passed
+/// stride, which enables de-interleaving buffers
+/// directly. Single precision columns are written
+/// directly into their internal buffer. Like
+/// writeDataDirectUnsafe(), it won't check for
+/// the existence of the needed amount of columns.
+///
+/// \param _nLine int
+/// \param _nCol int
+/// \param data const float*
+/// \param nElems size_t
+/// \param stride size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void Memory::writeDataBlock(int _nLine, int _nCol, const float* data, size_t nElems, size_t stride)
+{
+    F32ValueColumn* col = dynamic_cast<F32ValueColumn*>(memArray[_nCol].get());
+
+    if (col)
+        col->setBlock(_nLine, data, nElems, stride);
+    else
+    {
+        promote_if_needed(memArray[_nCol], _nCol, TableColumn::TYPE_VALUE);
+
+        for (size_t i = 0; i < nElems; i++)
+        {
+            memArray[_nCol]->setValue(_nLine+i, data[i*stride]);
+        }
+    }
+
+    memArray[_nCol]->markModified();
+    nCalcLines = -1;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function appends a batch
+/// of rows after the last filled row of the
+/// table. The batch is passed column-wise, i.e.
+/// every array contains the new values of one
+/// column. In contrast to writing the cells
+/// separately, the type of every column is
+/// determined and converted only once per batch
+/// and the capacity of the columns grows
+/// geometrically.
+///
+/// \param vColumns const std::vector<mu::Array>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void Memory::appendRows(const std::vector<mu::Array>& vColumns)
+{
+    size_t nRows = 0;
+
+    for (const mu::Array& col : vColumns)
+    {
+        nRows = std::max(nRows, col.size());
+    }
+
+    if (!nRows)
+        return;
+
+    size_t nFirstRow = getLines();
+
+    if (memArray.size() < vColumns.size())
+        resizeMemory(nFirstRow+nRows, vColumns.size());
+
+    // Grow the capacity in powers of two to avoid
+    // reallocations for every batch
+    size_t nCapacity = APPENDROWS_MINCAPACITY;
+
+    while (nCapacity < nFirstRow+nRows)
+    {
+        nCapacity *= 2;
+    }
+
+    for (size_t j = 0; j < vColumns.size(); j++)
+    {
+        if (!vColumns[j].size())
+            continue;
+
+        // Determine the type of the whole batch at once
+        promote_if_needed(memArray[j], j, to_column_type(vColumns[j]));
+
+        // Batches of only invalid values won't create
+        // a new column
+        if (!memArray[j])
+            continue;
+
+        memArray[j]->reserve(nCapacity);
+
+        for (size_t i = 0; i < vColumns[j].size(); i++)
+        {
+            memArray[j]->set(nFirstRow+i, vColumns[j][i]);
+        }
+
+        memArray[j]->markModified();
+    }
+
+    nCalcLines = -1;
+    m_meta.modify();
 }
 
 
@@ -1451,7 +1584,9 @@ void Memory::writeDataDirectUnsafe(int _nLine, int _nCol, const std::complex<dou
 /// \brief This member function writes a whole
 /// array of values to the selected table range.
 /// The table is automatically enlarged, if
-/// necessary.
+/// necessary. Rows directly after the last
+/// filled row are committed at once using
+/// appendRows().
 ///
 /// \param _idx Indices&
 /// \param _values const mu::Array&
@@ -1497,6 +1632,35 @@ void Memory::writeData(Indices& _idx, const mu::Array& _values)
     else if (_idx.col.size() > 1)
         nDirection = LINES;
 
+    // Rows directly after the last filled row are
+    // appended to the table at once
+    if (!rewriteColumn
+        && _idx.row.front() == getLines()
+        && _idx.col.min() >= 0
+        && (nDirection == LINES || (_idx.row.isExpanded() && _idx.row.last() > _idx.row.front())))
+    {
+        std::vector<mu::Array> vColumns(_idx.col.max()+1);
+
+        for (size_t j = 0; j < _idx.col.size(); j++)
+        {
+            if (nDirection == LINES)
+            {
+                if (_values.size() > j)
+                    vColumns[_idx.col[j]] = mu::Array(_values.get(j));
+
+                continue;
+            }
+
+            for (size_t i = 0; i < _idx.row.size() && i < _values.size(); i++)
+            {
+                vColumns[_idx.col[j]].push_back(_values.get(i));
+            }
+        }
+
+        appendRows(vColumns);
+        return;
+    }
+
     TableColumn::ColumnType t = to_column_type(_values);
 
     for (size_t j = 0; j < _idx.col.size(); j++)
@@ -1764,7 +1928,7 @@ std::vector<int> Memory::sortElements(const VectorIndex& _vLine, const VectorInd
             vIndex[i]++;
     }
 
-    m_meta.modify();
+    markModified();
 
     if (bError || !bReturnIndex)
         return std::vector<int>();
@@ -1989,7 +2153,7 @@ void Memory::insertCopiedTable(NumeRe::Table _table, const VectorIndex& lines, c
 
     // Try to convert string- to valuecolumns
     convert();
-    m_meta.modify();
+    markModified();
 }
 
 
@@ -2022,7 +2186,7 @@ bool Memory::insertBlock(size_t atRow, size_t atCol, size_t rows, size_t cols)
             memArray[c]->insertElements(atRow, rows);
     }
 
-    m_meta.modify();
+    markModified();
     nCalcLines = -1;
     return true;
 }
@@ -2069,7 +2233,7 @@ bool Memory::insertRows(size_t atRow, size_t num)
             col->insertElements(atRow, num);
     }
 
-    m_meta.modify();
+    markModified();
     nCalcLines = -1;
     return true;
 }
@@ -2104,7 +2268,7 @@ bool Memory::removeBlock(size_t atRow, size_t atCol, size_t rows, size_t cols)
             memArray[c]->removeElements(atRow, rows);
     }
 
-    m_meta.modify();
+    markModified();
     nCalcLines = -1;
     return true;
 }
@@ -2192,7 +2356,7 @@ bool Memory::removeRows(const VectorIndex& _vRows)
         }
     }
 
-    m_meta.modify();
+    markModified();
     nCalcLines = -1;
     return true;
 }
@@ -2283,7 +2447,7 @@ bool Memory::reorderRows(const VectorIndex& _vRows, const VectorIndex& _vNewOrde
         }
     }
 
-    m_meta.modify();
+    markModified();
     return true;
 }
 
@@ -2373,6 +2537,9 @@ bool Memory::replaceVals(const VectorIndex& _vCols, const mu::Array& _oldVals, c
         }
     }
 
+    if (success)
+        markModified();
+
     return success;
 }
 
@@ -2414,6 +2581,8 @@ bool Memory::save(string _sFileName, const string& sTableName, unsigned short nP
     // this memory page
     if (file->getExtension() == "ndat" || toLowerCase(sExt) == "ndat")
         static_cast<NumeRe::NumeReDataFile*>(file)->setComment(m_meta.comment);
+    else if (dynamic_cast<NumeRe::ArrowIpcFile*>(file)) // Arrow IPC files store it in their metadata
+        file->setComment(m_meta.comment);
 
     // Try to write the data to the file. This might
     // either result in writing errors or the write
@@ -2429,9 +2598,15 @@ bool Memory::save(string _sFileName, const string& sTableName, unsigned short nP
         throw;
     }
 
-    // Delete the created file instance
+    std::string sFormat = toLowerCase(file->getExtension());
+    std::string sWrittenFile = file->getFileName();
+
+    // Delete the created file instance. This will
+    // also flush and close the file
     delete file;
 
+    g_kernelStats.countFileIo(sFormat, sWrittenFile, true);
+
     return true;
 }
 
@@ -2453,6 +2628,7 @@ void Memory::deleteEntry(int _nLine, int _nCol)
         {
             // Delete the element
             memArray[_nCol]->deleteElements(VectorIndex(_nLine));
+            memArray[_nCol]->markModified();
             m_meta.modify();
 
             // Evaluate, whether we can remove
@@ -2490,7 +2666,10 @@ void Memory::deleteBulk(const VectorIndex& _vLine, const VectorIndex& _vCol)
     for (size_t j = 0; j < _vCol.size(); j++)
     {
         if (_vCol[j] >= 0 && _vCol[j] < (int)memArray.size() && memArray[_vCol[j]])
+        {
             memArray[_vCol[j]]->deleteElements(_vLine);
+            memArray[_vCol[j]]->markModified();
+        }
     }
 
     m_meta.modify();
@@ -3954,11 +4133,18 @@ std::vector<AnovaResult> Memory::getAnova(const VectorIndex& colCategories, size
         return std::vector<AnovaResult> {res};
     }
 
+    if (colValues >= memArray.size() || !memArray[colValues])
+    {
+        AnovaResult res;
+        res.m_FRatio = NAN;
+        return std::vector<AnovaResult> {res};
+    }
+
     size_t col_size = getElemsInColumn(colValues);
 
     for (size_t i = 0; i < colCategories.size(); i++)
     {
-        if (colCategories[i] > (int)memArray.size()
+        if (colCategories[i] >= (int)memArray.size()
             || !memArray[colCategories[i]]
             || memArray[colCategories[i]]->m_type != TableColumn::TYPE_CATEGORICAL
             || (size_t)getElemsInColumn(colCategories[i]) != col_size)
@@ -3972,126 +4158,206 @@ std::vector<AnovaResult> Memory::getAnova(const VectorIndex& colCategories, size
     colCategories.setOpenEndIndex(getCols()-1);
     _vIndex.setOpenEndIndex(col_size-1);
 
-    // We need to eliminate invalid values from the index vector first
-    std::vector<int> vExpanded = _vIndex.getVector();
-    auto iter = vExpanded.begin();
+    // Extract the values and the dense category
+    // codes of all rows, which are valid in all
+    // selected columns
+    std::vector<GroupKey> factors(colCategories.size());
+    std::vector<std::string> factorNames;
+    std::vector<double> values;
+    values.reserve(_vIndex.size());
 
-    while (iter != vExpanded.end())
+    for (size_t j = 0; j < colCategories.size(); j++)
     {
-        // Any invalids in the numerical values colum n?
-        if (!memArray[colValues]->get(*iter).isValid())
-        {
-            iter = vExpanded.erase(iter);
+        factors[j].m_levels = static_cast<CategoricalColumn*>(memArray[colCategories[j]].get())->getCategories().size();
+        factors[j].m_codes.reserve(_vIndex.size());
+        factorNames.push_back(memArray[colCategories[j]]->m_sHeadLine);
+    }
+
+    std::vector<int64_t> vCodes(colCategories.size());
+
+    for (size_t i = 0; i < _vIndex.size(); i++)
+    {
+        std::complex<double> val = memArray[colValues]->getValue(_vIndex[i]);
+
+        if (mu::isnan(val))
             continue;
-        }
 
-        bool erased = false;
+        bool isValid = true;
 
-        // Any invalids in the categorical columns?
-        for (size_t i = 0; i < colCategories.size(); i++)
+        for (size_t j = 0; j < colCategories.size(); j++)
         {
-            if (!memArray[colCategories[i]]->get(*iter).isValid())
+            // Categorical columns return their one-based code
+            std::complex<double> cat = memArray[colCategories[j]]->getValue(_vIndex[i]);
+
+            if (mu::isnan(cat))
             {
-                iter = vExpanded.erase(iter);
-                erased = true;
+                isValid = false;
                 break;
             }
-        }
-
-        if (!erased)
-            iter++;
-    }
-
-    // Create a new index vector
-    VectorIndex vPrepared(vExpanded);
 
-    Memory _mem(colCategories.size()+1);
-    _mem.memArray[0].reset(memArray[colValues]->copy(vPrepared));
+            vCodes[j] = (int64_t)cat.real() - 1;
+        }
 
-    for (size_t i = 0; i < colCategories.size(); i++)
-    {
-        _mem.memArray[i+1].reset(memArray[colCategories[i]]->copy(vPrepared));
-    }
+        if (!isValid)
+            continue;
 
-    std::vector<std::vector<std::string>> factors;
+        values.push_back(val.real());
 
-    for (size_t i = 0; i < colCategories.size(); i++)
-    {
-        factors.push_back(static_cast<CategoricalColumn*>(_mem.memArray[i+1].get())->getCategories());
+        for (size_t j = 0; j < colCategories.size(); j++)
+        {
+            factors[j].m_codes.push_back(vCodes[j]);
+        }
     }
 
     AnovaCalculationStructure ft = AnovaCalculationStructure();
-    ft.buildTree(factors, &_mem, significance);
+    ft.buildTree(std::move(factors), factorNames, std::move(values), significance);
     ft.calculateResults();
     return ft.getResults();
 }
 
 
 /////////////////////////////////////////////////
-/// \brief check if value type vector is already in a vector of vectors
+/// \brief Encodes the selected rows of a column
+/// as dense level codes, which may be used as a
+/// key of a grouping operation. Codes are
+/// assigned in the order of the first occurrence
+/// of each value.
 ///
-/// \param newVector const std::vector<std::complex<double>>&
-/// \param centroids const std::vector<std::vector<std::complex<double>>>&
-/// \return bool
+/// \param col const TableColumn*
+/// \param _vIndex const VectorIndex&
+/// \return GroupKey
 ///
 /////////////////////////////////////////////////
-static bool isUnique(const std::vector<std::complex<double>>& newVector, const std::vector<std::vector<std::complex<double>>>& centroids)
+static GroupKey createGroupKey(const TableColumn* col, const VectorIndex& _vIndex)
 {
-    return std::none_of(centroids.begin(), centroids.end(),
-                        [&newVector](const std::vector<std::complex<double>>& centroid)
-                        { return newVector == centroid; });
-}
+    GroupKey key;
+    key.m_codes.resize(_vIndex.size(), -1);
 
+    if (col->m_type == TableColumn::TYPE_CATEGORICAL)
+    {
+        // Categorical columns are already encoded
+        key.m_levels = static_cast<const CategoricalColumn*>(col)->getCategories().size();
 
-/////////////////////////////////////////////////
-/// \brief Calculate L2 Norm of 2 given value type vectors
-///
-/// \param vec1 const std::vector<std::complex<double>>&
-/// \param vec2 const std::vector<std::complex<double>>&
-/// \return double
-///
-/////////////////////////////////////////////////
-static double calculateL2Norm(const std::vector<std::complex<double>>& vec1, const std::vector<std::complex<double>>& vec2)
-{
-    // for norm of omplex => z * conj(z)
-    // conjugate a complex number z = a + bi -> z* = a - bi
+        #pragma omp parallel for
+        for (size_t i = 0; i < _vIndex.size(); i++)
+        {
+            std::complex<double> cat = col->getValue(_vIndex[i]);
 
-    std::complex<double> sum = 0.0;
-    for (size_t i = 0; i < vec1.size(); ++i)
+            if (!mu::isnan(cat))
+                key.m_codes[i] = (int64_t)cat.real() - 1;
+        }
+    }
+    else if (TableColumn::isValueType(col->m_type)
+             || col->m_type == TableColumn::TYPE_DATETIME
+             || col->m_type == TableColumn::TYPE_LOGICAL)
     {
-        sum += (vec1[i] - vec2[i]) * (conj(vec1[i] - vec2[i]));
+        std::map<std::pair<double,double>, int64_t> mLevels;
+
+        for (size_t i = 0; i < _vIndex.size(); i++)
+        {
+            std::complex<double> val = col->getValue(_vIndex[i]);
+
+            if (mu::isnan(val))
+                continue;
+
+            key.m_codes[i] = mLevels.emplace(std::make_pair(val.real(), val.imag()), mLevels.size()).first->second;
+        }
+
+        key.m_levels = mLevels.size();
     }
+    else
+    {
+        std::unordered_map<std::string, int64_t> mLevels;
 
-    // no need for sqrt in our case
-    return sum.real();
+        for (size_t i = 0; i < _vIndex.size(); i++)
+        {
+            if (!col->isValid(_vIndex[i]))
+                continue;
+
+            key.m_codes[i] = mLevels.emplace(col->getValueAsInternalString(_vIndex[i]), mLevels.size()).first->second;
+        }
+
+        key.m_levels = mLevels.size();
+    }
+
+    return key;
 }
 
 
 /////////////////////////////////////////////////
-/// \brief get all Indices of elements with given value
+/// \brief Groups the selected rows by the
+/// combination of the values in the key columns
+/// and calculates the statistics of the values
+/// column for all groups simultaneously. Rows
+/// with invalid keys are ignored.
 ///
-/// \param vec const std::vector<std::complex<double>>&
-/// \param value std::complex<double>
-/// \return std::vector<int>
+/// \param colKeys const VectorIndex&
+/// \param colValues size_t
+/// \param _vIndex const VectorIndex&
+/// \return GroupStatsResult
 ///
 /////////////////////////////////////////////////
-static std::vector<int> findIndicesOfValue(const std::vector<std::complex<double>>& vec, std::complex<double> value)
+GroupStatsResult Memory::getGroupStatistics(const VectorIndex& colKeys, size_t colValues, const VectorIndex& _vIndex) const
 {
-    std::vector<int> indices;
-    auto it = vec.begin();
+    if (colValues >= memArray.size() || !memArray[colValues] || !isValueLike(VectorIndex(colValues)))
+        return GroupStatsResult();
+
+    colKeys.setOpenEndIndex(getCols()-1);
+    _vIndex.setOpenEndIndex(getElemsInColumn(colValues)-1);
 
-    while ((it = std::find(it, vec.end(), value)) != vec.end())
+    std::vector<GroupKey> keys;
+    std::vector<const GroupKey*> keyRefs;
+
+    for (size_t j = 0; j < colKeys.size(); j++)
     {
-        indices.push_back(std::distance(vec.begin(), it));
-        ++it;  // Move past the last found element
+        if (colKeys[j] >= (int)memArray.size() || !memArray[colKeys[j]])
+            return GroupStatsResult();
+
+        keys.push_back(createGroupKey(memArray[colKeys[j]].get(), _vIndex));
     }
 
-    return indices;
+    for (const GroupKey& key : keys)
+    {
+        keyRefs.push_back(&key);
+    }
+
+    std::vector<double> values(_vIndex.size());
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < _vIndex.size(); i++)
+    {
+        values[i] = memArray[colValues]->getValue(_vIndex[i]).real();
+    }
+
+    GroupBy groups(keyRefs);
+
+    GroupStatsResult res;
+    res.stats = groups.aggregate(values);
+
+    // Use the key values of the first row of each group
+    // as its name
+    for (size_t g = 0; g < groups.size(); g++)
+    {
+        size_t row = _vIndex[groups.getFirstRow(g)];
+        std::string sName;
+
+        for (size_t j = 0; j < colKeys.size(); j++)
+        {
+            if (j)
+                sName += ", ";
+
+            sName += memArray[colKeys[j]]->getValueAsInternalString(row);
+        }
+
+        res.names.push_back(sName);
+    }
+
+    return res;
 }
 
 
 /////////////////////////////////////////////////
-/// \brief parse string to KmeansInit enum
+/// \brief Parse string to KmeansInit enum.
 ///
 /// \param init_type const std::string&
 /// \return Memory::KmeansInit
@@ -4107,150 +4373,123 @@ Memory::KmeansInit Memory::stringToKmeansInit(const std::string& init_type)
     return INVALID;
 }
 
+
 /////////////////////////////////////////////////
-/// \brief calculate kmeans
+/// \brief Calculate the k-means clustering of
+/// the selected columns. The columns are
+/// extracted once into a contiguous matrix
+/// (complex columns contribute their real and
+/// imaginary parts as separate dimensions) and
+/// clustered by the k-means engine. Rows
+/// containing invalid values get an invalid
+/// label.
 ///
 /// \param columns const VectorIndex&
 /// \param nClusters size_t
 /// \param maxIterations size_t
 /// \param init_method Memory::KmeansInit
+/// \param nInit size_t
+/// \param batchSize size_t
 /// \return KMeansResult
 ///
 /////////////////////////////////////////////////
-KMeansResult Memory::getKMeans(const VectorIndex& columns, size_t nClusters, size_t maxIterations, Memory::KmeansInit init_method) const
+KMeansResult Memory::getKMeans(const VectorIndex& columns, size_t nClusters, size_t maxIterations, Memory::KmeansInit init_method, size_t nInit, size_t batchSize) const
 {
-    for(size_t i = 0; i < columns.size(); i++)
+    for (size_t i = 0; i < columns.size(); i++)
     {
-        if ((int)memArray.size() <= columns[0] || !memArray[columns[0]]                // check if column does have data
+        if ((int)memArray.size() <= columns[i] || !memArray[columns[i]]                // check if column does have data
             || getElemsInColumn(columns[0]) != getElemsInColumn(columns[i]))      // All columns should have same size
             return KMeansResult();
     }
 
     size_t col_size = getElemsInColumn(columns[0]);
+
     if (col_size < nClusters || !isValueLike(columns))
         return KMeansResult();
 
-    std::vector<std::complex<double>> clusters(col_size, 0);
-    std::vector<std::vector<std::complex<double>>> centroids;
+    // Complex-valued columns need two dimensions
+    std::vector<size_t> vColOffset(columns.size());
+    std::vector<bool> vIsComplex(columns.size());
+    size_t dims = 0;
 
-    // Random generator
-    std::mt19937& mt = getRandGenInstance();
-    // Step 1 Initialization: Calculate starting centroids
-    if (init_method == INIT_KMEANSPP)
+    for (size_t j = 0; j < columns.size(); j++)
     {
-        // Run KMeans ++ init
-        // https://www.geeksforgeeks.org/ml-k-means-algorithm/
+        vColOffset[j] = dims;
+        vIsComplex[j] = memArray[columns[j]]->m_type == TableColumn::TYPE_VALUE_CF32
+            || memArray[columns[j]]->m_type == TableColumn::TYPE_VALUE_CF64;
+        dims += vIsComplex[j] ? 2 : 1;
+    }
 
-        // K++ Step 1: randomly select first centroid
-        size_t randinit = mt()%col_size;
-        std::vector<std::complex<double>> new_value = readMem(VectorIndex(randinit), columns).as_cmplx_vector();
-        centroids.push_back(new_value);
+    // Extract the observations as row-major matrix
+    std::vector<double> vValues(col_size*dims);
+    std::vector<char> vIsValid(col_size, true);
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < col_size; i++)
+    {
+        double* row = &vValues[i*dims];
 
-        for(size_t i = 1; i < nClusters; i++)
+        for (size_t j = 0; j < columns.size(); j++)
         {
-            // K++ Step 2: calculate distance to nearest centroid
-            std::vector<double> distance_vec;
-            for(size_t i = 0; i < col_size; i++)
+            std::complex<double> val = memArray[columns[j]]->getValue(i);
+
+            if (mu::isnan(val))
             {
-                std::vector<std::complex<double>> value = readMem(VectorIndex(i), columns).as_cmplx_vector();
-                double dis = calculateL2Norm(value, centroids[0]);
-                size_t idx = 0;
-                for(size_t j = 1; j < centroids.size(); j++)
-                {
-                    double dis2 = calculateL2Norm(value, centroids[j]);
-                    if(dis2 < dis)
-                    {
-                        dis = dis2;
-                        idx = j;
-                    }
-                }
-                distance_vec.push_back(dis);
-                if(clusters[i] != std::complex<double>(idx))
-                {
-                    clusters[i] = idx;
-                }
+                vIsValid[i] = false;
+                break;
             }
 
-            // K++ Step 3: add new centroid at point with highest distance to nearest neighbour
-            size_t max_elem_idx = std::distance(distance_vec.begin(), std::max_element(distance_vec.begin(), distance_vec.end()));
-            std::vector<std::complex<double>> new_value = readMem(VectorIndex(max_elem_idx), columns).as_cmplx_vector();
-            centroids.push_back(new_value);
+            row[vColOffset[j]] = val.real();
+
+            if (vIsComplex[j])
+                row[vColOffset[j]+1] = val.imag();
         }
     }
-    else if (init_method == INIT_RANDOM || init_method == INVALID)
+
+    // Compact the matrix by removing the invalid rows
+    KMeansData data;
+    data.m_dims = dims;
+    data.m_rowMap.reserve(col_size);
+
+    for (size_t i = 0; i < col_size; i++)
     {
-        // Run standard Init: Random Seeds
-        for(size_t i = 0; i < nClusters; )
-        {
-            size_t randinit = mt()%col_size;
-            std::vector<std::complex<double>> new_value = readMem(VectorIndex(randinit), columns).as_cmplx_vector();
-            if(isUnique(new_value, centroids))
-            {
-                centroids.push_back(new_value);
-                i++;
-            }
-        }
+        if (!vIsValid[i])
+            continue;
+
+        if (data.m_rowMap.size() != i)
+            std::copy(vValues.begin()+i*dims, vValues.begin()+(i+1)*dims, vValues.begin()+data.m_rowMap.size()*dims);
+
+        data.m_rowMap.push_back(i);
     }
 
-    long double inertia = 0;
-    for(size_t iteration = 0; iteration < maxIterations; iteration++)
-    {
-        // Step 2 assign points to closest Cluster centroid
-        size_t change = 0;
-        inertia = 0;
-        for(size_t i = 0; i < col_size; i++)
-        {
-            std::vector<std::complex<double>> value = readMem(VectorIndex(i), columns).as_cmplx_vector();
-            double min_distance = calculateL2Norm(value, centroids[0]);
-            size_t idx = 0;
-            for(size_t j = 1; j < nClusters; j++)
-            {
-                double curr_distance = calculateL2Norm(value, centroids[j]);
-                if(curr_distance < min_distance)
-                {
-                    min_distance = curr_distance;
-                    idx = j;
-                }
-            }
+    vValues.resize(data.m_rowMap.size()*dims);
+    data.m_values.swap(vValues);
 
-            idx++;
-            if(clusters[i] != std::complex<double>(idx))
-            {
-                clusters[i] = idx;
-                change++;
-            }
+    KMeansSettings settings;
+    settings.nClusters = nClusters;
+    settings.maxIterations = maxIterations;
+    settings.nInit = nInit;
+    settings.batchSize = batchSize;
+    settings.initKMeansPP = init_method == INIT_KMEANSPP;
 
-            inertia += intPower(min_distance,2);
-        }
+    CounterRandGen gen(getRandSeed(), reserveRandStream(), 0);
+    settings.seed = gen();
+    settings.seed = (settings.seed << 32) | gen();
 
-        // stop criteria: all points remain in same cluster
-        if(change == 0)
-            break;
+    KMeansClustering clustering = calculateKMeans(data, settings);
 
-        // Step 3 calculate new clusters
-        change = 0;
-        for(size_t i = 0; i < nClusters; i++)
-        {
-            VectorIndex indices(findIndicesOfValue(clusters, std::complex<double>(i+1)));
-            for(size_t elemIdx = 0; elemIdx < columns.size(); elemIdx++)
-            {
-                std::complex<double> new_val = avg(indices, VectorIndex(elemIdx));
-                if(!closeEnough(centroids[i][elemIdx], new_val))
-                {
-                    centroids[i][elemIdx] = new_val;
-                    change++;
-                }
-            }
-        }
+    if (!clustering.isValid())
+        return KMeansResult();
 
-        // stop criteria: all centroids stay same
-        if(change == 0)
-            break;
+    KMeansResult res;
+    res.cluster_labels.assign(col_size, NAN);
+
+    for (size_t i = 0; i < data.m_rowMap.size(); i++)
+    {
+        res.cluster_labels[data.m_rowMap[i]] = clustering.m_labels[i]+1;
     }
 
-    KMeansResult res;
-    res.cluster_labels = clusters;
-    res.inertia = inertia;
+    res.inertia = clustering.m_inertia;
     return res;
 }
 
@@ -4782,7 +5021,7 @@ bool Memory::retouch2D(const VectorIndex& _vLine, const VectorIndex& _vCol)
     }
 
     if (bMarkModified)
-        m_meta.modify();
+        markModified();
 
     return true;
 }
@@ -5174,7 +5413,7 @@ bool Memory::smooth(VectorIndex _vLine, VectorIndex _vCol, NumeRe::FilterSetting
         }
     }
 
-    m_meta.modify();
+    markModified();
     return true;
 }
 
@@ -5403,7 +5642,7 @@ bool Memory::resample(VectorIndex _vLine, VectorIndex _vCol, std::pair<size_t,si
 
     // Reset the calculated lines and columns
     nCalcLines = -1;
-    m_meta.modify();
+    markModified();
 
     return true;
 }
@@ -24,11 +24,16 @@
 #include "tablecolumn.hpp"
 #include "../maths/filtering.hpp"
 #include "../maths/anovaimpl.hpp"
+#include "../maths/groupby.hpp"
 #include "../maths/units.hpp"
 
 #ifndef MEMORY_HPP
 #define MEMORY_HPP
 
+// Minimal capacity of the columns, which are
+// filled by Memory::appendRows()
+#define APPENDROWS_MINCAPACITY 4096
+
 // forward declaration for using the memory manager as friend
 class MemoryManager;
 class Matrix;
@@ -53,6 +58,17 @@ struct KMeansResult
     long double inertia;
 };
 
+/////////////////////////////////////////////////
+/// \brief Contains the aggregated statistics of
+/// all groups together with the names of the
+/// groups (combined from their key values).
+/////////////////////////////////////////////////
+struct GroupStatsResult
+{
+    std::vector<std::string> names;
+    GroupStatistics stats;
+};
+
 /////////////////////////////////////////////////
 /// \brief This class represents a single table
 /// in memory, or a - so to say - single memory
@@ -87,8 +103,6 @@ class Memory : public Sorter
 	private:
 	    friend class MemoryManager;
 	    friend class NumeRe::FileAdapter;
-        friend AnovaCalculationStructure;
-        friend FactorNode;
 
 		NumeRe::TableMetaData m_meta;
 
@@ -160,7 +174,9 @@ class Memory : public Sorter
 		void writeData(int _nLine, int _nCol, const mu::Value& _dData, TableColumn::ColumnType type = TableColumn::TYPE_NONE);
 		void writeDataDirect(int _nLine, int _nCol, const std::complex<double>& _dData);
 		void writeDataDirectUnsafe(int _nLine, int _nCol, const std::complex<double>& _dData);
+		void writeDataBlock(int _nLine, int _nCol, const float* data, size_t nElems, size_t stride = 1);
 		void writeData(Indices& _idx, const mu::Array& _values);
+		void appendRows(const std::vector<mu::Array>& vColumns);
 		bool setHeadLineElement(size_t _i, const std::string& _sHead);
 		bool setUnit(int nCol, const std::string& sUnit);
 		std::vector<std::string> toSiUnits(const VectorIndex& _vCols, UnitConversionMode mode);
@@ -229,10 +245,11 @@ class Memory : public Sorter
         bool resample(VectorIndex _vLine, VectorIndex _vCol, std::pair<size_t,size_t> samples, AppDir Direction = ALL, std::string sFilter = "lanczos3");
 
         std::vector<AnovaResult> getAnova(const VectorIndex& colCategories, size_t colValues, const VectorIndex& _vIndex, double significance) const;
+        GroupStatsResult getGroupStatistics(const VectorIndex& colKeys, size_t colValues, const VectorIndex& _vIndex) const;
 
 
         static KmeansInit stringToKmeansInit(const std::string& init_type);
-        KMeansResult getKMeans(const VectorIndex& colCategories, size_t nClusters, size_t maxIterations, Memory::KmeansInit init_method) const;
+        KMeansResult getKMeans(const VectorIndex& columns, size_t nClusters, size_t maxIterations, Memory::KmeansInit init_method, size_t nInit, size_t batchSize) const;
 };
 
 #endif
@@ -94,6 +94,8 @@ struct WindowSet
 MemoryManager::MemoryManager() : NumeRe::FileAdapter(), NumeRe::ClusterManager()
 {
 	bSaveMutex = false;
+	nCacheFileSize = 0;
+	cacheWriteFailed = false;
 	sCache_file = "<>/numere.cache";
 	sPredefinedFuncs = "";
 	sUserdefinedFuncs = "";
@@ -115,6 +117,8 @@ MemoryManager::MemoryManager() : NumeRe::FileAdapter(), NumeRe::ClusterManager()
 /////////////////////////////////////////////////
 MemoryManager::~MemoryManager()
 {
+    waitForCacheWriter();
+
     if (cache_file.is_open())
         cache_file.close();
 
@@ -228,6 +232,11 @@ VectorIndex MemoryManager::arrayToIndex(const mu::Array& arr, const std::string&
 /////////////////////////////////////////////////
 bool MemoryManager::getSaveStatus() const
 {
+    // A failed background write invalidates the
+    // save status of all tables
+    if (cacheWriteFailed)
+        return false;
+
     if (!vMemory.size())
         return true;
 
@@ -381,61 +390,162 @@ void MemoryManager::setCacheFileName(string _sFileName)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Waits until a running background write
+/// of the cache file has been finished.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void MemoryManager::waitForCacheWriter()
+{
+    if (cacheWriter.joinable())
+        cacheWriter.join();
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This member function saves the
 /// contents of this class to the cache file so
 /// that they may be restored after a restart.
+/// Only the columns, which have been modified
+/// since the last save, are written. All other
+/// columns refer to their already existing
+/// blocks in the cache file. The cache file is
+/// rewritten completely, if it contains too many
+/// unused blocks. The snapshot of the modified
+/// columns is taken immediately, the file may be
+/// written in the background.
 ///
+/// \param inBackground bool
 /// \return bool
 ///
 /////////////////////////////////////////////////
-bool MemoryManager::saveToCacheFile()
+bool MemoryManager::saveToCacheFile(bool inBackground)
 {
     if (bSaveMutex)
         return false;
 
+    waitForCacheWriter();
+
     bSaveMutex = true;
 
     sCache_file = ValidFileName(sCache_file, ".cache");
-    std::string sTempFile = sCache_file + ".temp";
-    bool success = true;
 
-    // Write the data to a temporary file first
-    if (sCache_file.length())
+    if (!sCache_file.length())
     {
-        NumeRe::CacheFile cacheFile(sTempFile);
+        bSaveMutex = false;
+        return false;
+    }
 
-        cacheFile.setNumberOfTables(mCachesMap.size() - isTable("data"));
-        cacheFile.writeCacheHeader();
+    std::vector<NumeRe::CacheTable> vSnapshot;
+    uint64_t nLiveBytes = 0;
 
-        int nLines;
-        int nCols;
+    // Create the snapshot of the tables. Columns,
+    // which are already part of the cache file,
+    // only refer to their blocks
+    for (auto iter = mCachesMap.begin(); iter != mCachesMap.end(); ++iter)
+    {
+        if (iter->first == "data")
+            continue;
 
-        for (auto iter = mCachesMap.begin(); iter != mCachesMap.end(); ++iter)
+        Memory* _mem = vMemory[iter->second.first];
+        vSnapshot.push_back(NumeRe::CacheTable());
+        NumeRe::CacheTable& table = vSnapshot.back();
+
+        table.name = iter->first;
+        table.comment = _mem->m_meta.comment;
+        table.rows = _mem->getLines(false);
+        table.cols = _mem->getCols(false);
+        table.blocks.resize(table.cols);
+        table.columns.resize(table.cols);
+
+        for (int64_t j = 0; j < table.cols; j++)
         {
-            if (iter->first == "data")
+            if (!_mem->memArray[j])
                 continue;
 
-            nLines = vMemory[iter->second.first]->getLines(false);
-            nCols = vMemory[iter->second.first]->getCols(false);
-
-            cacheFile.setDimensions(nLines, nCols);
-            cacheFile.setData(&vMemory[iter->second.first]->memArray, nLines, nCols);
-            cacheFile.setTableName(iter->first);
-            cacheFile.setComment(vMemory[iter->second.first]->m_meta.comment);
+            table.blocks[j].revision = _mem->memArray[j]->getRevision();
+            auto found = mCacheIndex.find(table.blocks[j].revision);
 
-            success = success && cacheFile.write();
+            if (found != mCacheIndex.end())
+            {
+                table.blocks[j] = found->second;
+                nLiveBytes += found->second.length;
+            }
+            else
+                table.columns[j].reset(_mem->memArray[j]->copy());
         }
     }
 
-    // If the file has been written successfully, move it to the
-    // actual file name
-    if (success)
-        moveFile(sTempFile, sCache_file);
+    // Rewrite the whole file, if there is no valid
+    // index or too many unused blocks
+    bool bRewrite = !mCacheIndex.size()
+        || nCacheFileSize > 2*nLiveBytes + CACHE_COMPACTION_LIMIT;
 
+    cacheWriteFailed = false;
     setSaveStatus(true);
     bSaveMutex = false;
-    return true;
+
+    std::string sCacheFile = sCache_file;
+
+    auto writeTask = [this, sCacheFile, bRewrite](std::vector<NumeRe::CacheTable>&& vTables)
+    {
+        try
+        {
+            if (bRewrite)
+            {
+                // Write the data to a temporary file first
+                // and move it to the actual file name
+                // afterwards
+                std::string sTempFile = sCacheFile + ".temp";
+
+                {
+                    NumeRe::CacheFile cacheFile(sTempFile);
+                    cacheFile.writeIncremental(vTables, sCacheFile);
+                }
+
+                moveFile(sTempFile, sCacheFile);
+            }
+            else
+            {
+                NumeRe::CacheFile cacheFile(sCacheFile);
+                cacheFile.writeIncremental(vTables, "");
+            }
+
+            // Update the index of the blocks in the
+            // cache file
+            mCacheIndex.clear();
+
+            for (const NumeRe::CacheTable& table : vTables)
+            {
+                for (const NumeRe::CacheBlock& block : table.blocks)
+                {
+                    if (block.length)
+                        mCacheIndex[block.revision] = block;
+                }
+            }
+
+            std::ifstream cacheFile(sCacheFile, std::ios::binary | std::ios::ate);
+            nCacheFileSize = cacheFile.good() ? (uint64_t)cacheFile.tellg() : 0;
+        }
+        catch (...)
+        {
+            // Force a complete rewrite during the next
+            // save
+            mCacheIndex.clear();
+            cacheWriteFailed = true;
+        }
+    };
+
+    if (inBackground)
+    {
+        cacheWriter = std::thread(writeTask, std::move(vSnapshot));
+        return true;
+    }
+
+    writeTask(std::move(vSnapshot));
+    return !cacheWriteFailed;
 }
 
 
@@ -453,6 +563,8 @@ bool MemoryManager::loadFromCacheFile()
     if (bSaveMutex)
         return false;
 
+    waitForCacheWriter();
+
     bSaveMutex = true;
     sCache_file = ValidFileName(sCache_file, ".cache");
 
@@ -486,6 +598,7 @@ bool MemoryManager::loadFromNewCacheFile()
 
         vMemory.clear();
         mCachesMap.clear();
+        mCacheIndex.clear();
 
         for (size_t i = 0; i < nCaches; i++)
         {
@@ -495,10 +608,30 @@ bool MemoryManager::loadFromNewCacheFile()
             vMemory.push_back(new Memory());
 
             vMemory.back()->resizeMemory(cacheFile.getRows(), cacheFile.getCols());
-            cacheFile.getData(&vMemory.back()->memArray);
+            cacheFile.moveData(&vMemory.back()->memArray);
 
             if (cacheFile.getComment() != "NO COMMENT")
                 vMemory.back()->m_meta.comment = cacheFile.getComment();
+
+            // Connect the loaded columns with their
+            // blocks in the incremental cache file
+            std::vector<NumeRe::CacheBlock> vBlocks = cacheFile.getBlocks();
+            TableColumnArray& memArray = vMemory.back()->memArray;
+
+            for (size_t j = 0; j < vBlocks.size() && j < memArray.size(); j++)
+            {
+                if (memArray[j] && vBlocks[j].length)
+                {
+                    vBlocks[j].revision = memArray[j]->getRevision();
+                    mCacheIndex[vBlocks[j].revision] = vBlocks[j];
+                }
+            }
+        }
+
+        if (cacheFile.isIncrementalFile())
+        {
+            std::ifstream cacheFileSize(sCache_file, std::ios::binary | std::ios::ate);
+            nCacheFileSize = cacheFileSize.good() ? (uint64_t)cacheFileSize.tellg() : 0;
         }
 
         if (mCachesMap.find("table") == mCachesMap.end())
@@ -774,6 +907,9 @@ void MemoryManager::overwriteColumn(int col, const std::string& _sCache, TableCo
         return;
 
     convert_for_overwrite(vMemory[findTable(_sCache)]->memArray[col], col, type);
+
+    if (vMemory[findTable(_sCache)]->memArray[col])
+        vMemory[findTable(_sCache)]->memArray[col]->markModified();
 }
 
 
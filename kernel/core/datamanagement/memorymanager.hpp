@@ -20,6 +20,9 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <map>
+#include <thread>
+#include <atomic>
 
 #include "../ui/error.hpp"
 #include "../settings.hpp"
@@ -33,6 +36,10 @@
 #ifndef MEMORYMANAGER_HPP
 #define MEMORYMANAGER_HPP
 
+// Number of unused bytes in the cache file, which
+// are tolerated before the file is compacted
+#define CACHE_COMPACTION_LIMIT (1 << 24)
+
 
 /////////////////////////////////////////////////
 /// \brief This class represents the central
@@ -52,10 +59,15 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
 		std::string sUserdefinedFuncs;
 		std::string sPredefinedCommands;
 		std::string sPluginCommands;
+		std::map<uint64_t, NumeRe::CacheBlock> mCacheIndex;
+		uint64_t nCacheFileSize;
+		std::thread cacheWriter;
+		std::atomic<bool> cacheWriteFailed;
 
 		void reorderColumn(size_t _nLayer, const std::vector<int>& vIndex, long long int i1, long long int i2, long long int j1 = 0);
 		bool loadFromNewCacheFile();
 		bool loadFromLegacyCacheFile();
+		void waitForCacheWriter();
 		VectorIndex parseEveryCell(std::string& sDir, const std::string& sType, const std::string& sTableName) const;
         std::vector<std::complex<double>> resolveMAF(const std::string& sTableName, std::string sDir, std::complex<double> (MemoryManager::*MAF)(const std::string&, const VectorIndex&, const VectorIndex&) const) const;
 
@@ -259,7 +271,7 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
 		void setSaveStatus(bool _bIsSaved);
 		long long int getLastSaved() const;
 		void setCacheFileName(std::string _sFileName);
-		bool saveToCacheFile();
+		bool saveToCacheFile(bool inBackground = false);
 		bool loadFromCacheFile();
 
         inline size_t getNumberOfTables() const
@@ -430,10 +442,15 @@ class MemoryManager : public NumeRe::FileAdapter, public NumeRe::ClusterManager
             return vMemory[findTable(sTable)]->getAnova(colCategories, colValues, _vIndex, significance);
         }
 
-        KMeansResult getKMeans(const std::string& sTable, const VectorIndex& cols, size_t nClusters, size_t maxIterations, Memory::KmeansInit init_method) const
+        GroupStatsResult getGroupStatistics(const std::string& sTable, const VectorIndex& colKeys, size_t colValues, const VectorIndex& _vIndex) const
         {
+            return vMemory[findTable(sTable)]->getGroupStatistics(colKeys, colValues, _vIndex);
+        }
 
-            return vMemory[findTable(sTable)]->getKMeans(cols, nClusters, maxIterations, init_method);
+        KMeansResult getKMeans(const std::string& sTable, const VectorIndex& cols, size_t nClusters, size_t maxIterations,
+                               Memory::KmeansInit init_method, size_t nInit, size_t batchSize) const
+        {
+            return vMemory[findTable(sTable)]->getKMeans(cols, nClusters, maxIterations, init_method, nInit, batchSize);
         }
 
         double getCovariance(const std::string& sTable,
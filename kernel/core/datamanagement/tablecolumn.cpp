@@ -20,8 +20,14 @@
 #include "../ui/language.hpp"
 #include "../utils/tools.hpp"
 
+#include <atomic>
+
 extern Language _lang;
 
+/// The global revision counter of all table
+/// columns. Every revision is unique
+static std::atomic<uint64_t> columnRevision(0);
+
 
 /////////////////////////////////////////////////
 /// \brief Return the table column's contents as
@@ -418,3 +424,38 @@ bool TableColumn::isValueType(TableColumn::ColumnType type)
     return type > TableColumn::VALUELIKE && type < TableColumn::VALUE_LAST;
 }
 
+
+/////////////////////////////////////////////////
+/// \brief Returns the current revision of this
+/// column. If the column has been modified since
+/// the last request, a new revision is assigned
+/// first. Two columns with identical revisions
+/// share the same contents.
+///
+/// \return uint64_t
+///
+/////////////////////////////////////////////////
+uint64_t TableColumn::getRevision()
+{
+    if (m_isModified)
+    {
+        m_revision = getNewRevision();
+        m_isModified = false;
+    }
+
+    return m_revision;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns a new and unique column
+/// revision.
+///
+/// \return uint64_t
+///
+/////////////////////////////////////////////////
+uint64_t TableColumn::getNewRevision()
+{
+    return ++columnRevision;
+}
+
@@ -24,6 +24,7 @@
 #include <memory>
 #include "../ParserLib/muParserDef.h"
 #include "../structures.hpp"
+#include "../utils/kernelstats.hpp"
 
 /////////////////////////////////////////////////
 /// \brief Abstract table column, which allows
@@ -61,10 +62,30 @@ struct TableColumn
     std::string m_sHeadLine;
     std::string m_sUnit;
     ColumnType m_type;
+    uint64_t m_revision;
+    bool m_isModified;
 
-    TableColumn() : m_type(TYPE_NONE) {}
+    TableColumn() : m_type(TYPE_NONE), m_revision(getNewRevision()), m_isModified(false)
+    {
+        g_kernelStats.count(KC_COLUMN_ALLOCATIONS);
+    }
     virtual ~TableColumn() {}
 
+    /////////////////////////////////////////////////
+    /// \brief Mark this column as modified. The
+    /// revision will be updated, once it is
+    /// requested the next time.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void markModified()
+    {
+        m_isModified = true;
+    }
+
+    uint64_t getRevision();
+
     std::vector<std::string> getValueAsString(const VectorIndex& idx) const;
     std::vector<std::string> getValueAsInternalString(const VectorIndex& idx) const;
     std::vector<std::complex<double>> getValue(const VectorIndex& idx) const;
@@ -98,6 +119,7 @@ struct TableColumn
     virtual void appendElements(size_t elem) = 0;
     virtual void removeElements(size_t pos, size_t elem) = 0;
     virtual void resize(size_t elem) = 0;
+    virtual void reserve(size_t elem) = 0;
 
     virtual int compare(int i, int j, bool flag) const = 0;
     virtual bool isValid(int elem) const = 0;
@@ -115,6 +137,7 @@ struct TableColumn
     static ColumnType stringToType(const std::string& sType);
     static std::vector<std::string> getTypesAsString();
     static bool isValueType(ColumnType type);
+    static uint64_t getNewRevision();
 };
 
 
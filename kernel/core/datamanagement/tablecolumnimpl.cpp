@@ -417,6 +417,21 @@ void DateTimeColumn::resize(size_t elem)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Reserves capacity for the selected
+/// number of elements without changing the
+/// size of the column.
+///
+/// \param elem size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void DateTimeColumn::reserve(size_t elem)
+{
+    m_data.reserve(elem);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Returns 0, if both elements are equal,
 /// -1 if element i is smaller than element j and
@@ -849,6 +864,21 @@ void LogicalColumn::resize(size_t elem)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Reserves capacity for the selected
+/// number of elements without changing the
+/// size of the column.
+///
+/// \param elem size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void LogicalColumn::reserve(size_t elem)
+{
+    m_data.reserve(elem);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Returns 0, if both elements are equal,
 /// -1 if element i is smaller than element j and
@@ -1283,6 +1313,21 @@ void StringColumn::resize(size_t elem)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Reserves capacity for the selected
+/// number of elements without changing the
+/// size of the column.
+///
+/// \param elem size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void StringColumn::reserve(size_t elem)
+{
+    m_data.reserve(elem);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Returns 0, if both elements are equal,
 /// -1 if element i is smaller than element j and
@@ -1820,6 +1865,21 @@ void CategoricalColumn::resize(size_t elem)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Reserves capacity for the selected
+/// number of elements without changing the
+/// size of the column.
+///
+/// \param elem size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void CategoricalColumn::reserve(size_t elem)
+{
+    m_data.reserve(elem);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Returns 0, if both elements are equal,
 /// -1 if element i is smaller than element j and
@@ -2309,7 +2369,10 @@ bool convert_if_needed(TblColPtr& col, size_t colNo, TableColumn::ColumnType typ
         return false;
 
     if (convertedCol != col.get())
+    {
         col.reset(convertedCol);
+        g_kernelStats.count(KC_COLUMN_CONVERSIONS);
+    }
 
     return true;
 }
@@ -2341,6 +2404,8 @@ void convert_for_overwrite(TblColPtr& col, size_t colNo, TableColumn::ColumnType
     else if (promoted == TableColumn::TYPE_NONE)
         promoted = type;
 
+    g_kernelStats.count(KC_COLUMN_CONVERSIONS);
+
     std::string sHeadLine = col->m_sHeadLine;
     std::string sUnit = col->m_sUnit;
 
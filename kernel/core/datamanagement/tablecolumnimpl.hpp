@@ -311,6 +311,20 @@ class GenericValueColumn : public TableColumn
             m_numElements = std::min(m_numElements, elem);
         }
 
+        /////////////////////////////////////////////////
+        /// \brief Reserves capacity for the selected
+        /// number of elements without changing the
+        /// size of the column.
+        ///
+        /// \param elem size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        virtual void reserve(size_t elem) override
+        {
+            m_data.reserve(elem);
+        }
+
         /////////////////////////////////////////////////
         /// \brief Returns true, if the selected element
         /// is a valid value.
@@ -421,6 +435,39 @@ class GenericValueColumn : public TableColumn
             return col;
         }
 
+        /////////////////////////////////////////////////
+        /// \brief Writes a block of consecutive values
+        /// directly into the internal buffer starting at
+        /// the selected position. The values are read
+        /// from the passed buffer using the passed
+        /// stride. The column is enlarged, if necessary.
+        ///
+        /// \param pos size_t
+        /// \param data const V*
+        /// \param nElems size_t
+        /// \param stride size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        template <class V>
+        void setBlock(size_t pos, const V* data, size_t nElems, size_t stride = 1)
+        {
+            if (!nElems)
+                return;
+
+            if (pos + nElems > m_data.size())
+                m_data.resize(pos + nElems, INVALID_VALUE);
+
+            T* target = m_data.data() + pos;
+
+            for (size_t i = 0; i < nElems; i++)
+            {
+                target[i] = data[i*stride];
+            }
+
+            m_numElements = std::max(m_numElements, pos + nElems);
+        }
+
         /////////////////////////////////////////////////
         /// \brief Return the number of bytes occupied by
         /// this column.
@@ -908,6 +955,7 @@ class DateTimeColumn : public TableColumn
         virtual void appendElements(size_t elem) override;
         virtual void removeElements(size_t pos, size_t elem) override;
         virtual void resize(size_t elem) override;
+        virtual void reserve(size_t elem) override;
 
         virtual int compare(int i, int j, bool unused) const override;
         virtual bool isValid(int elem) const override;
@@ -1001,6 +1049,7 @@ class LogicalColumn : public TableColumn
         virtual void appendElements(size_t elem) override;
         virtual void removeElements(size_t pos, size_t elem) override;
         virtual void resize(size_t elem) override;
+        virtual void reserve(size_t elem) override;
 
         virtual int compare(int i, int j, bool unused) const override;
         virtual bool isValid(int elem) const override;
@@ -1087,6 +1136,7 @@ class StringColumn : public TableColumn
         virtual void appendElements(size_t elem);
         virtual void removeElements(size_t pos, size_t elem);
         virtual void resize(size_t elem) override;
+        virtual void reserve(size_t elem) override;
 
         virtual int compare(int i, int j, bool caseinsensitive) const override;
         virtual bool isValid(int elem) const override;
@@ -1166,6 +1216,7 @@ class CategoricalColumn : public TableColumn
         virtual void appendElements(size_t elem);
         virtual void removeElements(size_t pos, size_t elem);
         virtual void resize(size_t elem) override;
+        virtual void reserve(size_t elem) override;
 
         virtual int compare(int i, int j, bool caseinsensitive) const override;
         virtual bool isValid(int elem) const override;
@@ -0,0 +1,406 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "profiler.hpp"
+#include "../../kernel.hpp"
+#include "../utils/tools.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function to format a
+/// duration in nanoseconds as milliseconds.
+///
+/// \param nDuration int64_t
+/// \return std::string
+///
+/////////////////////////////////////////////////
+static std::string formatDuration(int64_t nDuration)
+{
+    return toString(nDuration / 1.0e6, 5) + " ms";
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper function to remove the
+/// path from the passed file name.
+///
+/// \param sFile const std::string&
+/// \return std::string
+///
+/////////////////////////////////////////////////
+static std::string getShortFileName(const std::string& sFile)
+{
+    std::string sFileName = replacePathSeparator(sFile);
+
+    if (sFileName.find('/') != std::string::npos)
+        return sFileName.substr(sFileName.rfind('/')+1);
+
+    return sFileName;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Constructor.
+/////////////////////////////////////////////////
+NumeReProfiler::NumeReProfiler() : m_isActive(false)
+{
+    reset();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the current time in
+/// nanoseconds of a monotonic clock.
+///
+/// \return int64_t
+///
+/////////////////////////////////////////////////
+int64_t NumeReProfiler::getTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Starts the recording. Already recorded
+/// data is kept.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::start()
+{
+    if (m_isActive)
+        return;
+
+    m_isActive = true;
+    m_startTime = getTime();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Stops the recording. Procedures, which
+/// are currently executed, are still completed.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::stop()
+{
+    if (!m_isActive)
+        return;
+
+    m_isActive = false;
+    m_recordedTime += getTime() - m_startTime;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes all recorded data.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::reset()
+{
+    m_startTime = getTime();
+    m_recordedTime = 0;
+    m_tableAccesses = 0;
+    m_tableAccessTime = 0;
+    m_callStack.clear();
+    m_procedures.clear();
+    m_callPaths.clear();
+    m_lines.clear();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Pushes a procedure to the internal
+/// call stack.
+///
+/// \param sName const std::string&
+/// \param sFile const std::string&
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::enterProcedure(const std::string& sName, const std::string& sFile)
+{
+    Frame frame;
+    frame.sName = sName;
+    frame.sFile = sFile;
+    frame.sCallPath = m_callStack.size() ? m_callStack.back().sCallPath + ";" + sName : sName;
+    frame.nChildTime = 0;
+    frame.nStartTime = getTime();
+
+    m_callStack.push_back(frame);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Removes the last procedure from the
+/// internal call stack and updates its
+/// statistics. The inclusive time of recursive
+/// calls is only counted once.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::leaveProcedure()
+{
+    if (!m_callStack.size())
+        return;
+
+    Frame frame = m_callStack.back();
+    m_callStack.pop_back();
+
+    int64_t nDuration = getTime() - frame.nStartTime;
+    bool isRecursive = std::find_if(m_callStack.begin(), m_callStack.end(),
+                                    [&](const Frame& f){return f.sName == frame.sName;}) != m_callStack.end();
+
+    CallStats& procStats = m_procedures[frame.sName];
+    procStats.nCalls++;
+    procStats.nSelfTime += nDuration - frame.nChildTime;
+
+    if (!isRecursive)
+        procStats.nInclusiveTime += nDuration;
+
+    CallStats& pathStats = m_callPaths[frame.sCallPath];
+    pathStats.nCalls++;
+    pathStats.nInclusiveTime += nDuration;
+    pathStats.nSelfTime += nDuration - frame.nChildTime;
+
+    if (m_callStack.size())
+        m_callStack.back().nChildTime += nDuration;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the file of the currently
+/// executed procedure or script.
+///
+/// \return std::string
+///
+/////////////////////////////////////////////////
+std::string NumeReProfiler::getCurrentFile() const
+{
+    if (m_callStack.size())
+        return m_callStack.back().sFile;
+
+    Script& _script = NumeReKernel::getInstance()->getScript();
+
+    if (_script.isValid() && _script.isOpen())
+        return _script.getScriptFileName();
+
+    return "<console>";
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Adds the run time of a single line to
+/// the statistics.
+///
+/// \param sFile const std::string&
+/// \param nLine int
+/// \param nDuration int64_t
+/// \param isCompiling bool
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::addLineSample(const std::string& sFile, int nLine, int64_t nDuration, bool isCompiling)
+{
+    LineStats& stats = m_lines[sFile][nLine];
+    stats.nHits++;
+    stats.nTotalTime += nDuration;
+
+    if (isCompiling)
+    {
+        stats.nCompilations++;
+        stats.nCompileTime += nDuration;
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Adds the run time of a table access to
+/// the statistics.
+///
+/// \param nDuration int64_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void NumeReProfiler::addTableAccess(int64_t nDuration)
+{
+    m_tableAccesses++;
+    m_tableAccessTime += nDuration;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Creates a flat report containing the
+/// procedures sorted by their self time and the
+/// lines sorted by their total time.
+///
+/// \param nEntries size_t
+/// \return std::vector<std::string>
+///
+/////////////////////////////////////////////////
+std::vector<std::string> NumeReProfiler::getFlatReport(size_t nEntries) const
+{
+    std::vector<std::string> vReport;
+    int64_t nRecordedTime = m_recordedTime + (m_isActive ? getTime() - m_startTime : 0);
+
+    vReport.push_back("Recorded time: " + formatDuration(nRecordedTime));
+    vReport.push_back("Table accesses: " + toString(m_tableAccesses) + " (" + formatDuration(m_tableAccessTime) + ")");
+    vReport.push_back("");
+
+    // Sort the procedures by their self time
+    std::vector<std::pair<std::string, CallStats>> vProcedures(m_procedures.begin(), m_procedures.end());
+    std::sort(vProcedures.begin(), vProcedures.end(),
+              [](const std::pair<std::string, CallStats>& a, const std::pair<std::string, CallStats>& b)
+              {return a.second.nSelfTime > b.second.nSelfTime;});
+
+    vReport.push_back(strlfill("Procedure", 40) + strfill("Calls", 10) + strfill("Inclusive", 16) + strfill("Self", 16));
+
+    for (size_t i = 0; i < std::min(nEntries, vProcedures.size()); i++)
+    {
+        vReport.push_back(strlfill(vProcedures[i].first, 40)
+                          + strfill(toString(vProcedures[i].second.nCalls), 10)
+                          + strfill(formatDuration(vProcedures[i].second.nInclusiveTime), 16)
+                          + strfill(formatDuration(vProcedures[i].second.nSelfTime), 16));
+    }
+
+    vReport.push_back("");
+
+    // Sort the lines by their total time
+    std::vector<std::pair<std::pair<std::string, int>, LineStats>> vLines;
+
+    for (const auto& file : m_lines)
+    {
+        for (const auto& line : file.second)
+        {
+            vLines.push_back(std::make_pair(std::make_pair(file.first, line.first), line.second));
+        }
+    }
+
+    std::sort(vLines.begin(), vLines.end(),
+              [](const std::pair<std::pair<std::string, int>, LineStats>& a, const std::pair<std::pair<std::string, int>, LineStats>& b)
+              {return a.second.nTotalTime > b.second.nTotalTime;});
+
+    vReport.push_back(strlfill("Line", 40) + strfill("Hits", 10) + strfill("Total", 16) + strfill("Compiling", 16) + strfill("Average", 16));
+
+    for (size_t i = 0; i < std::min(nEntries, vLines.size()); i++)
+    {
+        const LineStats& stats = vLines[i].second;
+
+        vReport.push_back(strlfill(getShortFileName(vLines[i].first.first) + ":" + toString(vLines[i].first.second+1), 40)
+                          + strfill(toString(stats.nHits), 10)
+                          + strfill(formatDuration(stats.nTotalTime), 16)
+                          + strfill(formatDuration(stats.nCompileTime), 16)
+                          + strfill(formatDuration(stats.nTotalTime / (int64_t)stats.nHits), 16));
+    }
+
+    return vReport;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Creates a hierarchical report of the
+/// recorded call tree. Every path is indented
+/// according to its depth.
+///
+/// \return std::vector<std::string>
+///
+/////////////////////////////////////////////////
+std::vector<std::string> NumeReProfiler::getCallTreeReport() const
+{
+    std::vector<std::string> vReport;
+
+    vReport.push_back(strlfill("Call tree", 56) + strfill("Calls", 10) + strfill("Inclusive", 16) + strfill("Self", 16));
+
+    // Split the paths into their frames. The
+    // lexicographical order of the frame lists
+    // corresponds to a depth-first traversal of
+    // the call tree
+    std::vector<std::pair<std::vector<std::string>, CallStats>> vPaths;
+
+    for (const auto& path : m_callPaths)
+    {
+        std::vector<std::string> vFrames;
+        size_t nPos = 0;
+
+        while (true)
+        {
+            size_t nSep = path.first.find(';', nPos);
+            vFrames.push_back(path.first.substr(nPos, nSep - nPos));
+
+            if (nSep == std::string::npos)
+                break;
+
+            nPos = nSep + 1;
+        }
+
+        vPaths.push_back(std::make_pair(vFrames, path.second));
+    }
+
+    std::sort(vPaths.begin(), vPaths.end(),
+              [](const std::pair<std::vector<std::string>, CallStats>& a, const std::pair<std::vector<std::string>, CallStats>& b)
+              {return a.first < b.first;});
+
+    for (const auto& path : vPaths)
+    {
+        vReport.push_back(strlfill(std::string(2*(path.first.size()-1), ' ') + path.first.back(), 56)
+                          + strfill(toString(path.second.nCalls), 10)
+                          + strfill(formatDuration(path.second.nInclusiveTime), 16)
+                          + strfill(formatDuration(path.second.nSelfTime), 16));
+    }
+
+    return vReport;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Writes the call tree in the folded
+/// stack format ("a;b;c self-time") to the
+/// selected file, which can be rendered by
+/// common flame graph tools. The self time is
+/// written in microseconds.
+///
+/// \param sFileName const std::string&
+/// \return bool
+///
+/////////////////////////////////////////////////
+bool NumeReProfiler::exportFoldedStacks(const std::string& sFileName) const
+{
+    std::ofstream file(sFileName, std::ios_base::out | std::ios_base::trunc);
+
+    if (!file.good())
+        return false;
+
+    for (const auto& path : m_callPaths)
+    {
+        if (path.second.nSelfTime >= 1000)
+            file << path.first << " " << path.second.nSelfTime / 1000 << "\n";
+    }
+
+    return file.good();
+}
+
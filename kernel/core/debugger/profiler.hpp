@@ -0,0 +1,215 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+// Default number of entries in the flat profiler report
+#define PROFILER_REPORT_ENTRIES 20
+
+
+/////////////////////////////////////////////////
+/// \brief This class records the run time of the
+/// executed procedures and their lines, once it
+/// has been started. Procedures are recorded as
+/// a call tree, lines are recorded per file.
+/// Both times are wall times and the line times
+/// include the time of nested calls.
+/////////////////////////////////////////////////
+class NumeReProfiler
+{
+    public:
+        /////////////////////////////////////////////////
+        /// \brief Statistics of a single line.
+        /////////////////////////////////////////////////
+        struct LineStats
+        {
+            size_t nHits = 0;
+            size_t nCompilations = 0;
+            int64_t nTotalTime = 0;
+            int64_t nCompileTime = 0;
+        };
+
+        /////////////////////////////////////////////////
+        /// \brief Statistics of a procedure or of a
+        /// single path in the call tree.
+        /////////////////////////////////////////////////
+        struct CallStats
+        {
+            size_t nCalls = 0;
+            int64_t nInclusiveTime = 0;
+            int64_t nSelfTime = 0;
+        };
+
+    private:
+        /////////////////////////////////////////////////
+        /// \brief A currently executed procedure.
+        /////////////////////////////////////////////////
+        struct Frame
+        {
+            std::string sName;
+            std::string sFile;
+            std::string sCallPath;
+            int64_t nStartTime;
+            int64_t nChildTime;
+        };
+
+        bool m_isActive;
+        int64_t m_startTime;
+        int64_t m_recordedTime;
+        size_t m_tableAccesses;
+        int64_t m_tableAccessTime;
+
+        std::vector<Frame> m_callStack;
+        std::map<std::string, CallStats> m_procedures;
+        std::map<std::string, CallStats> m_callPaths;
+        std::map<std::string, std::map<int, LineStats>> m_lines;
+
+    public:
+        NumeReProfiler();
+
+        static int64_t getTime();
+
+        void start();
+        void stop();
+        void reset();
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, if the profiler is
+        /// currently recording.
+        ///
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool isActive() const
+        {
+            return m_isActive;
+        }
+
+        void enterProcedure(const std::string& sName, const std::string& sFile);
+        void leaveProcedure();
+        std::string getCurrentFile() const;
+
+        void addLineSample(const std::string& sFile, int nLine, int64_t nDuration, bool isCompiling);
+        void addTableAccess(int64_t nDuration);
+
+        std::vector<std::string> getFlatReport(size_t nEntries = PROFILER_REPORT_ENTRIES) const;
+        std::vector<std::string> getCallTreeReport() const;
+        bool exportFoldedStacks(const std::string& sFileName) const;
+};
+
+
+/////////////////////////////////////////////////
+/// \brief This class records the passed
+/// procedure in the profiler during its
+/// lifetime, if the profiler is active.
+/////////////////////////////////////////////////
+class ProfilerProcedureScope
+{
+    private:
+        NumeReProfiler* m_profiler;
+
+    public:
+        ProfilerProcedureScope(NumeReProfiler& _profiler, const std::string& sName, const std::string& sFile) : m_profiler(nullptr)
+        {
+            if (_profiler.isActive())
+            {
+                m_profiler = &_profiler;
+                m_profiler->enterProcedure(sName, sFile);
+            }
+        }
+
+        ~ProfilerProcedureScope()
+        {
+            if (m_profiler)
+                m_profiler->leaveProcedure();
+        }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief This class measures the run time of a
+/// single line during its lifetime, if the
+/// profiler is active. The file is determined
+/// from the currently executed procedure or
+/// script.
+/////////////////////////////////////////////////
+class ProfilerLineScope
+{
+    private:
+        NumeReProfiler* m_profiler;
+        std::string m_file;
+        int m_line;
+        bool m_isCompiling;
+        int64_t m_startTime;
+
+    public:
+        ProfilerLineScope(NumeReProfiler& _profiler, int nLine, bool isCompiling) : m_profiler(nullptr), m_line(nLine), m_isCompiling(isCompiling), m_startTime(0)
+        {
+            if (_profiler.isActive())
+            {
+                m_profiler = &_profiler;
+                m_file = _profiler.getCurrentFile();
+                m_startTime = NumeReProfiler::getTime();
+            }
+        }
+
+        ~ProfilerLineScope()
+        {
+            if (m_profiler)
+                m_profiler->addLineSample(m_file, m_line, NumeReProfiler::getTime() - m_startTime, m_isCompiling);
+        }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief This class measures the run time of a
+/// table access during its lifetime, if the
+/// profiler is active.
+/////////////////////////////////////////////////
+class ProfilerTableScope
+{
+    private:
+        NumeReProfiler* m_profiler;
+        int64_t m_startTime;
+
+    public:
+        ProfilerTableScope(NumeReProfiler& _profiler) : m_profiler(nullptr), m_startTime(0)
+        {
+            if (_profiler.isActive())
+            {
+                m_profiler = &_profiler;
+                m_startTime = NumeReProfiler::getTime();
+            }
+        }
+
+        ~ProfilerTableScope()
+        {
+            if (m_profiler)
+                m_profiler->addTableAccess(NumeReProfiler::getTime() - m_startTime);
+        }
+};
+
+
+#endif // PROFILER_HPP
+
@@ -0,0 +1,1141 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "arrowipc.hpp"
+#include "flatbuffers.hpp"
+
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+
+// Alignment of the buffers within a message body
+#define ARROW_BUFFER_ALIGNMENT 8
+
+namespace Arrow
+{
+    // The file magic, which is written at the start and the end
+    static const char ARROW_MAGIC[] = "ARROW1";
+    static const size_t ARROW_MAGIC_LEN = 6;
+
+    // Version V5 of the metadata
+    static const int16_t ARROW_METADATA_VERSION = 4;
+
+    /////////////////////////////////////////////////
+    /// \brief The message header types.
+    /////////////////////////////////////////////////
+    enum MessageHeader
+    {
+        HEADER_SCHEMA = 1,
+        HEADER_DICTIONARYBATCH = 2,
+        HEADER_RECORDBATCH = 3
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief The ids of the used types within the
+    /// Type union.
+    /////////////////////////////////////////////////
+    enum TypeId
+    {
+        TYPEID_INT = 2,
+        TYPEID_FLOATINGPOINT = 3,
+        TYPEID_UTF8 = 5,
+        TYPEID_BOOL = 6,
+        TYPEID_DATE = 8,
+        TYPEID_TIMESTAMP = 10,
+        TYPEID_STRUCT = 13
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief A node of the flattened column tree
+    /// in a record batch.
+    /////////////////////////////////////////////////
+    struct FieldNode
+    {
+        int64_t length;
+        int64_t nullCount;
+    };
+
+    /////////////////////////////////////////////////
+    /// \brief The location of a buffer within a
+    /// message body.
+    /////////////////////////////////////////////////
+    struct BufferRef
+    {
+        int64_t offset;
+        int64_t length;
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief This structure collects the nodes and
+    /// buffers of a message body, before the body
+    /// is written.
+    /////////////////////////////////////////////////
+    struct MessageBody
+    {
+        std::vector<FieldNode> vNodes;
+        std::vector<BufferRef> vBuffers;
+        std::vector<const void*> vData;
+        int64_t nLength = 0;
+
+        /////////////////////////////////////////////////
+        /// \brief Adds a node.
+        ///
+        /// \param nLength int64_t
+        /// \param nNullCount int64_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void addNode(int64_t nElems, int64_t nNullCount)
+        {
+            vNodes.push_back(FieldNode{nElems, nNullCount});
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Adds a buffer. The referenced data
+        /// has to exist until the body is written.
+        ///
+        /// \param data const void*
+        /// \param nBytes size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void addBuffer(const void* data, size_t nBytes)
+        {
+            vBuffers.push_back(BufferRef{nLength, (int64_t)nBytes});
+            vData.push_back(data);
+            nLength += (nBytes + ARROW_BUFFER_ALIGNMENT - 1) / ARROW_BUFFER_ALIGNMENT * ARROW_BUFFER_ALIGNMENT;
+        }
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to write the
+    /// selected number of zero bytes.
+    ///
+    /// \param stream std::ostream&
+    /// \param nBytes size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void writePadding(std::ostream& stream, size_t nBytes)
+    {
+        static const char padding[ARROW_BUFFER_ALIGNMENT] = {0};
+        stream.write(padding, nBytes);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to create a
+    /// list of key-value pairs.
+    ///
+    /// \param builder FlatBuffers::Builder&
+    /// \param vMetaData const KeyValueList&
+    /// \return FlatBuffers::Offset
+    ///
+    /////////////////////////////////////////////////
+    static FlatBuffers::Offset createKeyValues(FlatBuffers::Builder& builder, const KeyValueList& vMetaData)
+    {
+        std::vector<FlatBuffers::Offset> vPairs;
+
+        for (const auto& kv : vMetaData)
+        {
+            FlatBuffers::Offset key = builder.createString(kv.first);
+            FlatBuffers::Offset value = builder.createString(kv.second);
+
+            builder.startTable();
+            builder.addOffsetField(0, key);
+            builder.addOffsetField(1, value);
+            vPairs.push_back(builder.endTable());
+        }
+
+        return builder.createOffsetVector(vPairs);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to create the
+    /// type table of the passed field.
+    ///
+    /// \param builder FlatBuffers::Builder&
+    /// \param field const ArrowField&
+    /// \param nTypeId uint8_t&
+    /// \return FlatBuffers::Offset
+    ///
+    /////////////////////////////////////////////////
+    static FlatBuffers::Offset createType(FlatBuffers::Builder& builder, const ArrowField& field, uint8_t& nTypeId)
+    {
+        builder.startTable();
+
+        switch (field.type)
+        {
+            case ARROW_INT:
+                nTypeId = TYPEID_INT;
+                builder.addField<int32_t>(0, field.nBitWidth);
+                builder.addField<uint8_t>(1, field.isSigned);
+                break;
+            case ARROW_FLOAT:
+                nTypeId = TYPEID_FLOATINGPOINT;
+                builder.addField<int16_t>(0, field.nBitWidth == 32 ? 1 : 2);
+                break;
+            case ARROW_BOOL:
+                nTypeId = TYPEID_BOOL;
+                break;
+            case ARROW_UTF8:
+                nTypeId = TYPEID_UTF8;
+                break;
+            case ARROW_TIMESTAMP:
+                nTypeId = TYPEID_TIMESTAMP;
+                builder.addField<int16_t>(0, field.unit);
+                break;
+            case ARROW_DATE:
+                nTypeId = TYPEID_DATE;
+                builder.addField<int16_t>(0, field.unit == UNIT_SECOND ? 0 : 1);
+                break;
+            case ARROW_COMPLEX:
+                nTypeId = TYPEID_STRUCT;
+                break;
+            case ARROW_UNSUPPORTED:
+                throw std::runtime_error("Unsupported Arrow type");
+        }
+
+        return builder.endTable();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to create the
+    /// description of a single column. Complex
+    /// columns get two floating point children.
+    ///
+    /// \param builder FlatBuffers::Builder&
+    /// \param field const ArrowField&
+    /// \return FlatBuffers::Offset
+    ///
+    /////////////////////////////////////////////////
+    static FlatBuffers::Offset createField(FlatBuffers::Builder& builder, const ArrowField& field)
+    {
+        std::vector<FlatBuffers::Offset> vChildren;
+
+        if (field.type == ARROW_COMPLEX)
+        {
+            ArrowField component;
+            component.type = ARROW_FLOAT;
+            component.nBitWidth = field.nBitWidth;
+            component.sName = "real";
+            vChildren.push_back(createField(builder, component));
+            component.sName = "imag";
+            vChildren.push_back(createField(builder, component));
+        }
+
+        FlatBuffers::Offset children = builder.createOffsetVector(vChildren);
+        FlatBuffers::Offset name = builder.createString(field.sName);
+        FlatBuffers::Offset metaData = field.vMetaData.size() ? createKeyValues(builder, field.vMetaData) : 0;
+        FlatBuffers::Offset dictionary = 0;
+
+        uint8_t nTypeId = 0;
+        FlatBuffers::Offset type = createType(builder, field, nTypeId);
+
+        if (field.isDictionary)
+        {
+            builder.startTable();
+            builder.addField<int32_t>(0, field.nBitWidth);
+            builder.addField<uint8_t>(1, field.isSigned);
+            FlatBuffers::Offset indexType = builder.endTable();
+
+            builder.startTable();
+            builder.addField<int64_t>(0, field.nDictionaryId);
+            builder.addOffsetField(1, indexType);
+            dictionary = builder.endTable();
+        }
+
+        builder.startTable();
+        builder.addOffsetField(0, name);
+        builder.addField<uint8_t>(1, true);
+        builder.addField<uint8_t>(2, nTypeId);
+        builder.addOffsetField(3, type);
+
+        if (dictionary)
+            builder.addOffsetField(4, dictionary);
+
+        builder.addOffsetField(5, children);
+
+        if (metaData)
+            builder.addOffsetField(6, metaData);
+
+        return builder.endTable();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to create the
+    /// schema of the file.
+    ///
+    /// \param builder FlatBuffers::Builder&
+    /// \param vColumns const std::vector<ArrowColumn>&
+    /// \param vMetaData const KeyValueList&
+    /// \return FlatBuffers::Offset
+    ///
+    /////////////////////////////////////////////////
+    static FlatBuffers::Offset createSchema(FlatBuffers::Builder& builder, const std::vector<ArrowColumn>& vColumns, const KeyValueList& vMetaData)
+    {
+        std::vector<FlatBuffers::Offset> vFields;
+
+        for (const ArrowColumn& col : vColumns)
+        {
+            vFields.push_back(createField(builder, col.field));
+        }
+
+        FlatBuffers::Offset fields = builder.createOffsetVector(vFields);
+        FlatBuffers::Offset metaData = createKeyValues(builder, vMetaData);
+
+        builder.startTable();
+        builder.addOffsetField(1, fields);
+        builder.addOffsetField(2, metaData);
+        return builder.endTable();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to create the
+    /// record batch description of the passed body.
+    ///
+    /// \param builder FlatBuffers::Builder&
+    /// \param nLength int64_t
+    /// \param body const MessageBody&
+    /// \return FlatBuffers::Offset
+    ///
+    /////////////////////////////////////////////////
+    static FlatBuffers::Offset createRecordBatch(FlatBuffers::Builder& builder, int64_t nLength, const MessageBody& body)
+    {
+        FlatBuffers::Offset nodes = builder.createStructVector(body.vNodes.data(), body.vNodes.size(), sizeof(FieldNode), sizeof(int64_t));
+        FlatBuffers::Offset buffers = builder.createStructVector(body.vBuffers.data(), body.vBuffers.size(), sizeof(BufferRef), sizeof(int64_t));
+
+        builder.startTable();
+        builder.addField<int64_t>(0, nLength);
+        builder.addOffsetField(1, nodes);
+        builder.addOffsetField(2, buffers);
+        return builder.endTable();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to write an
+    /// encapsulated message together with its body.
+    /// Returns the block describing the position of
+    /// the message in the file.
+    ///
+    /// \param stream std::ostream&
+    /// \param builder FlatBuffers::Builder&
+    /// \param nHeaderType uint8_t
+    /// \param header FlatBuffers::Offset
+    /// \param body const MessageBody&
+    /// \param nPos int64_t&
+    /// \return std::vector<int64_t>
+    ///
+    /////////////////////////////////////////////////
+    static std::vector<int64_t> writeMessage(std::ostream& stream, FlatBuffers::Builder& builder, uint8_t nHeaderType,
+                                             FlatBuffers::Offset header, const MessageBody& body, int64_t& nPos)
+    {
+        builder.startTable();
+        builder.addField<int16_t>(0, ARROW_METADATA_VERSION);
+        builder.addField<uint8_t>(1, nHeaderType);
+        builder.addOffsetField(2, header);
+        builder.addField<int64_t>(3, body.nLength);
+
+        size_t nSize;
+        const uint8_t* metaData = builder.finish(builder.endTable(), nSize);
+
+        // The metadata including its prefix has to be
+        // a multiple of the alignment
+        size_t nPadding = (ARROW_BUFFER_ALIGNMENT - (nSize + 8) % ARROW_BUFFER_ALIGNMENT) % ARROW_BUFFER_ALIGNMENT;
+        uint32_t nContinuation = 0xFFFFFFFF;
+        int32_t nMetaDataLength = nSize + nPadding;
+
+        stream.write((const char*)&nContinuation, sizeof(uint32_t));
+        stream.write((const char*)&nMetaDataLength, sizeof(int32_t));
+        stream.write((const char*)metaData, nSize);
+        writePadding(stream, nPadding);
+
+        for (size_t i = 0; i < body.vBuffers.size(); i++)
+        {
+            stream.write((const char*)body.vData[i], body.vBuffers[i].length);
+            writePadding(stream, (ARROW_BUFFER_ALIGNMENT - body.vBuffers[i].length % ARROW_BUFFER_ALIGNMENT) % ARROW_BUFFER_ALIGNMENT);
+        }
+
+        std::vector<int64_t> vBlock = {nPos, (int64_t)nMetaDataLength + 8, body.nLength};
+        nPos += nMetaDataLength + 8 + body.nLength;
+
+        return vBlock;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to create the
+    /// vector of blocks in the footer.
+    ///
+    /// \param builder FlatBuffers::Builder&
+    /// \param vBlocks const std::vector<std::vector<int64_t>>&
+    /// \return FlatBuffers::Offset
+    ///
+    /////////////////////////////////////////////////
+    static FlatBuffers::Offset createBlocks(FlatBuffers::Builder& builder, const std::vector<std::vector<int64_t>>& vBlocks)
+    {
+        // Offset, metadata length (with padding) and body length
+        std::vector<int64_t> vData;
+
+        for (const std::vector<int64_t>& block : vBlocks)
+        {
+            vData.push_back(block[0]);
+            vData.push_back(block[1]);
+            vData.push_back(block[2]);
+        }
+
+        return builder.createStructVector(vData.data(), vBlocks.size(), 3*sizeof(int64_t), sizeof(int64_t));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Writes the passed columns as a single
+    /// record batch in the Arrow IPC file format.
+    /// All columns have to contain nRows elements.
+    /// The data is written uncompressed.
+    ///
+    /// \param stream std::ostream&
+    /// \param vColumns const std::vector<ArrowColumn>&
+    /// \param nRows int64_t
+    /// \param vMetaData const KeyValueList&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void writeFile(std::ostream& stream, const std::vector<ArrowColumn>& vColumns, int64_t nRows, const KeyValueList& vMetaData)
+    {
+        stream.write(ARROW_MAGIC, ARROW_MAGIC_LEN);
+        writePadding(stream, 2);
+        int64_t nPos = 8;
+
+        // Write the schema
+        {
+            FlatBuffers::Builder builder;
+            FlatBuffers::Offset schema = createSchema(builder, vColumns, vMetaData);
+            writeMessage(stream, builder, HEADER_SCHEMA, schema, MessageBody(), nPos);
+        }
+
+        // Write the dictionaries
+        std::vector<std::vector<int64_t>> vDictionaryBlocks;
+
+        for (const ArrowColumn& col : vColumns)
+        {
+            if (!col.field.isDictionary)
+                continue;
+
+            std::vector<int32_t> vOffsets(1, 0);
+            std::string sChars;
+
+            for (const std::string& sValue : col.vDictionary)
+            {
+                sChars += sValue;
+                vOffsets.push_back(sChars.length());
+            }
+
+            MessageBody body;
+            body.addNode(col.vDictionary.size(), 0);
+            body.addBuffer(nullptr, 0);
+            body.addBuffer(vOffsets.data(), vOffsets.size()*sizeof(int32_t));
+            body.addBuffer(sChars.data(), sChars.length());
+
+            FlatBuffers::Builder builder;
+            FlatBuffers::Offset recordBatch = createRecordBatch(builder, col.vDictionary.size(), body);
+
+            builder.startTable();
+            builder.addField<int64_t>(0, col.field.nDictionaryId);
+            builder.addOffsetField(1, recordBatch);
+            FlatBuffers::Offset dictionaryBatch = builder.endTable();
+
+            vDictionaryBlocks.push_back(writeMessage(stream, builder, HEADER_DICTIONARYBATCH, dictionaryBatch, body, nPos));
+        }
+
+        // Write the data in a single record batch
+        MessageBody body;
+
+        for (const ArrowColumn& col : vColumns)
+        {
+            body.addNode(nRows, col.nNullCount);
+            body.addBuffer(col.vValidity.data(), col.nNullCount ? col.vValidity.size() : 0);
+
+            if (col.field.type == ARROW_COMPLEX)
+            {
+                body.addNode(nRows, 0);
+                body.addBuffer(nullptr, 0);
+                body.addBuffer(col.vData.data(), col.vData.size());
+                body.addNode(nRows, 0);
+                body.addBuffer(nullptr, 0);
+                body.addBuffer(col.vImagData.data(), col.vImagData.size());
+            }
+            else if (col.field.type == ARROW_UTF8 && !col.field.isDictionary)
+            {
+                body.addBuffer(col.vOffsets.data(), col.vOffsets.size()*sizeof(int32_t));
+                body.addBuffer(col.vData.data(), col.vData.size());
+            }
+            else
+                body.addBuffer(col.vData.data(), col.vData.size());
+        }
+
+        std::vector<std::vector<int64_t>> vRecordBlocks;
+
+        {
+            FlatBuffers::Builder builder;
+            FlatBuffers::Offset recordBatch = createRecordBatch(builder, nRows, body);
+            vRecordBlocks.push_back(writeMessage(stream, builder, HEADER_RECORDBATCH, recordBatch, body, nPos));
+        }
+
+        // Write the footer
+        FlatBuffers::Builder builder;
+        FlatBuffers::Offset schema = createSchema(builder, vColumns, vMetaData);
+        FlatBuffers::Offset dictionaries = createBlocks(builder, vDictionaryBlocks);
+        FlatBuffers::Offset recordBatches = createBlocks(builder, vRecordBlocks);
+
+        builder.startTable();
+        builder.addField<int16_t>(0, ARROW_METADATA_VERSION);
+        builder.addOffsetField(1, schema);
+        builder.addOffsetField(2, dictionaries);
+        builder.addOffsetField(3, recordBatches);
+
+        size_t nSize;
+        const uint8_t* footer = builder.finish(builder.endTable(), nSize);
+        int32_t nFooterSize = nSize;
+
+        stream.write((const char*)footer, nSize);
+        stream.write((const char*)&nFooterSize, sizeof(int32_t));
+        stream.write(ARROW_MAGIC, ARROW_MAGIC_LEN);
+    }
+
+
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to read a list
+    /// of key-value pairs.
+    ///
+    /// \param table const FlatBuffers::Table&
+    /// \param nSlot uint16_t
+    /// \return KeyValueList
+    ///
+    /////////////////////////////////////////////////
+    static KeyValueList readKeyValues(const FlatBuffers::Table& table, uint16_t nSlot)
+    {
+        KeyValueList vMetaData;
+
+        for (size_t i = 0; i < table.getVectorLength(nSlot); i++)
+        {
+            FlatBuffers::Table kv = table.getTableElement(nSlot, i);
+            vMetaData.push_back(std::make_pair(kv.getString(0), kv.getString(1)));
+        }
+
+        return vMetaData;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to read the
+    /// description of a single column.
+    ///
+    /// \param table const FlatBuffers::Table&
+    /// \return ArrowField
+    ///
+    /////////////////////////////////////////////////
+    static ArrowField readField(const FlatBuffers::Table& table)
+    {
+        ArrowField field;
+        field.sName = table.getString(0);
+        field.vMetaData = readKeyValues(table, 6);
+
+        uint8_t nTypeId = table.get<uint8_t>(2);
+
+        if (!table.has(3))
+            throw std::runtime_error("Missing type of column " + field.sName);
+
+        FlatBuffers::Table type = table.getTable(3);
+
+        switch (nTypeId)
+        {
+            case TYPEID_INT:
+                field.type = ARROW_INT;
+                field.nBitWidth = type.get<int32_t>(0);
+                field.isSigned = type.get<uint8_t>(1);
+                break;
+            case TYPEID_FLOATINGPOINT:
+            {
+                int16_t nPrecision = type.get<int16_t>(0);
+
+                if (nPrecision == 1 || nPrecision == 2)
+                {
+                    field.type = ARROW_FLOAT;
+                    field.nBitWidth = nPrecision == 1 ? 32 : 64;
+                }
+
+                break;
+            }
+            case TYPEID_UTF8:
+                field.type = ARROW_UTF8;
+                break;
+            case TYPEID_BOOL:
+                field.type = ARROW_BOOL;
+                break;
+            case TYPEID_DATE:
+                field.type = ARROW_DATE;
+                field.unit = type.get<int16_t>(0, 1) ? UNIT_MILLISECOND : UNIT_SECOND;
+                field.nBitWidth = field.unit == UNIT_SECOND ? 32 : 64;
+                break;
+            case TYPEID_TIMESTAMP:
+            {
+                int16_t nUnit = type.get<int16_t>(0);
+
+                if (nUnit >= UNIT_SECOND && nUnit <= UNIT_NANOSECOND)
+                {
+                    field.type = ARROW_TIMESTAMP;
+                    field.unit = (TimeUnit)nUnit;
+                    field.nBitWidth = 64;
+                }
+
+                break;
+            }
+            case TYPEID_STRUCT:
+            {
+                // Only structs of two floating point
+                // values are supported (complex values)
+                if (table.getVectorLength(5) != 2)
+                    break;
+
+                ArrowField real = readField(table.getTableElement(5, 0));
+                ArrowField imag = readField(table.getTableElement(5, 1));
+
+                if (real.type == ARROW_FLOAT && imag.type == ARROW_FLOAT && real.nBitWidth == imag.nBitWidth)
+                {
+                    field.type = ARROW_COMPLEX;
+                    field.nBitWidth = real.nBitWidth;
+                }
+
+                break;
+            }
+        }
+
+        if (table.has(4))
+        {
+            FlatBuffers::Table dictionary = table.getTable(4);
+            field.isDictionary = true;
+            field.nDictionaryId = dictionary.get<int64_t>(0);
+            field.nBitWidth = 32;
+            field.isSigned = true;
+
+            if (dictionary.has(1))
+            {
+                FlatBuffers::Table indexType = dictionary.getTable(1);
+                field.nBitWidth = indexType.get<int32_t>(0);
+                field.isSigned = indexType.get<uint8_t>(1);
+            }
+
+            if (field.type != ARROW_UTF8)
+                field.type = ARROW_UNSUPPORTED;
+        }
+
+        if (field.type == ARROW_UNSUPPORTED
+            || ((field.type == ARROW_INT || field.isDictionary)
+                && field.nBitWidth != 8 && field.nBitWidth != 16 && field.nBitWidth != 32 && field.nBitWidth != 64))
+            throw std::runtime_error("Unsupported type of column " + field.sName);
+
+        return field;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to get the
+    /// selected buffer of a record batch. The
+    /// buffer is checked to be large enough and to
+    /// be aligned. Empty buffers are returned as
+    /// null pointer.
+    ///
+    /// \param recordBatch const FlatBuffers::Table&
+    /// \param nBuffer size_t&
+    /// \param body const uint8_t*
+    /// \param nBodyLength int64_t
+    /// \param nMinLength int64_t
+    /// \param nAlignment size_t
+    /// \return const uint8_t*
+    ///
+    /////////////////////////////////////////////////
+    static const uint8_t* getBuffer(const FlatBuffers::Table& recordBatch, size_t& nBuffer, const uint8_t* body, int64_t nBodyLength,
+                                    int64_t nMinLength, size_t nAlignment)
+    {
+        if (nBuffer >= recordBatch.getVectorLength(2))
+            throw std::runtime_error("Missing buffer in record batch");
+
+        BufferRef ref = recordBatch.getElement<BufferRef>(2, nBuffer);
+        nBuffer++;
+
+        if (ref.offset < 0 || ref.length < nMinLength || ref.offset > nBodyLength || ref.length > nBodyLength - ref.offset)
+            throw std::runtime_error("Malformed buffer in record batch");
+
+        if (!ref.length)
+            return nullptr;
+
+        if ((uintptr_t)(body + ref.offset) % nAlignment)
+            throw std::runtime_error("Misaligned buffer in record batch");
+
+        return body + ref.offset;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to get the
+    /// selected node of a record batch. Every
+    /// supported column needs at least one bit per
+    /// value, which limits the valid node length
+    /// by the body length.
+    ///
+    /// \param recordBatch const FlatBuffers::Table&
+    /// \param nNode size_t&
+    /// \param nBodyLength int64_t
+    /// \return FieldNode
+    ///
+    /////////////////////////////////////////////////
+    static FieldNode getNode(const FlatBuffers::Table& recordBatch, size_t& nNode, int64_t nBodyLength)
+    {
+        if (nNode >= recordBatch.getVectorLength(1))
+            throw std::runtime_error("Missing node in record batch");
+
+        FieldNode node = recordBatch.getElement<FieldNode>(1, nNode);
+        nNode++;
+
+        if (node.length < 0 || node.nullCount < 0 || node.nullCount > node.length || node.length > 8*nBodyLength)
+            throw std::runtime_error("Malformed node in record batch");
+
+        return node;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Constructor. Reads the footer and the
+    /// dictionaries of the passed file buffer.
+    ///
+    /// \param data const char*
+    /// \param nSize size_t
+    ///
+    /////////////////////////////////////////////////
+    FileReader::FileReader(const char* data, size_t nSize) : m_data((const uint8_t*)data), m_size(nSize)
+    {
+        if (m_size < 2*ARROW_MAGIC_LEN + 2 + sizeof(int32_t)
+            || std::memcmp(m_data, ARROW_MAGIC, ARROW_MAGIC_LEN)
+            || std::memcmp(m_data + m_size - ARROW_MAGIC_LEN, ARROW_MAGIC, ARROW_MAGIC_LEN))
+            throw std::runtime_error("Not an Arrow IPC file");
+
+        readFooter();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reads the footer containing the schema
+    /// and the positions of all messages.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void FileReader::readFooter()
+    {
+        int32_t nFooterSize;
+        std::memcpy(&nFooterSize, m_data + m_size - ARROW_MAGIC_LEN - sizeof(int32_t), sizeof(int32_t));
+
+        if (nFooterSize <= 0 || (size_t)nFooterSize > m_size - 2*ARROW_MAGIC_LEN - 2 - sizeof(int32_t))
+            throw std::runtime_error("Malformed footer");
+
+        try
+        {
+            const uint8_t* footerData = m_data + m_size - ARROW_MAGIC_LEN - sizeof(int32_t) - nFooterSize;
+            FlatBuffers::Table footer = FlatBuffers::Table::getRoot(footerData, nFooterSize);
+            FlatBuffers::Table schema = footer.getTable(1);
+
+            if (schema.get<int16_t>(0))
+                throw std::runtime_error("Big endian files are not supported");
+
+            for (size_t i = 0; i < schema.getVectorLength(1); i++)
+            {
+                m_fields.push_back(readField(schema.getTableElement(1, i)));
+            }
+
+            m_metaData = readKeyValues(schema, 2);
+
+            for (size_t i = 0; i < footer.getVectorLength(3); i++)
+            {
+                m_batches.push_back(footer.getElement<Block>(3, i));
+            }
+
+            for (size_t i = 0; i < footer.getVectorLength(2); i++)
+            {
+                readDictionary(footer.getElement<Block>(2, i));
+            }
+        }
+        catch (std::out_of_range&)
+        {
+            throw std::runtime_error("Malformed footer");
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to get the
+    /// header of the message at the selected
+    /// position. The body position is returned via
+    /// the last parameter.
+    ///
+    /// \param data const uint8_t*
+    /// \param nSize size_t
+    /// \param block const Block&
+    /// \param nHeaderType uint8_t
+    /// \param body const uint8_t*&
+    /// \return FlatBuffers::Table
+    ///
+    /////////////////////////////////////////////////
+    template <class Block>
+    static FlatBuffers::Table getMessageHeader(const uint8_t* data, size_t nSize, const Block& block, uint8_t nHeaderType, const uint8_t*& body)
+    {
+        if (block.offset < 0 || block.metaDataLength < 8 || block.bodyLength < 0
+            || (uint64_t)block.offset + block.metaDataLength + block.bodyLength > nSize)
+            throw std::runtime_error("Malformed message block");
+
+        const uint8_t* message = data + block.offset;
+        int32_t nPrefix;
+        int32_t nLength;
+        std::memcpy(&nPrefix, message, sizeof(int32_t));
+
+        // Files of older versions do not contain the
+        // continuation marker
+        if (nPrefix == -1)
+        {
+            std::memcpy(&nLength, message + sizeof(int32_t), sizeof(int32_t));
+            message += 2*sizeof(int32_t);
+        }
+        else
+        {
+            nLength = nPrefix;
+            message += sizeof(int32_t);
+        }
+
+        if (nLength < 0 || message + nLength > data + block.offset + block.metaDataLength)
+            throw std::runtime_error("Malformed message");
+
+        FlatBuffers::Table msg = FlatBuffers::Table::getRoot(message, nLength);
+
+        if (msg.get<uint8_t>(1) != nHeaderType)
+            throw std::runtime_error("Unexpected message type");
+
+        body = data + block.offset + block.metaDataLength;
+        return msg.getTable(2);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reads a dictionary batch. Only string
+    /// dictionaries are supported.
+    ///
+    /// \param block const Block&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void FileReader::readDictionary(const Block& block)
+    {
+        const uint8_t* body;
+        FlatBuffers::Table dictionaryBatch = getMessageHeader(m_data, m_size, block, HEADER_DICTIONARYBATCH, body);
+        FlatBuffers::Table recordBatch = dictionaryBatch.getTable(1);
+
+        if (recordBatch.has(3))
+            throw std::runtime_error("Compressed files are not supported");
+
+        int64_t nId = dictionaryBatch.get<int64_t>(0);
+        std::vector<std::string>& vDictionary = m_dictionaries[nId];
+
+        if (!dictionaryBatch.get<uint8_t>(2))
+            vDictionary.clear();
+
+        size_t nNode = 0;
+        size_t nBuffer = 0;
+        FieldNode node = getNode(recordBatch, nNode, block.bodyLength);
+
+        const uint8_t* validity = getBuffer(recordBatch, nBuffer, body, block.bodyLength, node.nullCount ? (node.length+7)/8 : 0, 1);
+        const int32_t* offsets = (const int32_t*)getBuffer(recordBatch, nBuffer, body, block.bodyLength, node.length ? (node.length+1)*sizeof(int32_t) : 0, sizeof(int32_t));
+        const uint8_t* chars = getBuffer(recordBatch, nBuffer, body, block.bodyLength, node.length ? offsets[node.length] : 0, 1);
+
+        for (int64_t i = 0; i < node.length; i++)
+        {
+            if ((validity && !((validity[i / 8] >> (i % 8)) & 1))
+                || offsets[i] < 0 || offsets[i] >= offsets[i+1] || offsets[i+1] > offsets[node.length])
+                vDictionary.push_back("");
+            else
+                vDictionary.push_back(std::string((const char*)chars + offsets[i], offsets[i+1] - offsets[i]));
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the views on all columns of
+    /// the selected record batch. The views
+    /// reference the file buffer directly.
+    ///
+    /// \param nBatch size_t
+    /// \return std::vector<ArrowColumnView>
+    ///
+    /////////////////////////////////////////////////
+    std::vector<ArrowColumnView> FileReader::readBatch(size_t nBatch) const
+    {
+        std::vector<ArrowColumnView> vColumns;
+        const Block& block = m_batches.at(nBatch);
+
+        try
+        {
+            const uint8_t* body;
+            FlatBuffers::Table recordBatch = getMessageHeader(m_data, m_size, block, HEADER_RECORDBATCH, body);
+
+            if (recordBatch.has(3))
+                throw std::runtime_error("Compressed files are not supported");
+
+            size_t nNode = 0;
+            size_t nBuffer = 0;
+
+            for (const ArrowField& field : m_fields)
+            {
+                ArrowColumnView view;
+                FieldNode node = getNode(recordBatch, nNode, block.bodyLength);
+                int64_t n = node.length;
+
+                view.field = &field;
+                view.nLength = n;
+                view.nNullCount = node.nullCount;
+                view.validity = getBuffer(recordBatch, nBuffer, body, block.bodyLength, node.nullCount ? (n+7)/8 : 0, 1);
+
+                if (!node.nullCount)
+                    view.validity = nullptr;
+
+                if (field.isDictionary)
+                {
+                    auto iter = m_dictionaries.find(field.nDictionaryId);
+
+                    if (iter == m_dictionaries.end())
+                        throw std::runtime_error("Missing dictionary of column " + field.sName);
+
+                    view.dictionary = &iter->second;
+                    view.data = getBuffer(recordBatch, nBuffer, body, block.bodyLength, n*field.nBitWidth/8, field.nBitWidth/8);
+                }
+                else if (field.type == ARROW_BOOL)
+                    view.data = getBuffer(recordBatch, nBuffer, body, block.bodyLength, (n+7)/8, 1);
+                else if (field.type == ARROW_UTF8)
+                {
+                    view.offsets = (const int32_t*)getBuffer(recordBatch, nBuffer, body, block.bodyLength, n ? (n+1)*sizeof(int32_t) : 0, sizeof(int32_t));
+                    view.data = getBuffer(recordBatch, nBuffer, body, block.bodyLength, n ? std::max(view.offsets[n], 0) : 0, 1);
+                }
+                else if (field.type == ARROW_COMPLEX)
+                {
+                    getNode(recordBatch, nNode, block.bodyLength);
+                    getBuffer(recordBatch, nBuffer, body, block.bodyLength, 0, 1);
+                    view.data = getBuffer(recordBatch, nBuffer, body, block.bodyLength, n*field.nBitWidth/8, field.nBitWidth/8);
+                    getNode(recordBatch, nNode, block.bodyLength);
+                    getBuffer(recordBatch, nBuffer, body, block.bodyLength, 0, 1);
+                    view.imagData = getBuffer(recordBatch, nBuffer, body, block.bodyLength, n*field.nBitWidth/8, field.nBitWidth/8);
+                }
+                else
+                    view.data = getBuffer(recordBatch, nBuffer, body, block.bodyLength, n*field.nBitWidth/8, field.nBitWidth/8);
+
+                vColumns.push_back(view);
+            }
+        }
+        catch (std::out_of_range&)
+        {
+            throw std::runtime_error("Malformed record batch");
+        }
+
+        return vColumns;
+    }
+
+
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to read a
+    /// single value from an unaligned position.
+    ///
+    /// \param data const uint8_t*
+    /// \param i int64_t
+    /// \return T
+    ///
+    /////////////////////////////////////////////////
+    template <class T>
+    static T readValue(const uint8_t* data, int64_t i)
+    {
+        T val;
+        std::memcpy(&val, data + i*sizeof(T), sizeof(T));
+        return val;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the selected value of an
+    /// integer column or the selected index of a
+    /// dictionary encoded column.
+    ///
+    /// \param i int64_t
+    /// \return int64_t
+    ///
+    /////////////////////////////////////////////////
+    int64_t ArrowColumnView::getInteger(int64_t i) const
+    {
+        switch (field->nBitWidth)
+        {
+            case 8:
+                return field->isSigned ? (int64_t)readValue<int8_t>(data, i) : (int64_t)readValue<uint8_t>(data, i);
+            case 16:
+                return field->isSigned ? (int64_t)readValue<int16_t>(data, i) : (int64_t)readValue<uint16_t>(data, i);
+            case 32:
+                return field->isSigned ? (int64_t)readValue<int32_t>(data, i) : (int64_t)readValue<uint32_t>(data, i);
+        }
+
+        return readValue<int64_t>(data, i);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the selected value of a
+    /// numerical column as floating point value. For
+    /// complex columns, the real part is returned.
+    ///
+    /// \param i int64_t
+    /// \return double
+    ///
+    /////////////////////////////////////////////////
+    double ArrowColumnView::getFloat(int64_t i) const
+    {
+        if (field->type == ARROW_INT)
+            return field->isSigned || field->nBitWidth < 64 ? getInteger(i) : (double)readValue<uint64_t>(data, i);
+
+        if (field->nBitWidth == 32)
+            return readValue<float>(data, i);
+
+        return readValue<double>(data, i);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the imaginary part of the
+    /// selected value of a complex column.
+    ///
+    /// \param i int64_t
+    /// \return double
+    ///
+    /////////////////////////////////////////////////
+    double ArrowColumnView::getImag(int64_t i) const
+    {
+        if (field->nBitWidth == 32)
+            return readValue<float>(imagData, i);
+
+        return readValue<double>(imagData, i);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the selected value of a
+    /// timestamp or date column as seconds since
+    /// the epoch.
+    ///
+    /// \param i int64_t
+    /// \return double
+    ///
+    /////////////////////////////////////////////////
+    double ArrowColumnView::getSeconds(int64_t i) const
+    {
+        if (field->type == ARROW_DATE)
+        {
+            if (field->unit == UNIT_SECOND)
+                return readValue<int32_t>(data, i) * 86400.0;
+
+            return readValue<int64_t>(data, i) / 1000.0;
+        }
+
+        return readValue<int64_t>(data, i) / std::pow(1000.0, (int)field->unit);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the selected value of a
+    /// boolean column.
+    ///
+    /// \param i int64_t
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool ArrowColumnView::getBool(int64_t i) const
+    {
+        return (data[i / 8] >> (i % 8)) & 1;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the selected value of a string
+    /// or dictionary encoded column.
+    ///
+    /// \param i int64_t
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    std::string ArrowColumnView::getString(int64_t i) const
+    {
+        if (dictionary)
+        {
+            int64_t nIndex = getInteger(i);
+
+            if (nIndex < 0 || nIndex >= (int64_t)dictionary->size())
+                return "";
+
+            return (*dictionary)[nIndex];
+        }
+
+        if (offsets[i] < 0 || offsets[i] >= offsets[i+1] || offsets[i+1] > offsets[nLength])
+            return "";
+
+        return std::string((const char*)data + offsets[i], offsets[i+1] - offsets[i]);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the value of the selected key
+    /// or an empty string, if the key does not
+    /// exist.
+    ///
+    /// \param vMetaData const KeyValueList&
+    /// \param sKey const std::string&
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    std::string getMetaData(const KeyValueList& vMetaData, const std::string& sKey)
+    {
+        for (const auto& kv : vMetaData)
+        {
+            if (kv.first == sKey)
+                return kv.second;
+        }
+
+        return "";
+    }
+}
+
@@ -0,0 +1,224 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef ARROWIPC_HPP
+#define ARROWIPC_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <ostream>
+#include <cstdint>
+
+namespace Arrow
+{
+    /////////////////////////////////////////////////
+    /// \brief The logical column types, which are
+    /// supported by the Arrow IPC reader and
+    /// writer. Complex values are stored as a
+    /// struct of two floating point children.
+    /////////////////////////////////////////////////
+    enum ArrowType
+    {
+        ARROW_UNSUPPORTED,
+        ARROW_INT,
+        ARROW_FLOAT,
+        ARROW_BOOL,
+        ARROW_UTF8,
+        ARROW_TIMESTAMP,
+        ARROW_DATE,
+        ARROW_COMPLEX
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief The time units of timestamps as
+    /// defined by the Arrow format. Dates only use
+    /// DAY (encoded as second) and MILLISECOND.
+    /////////////////////////////////////////////////
+    enum TimeUnit
+    {
+        UNIT_SECOND,
+        UNIT_MILLISECOND,
+        UNIT_MICROSECOND,
+        UNIT_NANOSECOND
+    };
+
+
+    typedef std::vector<std::pair<std::string, std::string>> KeyValueList;
+
+
+    /////////////////////////////////////////////////
+    /// \brief Description of a single column. For
+    /// dictionary encoded columns, the type
+    /// describes the dictionary values and the bit
+    /// width and signedness describe the indices.
+    /////////////////////////////////////////////////
+    struct ArrowField
+    {
+        std::string sName;
+        ArrowType type = ARROW_UNSUPPORTED;
+        int nBitWidth = 0;
+        bool isSigned = true;
+        TimeUnit unit = UNIT_SECOND;
+        bool isDictionary = false;
+        int64_t nDictionaryId = 0;
+        KeyValueList vMetaData;
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief The data of a single column, which
+    /// shall be written. The data buffer contains
+    /// the values, the boolean bitmap, the UTF-8
+    /// characters or the dictionary indices.
+    /// Validity bitmaps may be left empty, if all
+    /// values are valid.
+    /////////////////////////////////////////////////
+    struct ArrowColumn
+    {
+        ArrowField field;
+        int64_t nNullCount = 0;
+        std::vector<uint8_t> vValidity;
+        std::vector<uint8_t> vData;
+        std::vector<uint8_t> vImagData;
+        std::vector<int32_t> vOffsets;
+        std::vector<std::string> vDictionary;
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief A read-only view on the data of a
+    /// single column within a record batch. The
+    /// pointers reference the passed file buffer
+    /// directly, i.e. no data is copied.
+    /////////////////////////////////////////////////
+    struct ArrowColumnView
+    {
+        const ArrowField* field = nullptr;
+        int64_t nLength = 0;
+        int64_t nNullCount = 0;
+        const uint8_t* validity = nullptr;
+        const uint8_t* data = nullptr;
+        const uint8_t* imagData = nullptr;
+        const int32_t* offsets = nullptr;
+        const std::vector<std::string>* dictionary = nullptr;
+
+        /////////////////////////////////////////////////
+        /// \brief Returns true, if the selected value
+        /// is not null.
+        ///
+        /// \param i int64_t
+        /// \return bool
+        ///
+        /////////////////////////////////////////////////
+        bool isValid(int64_t i) const
+        {
+            return !validity || (validity[i / 8] >> (i % 8)) & 1;
+        }
+
+        int64_t getInteger(int64_t i) const;
+        double getFloat(int64_t i) const;
+        double getImag(int64_t i) const;
+        double getSeconds(int64_t i) const;
+        bool getBool(int64_t i) const;
+        std::string getString(int64_t i) const;
+    };
+
+
+    void writeFile(std::ostream& stream, const std::vector<ArrowColumn>& vColumns, int64_t nRows, const KeyValueList& vMetaData);
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class reads an Arrow IPC file
+    /// from a buffer in memory (e.g. a memory
+    /// mapped file). The buffer has to outlive this
+    /// instance and all returned views.
+    /////////////////////////////////////////////////
+    class FileReader
+    {
+        private:
+            /////////////////////////////////////////////////
+            /// \brief Position of a record batch in the
+            /// file.
+            /////////////////////////////////////////////////
+            struct Block
+            {
+                int64_t offset;
+                int32_t metaDataLength;
+                int32_t padding;
+                int64_t bodyLength;
+            };
+
+            const uint8_t* m_data;
+            size_t m_size;
+            std::vector<ArrowField> m_fields;
+            KeyValueList m_metaData;
+            std::vector<Block> m_batches;
+            std::map<int64_t, std::vector<std::string>> m_dictionaries;
+
+            void readFooter();
+            void readDictionary(const Block& block);
+
+        public:
+            FileReader(const char* data, size_t nSize);
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the columns of the file.
+            ///
+            /// \return const std::vector<ArrowField>&
+            ///
+            /////////////////////////////////////////////////
+            const std::vector<ArrowField>& getFields() const
+            {
+                return m_fields;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the custom metadata of the
+            /// file.
+            ///
+            /// \return const KeyValueList&
+            ///
+            /////////////////////////////////////////////////
+            const KeyValueList& getMetaData() const
+            {
+                return m_metaData;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the number of record
+            /// batches in the file.
+            ///
+            /// \return size_t
+            ///
+            /////////////////////////////////////////////////
+            size_t getBatchCount() const
+            {
+                return m_batches.size();
+            }
+
+            std::vector<ArrowColumnView> readBatch(size_t nBatch) const;
+    };
+
+    std::string getMetaData(const KeyValueList& vMetaData, const std::string& sKey);
+}
+
+#endif // ARROWIPC_HPP
+
@@ -20,6 +20,9 @@
 #include <libzygo.hpp>
 
 #include <set>
+#include <atomic>
+#include <cstring>
+#include <omp.h>
 #include <algorithm> // contains std::find_if for datetime detection
 
 #include "file.hpp"
@@ -33,6 +36,8 @@
 #include "../version.h"
 #include "../../kernel.hpp"
 #include "../ParserLib/muHelpers.hpp"
+#include "../ParserLib/muFileMapping.hpp"
+#include "arrowipc.hpp"
 
 #define DEFAULT_PRECISION 14
 
@@ -96,6 +101,9 @@ namespace NumeRe
         if (sExt == "jdx" || sExt == "dx" || sExt == "jcm")
             return new JcampDX(filename);
 
+        if (sExt == "arrow" || sExt == "feather")
+            return new ArrowIpcFile(filename);
+
         // If no filetype matches, return a null pointer
         return nullptr;
     }
@@ -148,6 +156,9 @@ namespace NumeRe
         if (sExt == "jdx" || sExt == "dx" || sExt == "jcm")
             return true;
 
+        if (sExt == "arrow" || sExt == "feather")
+            return true;
+
         // If no filetype matches, return a null pointer
         return false;
     }
@@ -325,6 +336,59 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Formats the rows of the table in
+    /// blocks using the passed function and writes
+    /// the formatted blocks in order to the file. A
+    /// batch of blocks is formatted in parallel
+    /// into independent buffers, before the buffers
+    /// are written sequentially.
+    ///
+    /// \param formatRows const std::function<void(int64_t, int64_t, std::string&)>&
+    /// \return void
+    ///
+    /// \remark The passed function has to format
+    /// the rows [nFirst, nLast) into the passed
+    /// buffer and must not modify any shared state.
+    /////////////////////////////////////////////////
+    void GenericFile::writeRowBlocks(const std::function<void(int64_t, int64_t, std::string&)>& formatRows)
+    {
+        // Estimate the number of rows resulting in a
+        // block of the desired size
+        int64_t nBlockRows = std::max<int64_t>(64, TEXTFILE_BUFFER_SIZE / (16 * std::max<int64_t>(nCols, 1)));
+        int nBatchSize = std::max(1, omp_get_max_threads());
+        std::vector<std::string> vBuffers(nBatchSize);
+
+        for (int64_t nFirst = 0; nFirst < nRows; nFirst += nBatchSize * nBlockRows)
+        {
+            int nBatch = std::min<int64_t>(nBatchSize, (nRows - nFirst + nBlockRows - 1) / nBlockRows);
+            std::atomic<bool> failed(false);
+
+            #pragma omp parallel for if(nBatch > 1)
+            for (int i = 0; i < nBatch; i++)
+            {
+                try
+                {
+                    vBuffers[i].clear();
+                    formatRows(nFirst + i*nBlockRows, std::min(nRows, nFirst + (i+1)*nBlockRows), vBuffers[i]);
+                }
+                catch (...)
+                {
+                    failed = true;
+                }
+            }
+
+            if (failed)
+                throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+            for (int i = 0; i < nBatch; i++)
+            {
+                fFileStream.write(vBuffers[i].data(), vBuffers[i].size());
+            }
+        }
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief This method writes the data in memory
     /// to the referenced text file.
@@ -420,24 +484,25 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void TextDataFile::writeTableContents(const std::vector<size_t>& vColumnWidth)
     {
-        for (long long int i = 0; i < nRows; i++)
-        {
-            for (long long int j = 0; j < nCols; j++)
+        writeRowBlocks([&](int64_t nFirst, int64_t nLast, std::string& sBuffer)
             {
-                fFileStream.width(vColumnWidth[j]+2);
-                fFileStream.fill(' ');
-                fFileStream.precision(nPrecFields);
+                for (int64_t i = nFirst; i < nLast; i++)
+                {
+                    for (long long int j = 0; j < nCols; j++)
+                    {
+                        // Handle NaNs correctly
+                        std::string sCell = fileData->at(j)->isValid(i) ? fileData->at(j)->get(i).printVal(nPrecFields) : "---";
 
-                // Handle NaNs correctly
-                if (!fileData->at(j)->isValid(i))
-                    fFileStream << "---";
-                else
-                    fFileStream << fileData->at(j)->get(i).printVal(nPrecFields);
-            }
+                        // Align the cell to the right
+                        if (sCell.length() < vColumnWidth[j]+2)
+                            sBuffer.append(vColumnWidth[j]+2 - sCell.length(), ' ');
 
-            fFileStream.width(0);
-            fFileStream << "\n";
-        }
+                        sBuffer += sCell;
+                    }
+
+                    sBuffer += '\n';
+                }
+            });
     }
 
 
@@ -1181,6 +1246,148 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief This class encodes the binary fields
+    /// of the NDAT format into a memory buffer. The
+    /// layout is identical to the binary write
+    /// methods of GenericFile.
+    /////////////////////////////////////////////////
+    class BlockEncoder
+    {
+        private:
+            std::string& m_buffer;
+
+        public:
+            BlockEncoder(std::string& buffer) : m_buffer(buffer) {}
+
+            template <typename T> void writeNumField(T num)
+            {
+                m_buffer.append((const char*)&num, sizeof(T));
+            }
+
+            template <typename T> void updateNumField(size_t pos, T num)
+            {
+                m_buffer.replace(pos, sizeof(T), (const char*)&num, sizeof(T));
+            }
+
+            void writeStringField(const std::string& sString)
+            {
+                writeNumField<uint32_t>((uint32_t)sString.length());
+                m_buffer.append(sString);
+            }
+
+            template <typename T> void writeNumBlock(const T* data, int64_t size)
+            {
+                writeNumField<int64_t>(size);
+                m_buffer.append((const char*)data, sizeof(T)*size);
+            }
+
+            void writeStringBlock(const std::vector<std::string>& data)
+            {
+                writeNumField<int64_t>(data.size());
+
+                for (const std::string& sString : data)
+                {
+                    writeStringField(sString);
+                }
+            }
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class decodes the binary fields
+    /// of the NDAT format from a memory buffer. The
+    /// layout is identical to the binary read
+    /// methods of GenericFile. Reading beyond the
+    /// end of the buffer throws.
+    /////////////////////////////////////////////////
+    class BlockDecoder
+    {
+        private:
+            const std::string& m_buffer;
+            size_t m_pos;
+
+            void ensureAvailable(uint64_t nBytes)
+            {
+                if (nBytes > m_buffer.size() - m_pos)
+                    throw SyntaxError(SyntaxError::CANNOT_READ_FILE, "", SyntaxError::invalid_position);
+            }
+
+        public:
+            BlockDecoder(const std::string& buffer) : m_buffer(buffer), m_pos(0) {}
+
+            template <typename T> T readNumField()
+            {
+                T num;
+                ensureAvailable(sizeof(T));
+                memcpy(&num, &m_buffer[m_pos], sizeof(T));
+                m_pos += sizeof(T);
+                return num;
+            }
+
+            std::string readStringField()
+            {
+                uint32_t nLength = readNumField<uint32_t>();
+                ensureAvailable(nLength);
+                m_pos += nLength;
+                return m_buffer.substr(m_pos-nLength, nLength);
+            }
+
+            template <typename T> void readNumBlock(std::vector<T>& data)
+            {
+                int64_t size = readNumField<int64_t>();
+
+                if (size < 0)
+                    throw SyntaxError(SyntaxError::CANNOT_READ_FILE, "", SyntaxError::invalid_position);
+
+                ensureAvailable(size * sizeof(T));
+                data.resize(size);
+
+                if (size)
+                    memcpy(data.data(), &m_buffer[m_pos], size * sizeof(T));
+
+                m_pos += size * sizeof(T);
+            }
+
+            void readStringBlock(std::vector<std::string>& data)
+            {
+                int64_t size = readNumField<int64_t>();
+
+                if (size < 0)
+                    throw SyntaxError(SyntaxError::CANNOT_READ_FILE, "", SyntaxError::invalid_position);
+
+                data.resize(size);
+
+                for (std::string& sString : data)
+                {
+                    sString = readStringField();
+                }
+            }
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief Combines the hashes of the leaves of
+    /// the tree hash (the header and all columns)
+    /// into the checksum of the file.
+    ///
+    /// \param vHashes const std::vector<std::string>&
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    static std::string combineHashes(const std::vector<std::string>& vHashes)
+    {
+        std::string sHashes;
+
+        for (const std::string& sHash : vHashes)
+        {
+            sHashes += sHash;
+        }
+
+        return sha256(sHashes);
+    }
+
+
     //////////////////////////////////////////////
     // class NumeReDataFile
     //////////////////////////////////////////////
@@ -1312,15 +1519,20 @@ namespace NumeRe
 
         // Write the file header
         writeHeader();
+        checkEnd = tellp();
+
+        // The header is the first leaf of the tree
+        // hash
+        std::vector<std::string> vHashes;
+        seekp(checkStart);
+        vHashes.push_back(sha256(fFileStream, checkStart, checkEnd-checkStart));
+        seekp(checkEnd);
 
         // Write the columns
-        for (TblColPtr& col : *fileData)
-            writeColumn(col);
+        writeColumns(vHashes);
 
         size_t posEnd = tellp();
-
-        seekp(checkStart);
-        std::string checkSum = sha256(fFileStream, checkStart, posEnd-checkStart);
+        std::string checkSum = combineHashes(vHashes);
 
         // Update the checksum and file end
         seekp(checkPos);
@@ -1332,6 +1544,63 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Encodes and hashes the columns in
+    /// batches on multiple threads and writes the
+    /// encoded columns sequentially to the file.
+    /// The hashes of the columns are appended to the
+    /// passed vector.
+    ///
+    /// \param vHashes std::vector<std::string>&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void NumeReDataFile::writeColumns(std::vector<std::string>& vHashes)
+    {
+        int nBatchSize = std::max(1, omp_get_max_threads());
+        int nColumns = fileData->size();
+        std::vector<std::string> vBuffers(nBatchSize);
+        size_t nHashOffset = vHashes.size();
+        vHashes.resize(nHashOffset + nColumns);
+
+        for (int nFirst = 0; nFirst < nColumns; nFirst += nBatchSize)
+        {
+            int nBatch = std::min(nBatchSize, nColumns - nFirst);
+            size_t nElements = 0;
+            std::atomic<bool> failed(false);
+
+            for (int i = 0; i < nBatch; i++)
+            {
+                if (fileData->at(nFirst+i))
+                    nElements += fileData->at(nFirst+i)->size();
+            }
+
+            #pragma omp parallel for if(nBatch > 1 && nElements > NDAT_PARALLEL_LIMIT)
+            for (int i = 0; i < nBatch; i++)
+            {
+                try
+                {
+                    vBuffers[i].clear();
+                    encodeColumn(fileData->at(nFirst+i), vBuffers[i]);
+                    vHashes[nHashOffset+nFirst+i] = sha256(vBuffers[i]);
+                }
+                catch (...)
+                {
+                    failed = true;
+                }
+            }
+
+            if (failed)
+                throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+            for (int i = 0; i < nBatch; i++)
+            {
+                fFileStream.write(vBuffers[i].data(), vBuffers[i].size());
+            }
+        }
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Writes a single column to the file.
     ///
@@ -1341,64 +1610,81 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void NumeReDataFile::writeColumn(const TblColPtr& col)
     {
+        std::string buffer;
+        encodeColumn(col, buffer);
+        fFileStream.write(buffer.data(), buffer.size());
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Encodes a single column into the
+    /// passed buffer. The buffer contains exactly
+    /// the bytes, which represent the column in the
+    /// file. Does not access the file and may
+    /// therefore be used on multiple threads.
+    ///
+    /// \param col const TblColPtr&
+    /// \param buffer std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void NumeReDataFile::encodeColumn(const TblColPtr& col, std::string& buffer)
+    {
+        BlockEncoder encoder(buffer);
+
         if (!col)
         {
-            writeStringField("");
-            writeStringField("DTYPE=NONE");
+            encoder.writeStringField("");
+            encoder.writeStringField("DTYPE=NONE");
             return;
         }
 
-        writeStringField(col->m_sHeadLine + (col->m_sUnit.length() ? " [" + col->m_sUnit + "]" : ""));
+        encoder.writeStringField(col->m_sHeadLine + (col->m_sUnit.length() ? " [" + col->m_sUnit + "]" : ""));
 
         if (TableColumn::isValueType(col->m_type)
             || col->m_type == TableColumn::TYPE_DATETIME
             || col->m_type == TableColumn::TYPE_LOGICAL)
         {
             // All these colums write complex values
-            writeStringField("DTYPE=COMPLEX");
+            encoder.writeStringField("DTYPE=COMPLEX");
 
             // Note the type of the column
-            writeStringField("CTYPE="+toUpperCase(TableColumn::typeToString(col->m_type)));
+            encoder.writeStringField("CTYPE="+toUpperCase(TableColumn::typeToString(col->m_type)));
 
-            uint32_t lenPos = tellp();
             // Store the position of the next column
-            writeNumField<uint32_t>(lenPos);
+            size_t lenPos = buffer.size();
+            encoder.writeNumField<uint32_t>(0);
 
             std::vector<std::complex<double>> values = col->getValue(VectorIndex(0, VectorIndex::OPEN_END));
-            writeNumBlock<std::complex<double>>(&values[0], values.size());
+            buffer.reserve(buffer.size() + sizeof(int64_t) + values.size()*sizeof(std::complex<double>));
+            encoder.writeNumBlock<std::complex<double>>(values.data(), values.size());
 
-            uint32_t endPos = tellp();
-            seekp(lenPos);
-            writeNumField<uint32_t>(endPos-lenPos);
-            seekp(endPos);
+            encoder.updateNumField<uint32_t>(lenPos, buffer.size()-lenPos);
         }
         else if (col->m_type == TableColumn::TYPE_STRING
                  || col->m_type == TableColumn::TYPE_CATEGORICAL)
         {
             // All these colums write strings as values
-            writeStringField("DTYPE=STRING");
+            encoder.writeStringField("DTYPE=STRING");
 
             // Note the type of the column
             if (col->m_type == TableColumn::TYPE_STRING)
-                writeStringField("CTYPE=STRING");
+                encoder.writeStringField("CTYPE=STRING");
             else if (col->m_type == TableColumn::TYPE_CATEGORICAL)
-                writeStringField("CTYPE=CATEGORICAL");
+                encoder.writeStringField("CTYPE=CATEGORICAL");
 
-            uint32_t lenPos = tellp();
             // Store the position of the next column
-            writeNumField<uint32_t>(lenPos);
+            size_t lenPos = buffer.size();
+            encoder.writeNumField<uint32_t>(0);
 
             std::vector<std::string> values = col->getValueAsInternalString(VectorIndex(0, VectorIndex::OPEN_END));
-            writeStringBlock(&values[0], values.size());
+            encoder.writeStringBlock(values);
 
-            uint32_t endPos = tellp();
-            seekp(lenPos);
-            writeNumField<uint32_t>(endPos-lenPos);
-            seekp(endPos);
+            encoder.updateNumField<uint32_t>(lenPos, buffer.size()-lenPos);
         }
         else if (col->m_type == TableColumn::TYPE_NONE)
         {
-            writeStringField("DTYPE=NONE");
+            encoder.writeStringField("DTYPE=NONE");
         }
     }
 
@@ -1457,10 +1743,15 @@ namespace NumeRe
             std::string sha_check = readStringField();
             uint32_t fileEnd = readNumField<uint32_t>();
 
-            if (performShaCheck)
-            {
-                size_t checkStart = tellg();
+            checkStart = tellg();
+            sCheckSum.clear();
 
+            // Version 4.2 introduces tree hashes, which are
+            // validated while reading the columns
+            if (performShaCheck && fileVersionRead >= 4.02)
+                sCheckSum = sha_check;
+            else if (performShaCheck)
+            {
                 std::string sha = "SHA-256:" + sha256(fFileStream, checkStart, fileEnd-checkStart);
 
                 // Is it corrupted?
@@ -1515,6 +1806,7 @@ namespace NumeRe
         // Read the dimensions of the table
         nRows = readNumField<int64_t>();
         nCols = readNumField<int64_t>();
+        checkEnd = tellg();
     }
 
 
@@ -1575,12 +1867,7 @@ namespace NumeRe
         if (fileVersionRead >= 4.00)
         {
             if (fileData)
-            {
-                for (TblColPtr& col : *fileData)
-                {
-                    readColumnV4(col);
-                }
-            }
+                readColumnsV4();
 
             return;
         }
@@ -1696,6 +1983,125 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief Reads the columns in v4 format. The
+    /// raw columns are read sequentially in batches
+    /// and decoded and hashed on multiple threads.
+    /// If the file contains a tree hash, it is
+    /// validated afterwards.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void NumeReDataFile::readColumnsV4()
+    {
+        int nBatchSize = std::max(1, omp_get_max_threads());
+        int nColumns = fileData->size();
+        std::vector<std::string> vBuffers(nBatchSize);
+        std::vector<std::string> vHashes;
+        bool checkTreeHash = sCheckSum.length() && fileVersionRead >= 4.02;
+
+        // The header is the first leaf of the tree hash
+        if (checkTreeHash)
+        {
+            size_t dataStart = tellg();
+            vHashes.push_back(sha256(fFileStream, checkStart, checkEnd-checkStart));
+            seekg(dataStart);
+        }
+
+        size_t nHashOffset = vHashes.size();
+        vHashes.resize(nHashOffset + nColumns);
+
+        for (int nFirst = 0; nFirst < nColumns; nFirst += nBatchSize)
+        {
+            int nBatch = std::min(nBatchSize, nColumns - nFirst);
+            size_t nBytes = 0;
+            std::atomic<bool> failed(false);
+
+            for (int i = 0; i < nBatch; i++)
+            {
+                readColumnBlockV4(vBuffers[i]);
+                nBytes += vBuffers[i].size();
+            }
+
+            if (!good())
+                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+            #pragma omp parallel for if(nBatch > 1 && nBytes > NDAT_PARALLEL_LIMIT*sizeof(std::complex<double>))
+            for (int i = 0; i < nBatch; i++)
+            {
+                try
+                {
+                    decodeColumnV4(fileData->at(nFirst+i), vBuffers[i]);
+
+                    if (checkTreeHash)
+                        vHashes[nHashOffset+nFirst+i] = sha256(vBuffers[i]);
+                }
+                catch (...)
+                {
+                    failed = true;
+                }
+            }
+
+            if (failed)
+                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+        }
+
+        // Is it corrupted?
+        if (checkTreeHash && sCheckSum != "SHA-256:" + combineHashes(vHashes))
+            NumeReKernel::issueWarning(_lang.get("COMMON_DATAFILE_CORRUPTED", sFileName));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Reads the raw bytes of a single column
+    /// in v4 format into the passed buffer. Only the
+    /// leading fields of the column are parsed to
+    /// determine its length.
+    ///
+    /// \param buffer std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void NumeReDataFile::readColumnBlockV4(std::string& buffer)
+    {
+        size_t colStart = tellg();
+        size_t colEnd;
+
+        readStringField();
+        std::string sDataType = readStringField();
+
+        if (sDataType == "DTYPE=NONE")
+            colEnd = tellg();
+        else if (sDataType == "DTYPE=COMPLEX")
+        {
+            readStringField();
+            readNumField<uint32_t>();
+
+            // Determine the length from the number of
+            // values, because the length field may
+            // overflow for very large columns
+            int64_t size = readNumField<int64_t>();
+            colEnd = (size_t)tellg() + size * sizeof(std::complex<double>);
+        }
+        else if (sDataType == "DTYPE=STRING")
+        {
+            readStringField();
+            size_t lenPos = tellg();
+            colEnd = lenPos + readNumField<uint32_t>();
+        }
+        else // Unknown columns only provide their end
+            colEnd = readNumField<uint32_t>();
+
+        if (!good() || colEnd < colStart)
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+        buffer.resize(colEnd - colStart);
+        seekg(colStart);
+        fFileStream.read(&buffer[0], buffer.size());
+    }
+
+
     /////////////////////////////////////////////////
     /// \brief Reads a single column from file in v4
     /// format.
@@ -1706,20 +2112,41 @@ namespace NumeRe
     /////////////////////////////////////////////////
     void NumeReDataFile::readColumnV4(TblColPtr& col)
     {
-        std::pair<std::string,std::string> headAndUnit = findAndParseUnit(readStringField());
-        std::string sDataType = readStringField();
+        std::string buffer;
+        readColumnBlockV4(buffer);
+
+        if (!good())
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+        decodeColumnV4(col, buffer);
+    }
 
-        if (sDataType == "DTYPE=NONE")
-            return;
+
+    /////////////////////////////////////////////////
+    /// \brief Decodes a single column in v4 format
+    /// from the passed buffer. Does not access the
+    /// file and may therefore be used on multiple
+    /// threads.
+    ///
+    /// \param col TblColPtr&
+    /// \param buffer const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void NumeReDataFile::decodeColumnV4(TblColPtr& col, const std::string& buffer)
+    {
+        BlockDecoder decoder(buffer);
+        std::pair<std::string,std::string> headAndUnit = findAndParseUnit(decoder.readStringField());
+        std::string sDataType = decoder.readStringField();
 
         if (sDataType == "DTYPE=COMPLEX")
         {
             // Get the actual column type
-            std::string sColType = readStringField();
+            std::string sColType = decoder.readStringField();
             TableColumn::ColumnType type = TableColumn::stringToType(toLowerCase(sColType.substr(sColType.find('=')+1)));
 
             // Jump over the colum end information
-            readNumField<uint32_t>();
+            decoder.readNumField<uint32_t>();
 
             // Create the column for the corresponding CTYPE
             if (sColType == "CTYPE=DATETIME")
@@ -1733,18 +2160,17 @@ namespace NumeRe
 
             col->m_sHeadLine = headAndUnit.first;
             col->m_sUnit = headAndUnit.second;
-            int64_t size = 0;
-            std::complex<double>* values = readNumBlock<std::complex<double>>(size);
-            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::complex<double>>(values, values+size));
-            delete[] values;
+            std::vector<std::complex<double>> values;
+            decoder.readNumBlock(values);
+            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), values);
         }
         else if (sDataType == "DTYPE=STRING")
         {
             // Get the actual column type
-            std::string sColType = readStringField();
+            std::string sColType = decoder.readStringField();
 
             // Jump over the colum end information
-            readNumField<uint32_t>();
+            decoder.readNumField<uint32_t>();
 
             // Create the column for the corresponding CTYPE
             if (sColType == "CTYPE=STRING")
@@ -1756,16 +2182,13 @@ namespace NumeRe
 
             col->m_sHeadLine = headAndUnit.first;
             col->m_sUnit = headAndUnit.second;
-            int64_t size = 0;
-            std::string* strings = readStringBlock(size);
-            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), std::vector<std::string>(strings, strings+size));
-            delete[] strings;
-        }
-        else
-        {
-            // In all other cases: just jump over this column
-            seekg(readNumField<uint32_t>());
+            std::vector<std::string> strings;
+            decoder.readStringBlock(strings);
+            col->setValue(VectorIndex(0, VectorIndex::OPEN_END), strings);
         }
+
+        // All other columns (including DTYPE=NONE)
+        // are skipped
     }
 
 
@@ -1995,7 +2418,7 @@ namespace NumeRe
     // class CacheFile
     //////////////////////////////////////////////
     //
-    CacheFile::CacheFile(const std::string& filename) : NumeReDataFile(filename), nIndexPos(0u)
+    CacheFile::CacheFile(const std::string& filename) : NumeReDataFile(filename), nIndexPos(0u), nCurrentTable(0u), isIncremental(false)
     {
         // Empty constructor
     }
@@ -2046,6 +2469,38 @@ namespace NumeRe
     void CacheFile::readSome()
     {
         reset();
+
+        // Incremental cache files are read table by
+        // table using the table index
+        if (isIncremental)
+        {
+            if (nCurrentTable >= vTables.size())
+                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, "numere.cache", "numere.cache");
+
+            const CacheTable& table = vTables[nCurrentTable++];
+            sTableName = table.name;
+            sComment = table.comment;
+            nRows = table.rows;
+            nCols = table.cols;
+
+            createStorage();
+
+            for (int64_t j = 0; j < nCols; j++)
+            {
+                // Empty columns do not have a block
+                if (!table.blocks[j].length)
+                    continue;
+
+                seekg(table.blocks[j].offset);
+                readColumnV4(fileData->at(j));
+            }
+
+            if (!good())
+                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, "numere.cache", "numere.cache");
+
+            return;
+        }
+
         uint32_t pos = tellg();
 
         if (std::find(vFileIndex.begin(), vFileIndex.end(), pos) == vFileIndex.end())
@@ -2119,9 +2574,19 @@ namespace NumeRe
         // Ensure that the file major version is
         // not larger than the one currently
         // implemented in this class
-        if (fileVerMajor > fileSpecVersionMajor)
+        if (fileVerMajor > cacheSpecVersionMajor)
             throw SyntaxError(SyntaxError::INSUFFICIENT_NUMERE_VERSION, sFileName, SyntaxError::invalid_position, sFileName);
 
+        // Incremental cache files only store the
+        // position of their table index in the header
+        if (fileVerMajor >= 5)
+        {
+            isIncremental = true;
+            nIndexPos = tellg();
+            readTableIndex();
+            return;
+        }
+
         // Read the number of available tables
         // in the cache file
         uint32_t nNumberOfTables = readNumField<uint32_t>();
@@ -2175,6 +2640,187 @@ namespace NumeRe
     }
 
 
+    /////////////////////////////////////////////////
+    /// \brief This member function reads the table
+    /// index of an incremental cache file. The
+    /// position of the index is read from the
+    /// current position in the header.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void CacheFile::readTableIndex()
+    {
+        uint64_t nTableIndex = readNumField<uint64_t>();
+        seekg(nTableIndex);
+
+        vTables.resize(readNumField<uint32_t>());
+        nCurrentTable = 0;
+
+        for (CacheTable& table : vTables)
+        {
+            table.name = readStringField();
+            table.comment = readStringField();
+            table.rows = readNumField<int64_t>();
+            table.cols = readNumField<int64_t>();
+
+            if (table.rows < 0 || table.cols < 0 || !good())
+                throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+            table.blocks.resize(table.cols);
+
+            for (CacheBlock& block : table.blocks)
+            {
+                block.offset = readNumField<uint64_t>();
+                block.length = readNumField<uint64_t>();
+            }
+        }
+
+        if (!good())
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This member function writes the table
+    /// index of an incremental cache file to the
+    /// current position.
+    ///
+    /// \param vSnapshot const std::vector<CacheTable>&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void CacheFile::writeTableIndex(const std::vector<CacheTable>& vSnapshot)
+    {
+        writeNumField<uint32_t>(vSnapshot.size());
+
+        for (const CacheTable& table : vSnapshot)
+        {
+            writeStringField(table.name);
+            writeStringField(table.comment);
+            writeNumField<int64_t>(table.rows);
+            writeNumField<int64_t>(table.blocks.size());
+
+            for (const CacheBlock& block : table.blocks)
+            {
+                writeNumField<uint64_t>(block.offset);
+                writeNumField<uint64_t>(block.length);
+            }
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This member function writes a snapshot
+    /// of the tables to an incremental cache file.
+    /// Only the columns, which are part of the
+    /// snapshot, are written, all other columns
+    /// refer to already existing blocks. If a source
+    /// file is passed, the cache file is rewritten
+    /// completely and the unchanged blocks are
+    /// copied from the source file (compaction).
+    /// Otherwise, the new blocks and the new table
+    /// index are appended to the existing file and
+    /// activated afterwards by updating the index
+    /// position in the header. The block locations
+    /// in the snapshot are updated and the column
+    /// copies are released.
+    ///
+    /// \param vSnapshot std::vector<CacheTable>&
+    /// \param sSourceFile const std::string&
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void CacheFile::writeIncremental(std::vector<CacheTable>& vSnapshot, const std::string& sSourceFile)
+    {
+        std::ifstream source;
+
+        if (sSourceFile.length())
+        {
+            // Open the file in binary mode and truncate
+            // all its contents
+            open(std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+
+            writeNumField<int32_t>(AutoVersion::MAJOR);
+            writeNumField<int32_t>(AutoVersion::MINOR);
+            writeNumField<int32_t>(AutoVersion::BUILD);
+            writeNumField<__time32_t>(time(0));
+            writeStringField("NUMERECACHEFILE");
+            writeNumField(cacheSpecVersionMajor);
+            writeNumField(cacheSpecVersionMinor);
+
+            // Store the position of the index position,
+            // which is updated at the end
+            nIndexPos = tellp();
+            writeNumField<uint64_t>(0);
+
+            source.open(sSourceFile, std::ios::binary | std::ios::in);
+        }
+        else
+        {
+            // Read the existing header to find the
+            // position of the index position
+            readCacheHeader();
+
+            if (!isIncremental)
+                throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+            open(std::ios::binary | std::ios::in | std::ios::out);
+            fFileStream.seekp(0, std::ios::end);
+        }
+
+        std::vector<char> buffer;
+
+        for (CacheTable& table : vSnapshot)
+        {
+            for (size_t j = 0; j < table.blocks.size(); j++)
+            {
+                CacheBlock& block = table.blocks[j];
+
+                if (j < table.columns.size() && table.columns[j])
+                {
+                    // Write the modified column as new block
+                    block.offset = tellp();
+                    writeColumn(table.columns[j]);
+                    block.length = tellp() - block.offset;
+                    table.columns[j].reset();
+                }
+                else if (block.length && source.is_open())
+                {
+                    // Copy the unchanged block from the source
+                    // file in chunks
+                    source.seekg(block.offset);
+                    block.offset = tellp();
+
+                    for (uint64_t nCopied = 0; nCopied < block.length; nCopied += buffer.size())
+                    {
+                        buffer.resize(std::min(block.length - nCopied, (uint64_t)(1 << 20)));
+                        source.read(&buffer[0], buffer.size());
+
+                        if (!source.good())
+                            throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+                        fFileStream.write(&buffer[0], buffer.size());
+                    }
+                }
+            }
+        }
+
+        // Write the new index and make sure that it
+        // is complete before it is activated
+        uint64_t nTableIndex = tellp();
+        writeTableIndex(vSnapshot);
+        fFileStream.flush();
+
+        seekp(nIndexPos);
+        writeNumField<uint64_t>(nTableIndex);
+        fFileStream.flush();
+
+        if (!good())
+            throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+    }
+
+
     //////////////////////////////////////////////
     // class CassyLabx
     //////////////////////////////////////////////
@@ -2570,37 +3216,38 @@ namespace NumeRe
         // Write the headers
         writeHeader();
 
-        // Set the desired output precision
-        fFileStream.precision(nPrecFields);
-
-        // Write the data to the file
-        for (long long int i = 0; i < nRows; i++)
-        {
-            for (long long int j = 0; j < nCols; j++)
+        // Format blocks of rows on multiple threads and
+        // write them to the file
+        writeRowBlocks([&](int64_t nFirst, int64_t nLast, std::string& sBuffer)
             {
-                if (fileData->at(j) && fileData->at(j)->isValid(i))
+                for (int64_t i = nFirst; i < nLast; i++)
                 {
-                    if (TableColumn::isValueType(fileData->at(j)->m_type))
-                        fFileStream << toString(fileData->at(j)->getValue(i), DEFAULT_PRECISION);
-                    else
+                    for (long long int j = 0; j < nCols; j++)
                     {
-                        std::string sValue = fileData->at(j)->getValueAsInternalString(i);
-
-                        if (sValue.find_first_of("\n\",") != std::string::npos)
+                        if (fileData->at(j) && fileData->at(j)->isValid(i))
                         {
-                            replaceAll(sValue, "\"", "\"\"");
-                            fFileStream << "\"" << sValue << "\"";
-                        }
-                        else
-                            fFileStream << sValue;
-                    }
-                }
+                            if (TableColumn::isValueType(fileData->at(j)->m_type))
+                                appendNumber(sBuffer, fileData->at(j)->getValue(i), DEFAULT_PRECISION);
+                            else
+                            {
+                                std::string sValue = fileData->at(j)->getValueAsInternalString(i);
 
-                fFileStream << ",";
-            }
+                                if (sValue.find_first_of("\n\",") != std::string::npos)
+                                {
+                                    replaceAll(sValue, "\"", "\"\"");
+                                    sBuffer += "\"" + sValue + "\"";
+                                }
+                                else
+                                    sBuffer += sValue;
+                            }
+                        }
 
-            fFileStream << "\n";
-        }
+                        sBuffer += ',';
+                    }
+
+                    sBuffer += '\n';
+                }
+            });
 
         fFileStream.flush();
     }
@@ -5286,6 +5933,548 @@ namespace NumeRe
         assign(file);
         return *this;
     }
+
+
+    ArrowIpcFile::ArrowIpcFile(const std::string& filename) : GenericFile(filename)
+    {
+        // Empty constructor
+    }
+
+
+    ArrowIpcFile::~ArrowIpcFile()
+    {
+        // Empty destructor
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to determine,
+    /// whether the selected value of an Arrow column
+    /// is valid.
+    ///
+    /// \param arrowCol const Arrow::ArrowColumn&
+    /// \param i int64_t
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    static bool isArrowValid(const Arrow::ArrowColumn& arrowCol, int64_t i)
+    {
+        return (arrowCol.vValidity[i / 8] >> (i % 8)) & 1;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to create the
+    /// validity bitmap of the passed column.
+    ///
+    /// \param col const TblColPtr&
+    /// \param arrowCol Arrow::ArrowColumn&
+    /// \param nRows int64_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void encodeArrowValidity(const TblColPtr& col, Arrow::ArrowColumn& arrowCol, int64_t nRows)
+    {
+        arrowCol.vValidity.assign((nRows+7) / 8, 0);
+        arrowCol.nNullCount = 0;
+
+        for (int64_t i = 0; i < nRows; i++)
+        {
+            if (col && i < (int64_t)col->size() && col->isValid(i))
+                arrowCol.vValidity[i / 8] |= 1 << (i % 8);
+            else
+                arrowCol.nNullCount++;
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to encode the
+    /// values of a numerical column. Invalid values
+    /// are written as zeros.
+    ///
+    /// \param col const TblColPtr&
+    /// \param arrowCol Arrow::ArrowColumn&
+    /// \param nRows int64_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    template <class T>
+    static void encodeArrowValues(const TblColPtr& col, Arrow::ArrowColumn& arrowCol, int64_t nRows)
+    {
+        arrowCol.vData.assign(nRows*sizeof(T), 0);
+        T* data = (T*)arrowCol.vData.data();
+
+        for (int64_t i = 0; i < nRows; i++)
+        {
+            if (!isArrowValid(arrowCol, i))
+                continue;
+
+            if constexpr (std::is_integral<T>::value)
+                data[i] = std::is_signed<T>::value ? (T)col->get(i).getNum().asI64() : (T)col->get(i).getNum().asUI64();
+            else
+                data[i] = col->getValue(i).real();
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to encode the
+    /// values of a complex column into separate
+    /// buffers for real and imaginary parts.
+    ///
+    /// \param col const TblColPtr&
+    /// \param arrowCol Arrow::ArrowColumn&
+    /// \param nRows int64_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    template <class T>
+    static void encodeArrowComplex(const TblColPtr& col, Arrow::ArrowColumn& arrowCol, int64_t nRows)
+    {
+        arrowCol.vData.assign(nRows*sizeof(T), 0);
+        arrowCol.vImagData.assign(nRows*sizeof(T), 0);
+        T* real = (T*)arrowCol.vData.data();
+        T* imag = (T*)arrowCol.vImagData.data();
+
+        for (int64_t i = 0; i < nRows; i++)
+        {
+            if (!isArrowValid(arrowCol, i))
+                continue;
+
+            std::complex<double> val = col->getValue(i);
+            real[i] = val.real();
+            imag[i] = val.imag();
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This member function writes the
+    /// table as a single record batch into an
+    /// uncompressed Arrow IPC file. The table name,
+    /// the comment and the units are stored in the
+    /// custom metadata.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void ArrowIpcFile::writeFile()
+    {
+        std::vector<Arrow::ArrowColumn> vColumns(nCols);
+
+        for (int64_t j = 0; j < nCols; j++)
+        {
+            const TblColPtr& col = fileData->at(j);
+            Arrow::ArrowColumn& arrowCol = vColumns[j];
+            Arrow::ArrowField& field = arrowCol.field;
+
+            field.sName = col ? col->m_sHeadLine : TableColumn::getDefaultColumnHead(j);
+
+            if (col && col->m_sUnit.length())
+                field.vMetaData.push_back(std::make_pair("numere.unit", col->m_sUnit));
+
+            encodeArrowValidity(col, arrowCol, nRows);
+
+            switch (col ? col->m_type : TableColumn::TYPE_NONE)
+            {
+                case TableColumn::TYPE_VALUE_I8:
+                    field.type = Arrow::ARROW_INT;
+                    field.nBitWidth = 8;
+                    encodeArrowValues<int8_t>(col, arrowCol, nRows);
+                    break;
+                case TableColumn::TYPE_VALUE_UI8:
+                    field.type = Arrow::ARROW_INT;
+                    field.nBitWidth = 8;
+                    field.isSigned = false;
+                    encodeArrowValues<uint8_t>(col, arrowCol, nRows);
+                    break;
+                case TableColumn::TYPE_VALUE_I16:
+                    field.type = Arrow::ARROW_INT;
+                    field.nBitWidth = 16;
+                    encodeArrowValues<int16_t>(col, arrowCol, nRows);
+                    break;
+                case TableColumn::TYPE_VALUE_UI16:
+                    field.type = Arrow::ARROW_INT;
+                    field.nBitWidth = 16;
+                    field.isSigned = false;
+                    encodeArrowValues<uint16_t>(col, arrowCol, nRows);
+                    break;
+                case TableColumn::TYPE_VALUE_I32:
+                    field.type = Arrow::ARROW_INT;
+                    field.nBitWidth = 32;
+                    encodeArrowValues<int32_t>(col, arrowCol, nRows);
+                    break;
+                case TableColumn::TYPE_VALUE_UI32:
+                    field.type = Arrow::ARROW_INT;
+                    field.nBitWidth = 32;
+                    field.isSigned = false;
+                    encodeArrowValues<uint32_t>(col, arrowCol, nRows);
+                    break;
+                case TableColumn::TYPE_VALUE_I64:
+                    field.type = Arrow::ARROW_INT;
+                    field.nBitWidth = 64;
+                    encodeArrowValues<int64_t>(col, arrowCol, nRows);
+                    break;
+                case TableColumn::TYPE_VALUE_UI64:
+                    field.type = Arrow::ARROW_INT;
+                    field.nBitWidth = 64;
+                    field.isSigned = false;
+                    encodeArrowValues<uint64_t>(col, arrowCol, nRows);
+                    break;
+                case TableColumn::TYPE_VALUE_F32:
+                    field.type = Arrow::ARROW_FLOAT;
+                    field.nBitWidth = 32;
+                    encodeArrowValues<float>(col, arrowCol, nRows);
+                    break;
+                case TableColumn::TYPE_VALUE_CF32:
+                    field.type = Arrow::ARROW_COMPLEX;
+                    field.nBitWidth = 32;
+                    encodeArrowComplex<float>(col, arrowCol, nRows);
+                    break;
+                case TableColumn::TYPE_VALUE:
+                    field.type = Arrow::ARROW_COMPLEX;
+                    field.nBitWidth = 64;
+                    encodeArrowComplex<double>(col, arrowCol, nRows);
+                    break;
+                case TableColumn::TYPE_DATETIME:
+                {
+                    // Date-time values are stored as microseconds
+                    field.type = Arrow::ARROW_TIMESTAMP;
+                    field.unit = Arrow::UNIT_MICROSECOND;
+                    field.nBitWidth = 64;
+                    arrowCol.vData.assign(nRows*sizeof(int64_t), 0);
+                    int64_t* data = (int64_t*)arrowCol.vData.data();
+
+                    for (int64_t i = 0; i < nRows; i++)
+                    {
+                        if (isArrowValid(arrowCol, i))
+                            data[i] = std::llround(col->getValue(i).real() * 1e6);
+                    }
+
+                    break;
+                }
+                case TableColumn::TYPE_LOGICAL:
+                {
+                    field.type = Arrow::ARROW_BOOL;
+                    arrowCol.vData.assign((nRows+7) / 8, 0);
+
+                    for (int64_t i = 0; i < nRows; i++)
+                    {
+                        if (isArrowValid(arrowCol, i) && col->getValue(i).real() != 0.0)
+                            arrowCol.vData[i / 8] |= 1 << (i % 8);
+                    }
+
+                    break;
+                }
+                case TableColumn::TYPE_STRING:
+                {
+                    field.type = Arrow::ARROW_UTF8;
+                    arrowCol.vOffsets.assign(1, 0);
+
+                    for (int64_t i = 0; i < nRows; i++)
+                    {
+                        if (isArrowValid(arrowCol, i))
+                        {
+                            std::string sValue = col->getValueAsInternalString(i);
+                            arrowCol.vData.insert(arrowCol.vData.end(), sValue.begin(), sValue.end());
+                        }
+
+                        // The offsets are limited to 32 bit
+                        if (arrowCol.vData.size() > INT32_MAX)
+                            throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+                        arrowCol.vOffsets.push_back(arrowCol.vData.size());
+                    }
+
+                    break;
+                }
+                case TableColumn::TYPE_CATEGORICAL:
+                {
+                    field.type = Arrow::ARROW_UTF8;
+                    field.isDictionary = true;
+                    field.nBitWidth = 32;
+                    field.nDictionaryId = j;
+                    arrowCol.vDictionary = static_cast<CategoricalColumn*>(col.get())->getCategories();
+                    arrowCol.vData.assign(nRows*sizeof(int32_t), 0);
+                    int32_t* data = (int32_t*)arrowCol.vData.data();
+
+                    for (int64_t i = 0; i < nRows; i++)
+                    {
+                        if (isArrowValid(arrowCol, i))
+                            data[i] = col->getValue(i).real() - 1;
+                    }
+
+                    break;
+                }
+                default:
+                    field.type = Arrow::ARROW_FLOAT;
+                    field.nBitWidth = 64;
+                    encodeArrowValues<double>(col, arrowCol, nRows);
+            }
+        }
+
+        Arrow::KeyValueList vMetaData;
+        vMetaData.push_back(std::make_pair("numere.table", getTableName()));
+
+        if (sComment.length())
+            vMetaData.push_back(std::make_pair("numere.comment", sComment));
+
+        open(std::ios::out | std::ios::binary | std::ios::trunc);
+
+        try
+        {
+            Arrow::writeFile(fFileStream, vColumns, nRows, vMetaData);
+        }
+        catch (...)
+        {
+            throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+        }
+
+        if (!fFileStream.good())
+            throw SyntaxError(SyntaxError::CANNOT_SAVE_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to get the
+    /// column type corresponding to the passed Arrow
+    /// field.
+    ///
+    /// \param field const Arrow::ArrowField&
+    /// \return TableColumn::ColumnType
+    ///
+    /////////////////////////////////////////////////
+    static TableColumn::ColumnType getArrowColumnType(const Arrow::ArrowField& field)
+    {
+        switch (field.type)
+        {
+            case Arrow::ARROW_INT:
+            {
+                switch (field.nBitWidth)
+                {
+                    case 8:
+                        return field.isSigned ? TableColumn::TYPE_VALUE_I8 : TableColumn::TYPE_VALUE_UI8;
+                    case 16:
+                        return field.isSigned ? TableColumn::TYPE_VALUE_I16 : TableColumn::TYPE_VALUE_UI16;
+                    case 32:
+                        return field.isSigned ? TableColumn::TYPE_VALUE_I32 : TableColumn::TYPE_VALUE_UI32;
+                }
+
+                return field.isSigned ? TableColumn::TYPE_VALUE_I64 : TableColumn::TYPE_VALUE_UI64;
+            }
+            case Arrow::ARROW_FLOAT:
+                return field.nBitWidth == 32 ? TableColumn::TYPE_VALUE_F32 : TableColumn::TYPE_VALUE_F64;
+            case Arrow::ARROW_COMPLEX:
+                return field.nBitWidth == 32 ? TableColumn::TYPE_VALUE_CF32 : TableColumn::TYPE_VALUE;
+            case Arrow::ARROW_BOOL:
+                return TableColumn::TYPE_LOGICAL;
+            case Arrow::ARROW_UTF8:
+                return field.isDictionary ? TableColumn::TYPE_CATEGORICAL : TableColumn::TYPE_STRING;
+            case Arrow::ARROW_TIMESTAMP:
+            case Arrow::ARROW_DATE:
+                return TableColumn::TYPE_DATETIME;
+            case Arrow::ARROW_UNSUPPORTED:
+                break;
+        }
+
+        return TableColumn::TYPE_NONE;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to copy a whole
+    /// block of primitive values from the mapped
+    /// file into the passed column.
+    ///
+    /// \param col TableColumn*
+    /// \param view const Arrow::ArrowColumnView&
+    /// \param nOffset int64_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    template <class COL, class T>
+    static void copyArrowBlock(TableColumn* col, const Arrow::ArrowColumnView& view, int64_t nOffset)
+    {
+        static_cast<COL*>(col)->setBlock(nOffset, (const T*)view.data, view.nLength);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Static helper function to decode the
+    /// values of a single record batch into the
+    /// passed column starting at the selected row.
+    /// Primitive values are copied as a whole block.
+    ///
+    /// \param col TblColPtr&
+    /// \param view const Arrow::ArrowColumnView&
+    /// \param nOffset int64_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    static void decodeArrowColumn(TblColPtr& col, const Arrow::ArrowColumnView& view, int64_t nOffset)
+    {
+        if (!view.nLength)
+            return;
+
+        if (view.field->type == Arrow::ARROW_INT || view.field->type == Arrow::ARROW_FLOAT)
+        {
+            switch (col->m_type)
+            {
+                case TableColumn::TYPE_VALUE_I8:
+                    copyArrowBlock<I8ValueColumn, int8_t>(col.get(), view, nOffset);
+                    break;
+                case TableColumn::TYPE_VALUE_UI8:
+                    copyArrowBlock<UI8ValueColumn, uint8_t>(col.get(), view, nOffset);
+                    break;
+                case TableColumn::TYPE_VALUE_I16:
+                    copyArrowBlock<I16ValueColumn, int16_t>(col.get(), view, nOffset);
+                    break;
+                case TableColumn::TYPE_VALUE_UI16:
+                    copyArrowBlock<UI16ValueColumn, uint16_t>(col.get(), view, nOffset);
+                    break;
+                case TableColumn::TYPE_VALUE_I32:
+                    copyArrowBlock<I32ValueColumn, int32_t>(col.get(), view, nOffset);
+                    break;
+                case TableColumn::TYPE_VALUE_UI32:
+                    copyArrowBlock<UI32ValueColumn, uint32_t>(col.get(), view, nOffset);
+                    break;
+                case TableColumn::TYPE_VALUE_I64:
+                    copyArrowBlock<I64ValueColumn, int64_t>(col.get(), view, nOffset);
+                    break;
+                case TableColumn::TYPE_VALUE_UI64:
+                    copyArrowBlock<UI64ValueColumn, uint64_t>(col.get(), view, nOffset);
+                    break;
+                case TableColumn::TYPE_VALUE_F32:
+                    copyArrowBlock<F32ValueColumn, float>(col.get(), view, nOffset);
+                    break;
+                default:
+                    copyArrowBlock<F64ValueColumn, double>(col.get(), view, nOffset);
+            }
+
+            // Invalidate the null values afterwards
+            if (view.nNullCount)
+            {
+                for (int64_t i = 0; i < view.nLength; i++)
+                {
+                    if (!view.isValid(i))
+                        col->setValue(nOffset+i, NAN);
+                }
+            }
+
+            return;
+        }
+
+        for (int64_t i = 0; i < view.nLength; i++)
+        {
+            if (!view.isValid(i))
+                continue;
+
+            switch (view.field->type)
+            {
+                case Arrow::ARROW_COMPLEX:
+                    col->setValue(nOffset+i, std::complex<double>(view.getFloat(i), view.getImag(i)));
+                    break;
+                case Arrow::ARROW_BOOL:
+                    col->setValue(nOffset+i, view.getBool(i) ? 1.0 : 0.0);
+                    break;
+                case Arrow::ARROW_UTF8:
+                {
+                    // Dictionary indices are one-based in
+                    // categorical columns
+                    if (view.dictionary)
+                        col->setValue(nOffset+i, std::complex<double>(view.getInteger(i)+1));
+                    else
+                        col->setValue(nOffset+i, view.getString(i));
+
+                    break;
+                }
+                case Arrow::ARROW_TIMESTAMP:
+                case Arrow::ARROW_DATE:
+                    col->setValue(nOffset+i, view.getSeconds(i));
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief This member function reads the
+    /// contents of an Arrow IPC file. The file is
+    /// mapped into memory and all record batches
+    /// are appended to each other.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void ArrowIpcFile::readFile()
+    {
+        mu::FileMapping mapping(sFileName);
+
+        if (!mapping.isValid() || !mapping.size())
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+
+        needsConversion = false;
+
+        try
+        {
+            Arrow::FileReader reader(mapping.data(), mapping.size());
+            const std::vector<Arrow::ArrowField>& vFields = reader.getFields();
+            std::vector<std::vector<Arrow::ArrowColumnView>> vBatches;
+
+            nRows = 0;
+            nCols = vFields.size();
+
+            for (size_t b = 0; b < reader.getBatchCount(); b++)
+            {
+                vBatches.push_back(reader.readBatch(b));
+
+                if (vBatches.back().size())
+                    nRows += vBatches.back().front().nLength;
+            }
+
+            sTableName = Arrow::getMetaData(reader.getMetaData(), "numere.table");
+            sComment = Arrow::getMetaData(reader.getMetaData(), "numere.comment");
+
+            // Ensure that we actually read something
+            if (!nRows || !nCols)
+                throw SyntaxError(SyntaxError::FILE_IS_EMPTY, sFileName, SyntaxError::invalid_position, sFileName);
+
+            createStorage();
+
+            for (int64_t j = 0; j < nCols; j++)
+            {
+                TblColPtr& col = fileData->at(j);
+                convert_if_empty(col, j, getArrowColumnType(vFields[j]));
+
+                if (!col)
+                    continue;
+
+                if (vFields[j].sName.length())
+                    col->m_sHeadLine = vFields[j].sName;
+
+                col->m_sUnit = Arrow::getMetaData(vFields[j].vMetaData, "numere.unit");
+                col->resize(nRows);
+
+                if (col->m_type == TableColumn::TYPE_CATEGORICAL)
+                    static_cast<CategoricalColumn*>(col.get())->setCategories(*vBatches.front()[j].dictionary);
+
+                int64_t nOffset = 0;
+
+                for (const std::vector<Arrow::ArrowColumnView>& vBatch : vBatches)
+                {
+                    decodeArrowColumn(col, vBatch[j], nOffset);
+                    nOffset += vBatch[j].nLength;
+                }
+            }
+        }
+        catch (std::exception&)
+        {
+            throw SyntaxError(SyntaxError::CANNOT_READ_FILE, sFileName, SyntaxError::invalid_position, sFileName);
+        }
+    }
 }
 
 
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <vector>
 #include <utility>
+#include <functional>
 
 #include "zip++.hpp"
 #include "../utils/stringtools.hpp"
@@ -31,6 +32,15 @@
 #include "../datamanagement/tablecolumn.hpp"
 #include "filesystem.hpp"
 
+// Minimal number of elements in a batch of NDAT
+// columns, before they are processed in parallel
+#define NDAT_PARALLEL_LIMIT 100000
+// Size of the buffer for writing text-based
+// files, before it is flushed to the file. This
+// is also the size of a block of rows, which is
+// formatted by a single thread
+#define TEXTFILE_BUFFER_SIZE (1 << 20)
+
 namespace NumeRe
 {
     /////////////////////////////////////////////////
@@ -895,6 +905,8 @@ namespace NumeRe
                 }
             }
 
+            void writeRowBlocks(const std::function<void(int64_t, int64_t, std::string&)>& formatRows);
+
         public:
             // Constructor from filename
             /////////////////////////////////////////////////
@@ -1201,6 +1213,38 @@ namespace NumeRe
                 }
             }
 
+            /////////////////////////////////////////////////
+            /// \brief This method moves the internal data
+            /// to the passed memory address without copying
+            /// it. The target memory must already exist.
+            /// The internal storage is released afterwards.
+            /// External data is copied instead, because it
+            /// is not owned by this instance.
+            ///
+            /// \param data TableColumnArray*
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            void moveData(TableColumnArray* data)
+            {
+                if (useExternalData)
+                {
+                    getData(data);
+                    return;
+                }
+
+                if (data && fileData)
+                {
+                    for (int64_t col = 0; col < nCols; col++)
+                    {
+                        if (fileData->at(col))
+                            data->at(col) = std::move(fileData->at(col));
+                    }
+                }
+
+                clearStorage();
+            }
+
             /////////////////////////////////////////////////
             /// \brief This method returns a pointer to the
             /// internal memory with read and write access.
@@ -1619,20 +1663,27 @@ namespace NumeRe
             int32_t versionMinor;
             int32_t versionBuild;
             const short fileSpecVersionMajor = 4;
-            const short fileSpecVersionMinor = 1;
+            const short fileSpecVersionMinor = 2;
             float fileVersionRead;
             size_t checkPos;
             size_t checkStart;
+            size_t checkEnd;
+            std::string sCheckSum;
 
             void writeHeader();
             void writeDummyHeader();
             void writeFile();
+            void writeColumns(std::vector<std::string>& vHashes);
             void writeColumn(const TblColPtr& col);
+            static void encodeColumn(const TblColPtr& col, std::string& buffer);
             void readHeader(bool performShaCheck = true);
             void skipDummyHeader();
             void readFile();
             void readColumn(TblColPtr& col);
+            void readColumnsV4();
+            void readColumnBlockV4(std::string& buffer);
             void readColumnV4(TblColPtr& col);
+            static void decodeColumnV4(TblColPtr& col, const std::string& buffer);
             void readLegacyFormat();
             void* readGenericField(std::string& type, int64_t& size);
             void deleteGenericData(void* data, const std::string& type);
@@ -1704,27 +1755,73 @@ namespace NumeRe
     };
 
 
+    /////////////////////////////////////////////////
+    /// \brief Location of a single column within an
+    /// incremental cache file together with the
+    /// column revision, which it represents. A
+    /// length of zero denotes an empty column.
+    /////////////////////////////////////////////////
+    struct CacheBlock
+    {
+        uint64_t revision = 0;
+        uint64_t offset = 0;
+        uint64_t length = 0;
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief A single table within an incremental
+    /// cache file. Columns, which have to be
+    /// (re-)written, are passed as a copy in the
+    /// columns array. All other columns reference
+    /// their block in the current cache file.
+    /////////////////////////////////////////////////
+    struct CacheTable
+    {
+        std::string name;
+        std::string comment;
+        int64_t rows = 0;
+        int64_t cols = 0;
+        std::vector<CacheBlock> blocks;
+        TableColumnArray columns;
+    };
+
+
     /////////////////////////////////////////////////
     /// \brief This class resembles the cache file
     /// used to autosave and recover the tables in
     /// memory. It is derived from the NumeRe data
     /// file format and uses its functionalities to
-    /// layout the data in the file: the cache file
-    /// starts with a header containing the number of
-    /// tables in the file and the character
-    /// positions in the file, where each table
-    /// starts. The tables themselves are written in
-    /// the NumeRe data file format.
+    /// layout the data in the file. Since version 5,
+    /// the cache file is incremental: the header
+    /// only references the table index at the end
+    /// of the file. Every column is an independent
+    /// block. Changed columns are appended to the
+    /// file followed by a new table index, which is
+    /// activated by updating the header afterwards.
+    /// Unchanged columns keep their blocks. Older
+    /// cache files start with a header containing
+    /// the number of tables in the file and the
+    /// character positions in the file, where each
+    /// table starts. The tables themselves are
+    /// written in the NumeRe data file format.
     /////////////////////////////////////////////////
     class CacheFile : public NumeReDataFile
     {
         private:
             std::vector<uint32_t> vFileIndex;
+            std::vector<CacheTable> vTables;
             size_t nIndexPos;
+            size_t nCurrentTable;
+            bool isIncremental;
+            const short cacheSpecVersionMajor = 5;
+            const short cacheSpecVersionMinor = 0;
 
             void reset();
             void readSome();
             void writeSome();
+            void readTableIndex();
+            void writeTableIndex(const std::vector<CacheTable>& vSnapshot);
 
 
         public:
@@ -1745,6 +1842,7 @@ namespace NumeRe
 
             void readCacheHeader();
             void writeCacheHeader();
+            void writeIncremental(std::vector<CacheTable>& vSnapshot, const std::string& sSourceFile);
 
             /////////////////////////////////////////////////
             /// \brief Returns the number of tables stored in
@@ -1755,9 +1853,40 @@ namespace NumeRe
             /////////////////////////////////////////////////
             size_t getNumberOfTables()
             {
+                if (isIncremental)
+                    return vTables.size();
+
                 return vFileIndex.size();
             }
 
+            /////////////////////////////////////////////////
+            /// \brief Returns true, if the referenced cache
+            /// file is an incremental cache file.
+            ///
+            /// \return bool
+            ///
+            /////////////////////////////////////////////////
+            bool isIncrementalFile() const
+            {
+                return isIncremental;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the column blocks of the
+            /// table, which has been read last from an
+            /// incremental cache file.
+            ///
+            /// \return std::vector<CacheBlock>
+            ///
+            /////////////////////////////////////////////////
+            std::vector<CacheBlock> getBlocks() const
+            {
+                if (isIncremental && nCurrentTable && nCurrentTable <= vTables.size())
+                    return vTables[nCurrentTable-1].blocks;
+
+                return std::vector<CacheBlock>();
+            }
+
             /////////////////////////////////////////////////
             /// \brief Sets the number of tables to be stored
             /// in the referenced cache file.
@@ -2091,6 +2220,44 @@ namespace NumeRe
 
             ZygoDat& operator=(const ZygoDat& file);
         };
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class resembles the columnar
+    /// Arrow IPC file format (*.arrow), which is
+    /// also used by Feather V2 files. All column
+    /// types are mapped onto the corresponding Arrow
+    /// types. Categorical columns are written as
+    /// dictionaries and complex columns as structs
+    /// of real and imaginary part. The file is
+    /// mapped into memory for reading and the
+    /// columns are filled directly from the mapped
+    /// buffers. Reading and writing is supported
+    /// for this file format. Compressed files are
+    /// not supported.
+    /////////////////////////////////////////////////
+    class ArrowIpcFile : public GenericFile
+    {
+        private:
+            void readFile();
+            void writeFile();
+
+        public:
+            ArrowIpcFile(const std::string& filename);
+            virtual ~ArrowIpcFile();
+
+            virtual bool read() override
+            {
+                readFile();
+                return true;
+            }
+
+            virtual bool write() override
+            {
+                writeFile();
+                return true;
+            }
+    };
 }
 
 
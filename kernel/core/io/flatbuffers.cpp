@@ -0,0 +1,473 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "flatbuffers.hpp"
+
+#include <stdexcept>
+#include <algorithm>
+
+// Initial size of the builder buffer
+#define FLATBUFFERS_INITIAL_SIZE 1024
+
+namespace FlatBuffers
+{
+    /////////////////////////////////////////////////
+    /// \brief Constructor.
+    /////////////////////////////////////////////////
+    Builder::Builder() : m_buffer(FLATBUFFERS_INITIAL_SIZE), m_head(FLATBUFFERS_INITIAL_SIZE), m_minAlign(1), m_tableStart(0)
+    {
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Ensures that the selected number of
+    /// bytes can be prepended. The already written
+    /// data is moved to the end of the enlarged
+    /// buffer.
+    ///
+    /// \param nBytes size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Builder::grow(size_t nBytes)
+    {
+        if (m_head >= nBytes)
+            return;
+
+        size_t nUsed = size();
+        size_t nNewSize = std::max(2*m_buffer.size(), nUsed + nBytes);
+        std::vector<uint8_t> buffer(nNewSize);
+
+        std::memcpy(buffer.data() + nNewSize - nUsed, m_buffer.data() + m_head, nUsed);
+        m_buffer.swap(buffer);
+        m_head = nNewSize - nUsed;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Prepends the selected number of zero
+    /// bytes.
+    ///
+    /// \param nBytes size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Builder::pad(size_t nBytes)
+    {
+        grow(nBytes);
+        m_head -= nBytes;
+        std::memset(m_buffer.data() + m_head, 0, nBytes);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Pads the buffer so that it is aligned
+    /// to the selected alignment after nLength bytes
+    /// have been prepended.
+    ///
+    /// \param nLength size_t
+    /// \param nAlignment size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Builder::preAlign(size_t nLength, size_t nAlignment)
+    {
+        m_minAlign = std::max(m_minAlign, nAlignment);
+        pad((~(size() + nLength) + 1) & (nAlignment - 1));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Prepends the passed raw bytes.
+    ///
+    /// \param data const void*
+    /// \param nBytes size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Builder::prepend(const void* data, size_t nBytes)
+    {
+        grow(nBytes);
+        m_head -= nBytes;
+        std::memcpy(m_buffer.data() + m_head, data, nBytes);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Prepends a reference to the passed
+    /// object.
+    ///
+    /// \param off Offset
+    /// \return Offset
+    ///
+    /////////////////////////////////////////////////
+    Offset Builder::pushOffset(Offset off)
+    {
+        preAlign(sizeof(uint32_t), sizeof(uint32_t));
+        prependRaw<uint32_t>(size() + sizeof(uint32_t) - off);
+        return size();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Creates a zero-terminated string.
+    ///
+    /// \param sString const std::string&
+    /// \return Offset
+    ///
+    /////////////////////////////////////////////////
+    Offset Builder::createString(const std::string& sString)
+    {
+        preAlign(sString.length()+1, sizeof(uint32_t));
+        pad(1);
+        prepend(sString.data(), sString.length());
+        prependRaw<uint32_t>(sString.length());
+        return size();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Creates a vector of references to the
+    /// passed objects.
+    ///
+    /// \param vOffsets const std::vector<Offset>&
+    /// \return Offset
+    ///
+    /////////////////////////////////////////////////
+    Offset Builder::createOffsetVector(const std::vector<Offset>& vOffsets)
+    {
+        preAlign(vOffsets.size()*sizeof(uint32_t), sizeof(uint32_t));
+
+        for (auto iter = vOffsets.rbegin(); iter != vOffsets.rend(); ++iter)
+        {
+            prependRaw<uint32_t>(size() + sizeof(uint32_t) - *iter);
+        }
+
+        prependRaw<uint32_t>(vOffsets.size());
+        return size();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Creates a vector of structs (or
+    /// scalars) from the passed raw data.
+    ///
+    /// \param data const void*
+    /// \param nElems size_t
+    /// \param nElemSize size_t
+    /// \param nAlignment size_t
+    /// \return Offset
+    ///
+    /////////////////////////////////////////////////
+    Offset Builder::createStructVector(const void* data, size_t nElems, size_t nElemSize, size_t nAlignment)
+    {
+        preAlign(nElems*nElemSize, sizeof(uint32_t));
+        preAlign(nElems*nElemSize, nAlignment);
+        prepend(data, nElems*nElemSize);
+        prependRaw<uint32_t>(nElems);
+        return size();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Starts a new table. Its fields have to
+    /// be added before calling endTable(). Tables
+    /// cannot be nested.
+    ///
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Builder::startTable()
+    {
+        m_fields.clear();
+        m_tableStart = size();
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Adds a reference to the passed object
+    /// as field of the current table.
+    ///
+    /// \param nSlot uint16_t
+    /// \param off Offset
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Builder::addOffsetField(uint16_t nSlot, Offset off)
+    {
+        m_fields.push_back(std::make_pair(nSlot, pushOffset(off)));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Finishes the current table by writing
+    /// its vtable in front of it.
+    ///
+    /// \return Offset
+    ///
+    /////////////////////////////////////////////////
+    Offset Builder::endTable()
+    {
+        Offset tableOff = push<int32_t>(0);
+        uint16_t nFields = 0;
+
+        for (const auto& field : m_fields)
+        {
+            nFields = std::max<uint16_t>(nFields, field.first+1);
+        }
+
+        std::vector<uint16_t> vEntries(nFields, 0);
+
+        for (const auto& field : m_fields)
+        {
+            vEntries[field.first] = tableOff - field.second;
+        }
+
+        for (auto iter = vEntries.rbegin(); iter != vEntries.rend(); ++iter)
+        {
+            push<uint16_t>(*iter);
+        }
+
+        push<uint16_t>(tableOff - m_tableStart);
+        Offset vtableOff = push<uint16_t>(sizeof(uint16_t)*(2 + nFields));
+
+        // Let the table reference its vtable
+        int32_t nVtable = vtableOff - tableOff;
+        std::memcpy(m_buffer.data() + m_buffer.size() - tableOff, &nVtable, sizeof(int32_t));
+
+        m_fields.clear();
+        return tableOff;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Finishes the buffer by adding the
+    /// reference to its root table. Returns a
+    /// pointer to the finished buffer, which is
+    /// valid as long as the builder exists.
+    ///
+    /// \param root Offset
+    /// \param nSize size_t&
+    /// \return const uint8_t*
+    ///
+    /////////////////////////////////////////////////
+    const uint8_t* Builder::finish(Offset root, size_t& nSize)
+    {
+        preAlign(sizeof(uint32_t), m_minAlign);
+        pushOffset(root);
+        nSize = size();
+        return m_buffer.data() + m_head;
+    }
+
+
+
+
+    /////////////////////////////////////////////////
+    /// \brief Constructor. Reads the vtable of the
+    /// table at the selected position.
+    ///
+    /// \param buffer const uint8_t*
+    /// \param nSize size_t
+    /// \param pos size_t
+    ///
+    /////////////////////////////////////////////////
+    Table::Table(const uint8_t* buffer, size_t nSize, size_t pos) : m_buffer(buffer), m_size(nSize), m_pos(pos)
+    {
+        int64_t vtable = (int64_t)pos - read<int32_t>(pos);
+
+        if (vtable < 0)
+            throw std::out_of_range("Malformed FlatBuffer");
+
+        m_vtable = vtable;
+        m_vtableSize = read<uint16_t>(m_vtable);
+        check(m_vtable, m_vtableSize);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the root table of the passed
+    /// buffer.
+    ///
+    /// \param buffer const uint8_t*
+    /// \param nSize size_t
+    /// \return Table
+    ///
+    /////////////////////////////////////////////////
+    Table Table::getRoot(const uint8_t* buffer, size_t nSize)
+    {
+        uint32_t root;
+
+        if (nSize < sizeof(uint32_t))
+            throw std::out_of_range("Malformed FlatBuffer");
+
+        std::memcpy(&root, buffer, sizeof(uint32_t));
+        return Table(buffer, nSize, root);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Ensures that the selected range is
+    /// part of the buffer.
+    ///
+    /// \param pos size_t
+    /// \param nBytes size_t
+    /// \return void
+    ///
+    /////////////////////////////////////////////////
+    void Table::check(size_t pos, size_t nBytes) const
+    {
+        if (pos > m_size || nBytes > m_size - pos)
+            throw std::out_of_range("Malformed FlatBuffer");
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the position of the selected
+    /// field or zero, if it is not present.
+    ///
+    /// \param nSlot uint16_t
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t Table::getFieldPos(uint16_t nSlot) const
+    {
+        size_t nVtableEntry = sizeof(uint16_t)*(2 + nSlot);
+
+        if (nVtableEntry + sizeof(uint16_t) > m_vtableSize)
+            return 0;
+
+        uint16_t nOffset = read<uint16_t>(m_vtable + nVtableEntry);
+        return nOffset ? m_pos + nOffset : 0;
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Follows the reference stored at the
+    /// selected position.
+    ///
+    /// \param pos size_t
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t Table::deref(size_t pos) const
+    {
+        return pos + read<uint32_t>(pos);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the selected string field or
+    /// an empty string, if it is not present.
+    ///
+    /// \param nSlot uint16_t
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    std::string Table::getString(uint16_t nSlot) const
+    {
+        size_t pos = getFieldPos(nSlot);
+
+        if (!pos)
+            return "";
+
+        pos = deref(pos);
+        uint32_t nLength = read<uint32_t>(pos);
+        check(pos + sizeof(uint32_t), nLength);
+
+        return std::string((const char*)m_buffer + pos + sizeof(uint32_t), nLength);
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the selected table field.
+    /// Throws, if the field is not present.
+    ///
+    /// \param nSlot uint16_t
+    /// \return Table
+    ///
+    /////////////////////////////////////////////////
+    Table Table::getTable(uint16_t nSlot) const
+    {
+        size_t pos = getFieldPos(nSlot);
+
+        if (!pos)
+            throw std::out_of_range("Missing FlatBuffer table");
+
+        return Table(m_buffer, m_size, deref(pos));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the length of the selected
+    /// vector field or zero, if it is not present.
+    ///
+    /// \param nSlot uint16_t
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t Table::getVectorLength(uint16_t nSlot) const
+    {
+        size_t pos = getFieldPos(nSlot);
+
+        if (!pos)
+            return 0;
+
+        return read<uint32_t>(deref(pos));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the selected element of a
+    /// vector of tables.
+    ///
+    /// \param nSlot uint16_t
+    /// \param i size_t
+    /// \return Table
+    ///
+    /////////////////////////////////////////////////
+    Table Table::getTableElement(uint16_t nSlot, size_t i) const
+    {
+        if (i >= getVectorLength(nSlot))
+            throw std::out_of_range("Missing FlatBuffer table");
+
+        return Table(m_buffer, m_size, deref(deref(getFieldPos(nSlot)) + sizeof(uint32_t)*(i+1)));
+    }
+
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the selected element of a
+    /// vector of strings.
+    ///
+    /// \param nSlot uint16_t
+    /// \param i size_t
+    /// \return std::string
+    ///
+    /////////////////////////////////////////////////
+    std::string Table::getStringElement(uint16_t nSlot, size_t i) const
+    {
+        if (i >= getVectorLength(nSlot))
+            return "";
+
+        size_t pos = deref(deref(getFieldPos(nSlot)) + sizeof(uint32_t)*(i+1));
+        uint32_t nLength = read<uint32_t>(pos);
+        check(pos + sizeof(uint32_t), nLength);
+
+        return std::string((const char*)m_buffer + pos + sizeof(uint32_t), nLength);
+    }
+}
+
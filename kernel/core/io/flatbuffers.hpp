@@ -0,0 +1,253 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef FLATBUFFERS_HPP
+#define FLATBUFFERS_HPP
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+
+namespace FlatBuffers
+{
+    /////////////////////////////////////////////////
+    /// \brief Offset of an object in a FlatBuffer,
+    /// which is under construction. It is counted
+    /// from the end of the buffer.
+    /////////////////////////////////////////////////
+    typedef uint32_t Offset;
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class builds a FlatBuffer from
+    /// back to front, i.e. all children have to be
+    /// created before their parents. Only the
+    /// subset needed for the Arrow IPC metadata is
+    /// implemented (scalars, strings, tables and
+    /// vectors of offsets, scalars and structs).
+    /////////////////////////////////////////////////
+    class Builder
+    {
+        private:
+            std::vector<uint8_t> m_buffer;
+            size_t m_head;
+            size_t m_minAlign;
+            size_t m_tableStart;
+            std::vector<std::pair<uint16_t, Offset>> m_fields;
+
+            void grow(size_t nBytes);
+            void pad(size_t nBytes);
+            void preAlign(size_t nLength, size_t nAlignment);
+            void prepend(const void* data, size_t nBytes);
+
+            /////////////////////////////////////////////////
+            /// \brief Prepends a single scalar value
+            /// without aligning it.
+            ///
+            /// \param val T
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            template <class T>
+            void prependRaw(T val)
+            {
+                prepend(&val, sizeof(T));
+            }
+
+        public:
+            Builder();
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the current size of the
+            /// buffer, which is also the offset of the last
+            /// created object.
+            ///
+            /// \return Offset
+            ///
+            /////////////////////////////////////////////////
+            Offset size() const
+            {
+                return m_buffer.size() - m_head;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Prepends an aligned scalar value and
+            /// returns its offset.
+            ///
+            /// \param val T
+            /// \return Offset
+            ///
+            /////////////////////////////////////////////////
+            template <class T>
+            Offset push(T val)
+            {
+                preAlign(sizeof(T), sizeof(T));
+                prependRaw(val);
+                return size();
+            }
+
+            Offset pushOffset(Offset off);
+            Offset createString(const std::string& sString);
+            Offset createOffsetVector(const std::vector<Offset>& vOffsets);
+            Offset createStructVector(const void* data, size_t nElems, size_t nElemSize, size_t nAlignment);
+
+            /////////////////////////////////////////////////
+            /// \brief Creates a vector of scalar values.
+            ///
+            /// \param vValues const std::vector<T>&
+            /// \return Offset
+            ///
+            /////////////////////////////////////////////////
+            template <class T>
+            Offset createVector(const std::vector<T>& vValues)
+            {
+                return createStructVector(vValues.data(), vValues.size(), sizeof(T), sizeof(T));
+            }
+
+            void startTable();
+
+            /////////////////////////////////////////////////
+            /// \brief Adds a scalar field to the current
+            /// table. Fields with their default value may
+            /// be omitted by the caller.
+            ///
+            /// \param nSlot uint16_t
+            /// \param val T
+            /// \return void
+            ///
+            /////////////////////////////////////////////////
+            template <class T>
+            void addField(uint16_t nSlot, T val)
+            {
+                m_fields.push_back(std::make_pair(nSlot, push(val)));
+            }
+
+            void addOffsetField(uint16_t nSlot, Offset off);
+            Offset endTable();
+
+            const uint8_t* finish(Offset root, size_t& nSize);
+    };
+
+
+    /////////////////////////////////////////////////
+    /// \brief This class is a read-only view on a
+    /// table within a FlatBuffer. All accesses are
+    /// checked against the extents of the buffer
+    /// and throw a std::out_of_range exception, if
+    /// the buffer is malformed.
+    /////////////////////////////////////////////////
+    class Table
+    {
+        private:
+            const uint8_t* m_buffer;
+            size_t m_size;
+            size_t m_pos;
+            size_t m_vtable;
+            uint16_t m_vtableSize;
+
+            void check(size_t pos, size_t nBytes) const;
+            size_t getFieldPos(uint16_t nSlot) const;
+            size_t deref(size_t pos) const;
+
+            /////////////////////////////////////////////////
+            /// \brief Reads a scalar value at the selected
+            /// position.
+            ///
+            /// \param pos size_t
+            /// \return T
+            ///
+            /////////////////////////////////////////////////
+            template <class T>
+            T read(size_t pos) const
+            {
+                check(pos, sizeof(T));
+                T val;
+                std::memcpy(&val, m_buffer+pos, sizeof(T));
+                return val;
+            }
+
+        public:
+            Table(const uint8_t* buffer, size_t nSize, size_t pos);
+            static Table getRoot(const uint8_t* buffer, size_t nSize);
+
+            /////////////////////////////////////////////////
+            /// \brief Returns true, if the selected field
+            /// is present.
+            ///
+            /// \param nSlot uint16_t
+            /// \return bool
+            ///
+            /////////////////////////////////////////////////
+            bool has(uint16_t nSlot) const
+            {
+                return getFieldPos(nSlot) != 0;
+            }
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the value of the selected
+            /// scalar field or the passed default value, if
+            /// it is not present.
+            ///
+            /// \param nSlot uint16_t
+            /// \param defVal T
+            /// \return T
+            ///
+            /////////////////////////////////////////////////
+            template <class T>
+            T get(uint16_t nSlot, T defVal = T()) const
+            {
+                size_t pos = getFieldPos(nSlot);
+
+                if (!pos)
+                    return defVal;
+
+                return read<T>(pos);
+            }
+
+            std::string getString(uint16_t nSlot) const;
+            Table getTable(uint16_t nSlot) const;
+            size_t getVectorLength(uint16_t nSlot) const;
+            Table getTableElement(uint16_t nSlot, size_t i) const;
+            std::string getStringElement(uint16_t nSlot, size_t i) const;
+
+            /////////////////////////////////////////////////
+            /// \brief Returns the selected element of a
+            /// vector of scalars or structs. Structs are
+            /// returned as a whole and have to be mirrored
+            /// by a plain struct with the same layout.
+            ///
+            /// \param nSlot uint16_t
+            /// \param i size_t
+            /// \return T
+            ///
+            /////////////////////////////////////////////////
+            template <class T>
+            T getElement(uint16_t nSlot, size_t i) const
+            {
+                if (i >= getVectorLength(nSlot))
+                    return T();
+
+                return read<T>(deref(getFieldPos(nSlot)) + sizeof(uint32_t) + i*sizeof(T));
+            }
+    };
+}
+
+#endif // FLATBUFFERS_HPP
+
@@ -299,6 +299,10 @@ void DetachedLogger::setLoggingLevel(Logger::LogLevel lvl)
 /////////////////////////////////////////////////
 void DetachedLogger::push_info(const std::string& sInfo)
 {
+    // Files may be read on multiple threads, which
+    // all log their progress
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     if (is_buffering())
         m_buffer.push_back(sInfo);
     else
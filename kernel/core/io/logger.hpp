@@ -22,6 +22,7 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#include <mutex>
 
 #define LOGGER_STARTUP_LINE "NEW INSTANCE STARTUP"
 #define LOGGER_SHUTDOWN_LINE "SESSION WAS TERMINATED SUCCESSFULLY"
@@ -73,6 +74,7 @@ class DetachedLogger : public Logger
 {
     private:
         std::vector<std::string> m_buffer;
+        std::mutex m_mutex;
         Logger::LogLevel m_level;
         bool m_startAfterCrash;
         bool m_hasErrorLogged;
@@ -17,63 +17,41 @@
 ******************************************************************************/
 
 #include "anovaimpl.hpp"
-#include "../datamanagement/memory.hpp"
+#include <numeric>
 
 #include "../io/logger.hpp"
 
 /////////////////////////////////////////////////
 /// \brief This function calculates the mean and
-/// num values for the given node by first
-/// splitting up values into factor groups and
-/// then calculating the means of these groups.
+/// num values for the given node by grouping the
+/// values according to all factors in the
+/// subset of this node. All groups are evaluated
+/// simultaneously in a single pass.
 ///
-/// \param mem const Memory*
-/// \param factorSet const std::vector<std::string>&
-/// \param facIdx size_t
+/// \param factors const std::vector<GroupKey>&
+/// \param values const std::vector<double>&
 /// \return void
 ///
 /////////////////////////////////////////////////
-void FactorNode::calculateMean(const Memory* mem, const std::vector<std::string>& factorSet, size_t facIdx)
+void FactorNode::calculateMean(const std::vector<GroupKey>& factors, const std::vector<double>& values)
 {
-    for (size_t i = 0; i < factorSet.size(); i++)
-    {
-        // positions of all elements, which correspond to the passed values
-        mu::Array catIndex1 = mem->getIndex(facIdx+1, std::vector<std::string>(1, factorSet[i]));
-
-        if (!catIndex1.front().isValid())
-            continue;
-
-        if (parent == nullptr)
-        {
-            means.push_back(mem->avg(catIndex1, VectorIndex(0)));
-            nums.push_back(mem->num(catIndex1, VectorIndex(0)));
-
-            catIndex.push_back(catIndex1);
-        }
-        else
-        {
-            // Intersect with parent groups
-            const std::vector<mu::Array>& catIndicesParent = parent->catIndex;
-
-            for (const mu::Array& catIndex2 : catIndicesParent)
-            {
-                mu::Array intersection;
+    std::vector<const GroupKey*> keys;
 
-                for (const auto& a : catIndex1)
-                    for (const auto& b : catIndex2)
-                        if (a == b)
-                            intersection.push_back(a);
-
-                if (intersection.size() == 0)
-                    continue;
+    for (size_t fac : subset)
+    {
+        keys.push_back(&factors[fac]);
+    }
 
-                means.push_back(mem->avg(intersection, VectorIndex(0)));
-                nums.push_back(mem->num(intersection, VectorIndex(0)));
+    GroupBy groups(keys);
+    GroupStatistics stats = groups.aggregate(values);
 
+    for (size_t g = 0; g < stats.size(); g++)
+    {
+        if (!stats.m_count[g])
+            continue;
 
-                catIndex.push_back(intersection);
-            }
-        }
+        means.push_back(stats.mean(g));
+        nums.push_back((double)stats.m_count[g]);
     }
 }
 
@@ -138,15 +116,15 @@ void AnovaCalculationStructure::buildTreeHelper(FactorNode* node, size_t start,
             child->parent = node;
 
         // calculate SS for new child
-        child->calculateMean(mem, factors[i], i);
+        child->calculateMean(factors, values);
         child->calculateSS();
-        child->calculateDof(factors[i].size());
+        child->calculateDof(factors[i].m_levels);
 
         // Use the category column names as prefixes
-        child->name = mem->memArray[child->subset[0]+1]->m_sHeadLine;
+        child->name = factorNames[child->subset[0]];
 
         for (size_t i = 1; i < child->subset.size(); i++)
-            child->name += " x " + mem->memArray[child->subset[i]+1]->m_sHeadLine;
+            child->name += " x " + factorNames[child->subset[i]];
 
 //        g_logger.info(child->name + ":");
 //        g_logger.info("SS: " + toString(child->SS, 7));;
@@ -222,24 +200,10 @@ void AnovaCalculationStructure::calculateSSInteraction(FactorNode* node)
 /////////////////////////////////////////////////
 void AnovaCalculationStructure::calculateSSWithin(FactorNode* node)
 {
-    //make sure it is 0
-    SS_Within = 0;
-    dof_within = overallNum.real() - node->catIndex.size();
-
-    for (size_t i = 0; i < node->catIndex.size(); i++)
-    {
-        if (mu::isnan(node->means[i]))
-            continue;
-
-        for (const auto& idx : node->catIndex[i])
-        {
-            // these indeces start at 1 ?
-            std::complex<double> val_j = mem->readMem(idx.getNum().asI64()-1, 0).as_cmplx();
-
-            if (!mu::isnan(val_j))
-                SS_Within += val_j * val_j; // S_W
-        }
-    }
+    // The sum of squares of all values was already
+    // calculated during building the tree
+    SS_Within = overallSumSq;
+    dof_within = overallNum.real() - node->means.size();
 
     SS_Within -= node->SS;
 }
@@ -363,22 +327,36 @@ AnovaCalculationStructure::~AnovaCalculationStructure()
 
 /////////////////////////////////////////////////
 /// \brief This function will construct the Tree structure from the
-///     given factors and the provided memory from the table columns the anova
-///     is performed on.
+///     given factors (represented as dense level codes) and the
+///     values the anova is performed on.
 ///
-/// \param _factors const std::vector<std::vector<std::string>>&
-/// \param _mem Memory*
+/// \param _factors std::vector<GroupKey>&&
+/// \param _factorNames const std::vector<std::string>&
+/// \param _values std::vector<double>&&
 /// \param _significance double
 /// \return void
 ///
 /////////////////////////////////////////////////
-void AnovaCalculationStructure::buildTree(const std::vector<std::vector<std::string>>& _factors, Memory* _mem, double _significance)
+void AnovaCalculationStructure::buildTree(std::vector<GroupKey>&& _factors, const std::vector<std::string>& _factorNames, std::vector<double>&& _values, double _significance)
 {
     significance = _significance;
-    factors = _factors;
-    mem = _mem;
-    overallMean = _mem->avg(VectorIndex(0, VectorIndex::OPEN_END), VectorIndex(0));
-    overallNum = _mem->num(VectorIndex(0, VectorIndex::OPEN_END), VectorIndex(0));
+    factors = std::move(_factors);
+    factorNames = _factorNames;
+    values = std::move(_values);
+
+    double sum = 0.0;
+    double sumSq = 0.0;
+
+    #pragma omp parallel for reduction(+:sum,sumSq)
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        sum += values[i];
+        sumSq += values[i]*values[i];
+    }
+
+    overallNum = (double)values.size();
+    overallMean = sum / values.size();
+    overallSumSq = sumSq;
 
     size_t n = factors.size()-1;
     std::vector<size_t> startSet;
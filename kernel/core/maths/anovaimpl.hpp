@@ -17,6 +17,7 @@
 ******************************************************************************/
 #include <gsl/gsl_cdf.h>
 #include "../maths/anova.hpp"
+#include "groupby.hpp"
 
 #include <vector>
 #include <string>
@@ -24,8 +25,6 @@
 #ifndef ANOVAIMPL_HPP
 #define ANOVAIMPL_HPP
 
-class Memory;
-
 /////////////////////////////////////////////////
 /// \brief This class is representing a Node in the Anova
 /// calculation Tree.
@@ -40,7 +39,6 @@ public:
     std::vector<size_t> subset;
     std::string name;
 
-    std::vector<mu::Array> catIndex;
     std::vector<std::complex<double>> means;
     std::vector<std::complex<double>> nums;
     std::complex<double> SS;
@@ -80,7 +78,7 @@ public:
     }
 
     void calculateSS();
-    void calculateMean(const Memory* mem, const std::vector<std::string>& factorSet, size_t facIdx);
+    void calculateMean(const std::vector<GroupKey>& factors, const std::vector<double>& values);
     void calculateDof(size_t factorCnt);
 };
 
@@ -92,12 +90,14 @@ class AnovaCalculationStructure
 {
 private:
     FactorNode* root;
-    Memory* mem;
     double significance = 0;
-    std::vector<std::vector<std::string>> factors;
+    std::vector<GroupKey> factors;
+    std::vector<std::string> factorNames;
+    std::vector<double> values;
 
     std::complex<double> overallMean;
     std::complex<double> overallNum;
+    std::complex<double> overallSumSq;
     std::complex<double> SS_Within;
     double dof_within = 0;
     size_t max_depth = 0;
@@ -116,7 +116,7 @@ public:
 
     AnovaCalculationStructure();
     ~AnovaCalculationStructure();
-    void buildTree(const std::vector<std::vector<std::string>>& _factors, Memory* _mem, double _significance);
+    void buildTree(std::vector<GroupKey>&& _factors, const std::vector<std::string>& _factorNames, std::vector<double>&& _values, double _significance);
     void calculateResults();
     std::vector<AnovaResult> getResults();
 };
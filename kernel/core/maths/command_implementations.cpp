@@ -3683,41 +3683,150 @@ bool writeAudioFile(CommandLineParser& cmdParser)
 
     _accessParser.evalIndices();
 
-    if (_idx.col.size() > 2)
-        return false;
-
     // Find the absolute maximal value
     dMin = fabs(_data.min(_accessParser.getDataObject(), _idx.row, _idx.col));
     dMax = fabs(_data.max(_accessParser.getDataObject(), _idx.row, _idx.col));
 
     dMax = std::max(dMin, dMax);
 
-    nChannels = _idx.col.size() > 1 ? 2 : 1;
+    // Every column is a channel
+    nChannels = _idx.col.size();
+
+    // Sample format: PCM with 8, 16, 24 or 32 bits or
+    // IEEE float with 32 or 64 bits
+    std::string sFormat = cmdParser.getParameterValue("format");
+    int nBits = 16;
+    bool isFloat = false;
+
+    if (sFormat == "pcm8" || sFormat == "pcm16" || sFormat == "pcm24" || sFormat == "pcm32")
+        nBits = StrToInt(sFormat.substr(3));
+    else if (sFormat == "float32" || sFormat == "float64")
+    {
+        nBits = StrToInt(sFormat.substr(5));
+        isFloat = true;
+    }
+    else if (sFormat.length())
+        throw SyntaxError(SyntaxError::INVALID_SETTING, cmdParser.getCommandLine(), sFormat, sFormat);
+
+    // The frame size is stored in a 16 bit field
+    if (nChannels * nBits / 8 > 65535)
+        throw SyntaxError(SyntaxError::TOO_MANY_VECTORS, cmdParser.getCommandLine(), _accessParser.getDataObject()+"(", _accessParser.getDataObject());
 
     std::unique_ptr<Audio::File> audiofile(Audio::getAudioFileByType(sAudioFileName));
 
-    if (!audiofile.get())
+    if (!audiofile.get() || !audiofile->isSeekable())
         return false;
 
-    audiofile.get()->setChannels(nChannels);
-    audiofile.get()->setSampleRate(nSamples);
-    audiofile.get()->newFile();
+    Audio::SeekableFile* seekable = static_cast<Audio::SeekableFile*>(audiofile.get());
+    seekable->setChannels(nChannels);
+    seekable->setSampleRate(nSamples);
+    seekable->setSampleFormat(nBits, isFloat);
+    seekable->newFile();
 
-    if (!audiofile.get()->isValid())
+    if (!seekable->isValid())
         return false;
 
     const std::string& sTab = _accessParser.getDataObject();
+    std::vector<float> vFrames;
 
-    for (size_t i = 0; i < _idx.row.size(); i++)
+    // Write the samples in blocks of interleaved frames
+    for (size_t i = 0; i < _idx.row.size(); i += AUDIO_BLOCK_SIZE)
     {
-        audiofile.get()->write(Audio::Sample(_data.getElement(_idx.row[i],_idx.col[0],sTab).getNum().asF64()/dMax,
-                                             nChannels > 1 ? _data.getElement(_idx.row[i],_idx.col[1],sTab).getNum().asF64()/dMax : NAN));
+        VectorIndex vRows = _idx.row.subidx(i, AUDIO_BLOCK_SIZE);
+        vFrames.assign(vRows.size() * nChannels, 0.0f);
+
+        for (int c = 0; c < nChannels; c++)
+        {
+            mu::Array vChannel = _data.getElement(vRows, VectorIndex(_idx.col[c]), sTab);
+
+            for (size_t n = 0; n < vChannel.size() && n < vRows.size(); n++)
+            {
+                vFrames[n*nChannels+c] = vChannel[n].getNum().asF64() / dMax;
+            }
+        }
+
+        seekable->writeBlock(vFrames);
     }
 
     return true;
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Reads the selected number of frames
+/// from the current position of the audio file
+/// in blocks and writes the first channels
+/// directly into the target columns, which are
+/// converted to single precision first.
+///
+/// \param audiofile const Audio::SeekableFile*
+/// \param _table Memory*
+/// \param _targetIdx const Indices&
+/// \param nLen size_t
+/// \param nTargetChannels size_t
+/// \return void
+///
+/////////////////////////////////////////////////
+static void readAudioFrames(const Audio::SeekableFile* audiofile, Memory* _table, const Indices& _targetIdx, size_t nLen, size_t nTargetChannels)
+{
+    size_t nChannels = audiofile->getChannels();
+    int rowmin = _targetIdx.row.subidx(0, nLen).min();
+    int rowmax = _targetIdx.row.subidx(0, nLen).max();
+
+    // Write the first row for conversion and afterwards
+    // last row for preallocation
+    for (size_t c = 0; c < nTargetChannels; c++)
+    {
+        _table->writeData(rowmin, _targetIdx.col[c], mu::Numerical(0.0F));
+        _table->convertColumns(_targetIdx.col.subidx(c, 1), "value.f32");
+        _table->writeData(rowmax, _targetIdx.col[c], mu::Numerical(0.0F));
+    }
+
+    // Consecutive rows can be written directly as block
+    bool isBlock = _targetIdx.row.isExpanded() && _targetIdx.row.isOrdered();
+    nLen = std::min(nLen, _targetIdx.row.size());
+    std::vector<float> vFrames;
+
+    for (size_t i = 0; i < nLen; i += AUDIO_BLOCK_SIZE)
+    {
+        size_t nFrames = audiofile->readBlock(vFrames, std::min((size_t)AUDIO_BLOCK_SIZE, nLen-i));
+
+        if (!nFrames)
+            break;
+
+        for (size_t c = 0; c < nTargetChannels; c++)
+        {
+            if (isBlock)
+                _table->writeDataBlock(_targetIdx.row[i], _targetIdx.col[c], &vFrames[c], nFrames, nChannels);
+            else
+            {
+                for (size_t n = 0; n < nFrames; n++)
+                {
+                    _table->writeDataDirectUnsafe(_targetIdx.row[i+n], _targetIdx.col[c], vFrames[n*nChannels+c]);
+                }
+            }
+        }
+    }
+
+    if (nTargetChannels == 2)
+    {
+        _table->setHeadLineElement(_targetIdx.col[0], "A_L");
+        _table->setHeadLineElement(_targetIdx.col[1], "A_R");
+    }
+    else if (nTargetChannels > 2)
+    {
+        for (size_t c = 0; c < nTargetChannels; c++)
+        {
+            _table->setHeadLineElement(_targetIdx.col[c], "A_" + toString(c+1));
+        }
+    }
+    else
+        _table->setHeadLineElement(_targetIdx.col[0], "A");
+
+    _table->markModified();
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Reads either the audio file meta
 /// information or the whole audio file to memory.
@@ -3741,64 +3850,21 @@ bool readAudioFile(CommandLineParser& cmdParser)
     {
         std::unique_ptr<Audio::File> audiofile(Audio::getAudioFileByType(sAudioFile));
 
-        if (!audiofile || !audiofile->isValid())
+        if (!audiofile || !audiofile->isValid() || !audiofile->isSeekable())
             return false;
 
         size_t nLen = audiofile->getLength();
-        size_t nChannels = audiofile->getChannels();
+        size_t nTargetChannels = std::min(audiofile->getChannels(), _targetIdx.col.size());
 
         // Try to read the entire file
-        _data.resizeTable(nChannels > 1 && _targetIdx.col.size() > 1
-                          ? _targetIdx.col.subidx(0, 2).max()+1
-                          : _targetIdx.col.front()+1,
-                          sTarget);
-
-        Memory* _table = _data.getTable(sTarget);
-        int rowmin = _targetIdx.row.subidx(0, nLen).min();
-        int rowmax = _targetIdx.row.subidx(0, nLen).max();
-
-        // Write the first row for conversion and afterwards
-        // last row for preallocation
-        _table->writeData(rowmin, _targetIdx.col.front(), mu::Numerical(0.0F));
-        _table->convertColumns(_targetIdx.col.subidx(0, 1), "value.f32");
-        _table->writeData(rowmax, _targetIdx.col.front(), mu::Numerical(0.0F));
-
-        // Same for second channel, if any
-        if (nChannels > 1 && _targetIdx.col.size() > 1)
-        {
-            _table->writeData(rowmin, _targetIdx.col[1], mu::Numerical(0.0F));
-            _table->convertColumns(_targetIdx.col.subidx(1, 1), "value.f32");
-            _table->writeData(rowmax, _targetIdx.col[1], mu::Numerical(0.0F));
-        }
-
-        for (size_t i = 0; i < nLen; i++)
-        {
-            Audio::Sample sample = audiofile->read();
-
-            if (_targetIdx.row.size() <= i)
-                break;
-
-            _table->writeDataDirectUnsafe(_targetIdx.row[i], _targetIdx.col[0], sample.leftOrMono);
-
-            if (nChannels > 1 && _targetIdx.col.size() > 1)
-                _table->writeDataDirectUnsafe(_targetIdx.row[i], _targetIdx.col[1], sample.right);
-        }
-
-        if (nChannels > 1 && _targetIdx.col.size() > 1)
-        {
-            _table->setHeadLineElement(_targetIdx.col[0], "A_L");
-            _table->setHeadLineElement(_targetIdx.col[1], "A_R");
-        }
-        else
-            _table->setHeadLineElement(_targetIdx.col[0], "A");
-
-        _table->markModified();
+        _data.resizeTable(_targetIdx.col.subidx(0, nTargetChannels).max()+1, sTarget);
+        readAudioFrames(static_cast<Audio::SeekableFile*>(audiofile.get()), _data.getTable(sTarget), _targetIdx, nLen, nTargetChannels);
 
         // Create the storage indices
         std::vector<std::complex<double>> vIndices = {_targetIdx.row.min()+1,
             _targetIdx.row.size() < nLen ? _targetIdx.row.max()+1 : _targetIdx.row.min()+nLen,
-            (nChannels > 1 && _targetIdx.col.size() > 1 ? _targetIdx.col.subidx(0, 2).min()+1 : _targetIdx.col.front()+1),
-            (nChannels > 1 && _targetIdx.col.size() > 1 ? _targetIdx.col.subidx(0, 2).max()+1 : _targetIdx.col.front()+1)};
+            _targetIdx.col.subidx(0, nTargetChannels).min()+1,
+            _targetIdx.col.subidx(0, nTargetChannels).max()+1};
 
         cmdParser.setReturnValue(vIndices);
         g_logger.info("Audiofile read.");
@@ -3853,7 +3919,7 @@ bool seekInAudioFile(CommandLineParser& cmdParser)
         return false;
 
     size_t nLen = audiofile->getLength();
-    size_t nChannels = audiofile->getChannels();
+    size_t nTargetChannels = std::min(audiofile->getChannels(), _targetIdx.col.size());
 
     if (!audiofile->isSeekable() || std::max(vSeekIndices[0].front().getNum().asF64()-1, 0.0) >= nLen)
         return false;
@@ -3864,49 +3930,8 @@ bool seekInAudioFile(CommandLineParser& cmdParser)
     nLen = std::min(nLen - seekable->getPosition(), (size_t)(std::max(vSeekIndices[1].front().getNum().asF64(), 0.0)));
 
     // Try to read the desired length from the file
-    _data.resizeTable(nChannels > 1 && _targetIdx.col.size() > 1 ? _targetIdx.col.subidx(0, 2).max()+1 : _targetIdx.col.front()+1,
-                      sTarget);
-
-    Memory* _table = _data.getTable(sTarget);
-    int rowmin = _targetIdx.row.subidx(0, nLen).min();
-    int rowmax = _targetIdx.row.subidx(0, nLen).max();
-
-    // Write the first row for conversion and afterwards
-    // last row for preallocation
-    _table->writeData(rowmin, _targetIdx.col.front(), mu::Numerical(0.0F));
-    _table->convertColumns(_targetIdx.col.subidx(0, 1), "value.f32");
-    _table->writeData(rowmax, _targetIdx.col.front(), mu::Numerical(0.0F));
-
-    // Same for second channel, if any
-    if (nChannels > 1 && _targetIdx.col.size() > 1)
-    {
-        _table->writeData(rowmin, _targetIdx.col[1], mu::Numerical(0.0F));
-        _table->convertColumns(_targetIdx.col.subidx(1, 1), "value.f32");
-        _table->writeData(rowmax, _targetIdx.col[1], mu::Numerical(0.0F));
-    }
-
-    for (size_t i = 0; i < nLen; i++)
-    {
-        Audio::Sample sample = seekable->read();
-
-        if (_targetIdx.row.size() <= i)
-            break;
-
-        _table->writeDataDirectUnsafe(_targetIdx.row[i], _targetIdx.col[0], sample.leftOrMono);
-
-        if (nChannels > 1 && _targetIdx.col.size() > 1)
-            _table->writeDataDirectUnsafe(_targetIdx.row[i], _targetIdx.col[1], sample.right);
-    }
-
-    _table->markModified();
-
-    if (nChannels > 1 && _targetIdx.col.size() > 1)
-    {
-        _table->setHeadLineElement(_targetIdx.col[0], "A_L");
-        _table->setHeadLineElement(_targetIdx.col[1], "A_R");
-    }
-    else
-        _table->setHeadLineElement(_targetIdx.col[0], "A");
+    _data.resizeTable(_targetIdx.col.subidx(0, nTargetChannels).max()+1, sTarget);
+    readAudioFrames(seekable.get(), _data.getTable(sTarget), _targetIdx, nLen, nTargetChannels);
 
     cmdParser.setReturnValue(toString(nLen));
     g_logger.info("Seeked portion read.");
@@ -18,6 +18,7 @@
 
 #include "define.hpp"
 #include "../../kernel.hpp"
+#include "../utils/kernelstats.hpp"
 
 //////////////////////////////////
 // CLASS FUNCTIONDEFINITION
@@ -872,6 +873,7 @@ bool FunctionDefinitionManager::call(std::string& sExpr, int nRecursion)
             // passed arguments
             sImpFunc = iter->second.parse(sArgs.to_string());
             StripSpaces(sImpFunc);
+            g_kernelStats.count(KC_DEFINITION_EXPANSIONS);
 
             // Remove obsolete duplicated parenthesis pairs
             while (expr.match("))", nPos) && sTemp.ends_with("(("))
@@ -437,7 +437,7 @@ static vector<double> evaluateFittingParams(FittingData& fitData, string& sCmd,
     FunctionDefinitionManager& _functions = NumeReKernel::getInstance()->getDefinitions();
 
     vector<double> vInterVal;
-    static const string sBADFUNCTIONS = "ascii(),char(),findfile(),findparam(),gauss(),getopt(),is_string(),rand(),replace(),replaceall(),split(),strfnd(),string_cast(),strrfnd(),strlen(),time(),to_char(),to_cmd(),to_string(),to_value()";
+    static const string sBADFUNCTIONS = "ascii(),char(),findfile(),findparam(),gauss(),getopt(),is_string(),rand(),replace(),replaceall(),setseed(),split(),strfnd(),string_cast(),strrfnd(),strlen(),time(),to_char(),to_cmd(),to_string(),to_value()";
 
     // Evaluate the chi^2 map option
     if (findParameter(sCmd, "chimap", '='))
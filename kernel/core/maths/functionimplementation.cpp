@@ -43,6 +43,7 @@ extern double g_pixelScale;
 #include "../datamanagement/memorymanager.hpp"
 #endif
 #include "../utils/tools.hpp"
+#include "../utils/counterrandgen.hpp"
 #include "../../versioninformation.hpp"
 #include "../ParserLib/muValueImpl.hpp"
 
@@ -2551,16 +2552,16 @@ mu::Array numfnc_theta(const mu::Array& x, const mu::Array& y, const mu::Array&
 ///
 /// \param vRandMin const std::complex<double>&
 /// \param vRandMax const std::complex<double>&
+/// \param gen CounterRandGen&
 /// \return std::complex<double>
 ///
 /////////////////////////////////////////////////
-static std::complex<double> rand_impl(const std::complex<double>& vRandMin, const std::complex<double>& vRandMax)
+static std::complex<double> rand_impl(const std::complex<double>& vRandMin, const std::complex<double>& vRandMax, CounterRandGen& gen)
 {
     if (mu::isinf(vRandMin) || mu::isnan(vRandMin) || mu::isinf(vRandMax) || mu::isnan(vRandMax))
         return NAN;
 
-    static std::uniform_real_distribution<double> randDist(0, 1);
-    return randDist(getRandGenInstance()) * (vRandMax - vRandMin) + vRandMin;
+    return gen.uniform() * (vRandMax - vRandMin) + vRandMin;
 }
 
 
@@ -2570,16 +2571,16 @@ static std::complex<double> rand_impl(const std::complex<double>& vRandMin, cons
 ///
 /// \param vRandAvg const std::complex<double>&
 /// \param vRandstd const std::complex<double>&
+/// \param gen CounterRandGen&
 /// \return std::complex<double>
 ///
 /////////////////////////////////////////////////
-static std::complex<double> gauss_rand_impl(const std::complex<double>& vRandAvg, const std::complex<double>& vRandstd)
+static std::complex<double> gauss_rand_impl(const std::complex<double>& vRandAvg, const std::complex<double>& vRandstd, CounterRandGen& gen)
 {
     if (mu::isinf(vRandAvg) || mu::isnan(vRandAvg) || mu::isinf(vRandstd) || mu::isnan(vRandstd))
         return NAN;
 
-    static std::normal_distribution<double> randDist(0, 1);
-    return randDist(getRandGenInstance()) * fabs(vRandstd) + vRandAvg;
+    return gen.normal() * fabs(vRandstd) + vRandAvg;
 }
 
 
@@ -2611,10 +2612,16 @@ mu::Array rndfnc_Random(const mu::Array& vRandMin, const mu::Array& vRandMax, co
 
     mu::Array ret(nRandCount, mu::Value());
 
+    // Every element is drawn from its own sequence,
+    // which only depends on seed, stream and index
+    uint64_t seed = getRandSeed();
+    uint64_t stream = reserveRandStream();
+
     #pragma omp parallel for if(nRandCount > 500)
     for (size_t i = 0; i < nRandCount; i++)
     {
-        ret[i] = mu::Value(rand_impl(vRandMin.get(i).getNum().asCF64(), vRandMax.get(i).getNum().asCF64()));
+        CounterRandGen gen(seed, stream, i);
+        ret[i] = mu::Value(rand_impl(vRandMin.get(i).getNum().asCF64(), vRandMax.get(i).getNum().asCF64(), gen));
     }
 
     return ret;
@@ -2649,16 +2656,42 @@ mu::Array rndfnc_gRandom(const mu::Array& vRandAvg, const mu::Array& vRandStd, c
 
     mu::Array ret(nRandCount, mu::Value());
 
+    uint64_t seed = getRandSeed();
+    uint64_t stream = reserveRandStream();
+
     #pragma omp parallel for if(nRandCount > 500)
     for (size_t i = 0; i < nRandCount; i++)
     {
-        ret[i] = mu::Value(gauss_rand_impl(vRandAvg.get(i).getNum().asCF64(), vRandStd.get(i).getNum().asCF64()));
+        CounterRandGen gen(seed, stream, i);
+        ret[i] = mu::Value(gauss_rand_impl(vRandAvg.get(i).getNum().asCF64(), vRandStd.get(i).getNum().asCF64(), gen));
     }
 
     return ret;
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This function sets the seed of all
+/// random number functions and resets the draw
+/// counters of their call sites. All following
+/// draws are therefore reproducible independent
+/// on the number of threads.
+///
+/// \param seed const mu::Array&
+/// \return mu::Array
+///
+/////////////////////////////////////////////////
+mu::Array rndfnc_setseed(const mu::Array& seed)
+{
+    if (seed.getCommonType() != mu::TYPE_NUMERICAL)
+        throw mu::ParserError(mu::ecTYPE_NO_VAL, seed.getCommonTypeAsString());
+
+    setRandSeed(seed.getAsScalarInt());
+
+    return seed;
+}
+
+
 /////////////////////////////////////////////////
 /// \brief Internal implementation of the error
 /// function.
@@ -4880,17 +4913,18 @@ mu::Array timfnc_as_time(const mu::Array& h, const mu::Array& m, const mu::Array
 /// from the Laplace distribution function.
 ///
 /// \param a const std::complex<double>&
+/// \param r const gsl_rng*
 /// \return std::complex<double>
 ///
 /////////////////////////////////////////////////
-static std::complex<double> rndfnc_laplace_rd(const std::complex<double>& a)
+static std::complex<double> rndfnc_laplace_rd(const std::complex<double>& a, const gsl_rng* r)
 {
     // Check the input values
     if (mu::isnan(a) || a.imag() != 0 || a.real() <= 0)
         return NAN;
 
     // Get the value from the probability density function
-    return gsl_ran_laplace(getGslRandGenInstance(), a.real());
+    return gsl_ran_laplace(r, a.real());
 }
 
 
@@ -5000,17 +5034,18 @@ static std::complex<double> rndfnc_laplace_inv_q(const std::complex<double>& q,
 /// from the Cauchy distribution function.
 ///
 /// \param a const std::complex<double>&
+/// \param r const gsl_rng*
 /// \return std::complex<double>
 ///
 /////////////////////////////////////////////////
-static std::complex<double> rndfnc_cauchy_rd(const std::complex<double>& a)
+static std::complex<double> rndfnc_cauchy_rd(const std::complex<double>& a, const gsl_rng* r)
 {
     // Check the input values
     if (mu::isnan(a) || a.imag() != 0 || a.real() <= 0)
         return NAN;
 
     // Get the value from the probability density function
-    return gsl_ran_cauchy(getGslRandGenInstance(), a.real());
+    return gsl_ran_cauchy(r, a.real());
 }
 
 
@@ -5120,17 +5155,18 @@ static std::complex<double> rndfnc_cauchy_inv_q(const std::complex<double>& q, c
 /// from the Rayleigh distribution function.
 ///
 /// \param sigma const std::complex<double>&
+/// \param r const gsl_rng*
 /// \return std::complex<double>
 ///
 /////////////////////////////////////////////////
-static std::complex<double> rndfnc_rayleigh_rd(const std::complex<double>& sigma)
+static std::complex<double> rndfnc_rayleigh_rd(const std::complex<double>& sigma, const gsl_rng* r)
 {
     // Check the input values
     if (mu::isnan(sigma) || sigma.imag() != 0 || sigma.real() <= 0)
         return NAN;
 
     // Get the value from the probability density function
-    return gsl_ran_rayleigh(getGslRandGenInstance(), sigma.real());
+    return gsl_ran_rayleigh(r, sigma.real());
 }
 
 
@@ -5260,17 +5296,18 @@ static std::complex<double> rndfnc_landau_pdf(const std::complex<double>& x)
 ///
 /// \param c const std::complex<double>&
 /// \param alpha const std::complex<double>&
+/// \param r const gsl_rng*
 /// \return std::complex<double>
 ///
 /////////////////////////////////////////////////
-static std::complex<double> rndfnc_levyAlphaStable_rd(const std::complex<double>& c, const std::complex<double>& alpha)
+static std::complex<double> rndfnc_levyAlphaStable_rd(const std::complex<double>& c, const std::complex<double>& alpha, const gsl_rng* r)
 {
     // Check the input values
     if (mu::isnan(c) || c.imag() != 0 || c.real() < 0 || mu::isnan(alpha) || alpha.imag() != 0 || alpha.real() <= 0 || alpha.real() > 2)
         return NAN;
 
     // Get the value from the probability density function
-    return gsl_ran_levy(getGslRandGenInstance(), c.real(), alpha.real());
+    return gsl_ran_levy(r, c.real(), alpha.real());
 }
 
 
@@ -5280,17 +5317,18 @@ static std::complex<double> rndfnc_levyAlphaStable_rd(const std::complex<double>
 ///
 /// \param nu1 const std::complex<double>&
 /// \param nu2 const std::complex<double>&
+/// \param r const gsl_rng*
 /// \return std::complex<double>
 ///
 /////////////////////////////////////////////////
-static std::complex<double> rndfnc_fisher_f_rd(const std::complex<double>& nu1, const std::complex<double>& nu2)
+static std::complex<double> rndfnc_fisher_f_rd(const std::complex<double>& nu1, const std::complex<double>& nu2, const gsl_rng* r)
 {
     // Check the input values
     if (mu::isnan(nu1) || nu1.imag() != 0 || nu1.real() <= 0 || mu::isnan(nu2) || nu2.imag() != 0 || nu2.real() <= 0 || !isInt(nu1.real()) || !isInt(nu2.real()))
         return NAN;
 
     // Get the value from the probability density function
-    return gsl_ran_fdist(getGslRandGenInstance(), intCast(nu1.real()), intCast(nu2.real()));
+    return gsl_ran_fdist(r, intCast(nu1.real()), intCast(nu2.real()));
 }
 
 
@@ -5406,17 +5444,18 @@ static std::complex<double> rndfnc_fisher_f_inv_q(const std::complex<double>& q,
 ///
 /// \param a const std::complex<double>&
 /// \param b const std::complex<double>&
+/// \param r const gsl_rng*
 /// \return std::complex<double>
 ///
 /////////////////////////////////////////////////
-static std::complex<double> rndfnc_weibull_rd(const std::complex<double>& a, const std::complex<double>& b)
+static std::complex<double> rndfnc_weibull_rd(const std::complex<double>& a, const std::complex<double>& b, const gsl_rng* r)
 {
     // Check the input values
     if (mu::isnan(a) || a.real() == 0 || mu::isnan(b))
         return NAN;
 
     // Get the value from the probability density function
-    return gsl_ran_weibull(getGslRandGenInstance(), a.real(), b.real());
+    return gsl_ran_weibull(r, a.real(), b.real());
 }
 
 
@@ -5534,17 +5573,18 @@ static std::complex<double> rndfnc_weibull_inv_q(const std::complex<double>& q,
 /// from the Student t-distribution function.
 ///
 /// \param nu const std::complex<double>&
+/// \param r const gsl_rng*
 /// \return std::complex<double>
 ///
 /////////////////////////////////////////////////
-static std::complex<double> rndfnc_student_t_rd(const std::complex<double>& nu)
+static std::complex<double> rndfnc_student_t_rd(const std::complex<double>& nu, const gsl_rng* r)
 {
     // Check the input values
     if (mu::isnan(nu) || nu.imag() != 0 || nu.real() <= 0 || !isInt(nu.real()))
         return NAN;
 
     // Get the value from the probability density function
-    return gsl_ran_tdist(getGslRandGenInstance(), intCast(nu.real()));
+    return gsl_ran_tdist(r, intCast(nu.real()));
 }
 
 
@@ -5672,10 +5712,14 @@ mu::Array rndfnc_laplace_rd(const mu::Array& a, const mu::Array& n)
 
     mu::Array ret(nRandCount, mu::Value());
 
+    uint64_t seed = getRandSeed();
+    uint64_t stream = reserveRandStream();
+
     #pragma omp parallel for if(nRandCount > 500)
     for (size_t i = 0; i < nRandCount; i++)
     {
-        ret[i] = mu::Value(rndfnc_laplace_rd(a.get(i).getNum().asCF64()));
+        CounterRandGen gen(seed, stream, i);
+        ret[i] = mu::Value(rndfnc_laplace_rd(a.get(i).getNum().asCF64(), gen.gsl()));
     }
 
     return ret;
@@ -5786,10 +5830,14 @@ mu::Array rndfnc_cauchy_rd(const mu::Array& a, const mu::Array& n)
 
     mu::Array ret(nRandCount, mu::Value());
 
+    uint64_t seed = getRandSeed();
+    uint64_t stream = reserveRandStream();
+
     #pragma omp parallel for if(nRandCount > 500)
     for (size_t i = 0; i < nRandCount; i++)
     {
-        ret[i] = mu::Value(rndfnc_cauchy_rd(a.get(i).getNum().asCF64()));
+        CounterRandGen gen(seed, stream, i);
+        ret[i] = mu::Value(rndfnc_cauchy_rd(a.get(i).getNum().asCF64(), gen.gsl()));
     }
 
     return ret;
@@ -5899,10 +5947,14 @@ mu::Array rndfnc_rayleigh_rd(const mu::Array& sigma, const mu::Array& n)
 
     mu::Array ret(nRandCount, mu::Value());
 
+    uint64_t seed = getRandSeed();
+    uint64_t stream = reserveRandStream();
+
     #pragma omp parallel for if(nRandCount > 500)
     for (size_t i = 0; i < nRandCount; i++)
     {
-        ret[i] = mu::Value(rndfnc_rayleigh_rd(sigma.get(i).getNum().asCF64()));
+        CounterRandGen gen(seed, stream, i);
+        ret[i] = mu::Value(rndfnc_rayleigh_rd(sigma.get(i).getNum().asCF64(), gen.gsl()));
     }
 
     return ret;
@@ -5999,10 +6051,14 @@ mu::Array rndfnc_rayleigh_inv_q(const mu::Array& q, const mu::Array& sigma)
 /////////////////////////////////////////////////
 mu::Array rndfnc_landau_rd(const mu::Array& n)
 {
+    uint64_t seed = getRandSeed();
+    uint64_t stream = reserveRandStream();
+
     if (n.isDefault())
     {
         // Get the value from the probability density function
-        return mu::Value(gsl_ran_landau(getGslRandGenInstance()));
+        CounterRandGen gen(seed, stream, 0);
+        return mu::Value(gsl_ran_landau(gen.gsl()));
     }
 
     mu::Array ret(n.getAsScalarInt(), mu::Value());
@@ -6010,7 +6066,8 @@ mu::Array rndfnc_landau_rd(const mu::Array& n)
     #pragma omp parallel for if(n.getAsScalarInt() > 500)
     for (size_t i = 0; (int64_t)i < n.getAsScalarInt(); i++)
     {
-        ret[i] = mu::Value(gsl_ran_landau(getGslRandGenInstance()));
+        CounterRandGen gen(seed, stream, i);
+        ret[i] = mu::Value(gsl_ran_landau(gen.gsl()));
     }
 
     return ret;
@@ -6058,10 +6115,14 @@ mu::Array rndfnc_levyAlphaStable_rd(const mu::Array& c, const mu::Array& alpha,
 
     mu::Array ret(nRandCount, mu::Value());
 
+    uint64_t seed = getRandSeed();
+    uint64_t stream = reserveRandStream();
+
     #pragma omp parallel for if(nRandCount > 500)
     for (size_t i = 0; i < nRandCount; i++)
     {
-        ret[i] = mu::Value(rndfnc_levyAlphaStable_rd(c.get(i).getNum().asCF64(), alpha.get(i).getNum().asCF64()));;
+        CounterRandGen gen(seed, stream, i);
+        ret[i] = mu::Value(rndfnc_levyAlphaStable_rd(c.get(i).getNum().asCF64(), alpha.get(i).getNum().asCF64(), gen.gsl()));
     }
 
     return ret;
@@ -6095,10 +6156,14 @@ mu::Array rndfnc_fisher_f_rd(const mu::Array& nu1, const mu::Array& nu2, const m
 
     mu::Array ret(nRandCount, mu::Value());
 
+    uint64_t seed = getRandSeed();
+    uint64_t stream = reserveRandStream();
+
     #pragma omp parallel for if(nRandCount > 500)
     for (size_t i = 0; i < nRandCount; i++)
     {
-        ret[i] = mu::Value(rndfnc_fisher_f_rd(nu1.get(i).getNum().asCF64(), nu2.get(i).getNum().asCF64()));
+        CounterRandGen gen(seed, stream, i);
+        ret[i] = mu::Value(rndfnc_fisher_f_rd(nu1.get(i).getNum().asCF64(), nu2.get(i).getNum().asCF64(), gen.gsl()));
     }
 
     return ret;
@@ -6217,10 +6282,14 @@ mu::Array rndfnc_weibull_rd(const mu::Array& a, const mu::Array& b, const mu::Ar
 
     mu::Array ret(nRandCount, mu::Value());
 
+    uint64_t seed = getRandSeed();
+    uint64_t stream = reserveRandStream();
+
     #pragma omp parallel for if(nRandCount > 500)
     for (size_t i = 0; i < nRandCount; i++)
     {
-        ret[i] = mu::Value(rndfnc_weibull_rd(a.get(i).getNum().asCF64(), b.get(i).getNum().asCF64()));
+        CounterRandGen gen(seed, stream, i);
+        ret[i] = mu::Value(rndfnc_weibull_rd(a.get(i).getNum().asCF64(), b.get(i).getNum().asCF64(), gen.gsl()));
     }
 
     return ret;
@@ -6335,10 +6404,14 @@ mu::Array rndfnc_student_t_rd(const mu::Array& nu, const mu::Array& n)
 
     mu::Array ret(nRandCount, mu::Value());
 
+    uint64_t seed = getRandSeed();
+    uint64_t stream = reserveRandStream();
+
     #pragma omp parallel for if(nRandCount > 500)
     for (size_t i = 0; i < nRandCount; i++)
     {
-        ret[i] = mu::Value(rndfnc_student_t_rd(nu.get(i).getNum().asCF64()));
+        CounterRandGen gen(seed, stream, i);
+        ret[i] = mu::Value(rndfnc_student_t_rd(nu.get(i).getNum().asCF64(), gen.gsl()));
     }
 
     return ret;
@@ -184,6 +184,7 @@ mu::Array rndfnc_billow(const mu::Array& x, const mu::Array& y, const mu::Array&
 mu::Array rndfnc_voronoi(const mu::Array& x, const mu::Array& y, const mu::Array& z, const mu::Array& seed, const mu::Array& freq, const mu::Array& displacement, const mu::Array& usedistance); // OPT=6
 mu::Array rndfnc_Random(const mu::Array& xmin, const mu::Array& xmax, const mu::Array& n); // OPT=1
 mu::Array rndfnc_gRandom(const mu::Array& avg, const mu::Array& stdev, const mu::Array& n); // OPT=1
+mu::Array rndfnc_setseed(const mu::Array& seed);
 mu::Array rndfnc_laplace_rd(const mu::Array& a, const mu::Array& n); // OPT=1
 mu::Array rndfnc_laplace_pdf(const mu::Array& x, const mu::Array& a);
 mu::Array rndfnc_laplace_cdf_p(const mu::Array& x, const mu::Array& a);
@@ -0,0 +1,290 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "groupby.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <omp.h>
+
+// Maximal number of possible key combinations, for
+// which a direct lookup table is used instead of a
+// hash map
+#define GROUPBY_DIRECT_LIMIT (1ull << 24)
+// Minimal number of rows for parallelizing the loops
+#define GROUPBY_PARALLEL_LIMIT 100000
+
+
+/////////////////////////////////////////////////
+/// \brief Constructor. Prepares the statistics
+/// for the passed number of groups.
+///
+/// \param nGroups size_t
+///
+/////////////////////////////////////////////////
+GroupStatistics::GroupStatistics(size_t nGroups)
+    : m_count(nGroups, 0), m_sum(nGroups, 0.0), m_sumSq(nGroups, 0.0),
+      m_min(nGroups, std::numeric_limits<double>::infinity()),
+      m_max(nGroups, -std::numeric_limits<double>::infinity())
+{
+    //
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Merge the partial statistics of
+/// another instance with the same number of
+/// groups into this instance.
+///
+/// \param other const GroupStatistics&
+/// \return void
+///
+/////////////////////////////////////////////////
+void GroupStatistics::merge(const GroupStatistics& other)
+{
+    for (size_t g = 0; g < size(); g++)
+    {
+        m_count[g] += other.m_count[g];
+        m_sum[g] += other.m_sum[g];
+        m_sumSq[g] += other.m_sumSq[g];
+        m_min[g] = std::min(m_min[g], other.m_min[g]);
+        m_max[g] = std::max(m_max[g], other.m_max[g]);
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the mean of the selected
+/// group.
+///
+/// \param group size_t
+/// \return double
+///
+/////////////////////////////////////////////////
+double GroupStatistics::mean(size_t group) const
+{
+    if (!m_count[group])
+        return NAN;
+
+    return m_sum[group] / m_count[group];
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the (sample) variance of the
+/// selected group.
+///
+/// \param group size_t
+/// \return double
+///
+/////////////////////////////////////////////////
+double GroupStatistics::var(size_t group) const
+{
+    if (m_count[group] < 2)
+        return NAN;
+
+    return std::max(0.0, (m_sumSq[group] - m_sum[group]*m_sum[group] / m_count[group]) / (m_count[group] - 1.0));
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Constructor. Maps the combinations of
+/// the key columns to dense group ids. All keys
+/// have to have the same number of rows. If the
+/// number of possible combinations is small
+/// enough, a direct lookup table is used,
+/// otherwise the combinations are hashed.
+///
+/// \param keys const std::vector<const GroupKey*>&
+///
+/////////////////////////////////////////////////
+GroupBy::GroupBy(const std::vector<const GroupKey*>& keys)
+{
+    if (!keys.size())
+        return;
+
+    size_t nRows = keys.front()->m_codes.size();
+    m_groups.resize(nRows);
+
+    // Determine the strides of the compound code
+    // and whether it fits into a signed 64 bit integer
+    std::vector<uint64_t> strides(keys.size());
+    uint64_t combinations = 1;
+    bool fits = true;
+
+    for (size_t k = 0; k < keys.size(); k++)
+    {
+        strides[k] = combinations;
+
+        if (keys[k]->m_levels && combinations > (uint64_t)std::numeric_limits<int64_t>::max() / keys[k]->m_levels)
+        {
+            fits = false;
+            break;
+        }
+
+        combinations *= std::max(keys[k]->m_levels, (size_t)1);
+    }
+
+    if (!fits)
+    {
+        // Fallback for extremely large key spaces
+        std::map<std::vector<int64_t>, int64_t> mGroups;
+        std::vector<int64_t> tuple(keys.size());
+
+        for (size_t i = 0; i < nRows; i++)
+        {
+            bool isValid = true;
+            m_groups[i] = -1;
+
+            for (size_t k = 0; k < keys.size(); k++)
+            {
+                tuple[k] = keys[k]->m_codes[i];
+
+                if (tuple[k] < 0)
+                {
+                    isValid = false;
+                    break;
+                }
+            }
+
+            if (!isValid)
+                continue;
+
+            auto iter = mGroups.emplace(tuple, m_firstRow.size());
+
+            if (iter.second)
+                m_firstRow.push_back(i);
+
+            m_groups[i] = iter.first->second;
+        }
+
+        return;
+    }
+
+    // Calculate the compound codes
+    #pragma omp parallel for if(nRows > GROUPBY_PARALLEL_LIMIT)
+    for (size_t i = 0; i < nRows; i++)
+    {
+        int64_t code = 0;
+
+        for (size_t k = 0; k < keys.size(); k++)
+        {
+            if (keys[k]->m_codes[i] < 0)
+            {
+                code = -1;
+                break;
+            }
+
+            code += keys[k]->m_codes[i] * strides[k];
+        }
+
+        m_groups[i] = code;
+    }
+
+    // Map the compound codes to dense group ids in
+    // the order of their first occurrence
+    if (combinations <= GROUPBY_DIRECT_LIMIT)
+    {
+        std::vector<int64_t> vLookUp(combinations, -1);
+
+        for (size_t i = 0; i < nRows; i++)
+        {
+            if (m_groups[i] < 0)
+                continue;
+
+            int64_t& id = vLookUp[m_groups[i]];
+
+            if (id < 0)
+            {
+                id = m_firstRow.size();
+                m_firstRow.push_back(i);
+            }
+
+            m_groups[i] = id;
+        }
+    }
+    else
+    {
+        std::unordered_map<int64_t, int64_t> mLookUp;
+
+        for (size_t i = 0; i < nRows; i++)
+        {
+            if (m_groups[i] < 0)
+                continue;
+
+            auto iter = mLookUp.emplace(m_groups[i], m_firstRow.size());
+
+            if (iter.second)
+                m_firstRow.push_back(i);
+
+            m_groups[i] = iter.first->second;
+        }
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Calculates count, sum, sum of squares,
+/// minimum and maximum of the passed values for
+/// all groups simultaneously. Every thread
+/// accumulates its own partial statistics, which
+/// are merged afterwards. Invalid values are
+/// ignored.
+///
+/// \param values const std::vector<double>&
+/// \return GroupStatistics
+///
+/////////////////////////////////////////////////
+GroupStatistics GroupBy::aggregate(const std::vector<double>& values) const
+{
+    size_t nRows = std::min(values.size(), m_groups.size());
+    int nThreads = nRows > GROUPBY_PARALLEL_LIMIT ? omp_get_max_threads() : 1;
+    std::vector<GroupStatistics> vPartials(nThreads, GroupStatistics(size()));
+
+    #pragma omp parallel num_threads(nThreads)
+    {
+        GroupStatistics& partial = vPartials[omp_get_thread_num()];
+
+        #pragma omp for schedule(static)
+        for (size_t i = 0; i < nRows; i++)
+        {
+            int64_t g = m_groups[i];
+            double val = values[i];
+
+            if (g < 0 || std::isnan(val))
+                continue;
+
+            partial.m_count[g]++;
+            partial.m_sum[g] += val;
+            partial.m_sumSq[g] += val*val;
+            partial.m_min[g] = std::min(partial.m_min[g], val);
+            partial.m_max[g] = std::max(partial.m_max[g], val);
+        }
+    }
+
+    for (int t = 1; t < nThreads; t++)
+    {
+        vPartials.front().merge(vPartials[t]);
+    }
+
+    return vPartials.front();
+}
+
@@ -0,0 +1,133 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef GROUPBY_HPP
+#define GROUPBY_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/////////////////////////////////////////////////
+/// \brief This structure represents a single key
+/// column of a grouping operation. Each row is
+/// represented by a dense level code in the
+/// range [0, m_levels). Negative codes mark
+/// invalid rows, which do not belong to any
+/// group.
+/////////////////////////////////////////////////
+struct GroupKey
+{
+    std::vector<int64_t> m_codes;
+    size_t m_levels;
+
+    GroupKey() : m_levels(0) {}
+};
+
+
+/////////////////////////////////////////////////
+/// \brief This structure contains the aggregated
+/// statistics of all groups of a grouping
+/// operation.
+/////////////////////////////////////////////////
+struct GroupStatistics
+{
+    std::vector<size_t> m_count;
+    std::vector<double> m_sum;
+    std::vector<double> m_sumSq;
+    std::vector<double> m_min;
+    std::vector<double> m_max;
+
+    GroupStatistics(size_t nGroups = 0);
+
+    void merge(const GroupStatistics& other);
+    double mean(size_t group) const;
+    double var(size_t group) const;
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the number of groups.
+    ///
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t size() const
+    {
+        return m_count.size();
+    }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief This class maps the combination of one
+/// or more key columns to dense group ids in a
+/// single pass. The group ids are assigned in
+/// the order of the first occurrence of each
+/// combination. The statistics of all groups
+/// are calculated simultaneously afterwards.
+/////////////////////////////////////////////////
+class GroupBy
+{
+    private:
+        std::vector<int64_t> m_groups;
+        std::vector<size_t> m_firstRow;
+
+    public:
+        GroupBy(const std::vector<const GroupKey*>& keys);
+
+        GroupStatistics aggregate(const std::vector<double>& values) const;
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the number of groups.
+        ///
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        size_t size() const
+        {
+            return m_firstRow.size();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the group ids of all rows.
+        /// Invalid rows have a negative group id.
+        ///
+        /// \return const std::vector<int64_t>&
+        ///
+        /////////////////////////////////////////////////
+        const std::vector<int64_t>& getGroupIds() const
+        {
+            return m_groups;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the first row, which belongs
+        /// to the selected group. Can be used to
+        /// retrieve the key values of this group.
+        ///
+        /// \param group size_t
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        size_t getFirstRow(size_t group) const
+        {
+            return m_firstRow[group];
+        }
+};
+
+#endif // GROUPBY_HPP
+
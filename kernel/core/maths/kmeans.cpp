@@ -0,0 +1,641 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "kmeans.hpp"
+
+#include <cmath>
+#include <random>
+#include <limits>
+#include <algorithm>
+
+// Observations are accumulated in blocks of fixed size. The partial
+// results are combined in block order, which makes the results
+// independent from the number of threads
+#define KMEANS_BLOCKSIZE 16384
+// Minimal number of observations for parallelizing the loops
+#define KMEANS_PARALLEL_LIMIT 2048
+// Maximal number of observations for parallelizing the restarts
+// instead of the single iterations
+#define KMEANS_PARALLEL_RESTART_LIMIT 100000
+
+
+/////////////////////////////////////////////////
+/// \brief Calculates the squared euclidian
+/// distance between two points.
+///
+/// \param a const double*
+/// \param b const double*
+/// \param dims size_t
+/// \return double
+///
+/////////////////////////////////////////////////
+static inline double squaredDistance(const double* a, const double* b, size_t dims)
+{
+    double sum = 0.0;
+
+    for (size_t d = 0; d < dims; d++)
+    {
+        double diff = a[d] - b[d];
+        sum += diff*diff;
+    }
+
+    return sum;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Finds the closest and the second
+/// closest centroid for the passed observation.
+/// Both distances are returned as squared
+/// distances.
+///
+/// \param x const double*
+/// \param centroids const std::vector<double>&
+/// \param dims size_t
+/// \param closest size_t&
+/// \param dist1 double&
+/// \param dist2 double&
+/// \return void
+///
+/////////////////////////////////////////////////
+static void findClosest(const double* x, const std::vector<double>& centroids, size_t dims, size_t& closest, double& dist1, double& dist2)
+{
+    size_t k = centroids.size() / dims;
+    closest = 0;
+    dist1 = std::numeric_limits<double>::infinity();
+    dist2 = std::numeric_limits<double>::infinity();
+
+    for (size_t j = 0; j < k; j++)
+    {
+        double dist = squaredDistance(x, &centroids[j*dims], dims);
+
+        if (dist < dist1)
+        {
+            dist2 = dist1;
+            dist1 = dist;
+            closest = j;
+        }
+        else if (dist < dist2)
+            dist2 = dist;
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Selects the initial centroids randomly
+/// from the observations. Each centroid has to
+/// be unique. If there are not enough unique
+/// observations, fewer centroids are returned.
+///
+/// \param data const KMeansData&
+/// \param k size_t
+/// \param rng std::mt19937_64&
+/// \return std::vector<double>
+///
+/////////////////////////////////////////////////
+static std::vector<double> initRandom(const KMeansData& data, size_t k, std::mt19937_64& rng)
+{
+    size_t dims = data.m_dims;
+    std::vector<double> centroids;
+    centroids.reserve(k*dims);
+    std::uniform_int_distribution<size_t> dist(0, data.rows()-1);
+    size_t nFound = 0;
+
+    for (size_t attempts = 0; nFound < k && attempts < 100*k; attempts++)
+    {
+        const double* candidate = data.row(dist(rng));
+        bool isUnique = true;
+
+        for (size_t j = 0; j < nFound; j++)
+        {
+            if (std::equal(candidate, candidate+dims, &centroids[j*dims]))
+            {
+                isUnique = false;
+                break;
+            }
+        }
+
+        if (isUnique)
+        {
+            centroids.insert(centroids.end(), candidate, candidate+dims);
+            nFound++;
+        }
+    }
+
+    return centroids;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Selects the initial centroids using
+/// the k-means++ strategy, i.e. each new
+/// centroid is drawn with a probability
+/// proportional to the squared distance to its
+/// nearest already selected centroid.
+///
+/// \param data const KMeansData&
+/// \param k size_t
+/// \param rng std::mt19937_64&
+/// \return std::vector<double>
+///
+/////////////////////////////////////////////////
+static std::vector<double> initKMeansPP(const KMeansData& data, size_t k, std::mt19937_64& rng)
+{
+    size_t n = data.rows();
+    size_t dims = data.m_dims;
+    size_t nBlocks = (n + KMEANS_BLOCKSIZE - 1) / KMEANS_BLOCKSIZE;
+
+    std::vector<double> centroids;
+    centroids.reserve(k*dims);
+    std::vector<double> minDist(n, std::numeric_limits<double>::infinity());
+    std::vector<double> blockSums(nBlocks);
+
+    const double* first = data.row(std::uniform_int_distribution<size_t>(0, n-1)(rng));
+    centroids.insert(centroids.end(), first, first+dims);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    while (centroids.size() < k*dims)
+    {
+        const double* newest = &centroids[centroids.size()-dims];
+
+        // Update the distances to the nearest centroid
+        #pragma omp parallel for if(n > KMEANS_PARALLEL_LIMIT)
+        for (size_t b = 0; b < nBlocks; b++)
+        {
+            double sum = 0.0;
+
+            for (size_t i = b*KMEANS_BLOCKSIZE; i < std::min(n, (b+1)*KMEANS_BLOCKSIZE); i++)
+            {
+                minDist[i] = std::min(minDist[i], squaredDistance(data.row(i), newest, dims));
+                sum += minDist[i];
+            }
+
+            blockSums[b] = sum;
+        }
+
+        double total = 0.0;
+
+        for (double sum : blockSums)
+            total += sum;
+
+        // All remaining observations are equal to one
+        // of the centroids
+        if (total <= 0.0)
+            break;
+
+        // Draw the next centroid by walking the
+        // cumulative distribution
+        double target = uniform(rng) * total;
+        size_t b = 0;
+
+        while (b+1 < nBlocks && target >= blockSums[b])
+        {
+            target -= blockSums[b];
+            b++;
+        }
+
+        size_t selected = std::min(n, (b+1)*KMEANS_BLOCKSIZE)-1;
+
+        for (size_t i = b*KMEANS_BLOCKSIZE; i < std::min(n, (b+1)*KMEANS_BLOCKSIZE); i++)
+        {
+            if (minDist[i] > 0.0 && target < minDist[i])
+            {
+                selected = i;
+                break;
+            }
+
+            target -= minDist[i];
+        }
+
+        // Rounding may end up on an already selected
+        // observation. Search for the last possible
+        // one in this case
+        while (minDist[selected] <= 0.0 && selected > 0)
+            selected--;
+
+        if (minDist[selected] <= 0.0)
+            break;
+
+        const double* next = data.row(selected);
+        centroids.insert(centroids.end(), next, next+dims);
+    }
+
+    return centroids;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Assigns every observation to its
+/// nearest centroid and returns the inertia
+/// (sum of squared distances) of this
+/// assignment.
+///
+/// \param data const KMeansData&
+/// \param centroids const std::vector<double>&
+/// \param labels std::vector<size_t>&
+/// \return double
+///
+/////////////////////////////////////////////////
+static double assignAll(const KMeansData& data, const std::vector<double>& centroids, std::vector<size_t>& labels)
+{
+    size_t n = data.rows();
+    size_t nBlocks = (n + KMEANS_BLOCKSIZE - 1) / KMEANS_BLOCKSIZE;
+    std::vector<double> blockInertia(nBlocks);
+    labels.resize(n);
+
+    #pragma omp parallel for if(n > KMEANS_PARALLEL_LIMIT)
+    for (size_t b = 0; b < nBlocks; b++)
+    {
+        double sum = 0.0;
+
+        for (size_t i = b*KMEANS_BLOCKSIZE; i < std::min(n, (b+1)*KMEANS_BLOCKSIZE); i++)
+        {
+            double dist1, dist2;
+            findClosest(data.row(i), centroids, data.m_dims, labels[i], dist1, dist2);
+            sum += dist1;
+        }
+
+        blockInertia[b] = sum;
+    }
+
+    double inertia = 0.0;
+
+    for (double sum : blockInertia)
+        inertia += sum;
+
+    return inertia;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Recalculates the centroids as the
+/// means of their assigned observations and
+/// stores the distance, which each centroid
+/// moved. Empty clusters keep their centroid.
+///
+/// \param data const KMeansData&
+/// \param labels const std::vector<size_t>&
+/// \param centroids std::vector<double>&
+/// \param movement std::vector<double>&
+/// \return double
+///
+/////////////////////////////////////////////////
+static double updateCentroids(const KMeansData& data, const std::vector<size_t>& labels, std::vector<double>& centroids, std::vector<double>& movement)
+{
+    size_t n = data.rows();
+    size_t dims = data.m_dims;
+    size_t k = centroids.size() / dims;
+    size_t nBlocks = (n + KMEANS_BLOCKSIZE - 1) / KMEANS_BLOCKSIZE;
+
+    std::vector<double> blockSums(nBlocks*k*dims, 0.0);
+    std::vector<size_t> blockCounts(nBlocks*k, 0);
+
+    #pragma omp parallel for if(n > KMEANS_PARALLEL_LIMIT)
+    for (size_t b = 0; b < nBlocks; b++)
+    {
+        double* sums = &blockSums[b*k*dims];
+        size_t* counts = &blockCounts[b*k];
+
+        for (size_t i = b*KMEANS_BLOCKSIZE; i < std::min(n, (b+1)*KMEANS_BLOCKSIZE); i++)
+        {
+            const double* x = data.row(i);
+            double* sum = sums + labels[i]*dims;
+
+            for (size_t d = 0; d < dims; d++)
+                sum[d] += x[d];
+
+            counts[labels[i]]++;
+        }
+    }
+
+    double maxMovement = 0.0;
+    movement.assign(k, 0.0);
+
+    #pragma omp parallel for reduction(max:maxMovement) if(k*nBlocks > KMEANS_PARALLEL_LIMIT)
+    for (size_t j = 0; j < k; j++)
+    {
+        std::vector<double> sum(dims, 0.0);
+        size_t count = 0;
+
+        for (size_t b = 0; b < nBlocks; b++)
+        {
+            count += blockCounts[b*k+j];
+
+            for (size_t d = 0; d < dims; d++)
+                sum[d] += blockSums[(b*k+j)*dims+d];
+        }
+
+        if (!count)
+            continue;
+
+        for (size_t d = 0; d < dims; d++)
+            sum[d] /= count;
+
+        movement[j] = std::sqrt(squaredDistance(&sum[0], &centroids[j*dims], dims));
+        std::copy(sum.begin(), sum.end(), centroids.begin()+j*dims);
+        maxMovement = std::max(maxMovement, movement[j]);
+    }
+
+    return maxMovement;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Runs the full-batch k-means iteration
+/// using Hamerly's algorithm, i.e. a single
+/// upper and lower distance bound is maintained
+/// per observation and the triangle inequality
+/// is used to skip most distance calculations.
+///
+/// \param data const KMeansData&
+/// \param centroids std::vector<double>
+/// \param maxIterations size_t
+/// \return KMeansClustering
+///
+/////////////////////////////////////////////////
+static KMeansClustering runHamerly(const KMeansData& data, std::vector<double> centroids, size_t maxIterations)
+{
+    size_t n = data.rows();
+    size_t dims = data.m_dims;
+    size_t k = centroids.size() / dims;
+
+    KMeansClustering result;
+    result.m_labels.resize(n);
+    std::vector<size_t>& labels = result.m_labels;
+    std::vector<double> upper(n);
+    std::vector<double> lower(n);
+    std::vector<double> movement(k);
+    std::vector<double> halfMinDist(k);
+
+    // Initial assignment
+    #pragma omp parallel for if(n > KMEANS_PARALLEL_LIMIT)
+    for (size_t i = 0; i < n; i++)
+    {
+        double dist1, dist2;
+        findClosest(data.row(i), centroids, dims, labels[i], dist1, dist2);
+        upper[i] = std::sqrt(dist1);
+        lower[i] = std::sqrt(dist2);
+    }
+
+    for (size_t iteration = 0; iteration < maxIterations; iteration++)
+    {
+        result.m_iterations = iteration+1;
+
+        // stop criteria: all centroids stay same
+        if (updateCentroids(data, labels, centroids, movement) == 0.0)
+            break;
+
+        // Find the largest and second largest movement
+        // for updating the lower bounds
+        size_t maxMoved = 0;
+        double max1 = 0.0;
+        double max2 = 0.0;
+
+        for (size_t j = 0; j < k; j++)
+        {
+            if (movement[j] > max1)
+            {
+                max2 = max1;
+                max1 = movement[j];
+                maxMoved = j;
+            }
+            else if (movement[j] > max2)
+                max2 = movement[j];
+        }
+
+        // Half of the distance to the nearest other
+        // centroid
+        #pragma omp parallel for if(k > 64)
+        for (size_t j = 0; j < k; j++)
+        {
+            double minDist = std::numeric_limits<double>::infinity();
+
+            for (size_t j2 = 0; j2 < k; j2++)
+            {
+                if (j2 != j)
+                    minDist = std::min(minDist, squaredDistance(&centroids[j*dims], &centroids[j2*dims], dims));
+            }
+
+            halfMinDist[j] = 0.5*std::sqrt(minDist);
+        }
+
+        size_t changes = 0;
+
+        // Assign points to closest cluster centroid
+        #pragma omp parallel for reduction(+:changes) if(n > KMEANS_PARALLEL_LIMIT)
+        for (size_t i = 0; i < n; i++)
+        {
+            size_t label = labels[i];
+            upper[i] += movement[label];
+            lower[i] -= label == maxMoved ? max2 : max1;
+
+            double bound = std::max(halfMinDist[label], lower[i]);
+
+            if (upper[i] <= bound)
+                continue;
+
+            // Tighten the upper bound and test again
+            upper[i] = std::sqrt(squaredDistance(data.row(i), &centroids[label*dims], dims));
+
+            if (upper[i] <= bound)
+                continue;
+
+            double dist1, dist2;
+            findClosest(data.row(i), centroids, dims, labels[i], dist1, dist2);
+            upper[i] = std::sqrt(dist1);
+            lower[i] = std::sqrt(dist2);
+
+            if (labels[i] != label)
+                changes++;
+        }
+
+        // stop criteria: all points remain in same cluster
+        if (!changes)
+            break;
+    }
+
+    result.m_inertia = assignAll(data, centroids, labels);
+    result.m_centroids.swap(centroids);
+    return result;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Runs the mini-batch k-means iteration.
+/// Each iteration draws a random batch of
+/// observations and moves the centroids towards
+/// them using a per-centroid learning rate. The
+/// final labels are obtained from a full
+/// assignment.
+///
+/// \param data const KMeansData&
+/// \param centroids std::vector<double>
+/// \param maxIterations size_t
+/// \param batchSize size_t
+/// \param rng std::mt19937_64&
+/// \return KMeansClustering
+///
+/////////////////////////////////////////////////
+static KMeansClustering runMiniBatch(const KMeansData& data, std::vector<double> centroids, size_t maxIterations, size_t batchSize, std::mt19937_64& rng)
+{
+    size_t n = data.rows();
+    size_t dims = data.m_dims;
+    size_t k = centroids.size() / dims;
+
+    KMeansClustering result;
+    std::vector<size_t> counts(k, 0);
+    std::vector<size_t> batch(batchSize);
+    std::vector<size_t> batchLabels(batchSize);
+    std::uniform_int_distribution<size_t> dist(0, n-1);
+
+    for (size_t iteration = 0; iteration < maxIterations; iteration++)
+    {
+        result.m_iterations = iteration+1;
+
+        for (size_t& idx : batch)
+            idx = dist(rng);
+
+        #pragma omp parallel for if(batchSize > KMEANS_PARALLEL_LIMIT)
+        for (size_t b = 0; b < batchSize; b++)
+        {
+            double dist1, dist2;
+            findClosest(data.row(batch[b]), centroids, dims, batchLabels[b], dist1, dist2);
+        }
+
+        double maxMovement = 0.0;
+        std::vector<double> previous(centroids);
+
+        // Gradient step with per-centroid learning rate
+        for (size_t b = 0; b < batchSize; b++)
+        {
+            size_t label = batchLabels[b];
+            double eta = 1.0 / ++counts[label];
+            const double* x = data.row(batch[b]);
+            double* c = &centroids[label*dims];
+
+            for (size_t d = 0; d < dims; d++)
+                c[d] += eta * (x[d] - c[d]);
+        }
+
+        for (size_t j = 0; j < k; j++)
+        {
+            maxMovement = std::max(maxMovement, squaredDistance(&previous[j*dims], &centroids[j*dims], dims));
+        }
+
+        // stop criteria: centroids do not move anymore
+        if (maxMovement == 0.0)
+            break;
+    }
+
+    result.m_inertia = assignAll(data, centroids, result.m_labels);
+    result.m_centroids.swap(centroids);
+    return result;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Runs a single k-means clustering
+/// including its initialization.
+///
+/// \param data const KMeansData&
+/// \param settings const KMeansSettings&
+/// \param seed uint64_t
+/// \return KMeansClustering
+///
+/////////////////////////////////////////////////
+static KMeansClustering runKMeans(const KMeansData& data, const KMeansSettings& settings, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::vector<double> centroids;
+    bool useMiniBatch = settings.batchSize && settings.batchSize < data.rows();
+
+    if (settings.initKMeansPP && useMiniBatch)
+    {
+        // Mini-batch mode only uses a random subset of
+        // the observations for the initialization
+        KMeansData subset;
+        subset.m_dims = data.m_dims;
+        size_t nInitSize = std::min(data.rows(), std::max(3*settings.batchSize, settings.nClusters));
+        std::uniform_int_distribution<size_t> dist(0, data.rows()-1);
+        subset.m_values.reserve(nInitSize*data.m_dims);
+
+        for (size_t i = 0; i < nInitSize; i++)
+        {
+            const double* x = data.row(dist(rng));
+            subset.m_values.insert(subset.m_values.end(), x, x+data.m_dims);
+        }
+
+        centroids = initKMeansPP(subset, settings.nClusters, rng);
+    }
+    else if (settings.initKMeansPP)
+        centroids = initKMeansPP(data, settings.nClusters, rng);
+    else
+        centroids = initRandom(data, settings.nClusters, rng);
+
+    // Not enough distinct observations
+    if (centroids.size() < settings.nClusters*data.m_dims)
+        return KMeansClustering();
+
+    if (useMiniBatch)
+        return runMiniBatch(data, centroids, settings.maxIterations, settings.batchSize, rng);
+
+    return runHamerly(data, centroids, settings.maxIterations);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Calculates the k-means clustering of
+/// the passed observations. Multiple restarts
+/// are evaluated and the clustering with the
+/// lowest inertia is returned. The result only
+/// depends on the settings (including the seed)
+/// and not on the number of threads.
+///
+/// \param data const KMeansData&
+/// \param settings const KMeansSettings&
+/// \return KMeansClustering
+///
+/////////////////////////////////////////////////
+KMeansClustering calculateKMeans(const KMeansData& data, const KMeansSettings& settings)
+{
+    if (!data.m_dims || !settings.nClusters || data.rows() < settings.nClusters)
+        return KMeansClustering();
+
+    size_t nInit = std::max(settings.nInit, (size_t)1);
+    std::vector<KMeansClustering> runs(nInit);
+
+    // Small data sets benefit more from running the
+    // restarts in parallel. The nested parallel
+    // regions are executed serially then
+    #pragma omp parallel for schedule(dynamic) if(nInit > 1 && data.rows() < KMEANS_PARALLEL_RESTART_LIMIT)
+    for (size_t r = 0; r < nInit; r++)
+    {
+        runs[r] = runKMeans(data, settings, settings.seed + r);
+    }
+
+    size_t best = 0;
+
+    for (size_t r = 1; r < nInit; r++)
+    {
+        if (runs[r].isValid() && (!runs[best].isValid() || runs[r].m_inertia < runs[best].m_inertia))
+            best = r;
+    }
+
+    return runs[best];
+}
+
@@ -0,0 +1,116 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef KMEANS_HPP
+#define KMEANS_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/////////////////////////////////////////////////
+/// \brief This structure contains the
+/// observations for the k-means clustering as a
+/// contiguous row-major matrix. Rows, which
+/// contain invalid values, are not part of the
+/// matrix but are referenced via the row map.
+/////////////////////////////////////////////////
+struct KMeansData
+{
+    std::vector<double> m_values;
+    std::vector<size_t> m_rowMap;
+    size_t m_dims;
+
+    KMeansData() : m_dims(0) {}
+
+    /////////////////////////////////////////////////
+    /// \brief Returns the number of (valid)
+    /// observations.
+    ///
+    /// \return size_t
+    ///
+    /////////////////////////////////////////////////
+    size_t rows() const
+    {
+        return m_dims ? m_values.size() / m_dims : 0;
+    }
+
+    /////////////////////////////////////////////////
+    /// \brief Returns a pointer to the first
+    /// element of the selected observation.
+    ///
+    /// \param i size_t
+    /// \return const double*
+    ///
+    /////////////////////////////////////////////////
+    const double* row(size_t i) const
+    {
+        return &m_values[i*m_dims];
+    }
+};
+
+
+/////////////////////////////////////////////////
+/// \brief The settings for a single k-means
+/// clustering call.
+/////////////////////////////////////////////////
+struct KMeansSettings
+{
+    size_t nClusters;
+    size_t maxIterations;
+    size_t nInit;
+    size_t batchSize;
+    bool initKMeansPP;
+    uint64_t seed;
+
+    KMeansSettings() : nClusters(2), maxIterations(100), nInit(1), batchSize(0), initKMeansPP(false), seed(0) {}
+};
+
+
+/////////////////////////////////////////////////
+/// \brief The result of the k-means clustering.
+/// Labels are zero-based and refer to the rows
+/// of the KMeansData matrix.
+/////////////////////////////////////////////////
+struct KMeansClustering
+{
+    std::vector<size_t> m_labels;
+    std::vector<double> m_centroids;
+    double m_inertia;
+    size_t m_iterations;
+
+    KMeansClustering() : m_inertia(-1.0), m_iterations(0) {}
+
+    /////////////////////////////////////////////////
+    /// \brief Returns true, if this clustering
+    /// contains a valid result.
+    ///
+    /// \return bool
+    ///
+    /////////////////////////////////////////////////
+    bool isValid() const
+    {
+        return m_inertia >= 0.0;
+    }
+};
+
+
+KMeansClustering calculateKMeans(const KMeansData& data, const KMeansSettings& settings);
+
+#endif // KMEANS_HPP
+
@@ -23,6 +23,9 @@
 #include <string>
 #include <complex>
 #include <utility>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 #include "../ui/error.hpp"
 #include "../utils/stringtools.hpp"
@@ -610,6 +613,367 @@ class Matrix
 
 
 
+/////////////////////////////////////////////////
+/// \brief This class defines a sparse 2D matrix
+/// in the compressed sparse column format. Only
+/// the non-zero elements are stored, therefore
+/// the memory scales with their number and not
+/// with the dimensions. The index arrays use the
+/// layout of Eigen's compressed sparse matrices
+/// and may be mapped without copying.
+/////////////////////////////////////////////////
+class SparseMatrix
+{
+    private:
+        std::vector<int> m_colStart;                ///< Start of each column in the value array
+        std::vector<int> m_rowIndex;                ///< Row of each stored element
+        std::vector<std::complex<double>> m_values; ///< The stored elements
+        size_t m_rows;                              ///< Number of rows
+        size_t m_cols;                              ///< Number of columns
+
+        /////////////////////////////////////////////////
+        /// \brief Converts the passed value from a
+        /// triplet into a zero-based index and ensures
+        /// that it is valid.
+        ///
+        /// \param val const std::complex<double>&
+        /// \param nMax size_t
+        /// \return int
+        ///
+        /////////////////////////////////////////////////
+        static int toIndex(const std::complex<double>& val, size_t nMax)
+        {
+            if (std::isnan(val.real()) || val.real() < 1 || val.real() > nMax || val.real() != std::rint(val.real()))
+                throw SyntaxError(SyntaxError::INVALID_INDEX, "INTERNAL INDEXING ERROR",
+                                  SyntaxError::invalid_position,
+                                  toString(val.real()) + " vs. size = " + toString(nMax));
+
+            return (int)val.real() - 1;
+        }
+
+    public:
+        /////////////////////////////////////////////////
+        /// \brief Empty sparse matrix default
+        /// constructor.
+        /////////////////////////////////////////////////
+        SparseMatrix() : m_colStart(1, 0), m_rows(0u), m_cols(0u) {}
+
+        /////////////////////////////////////////////////
+        /// \brief Creates a sparse matrix of the passed
+        /// dimensions without any non-zero elements.
+        ///
+        /// \param r size_t
+        /// \param c size_t
+        ///
+        /////////////////////////////////////////////////
+        SparseMatrix(size_t r, size_t c) : m_colStart(c+1, 0), m_rows(r), m_cols(c) {}
+
+        /////////////////////////////////////////////////
+        /// \brief Assigns the elements from a matrix of
+        /// triplets, where each row contains the
+        /// one-based row and column indices and the
+        /// value of a single element. Duplicates are
+        /// summed up and zeros are not stored. Missing
+        /// dimensions (i.e. zero) are derived from the
+        /// largest indices.
+        ///
+        /// \param triplets const Matrix&
+        /// \param r size_t
+        /// \param c size_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void assignTriplets(const Matrix& triplets, size_t r = 0u, size_t c = 0u)
+        {
+            if (triplets.rows() && triplets.cols() != 3)
+                throw SyntaxError(SyntaxError::WRONG_MATRIX_DIMENSIONS_FOR_MATOP, "INTERNAL INDEXING ERROR",
+                                  SyntaxError::invalid_position, triplets.printDims() + " vs. Nx3");
+
+            size_t nElems = triplets.rows();
+            size_t nMaxRow = 0;
+            size_t nMaxCol = 0;
+
+            // Derive the missing dimensions
+            for (size_t n = 0; n < nElems; n++)
+            {
+                nMaxRow = std::max(nMaxRow, (size_t)toIndex(triplets(n, 0), INT32_MAX) + 1);
+                nMaxCol = std::max(nMaxCol, (size_t)toIndex(triplets(n, 1), INT32_MAX) + 1);
+            }
+
+            m_rows = r ? r : nMaxRow;
+            m_cols = c ? c : nMaxCol;
+
+            if (m_rows > INT32_MAX || m_cols > INT32_MAX || nElems > INT32_MAX)
+                throw SyntaxError(SyntaxError::INVALID_INDEX, "INTERNAL INDEXING ERROR",
+                                  SyntaxError::invalid_position, toString(m_rows) + "x" + toString(m_cols));
+
+            // Count the elements per column
+            m_colStart.assign(m_cols+1, 0);
+
+            for (size_t n = 0; n < nElems; n++)
+            {
+                toIndex(triplets(n, 0), m_rows);
+                m_colStart[toIndex(triplets(n, 1), m_cols)+1]++;
+            }
+
+            for (size_t j = 0; j < m_cols; j++)
+            {
+                m_colStart[j+1] += m_colStart[j];
+            }
+
+            // Scatter the elements into their columns
+            std::vector<int> vPos(m_colStart.begin(), m_colStart.end()-1);
+            m_rowIndex.resize(nElems);
+            m_values.resize(nElems);
+
+            for (size_t n = 0; n < nElems; n++)
+            {
+                int nPos = vPos[toIndex(triplets(n, 1), m_cols)]++;
+                m_rowIndex[nPos] = toIndex(triplets(n, 0), m_rows);
+                m_values[nPos] = triplets(n, 2);
+            }
+
+            // Sort each column by row, sum up the duplicates
+            // and remove the zeros
+            int nTarget = 0;
+            std::vector<std::pair<int,std::complex<double>>> vColumn;
+
+            for (size_t j = 0; j < m_cols; j++)
+            {
+                vColumn.clear();
+
+                for (int p = m_colStart[j]; p < m_colStart[j+1]; p++)
+                {
+                    vColumn.push_back(std::make_pair(m_rowIndex[p], m_values[p]));
+                }
+
+                std::stable_sort(vColumn.begin(), vColumn.end(),
+                                 [](const std::pair<int,std::complex<double>>& a, const std::pair<int,std::complex<double>>& b)
+                                 {return a.first < b.first;});
+
+                m_colStart[j] = nTarget;
+
+                for (size_t p = 0; p < vColumn.size(); p++)
+                {
+                    std::complex<double> val = vColumn[p].second;
+
+                    while (p+1 < vColumn.size() && vColumn[p+1].first == vColumn[p].first)
+                        val += vColumn[++p].second;
+
+                    if (val == 0.0)
+                        continue;
+
+                    m_rowIndex[nTarget] = vColumn[p].first;
+                    m_values[nTarget] = val;
+                    nTarget++;
+                }
+            }
+
+            m_colStart[m_cols] = nTarget;
+            m_rowIndex.resize(nTarget);
+            m_values.resize(nTarget);
+            m_rowIndex.shrink_to_fit();
+            m_values.shrink_to_fit();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the stored elements as a
+        /// matrix of triplets with one-based indices
+        /// sorted by columns.
+        ///
+        /// \return Matrix
+        ///
+        /////////////////////////////////////////////////
+        Matrix getTriplets() const
+        {
+            Matrix mRet(m_values.size(), 3);
+
+            for (size_t j = 0; j < m_cols; j++)
+            {
+                for (int p = m_colStart[j]; p < m_colStart[j+1]; p++)
+                {
+                    mRet(p, 0) = m_rowIndex[p] + 1;
+                    mRet(p, 1) = j + 1;
+                    mRet(p, 2) = m_values[p];
+                }
+            }
+
+            return mRet;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Converts this sparse matrix into a
+        /// dense matrix.
+        ///
+        /// \return Matrix
+        ///
+        /////////////////////////////////////////////////
+        Matrix toDense() const
+        {
+            Matrix mRet(m_rows, m_cols, std::complex<double>(0.0));
+
+            for (size_t j = 0; j < m_cols; j++)
+            {
+                for (int p = m_colStart[j]; p < m_colStart[j+1]; p++)
+                {
+                    mRet(m_rowIndex[p], j) = m_values[p];
+                }
+            }
+
+            return mRet;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Get the number of rows.
+        ///
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        size_t rows() const
+        {
+            return m_rows;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Get the number of columns.
+        ///
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        size_t cols() const
+        {
+            return m_cols;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Get the number of stored non-zero
+        /// elements.
+        ///
+        /// \return size_t
+        ///
+        /////////////////////////////////////////////////
+        size_t nonZeros() const
+        {
+            return m_values.size();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Get the column start array (size
+        /// cols+1).
+        ///
+        /// \return const int*
+        ///
+        /////////////////////////////////////////////////
+        const int* colStarts() const
+        {
+            return m_colStart.data();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Get the row index array.
+        ///
+        /// \return const int*
+        ///
+        /////////////////////////////////////////////////
+        const int* rowIndices() const
+        {
+            return m_rowIndex.data();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Get the array of stored values.
+        ///
+        /// \return const std::complex<double>*
+        ///
+        /////////////////////////////////////////////////
+        const std::complex<double>* values() const
+        {
+            return m_values.data();
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Get the indexed element. Elements,
+        /// which are not stored, are zero.
+        ///
+        /// \param i size_t
+        /// \param j size_t
+        /// \return std::complex<double>
+        ///
+        /////////////////////////////////////////////////
+        std::complex<double> operator()(size_t i, size_t j) const
+        {
+            if (i >= m_rows || j >= m_cols)
+                throw SyntaxError(SyntaxError::INVALID_INDEX, "INTERNAL INDEXING ERROR",
+                                  SyntaxError::invalid_position,
+                                  "MAT(" + toString(i) + "," + toString(j) + ") vs. size = " + printDims());
+
+            auto begin = m_rowIndex.begin() + m_colStart[j];
+            auto end = m_rowIndex.begin() + m_colStart[j+1];
+            auto iter = std::lower_bound(begin, end, (int)i);
+
+            if (iter != end && *iter == (int)i)
+                return m_values[iter - m_rowIndex.begin()];
+
+            return 0.0;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Convert the dimensions to a printable
+        /// string.
+        ///
+        /// \return std::string
+        ///
+        /////////////////////////////////////////////////
+        std::string printDims() const
+        {
+            return toString(m_rows) + "x" + toString(m_cols);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Multiply this sparse matrix with a
+        /// dense matrix from the right. Only the stored
+        /// elements are visited.
+        ///
+        /// \param mat const Matrix&
+        /// \return Matrix
+        ///
+        /////////////////////////////////////////////////
+        Matrix operator*(const Matrix& mat) const
+        {
+            if (mat.rows() != m_cols)
+                throw SyntaxError(SyntaxError::WRONG_MATRIX_DIMENSIONS_FOR_MATOP, "INTERNAL INDEXING ERROR",
+                                  SyntaxError::invalid_position,
+                                  printDims() + " vs. " + mat.printDims());
+
+            Matrix ret(m_rows, mat.cols(), std::complex<double>(0.0));
+
+            #pragma omp parallel for
+            for (size_t k = 0; k < mat.cols(); k++)
+            {
+                // The result is not transposed, i.e. its
+                // columns are contiguous
+                std::complex<double>* target = ret.data().data() + k*m_rows;
+
+                for (size_t j = 0; j < m_cols; j++)
+                {
+                    const std::complex<double>& val = mat(j, k);
+
+                    if (val == 0.0)
+                        continue;
+
+                    for (int p = m_colStart[j]; p < m_colStart[j+1]; p++)
+                    {
+                        target[m_rowIndex[p]] += m_values[p] * val;
+                    }
+                }
+            }
+
+            return ret;
+        }
+};
+
+
+
 // Erster Index: No. of Line; zweiter Index: No. of Col (push_back verwendet dazu stets zeilen!)
 /////////////////////////////////////////////////
 /// \brief Defines a Matrix.
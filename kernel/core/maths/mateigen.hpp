@@ -0,0 +1,68 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef MATEIGEN_HPP
+#define MATEIGEN_HPP
+
+#include <Eigen/Dense>
+#include <algorithm>
+
+#include "matdatastructures.hpp"
+
+/////////////////////////////////////////////////
+/// \brief This static function copies the passed
+/// matrix into an Eigen matrix.
+///
+/// \param mat const Matrix&
+/// \return Eigen::MatrixXcd
+///
+/////////////////////////////////////////////////
+static Eigen::MatrixXcd toEigenMatrix(const Matrix& mat)
+{
+    Eigen::MatrixXcd mEigen(mat.rows(), mat.cols());
+
+    #pragma omp parallel for
+    for (size_t j = 0; j < mat.cols(); j++)
+    {
+        for (size_t i = 0; i < mat.rows(); i++)
+        {
+            mEigen(i, j) = mat(i, j);
+        }
+    }
+
+    return mEigen;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This static function copies the passed
+/// Eigen matrix into a Matrix instance. Both use
+/// a column-major layout.
+///
+/// \param mEigen const Eigen::MatrixXcd&
+/// \return Matrix
+///
+/////////////////////////////////////////////////
+static Matrix fromEigenMatrix(const Eigen::MatrixXcd& mEigen)
+{
+    Matrix mat(mEigen.rows(), mEigen.cols());
+    std::copy(mEigen.data(), mEigen.data() + mEigen.size(), mat.data().begin());
+    return mat;
+}
+
+#endif // MATEIGEN_HPP
@@ -23,11 +23,22 @@
 #define EIGENVECTORS 1
 #define DIAGONALIZE 2
 
+// Reciprocal condition numbers below this limit
+// mark a matrix as numerically singular
+#define MATRIX_SINGULARITY_LIMIT std::numeric_limits<double>::epsilon()
+
+// Reciprocal condition numbers below this limit
+// issue a warning about the accuracy of the inverse
+#define MATRIX_CONDITION_WARNING_LIMIT 1e-10
+
 #include <Eigen/Dense>
 #include <Eigen/Eigenvalues>
+#include <Eigen/Sparse>
 #include <random>
 #include <map>
+#include <limits>
 #include "matdatastructures.hpp"
+#include "mateigen.hpp"
 #include "../ui/error.hpp"
 #include "../../kernel.hpp"
 #include "functionimplementation.hpp"
@@ -524,16 +535,21 @@ static Matrix createShuffledMatrix(const MatFuncData& funcData, const MatFuncErr
 
 
 /////////////////////////////////////////////////
-/// \brief Calculates the inverse matrix and
-/// checks in advance, whether the matrix is
-/// invertible.
+/// \brief This static function implements the
+/// "invert()" function. It inverts the matrix
+/// using a LU decomposition with partial
+/// pivoting. Singular matrices are detected from
+/// the estimated reciprocal condition number and
+/// nearly singular ones issue a warning.
 ///
 /// \param funcData const MatFuncData&
 /// \param errorInfo const MatFuncErrorInfo&
 /// \return Matrix
 ///
+/// \c __attribute__((force_align_arg_pointer))
+/// fixes TDM-GCC Bug for wrong stack alignment.
 /////////////////////////////////////////////////
-static Matrix invertMatrix(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo)
+__attribute__((force_align_arg_pointer)) static Matrix invertMatrix(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo)
 {
     if (funcData.mat1.isEmpty())
         throw SyntaxError(SyntaxError::MATRIX_CANNOT_HAVE_ZERO_SIZE, errorInfo.command, errorInfo.position);
@@ -545,132 +561,18 @@ static Matrix invertMatrix(const MatFuncData& funcData, const MatFuncErrorInfo&
     if (funcData.mat1.containsInvalidValues())
         throw SyntaxError(SyntaxError::MATRIX_CONTAINS_INVALID_VALUES, errorInfo.command, errorInfo.position);
 
-    // Gauss-Elimination???
-    Matrix _mInverse = identityMatrix(MatFuncData(funcData.mat1.rows()), errorInfo);
-    Matrix _mToInvert = funcData.mat1;
-
-    std::complex<double> dDet = getDeterminant(funcData, errorInfo)(0);
+    Eigen::PartialPivLU<Eigen::MatrixXcd> lu(toEigenMatrix(funcData.mat1));
+    double dRcond = lu.rcond();
 
-    if (dDet == 0.0)
+    if (!(dRcond > MATRIX_SINGULARITY_LIMIT))
         throw SyntaxError(SyntaxError::MATRIX_IS_NOT_INVERTIBLE, errorInfo.command, errorInfo.position);
 
-    //Spezialfaelle mit analytischem Ausdruck
-    if (_mToInvert.rows() == 1)
-    {
-        // eigentlich nicht zwangslaeufig existent... aber skalar und so...
-        _mInverse(0) /= _mToInvert(0);
-        return _mInverse;
-    }
-    else if (_mToInvert.rows() == 2)
-    {
-        _mInverse = _mToInvert;
-        _mInverse(0, 0) = _mToInvert(1, 1);
-        _mInverse(1, 1) = _mToInvert(0, 0);
-        _mInverse(1, 0) *= -1.0;
-        _mInverse(0, 1) *= -1.0;
-
-        for (size_t i = 0; i < 2; i++)
-        {
-            _mInverse(i, 0) /= dDet;
-            _mInverse(i, 1) /= dDet;
-        }
-
-        return _mInverse;
-    }
-    else if (_mToInvert.rows() == 3)
-    {
-        _mInverse(0, 0) =  (_mToInvert(1, 1)*_mToInvert(2, 2) - _mToInvert(2, 1)*_mToInvert(1, 2)) / dDet;
-        _mInverse(1, 0) = -(_mToInvert(1, 0)*_mToInvert(2, 2) - _mToInvert(1, 2)*_mToInvert(2, 0)) / dDet;
-        _mInverse(2, 0) =  (_mToInvert(1, 0)*_mToInvert(2, 1) - _mToInvert(1, 1)*_mToInvert(2, 0)) / dDet;
-
-        _mInverse(0, 1) = -(_mToInvert(0, 1)*_mToInvert(2, 2) - _mToInvert(0, 2)*_mToInvert(2, 1)) / dDet;
-        _mInverse(1, 1) =  (_mToInvert(0, 0)*_mToInvert(2, 2) - _mToInvert(0, 2)*_mToInvert(2, 0)) / dDet;
-        _mInverse(2, 1) = -(_mToInvert(0, 0)*_mToInvert(2, 1) - _mToInvert(0, 1)*_mToInvert(2, 0)) / dDet;
-
-        _mInverse(0, 2) =  (_mToInvert(0, 1)*_mToInvert(1, 2) - _mToInvert(0, 2)*_mToInvert(1, 1)) / dDet;
-        _mInverse(1, 2) = -(_mToInvert(0, 0)*_mToInvert(1, 2) - _mToInvert(0, 2)*_mToInvert(1, 0)) / dDet;
-        _mInverse(2, 2) =  (_mToInvert(0, 0)*_mToInvert(1, 1) - _mToInvert(0, 1)*_mToInvert(1, 0)) / dDet;
-
-        return _mInverse;
-    }
-
-    // Allgemeiner Fall fuer n > 3
-    for (size_t j = 0; j < _mToInvert.cols(); j++)
-    {
-        for (size_t i = j; i < _mToInvert.rows(); i++)
-        {
-            if (_mToInvert(i, j) != 0.0)
-            {
-                if (i != j) //vertauschen
-                {
-                    std::complex<double> dElement;
-
-                    for (size_t _j = 0; _j < _mToInvert.cols(); _j++)
-                    {
-                        dElement = _mToInvert(i, _j);
-                        _mToInvert(i, _j) = _mToInvert(j, _j);
-                        _mToInvert(j, _j) = dElement;
-                        dElement = _mInverse(i, _j);
-                        _mInverse(i, _j) = _mInverse(j, _j);
-                        _mInverse(j, _j) = dElement;
-                    }
-
-                    i = j-1;
-                }
-                else //Gauss-Elimination
-                {
-                    std::complex<double> dPivot = _mToInvert(i, j);
-
-                    for (size_t _j = 0; _j < _mToInvert.cols(); _j++)
-                    {
-                        _mToInvert(i, _j) /= dPivot;
-                        _mInverse(i, _j) /= dPivot;
-                    }
-
-                    for (size_t _i = i+1; _i < _mToInvert.rows(); _i++)
-                    {
-                        std::complex<double> dFactor = _mToInvert(_i, j);
-
-                        if (dFactor == 0.0) // Bereits 0???
-                            continue;
-
-                        for (size_t _j = 0; _j < _mToInvert.cols(); _j++)
-                        {
-                            _mToInvert(_i, _j) -= _mToInvert(i, _j)*dFactor;
-                            _mInverse(_i, _j) -= _mInverse(i, _j)*dFactor;
-                        }
-                    }
-
-                    break;
-                }
-            }
-        }
-    }
-
-    // die Matrix _mToInvert() sollte nun Dreiecksgestalt besitzen. Jetzt den Gauss von unten her umkehren
-    for (int j = (int)_mToInvert.rows()-1; j >= 0; j--)
-    {
-        if (_mToInvert(j, j) == 0.0) // Hauptdiagonale ist ein Element == 0??
-            throw SyntaxError(SyntaxError::MATRIX_IS_NOT_INVERTIBLE, errorInfo.command, errorInfo.position);
-
-        if (_mToInvert(j, j) != 1.0)
-        {
-            for (size_t _j = 0; _j < _mInverse.cols(); _j++)
-                _mInverse(j, _j) /= _mToInvert(j, j);
-
-            _mToInvert(j, j) = 1.0;
-        }
-
-        for (int i = 0; i < j; i++)
-        {
-            for (size_t _j = 0; _j < _mInverse.cols(); _j++)
-                _mInverse(i, _j) -= _mToInvert(i, j)*_mInverse(j, _j);
-
-            _mToInvert(i, j) -= _mToInvert(i, j)*_mToInvert(j, j);
-        }
-    }
+    // The inverse will lose about log10(1/rcond) digits
+    // of precision
+    if (dRcond < MATRIX_CONDITION_WARNING_LIMIT)
+        NumeReKernel::issueWarning(_lang.get("MATOP_INVERT_NEARLY_SINGULAR", toString(dRcond, 3)));
 
-    return _mInverse;
+    return fromEigenMatrix(lu.inverse());
 }
 
 
@@ -2519,14 +2421,17 @@ static void solveLGSSymbolic(const Matrix& _mMatrix, const MatFuncErrorInfo& err
 /////////////////////////////////////////////////
 /// \brief This static function will solve the
 /// system of linear equations passed as matrix
-/// using the Gauss elimination algorithm.
+/// using the Gauss elimination algorithm with
+/// partial pivoting.
 ///
 /// \param funcData const MatFuncData&
 /// \param errorInfo const MatFuncErrorInfo&
 /// \return Matrix
 ///
+/// \c __attribute__((force_align_arg_pointer))
+/// fixes TDM-GCC Bug for wrong stack alignment.
 /////////////////////////////////////////////////
-static Matrix solveLGS(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo)
+__attribute__((force_align_arg_pointer)) static Matrix solveLGS(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo)
 {
     if (funcData.mat1.isEmpty())
         throw SyntaxError(SyntaxError::MATRIX_CANNOT_HAVE_ZERO_SIZE, errorInfo.command, errorInfo.position);
@@ -2540,54 +2445,64 @@ static Matrix solveLGS(const MatFuncData& funcData, const MatFuncErrorInfo& erro
         return _mResult;
     }
 
+    // Regular square systems are solved directly using
+    // a pivoted LU decomposition. Singular systems are
+    // handled by the elimination below, which is able to
+    // detect and describe the solution space
+    if (_mToSolve.rows()+1 == _mToSolve.cols() && !_mToSolve.containsInvalidValues())
+    {
+        Eigen::MatrixXcd mAugmented = toEigenMatrix(_mToSolve);
+        Eigen::PartialPivLU<Eigen::MatrixXcd> lu(mAugmented.leftCols(_mToSolve.rows()));
+
+        if (lu.rcond() > MATRIX_SINGULARITY_LIMIT)
+            return fromEigenMatrix(lu.solve(mAugmented.rightCols(1)));
+    }
+
     // Allgemeiner Fall fuer n > 2
-    for (size_t j = 0; j < _mToSolve.cols()-1; j++)
+    for (size_t j = 0; j < std::min(_mToSolve.cols()-1, _mToSolve.rows()); j++)
     {
-        for (size_t i = j; i < _mToSolve.rows(); i++)
+        // Use the element with the largest magnitude
+        // as pivot to reduce the rounding errors
+        size_t nPivot = j;
+
+        for (size_t i = j+1; i < _mToSolve.rows(); i++)
         {
-            if (_mToSolve(i, j) != 0.0)
-            {
-                if (i != j) //vertauschen
-                {
-                    std::complex<double> dElement;
+            if (std::abs(_mToSolve(i, j)) > std::abs(_mToSolve(nPivot, j)))
+                nPivot = i;
+        }
 
-                    for (size_t _j = 0; _j < _mToSolve.cols(); _j++)
-                    {
-                        dElement = _mToSolve(i, _j);
-                        _mToSolve(i, _j) = _mToSolve(j, _j);
-                        _mToSolve(j, _j) = dElement;
-                    }
+        // Matrix scheint keinen vollen Rang zu besitzen
+        if (_mToSolve(nPivot, j) == 0.0)
+            continue;
 
-                    i = j-1;
-                }
-                else //Gauss-Elimination
-                {
-                    std::complex<double> dPivot = _mToSolve(i, j);
+        if (nPivot != j) //vertauschen
+        {
+            for (size_t _j = 0; _j < _mToSolve.cols(); _j++)
+            {
+                std::swap(_mToSolve(nPivot, _j), _mToSolve(j, _j));
+            }
+        }
 
-                    for (size_t _j = 0; _j < _mToSolve.cols(); _j++)
-                    {
-                        _mToSolve(i, _j) /= dPivot;
-                    }
+        //Gauss-Elimination
+        std::complex<double> dPivot = _mToSolve(j, j);
 
-                    #pragma omp parallel for
-                    for (size_t _i = i+1; _i < _mToSolve.rows(); _i++)
-                    {
-                        std::complex<double> dFactor = _mToSolve(_i, j);
+        for (size_t _j = 0; _j < _mToSolve.cols(); _j++)
+        {
+            _mToSolve(j, _j) /= dPivot;
+        }
 
-                        if (dFactor == 0.0) // Bereits 0???
-                            continue;
+        #pragma omp parallel for
+        for (size_t _i = j+1; _i < _mToSolve.rows(); _i++)
+        {
+            std::complex<double> dFactor = _mToSolve(_i, j);
 
-                        for (size_t _j = 0; _j < _mToSolve.cols(); _j++)
-                        {
-                            _mToSolve(_i, _j) -= _mToSolve(i, _j)*dFactor;
-                        }
-                    }
+            if (dFactor == 0.0) // Bereits 0???
+                continue;
 
-                    break;
-                }
+            for (size_t _j = 0; _j < _mToSolve.cols(); _j++)
+            {
+                _mToSolve(_i, _j) -= _mToSolve(j, _j)*dFactor;
             }
-            /*else if (_mToSolve[i][j] == 0.0 && j+1 == _mToSolve.size()) // Matrix scheint keinen vollen Rang zu besitzen
-                throw MATRIX_IS_NOT_INVERTIBLE;*/
         }
     }
 
@@ -2682,6 +2597,269 @@ static Matrix solveLGS(const MatFuncData& funcData, const MatFuncErrorInfo& erro
 }
 
 
+/////////////////////////////////////////////////
+/// \brief This static function checks the
+/// dimensions of the coefficient matrix and the
+/// right-hand sides passed to one of the
+/// factorisation-based solvers.
+///
+/// \param funcData const MatFuncData&
+/// \param errorInfo const MatFuncErrorInfo&
+/// \param needsSquare bool
+/// \return void
+///
+/////////////////////////////////////////////////
+static void checkLinearSystem(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo, bool needsSquare)
+{
+    if (funcData.mat1.isEmpty() || funcData.mat2.isEmpty())
+        throw SyntaxError(SyntaxError::MATRIX_CANNOT_HAVE_ZERO_SIZE, errorInfo.command, errorInfo.position);
+
+    if ((needsSquare && !funcData.mat1.isSquare()) || funcData.mat1.rows() != funcData.mat2.rows())
+        throw SyntaxError(SyntaxError::WRONG_MATRIX_DIMENSIONS_FOR_MATOP, errorInfo.command, errorInfo.position,
+                          printMatrixDim(funcData.mat1) + " vs. " + printMatrixDim(funcData.mat2));
+
+    if (funcData.mat1.containsInvalidValues() || funcData.mat2.containsInvalidValues())
+        throw SyntaxError(SyntaxError::MATRIX_CONTAINS_INVALID_VALUES, errorInfo.command, errorInfo.position);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This static function implements the
+/// "linsolve(A,B)" function, which solves A*X=B
+/// for a square matrix A and an arbitrary number
+/// of right-hand sides in the columns of B using
+/// a LU decomposition with partial pivoting.
+///
+/// \param funcData const MatFuncData&
+/// \param errorInfo const MatFuncErrorInfo&
+/// \return Matrix
+///
+/// \c __attribute__((force_align_arg_pointer))
+/// fixes TDM-GCC Bug for wrong stack alignment.
+/////////////////////////////////////////////////
+__attribute__((force_align_arg_pointer)) static Matrix solveLU(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo)
+{
+    checkLinearSystem(funcData, errorInfo, true);
+
+    Eigen::PartialPivLU<Eigen::MatrixXcd> lu(toEigenMatrix(funcData.mat1));
+
+    // The decomposition itself does not fail for singular
+    // matrices. We detect them with the estimated
+    // reciprocal condition number instead
+    if (!(lu.rcond() > MATRIX_SINGULARITY_LIMIT))
+        throw SyntaxError(SyntaxError::MATRIX_IS_NOT_INVERTIBLE, errorInfo.command, errorInfo.position);
+
+    return fromEigenMatrix(lu.solve(toEigenMatrix(funcData.mat2)));
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This static function implements the
+/// "cholsolve(A,B)" function, which solves A*X=B
+/// for a hermitian positive definite matrix A
+/// and an arbitrary number of right-hand sides
+/// using a Cholesky decomposition.
+///
+/// \param funcData const MatFuncData&
+/// \param errorInfo const MatFuncErrorInfo&
+/// \return Matrix
+///
+/// \c __attribute__((force_align_arg_pointer))
+/// fixes TDM-GCC Bug for wrong stack alignment.
+/////////////////////////////////////////////////
+__attribute__((force_align_arg_pointer)) static Matrix solveCholesky(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo)
+{
+    checkLinearSystem(funcData, errorInfo, true);
+
+    Eigen::MatrixXcd mMatrix = toEigenMatrix(funcData.mat1);
+
+    // The decomposition only reads the lower triangle,
+    // therefore we have to ensure that the matrix is
+    // actually hermitian
+    if (!mMatrix.isApprox(mMatrix.adjoint()))
+        throw SyntaxError(SyntaxError::MATRIX_IS_NOT_SYMMETRIC, errorInfo.command, errorInfo.position);
+
+    Eigen::LLT<Eigen::MatrixXcd> llt(mMatrix);
+
+    // Fails, if the matrix is not positive definite
+    if (llt.info() != Eigen::Success)
+        throw SyntaxError(SyntaxError::MATRIX_IS_NOT_INVERTIBLE, errorInfo.command, errorInfo.position);
+
+    return fromEigenMatrix(llt.solve(toEigenMatrix(funcData.mat2)));
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This static function implements the
+/// "lstsq(A,B)" function, which returns the
+/// least-squares solution of A*X=B for an
+/// arbitrary matrix A and an arbitrary number of
+/// right-hand sides using a QR decomposition
+/// with column pivoting. Rank deficient systems
+/// return a basic solution.
+///
+/// \param funcData const MatFuncData&
+/// \param errorInfo const MatFuncErrorInfo&
+/// \return Matrix
+///
+/// \c __attribute__((force_align_arg_pointer))
+/// fixes TDM-GCC Bug for wrong stack alignment.
+/////////////////////////////////////////////////
+__attribute__((force_align_arg_pointer)) static Matrix solveLeastSquares(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo)
+{
+    checkLinearSystem(funcData, errorInfo, false);
+
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXcd> qr(toEigenMatrix(funcData.mat1));
+
+    if (!qr.rank())
+        throw SyntaxError(SyntaxError::LGS_HAS_NO_UNIQUE_SOLUTION, errorInfo.command, errorInfo.position);
+
+    return fromEigenMatrix(qr.solve(toEigenMatrix(funcData.mat2)));
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This static function implements the
+/// "tosparse(A)" function, which returns the
+/// non-zero elements of a matrix as triplets of
+/// row, column and value. The last element is
+/// always part of the triplets to keep the
+/// dimensions of the matrix.
+///
+/// \param funcData const MatFuncData&
+/// \param errorInfo const MatFuncErrorInfo&
+/// \return Matrix
+///
+/////////////////////////////////////////////////
+static Matrix toSparseTriplets(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo)
+{
+    if (funcData.mat1.isEmpty())
+        throw SyntaxError(SyntaxError::MATRIX_CANNOT_HAVE_ZERO_SIZE, errorInfo.command, errorInfo.position);
+
+    std::vector<std::complex<double>> vTriplets;
+
+    for (size_t j = 0; j < funcData.mat1.cols(); j++)
+    {
+        for (size_t i = 0; i < funcData.mat1.rows(); i++)
+        {
+            if (funcData.mat1(i, j) != 0.0)
+            {
+                vTriplets.push_back(i+1);
+                vTriplets.push_back(j+1);
+                vTriplets.push_back(funcData.mat1(i, j));
+            }
+        }
+    }
+
+    if (funcData.mat1(funcData.mat1.rows()-1, funcData.mat1.cols()-1) == 0.0)
+    {
+        vTriplets.push_back(funcData.mat1.rows());
+        vTriplets.push_back(funcData.mat1.cols());
+        vTriplets.push_back(0.0);
+    }
+
+    Matrix _mTriplets;
+    _mTriplets.assign(3, vTriplets.size() / 3, vTriplets);
+    _mTriplets.transpose();
+
+    return _mTriplets;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This static function implements the
+/// "todense(T)" function, which creates a dense
+/// matrix from a matrix of triplets of row,
+/// column and value. The dimensions are derived
+/// from the largest indices.
+///
+/// \param funcData const MatFuncData&
+/// \param errorInfo const MatFuncErrorInfo&
+/// \return Matrix
+///
+/////////////////////////////////////////////////
+static Matrix toDenseMatrix(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo)
+{
+    if (funcData.mat1.isEmpty())
+        throw SyntaxError(SyntaxError::MATRIX_CANNOT_HAVE_ZERO_SIZE, errorInfo.command, errorInfo.position);
+
+    SparseMatrix _mSparse;
+    _mSparse.assignTriplets(funcData.mat1);
+
+    return _mSparse.toDense();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This static function implements the
+/// "sparsemul(T,B)" function, which multiplies
+/// the sparse matrix defined by the triplets in
+/// T with the dense matrix B. The sparse matrix
+/// is never expanded.
+///
+/// \param funcData const MatFuncData&
+/// \param errorInfo const MatFuncErrorInfo&
+/// \return Matrix
+///
+/////////////////////////////////////////////////
+static Matrix sparseMultiply(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo)
+{
+    if (funcData.mat1.isEmpty() || funcData.mat2.isEmpty())
+        throw SyntaxError(SyntaxError::MATRIX_CANNOT_HAVE_ZERO_SIZE, errorInfo.command, errorInfo.position);
+
+    SparseMatrix _mSparse;
+    _mSparse.assignTriplets(funcData.mat1, 0u, funcData.mat2.rows());
+
+    return _mSparse * funcData.mat2;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This static function implements the
+/// "sparsesolve(T,B)" function, which solves
+/// A*X=B for the sparse square matrix A defined
+/// by the triplets in T and an arbitrary number
+/// of right-hand sides using a sparse LU
+/// decomposition with a fill-reducing ordering.
+///
+/// \param funcData const MatFuncData&
+/// \param errorInfo const MatFuncErrorInfo&
+/// \return Matrix
+///
+/// \c __attribute__((force_align_arg_pointer))
+/// fixes TDM-GCC Bug for wrong stack alignment.
+/////////////////////////////////////////////////
+__attribute__((force_align_arg_pointer)) static Matrix sparseSolve(const MatFuncData& funcData, const MatFuncErrorInfo& errorInfo)
+{
+    if (funcData.mat1.isEmpty() || funcData.mat2.isEmpty())
+        throw SyntaxError(SyntaxError::MATRIX_CANNOT_HAVE_ZERO_SIZE, errorInfo.command, errorInfo.position);
+
+    if (funcData.mat2.containsInvalidValues())
+        throw SyntaxError(SyntaxError::MATRIX_CONTAINS_INVALID_VALUES, errorInfo.command, errorInfo.position);
+
+    SparseMatrix _mSparse;
+    _mSparse.assignTriplets(funcData.mat1, funcData.mat2.rows(), funcData.mat2.rows());
+
+    // The compressed layout is identical, therefore
+    // we can map the sparse matrix directly
+    Eigen::Map<const Eigen::SparseMatrix<std::complex<double>>> mMapped(_mSparse.rows(), _mSparse.cols(), _mSparse.nonZeros(),
+                                                                      _mSparse.colStarts(), _mSparse.rowIndices(), _mSparse.values());
+
+    Eigen::SparseLU<Eigen::SparseMatrix<std::complex<double>>, Eigen::COLAMDOrdering<int>> solver;
+    solver.compute(mMapped);
+
+    if (solver.info() != Eigen::Success)
+        throw SyntaxError(SyntaxError::MATRIX_IS_NOT_INVERTIBLE, errorInfo.command, errorInfo.position);
+
+    Eigen::MatrixXcd mSolution = solver.solve(toEigenMatrix(funcData.mat2));
+
+    if (solver.info() != Eigen::Success)
+        throw SyntaxError(SyntaxError::MATRIX_IS_NOT_INVERTIBLE, errorInfo.command, errorInfo.position);
+
+    return fromEigenMatrix(mSolution);
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This static function implements the
 /// "diag()" function.
@@ -3807,6 +3985,13 @@ static std::map<std::string,MatFuncDef> getMatrixFunctions()
     mFunctions["cumsum"] = MatFuncDef(MATSIG_MAT_NOPT, matrixCumSum);
     mFunctions["cumprd"] = MatFuncDef(MATSIG_MAT_NOPT, matrixCumPrd);
     mFunctions["solve"] = MatFuncDef(MATSIG_MAT, solveLGS);
+    mFunctions["linsolve"] = MatFuncDef(MATSIG_MAT_MAT, solveLU);
+    mFunctions["cholsolve"] = MatFuncDef(MATSIG_MAT_MAT, solveCholesky);
+    mFunctions["lstsq"] = MatFuncDef(MATSIG_MAT_MAT, solveLeastSquares);
+    mFunctions["tosparse"] = MatFuncDef(MATSIG_MAT, toSparseTriplets);
+    mFunctions["todense"] = MatFuncDef(MATSIG_MAT, toDenseMatrix);
+    mFunctions["sparsemul"] = MatFuncDef(MATSIG_MAT_MAT, sparseMultiply);
+    mFunctions["sparsesolve"] = MatFuncDef(MATSIG_MAT_MAT, sparseSolve);
     mFunctions["diag"] = MatFuncDef(MATSIG_MAT, diagonalMatrix);
     mFunctions["carttocyl"] = MatFuncDef(MATSIG_MAT, cartToCyl);
     mFunctions["carttopol"] = MatFuncDef(MATSIG_MAT, cartToPolar);
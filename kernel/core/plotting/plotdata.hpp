@@ -59,6 +59,7 @@ class PlotData : public FileSystem
 
         enum LogicalPlotSetting
         {
+            LOG_ADAPTIVE,
             LOG_ALLHIGHRES,
             LOG_ALPHA,
             LOG_ALPHAMASK,
@@ -17,6 +17,8 @@
 ******************************************************************************/
 
 #include <wx/image.h>
+#include <omp.h>
+#include <memory>
 
 #include "plotting.hpp"
 #include "plotasset.hpp"
@@ -32,6 +34,30 @@ extern mglGraph _fontData;
 std::string removeQuotationMarks(const std::string&);
 
 
+/////////////////////////////////////////////////
+/// \brief Sets the number of threads used by
+/// MathGL for rasterizing and restores the
+/// previous number, once the instance goes out
+/// of scope. The MathGL setting is process-wide.
+/////////////////////////////////////////////////
+class MglThreadCount
+{
+    private:
+        int m_previous;
+
+    public:
+        MglThreadCount(int nThreads) : m_previous(mglNumThr)
+        {
+            mgl_set_num_thr(nThreads);
+        }
+
+        ~MglThreadCount()
+        {
+            mgl_set_num_thr(m_previous);
+        }
+};
+
+
 
 static bool isPlot1D(StringView sCommand)
 {
@@ -94,6 +120,11 @@ static bool has3DView(StringView sCommand)
 #define APPR_ONE 0.9999999
 #define APPR_TWO 1.9999999
 #define STYLES_COUNT 20
+// Minimal number of initial samples for adaptive sampling
+#define ADAPTIVE_INITIAL_SAMPLES 16
+// Maximal subdivision of the uniform sampling distance
+// during adaptive sampling
+#define ADAPTIVE_MAX_REFINEMENT 64
 
 void applyLegendPosition(mglGraph* _graph, int nLegendPos)
 {
@@ -1067,6 +1098,19 @@ bool Plot::createPlotOrAnimation(size_t nPlotCompose, size_t nPlotComposeSize, b
     if (_pData.getAnimateSamples() && bOutputDesired)
         _graph->StartGIF(sOutputName.c_str(), 40); // 40msec = 2sec bei 50 Frames, d.h. 25 Bilder je Sekunde
 
+    // The frames of animations are rendered one after
+    // another on this graph, because the plotted functions
+    // are evaluated by the kernel's parser through the
+    // shared plotting variables and the assets, ranges and
+    // styles of this instance are updated for every frame.
+    // Only the rasterization of each frame uses all
+    // available cores. The previous number of threads is
+    // restored afterwards
+    std::unique_ptr<MglThreadCount> threadCount;
+
+    if (_pData.getAnimateSamples() && bAnimateVar)
+        threadCount.reset(new MglThreadCount(omp_get_max_threads()));
+
     // Load the background image from the target file and apply the
     // black/white color scheme
     if (_pData.getSettings(PlotData::STR_BACKGROUND).length() && _pData.getSettings(PlotData::STR_BACKGROUNDCOLORSCHEME) != "<<REALISTIC>>")
@@ -4968,6 +5012,357 @@ void Plot::defaultRanges(size_t nPlotCompose, bool bNewSubPlot)
 }
 
 
+/////////////////////////////////////////////////
+/// \brief Static helper to compare the results of
+/// a vectorised and a scalar evaluation.
+///
+/// \param vectorised const std::complex<double>&
+/// \param scalar const std::complex<double>&
+/// \return bool
+///
+/////////////////////////////////////////////////
+static bool isSameResult(const std::complex<double>& vectorised, const std::complex<double>& scalar)
+{
+    if (mu::isnan(vectorised) || mu::isnan(scalar))
+        return mu::isnan(vectorised) && mu::isnan(scalar);
+
+    return vectorised == scalar
+        || std::abs(vectorised - scalar) <= 1e-10 * std::max(std::abs(vectorised), std::abs(scalar));
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the uniformly distributed
+/// samples of the selected plotting range
+/// respecting a logarithmic scale.
+///
+/// \param nRange int
+/// \return std::vector<double>
+///
+/////////////////////////////////////////////////
+std::vector<double> Plot::getSampleAxis(int nRange)
+{
+    std::vector<double> vAxis(_pInfo.nSamples);
+
+    for (int n = 0; n < _pInfo.nSamples; n++)
+    {
+        if (_pData.getLogscale(nRange))
+            vAxis[n] = _pInfo.ranges[nRange].log(n, _pInfo.nSamples).real();
+        else
+            vAxis[n] = _pInfo.ranges[nRange](n, _pInfo.nSamples).real();
+    }
+
+    return vAxis;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function evaluates the
+/// current plotting expression at all passed
+/// values of the selected coordinate. The whole
+/// grid is evaluated in a single vectorised
+/// parser call, if the expression only consists
+/// of element-wise operations. Aggregating
+/// functions (e.g. "x/max(abs(x))") or random
+/// values would otherwise see all samples at
+/// once. The vectorised results are verified
+/// with scalar evaluations at the first, the
+/// middle and the last sample and the evaluation
+/// falls back to a sample-wise evaluation, if
+/// they differ.
+///
+/// \param nCoord int
+/// \param vX const std::vector<double>&
+/// \param vY std::vector<std::vector<std::complex<double>>>&
+/// \return void
+///
+/// \remark The coordinate variable contains the
+/// last value afterwards, as the legend entries
+/// are evaluated using this value.
+/////////////////////////////////////////////////
+void Plot::evalSamples(int nCoord, const std::vector<double>& vX, std::vector<std::vector<std::complex<double>>>& vY)
+{
+    const mu::StackItem* vResults = nullptr;
+    bool isVectorised = vX.size() > 1;
+    vY.clear();
+
+    if (isVectorised)
+    {
+        try
+        {
+            _defVars.vValue[nCoord][0] = mu::Array(vX);
+            vResults = _parser.Eval(_pInfo.nFunctions);
+            vY.resize(_pInfo.nFunctions, std::vector<std::complex<double>>(vX.size()));
+
+            if (!_parser.IsElementwise())
+                isVectorised = false;
+
+            for (int i = 0; i < _pInfo.nFunctions && isVectorised; i++)
+            {
+                const mu::Array& res = vResults[i].get();
+
+                if (res.size() != vX.size())
+                {
+                    isVectorised = false;
+                    break;
+                }
+
+                for (size_t x = 0; x < vX.size(); x++)
+                {
+                    vY[i][x] = res.get(x).getNum().asCF64();
+                }
+            }
+        }
+        catch (...)
+        {
+            isVectorised = false;
+        }
+    }
+
+    // Verify the vectorised evaluation at the first, the
+    // middle and the last sample. The last sample has to
+    // be evaluated last (see remark)
+    if (isVectorised)
+    {
+        if ((size_t)_pInfo.nFunctions != vY.size())
+            isVectorised = false;
+
+        for (size_t x : {(size_t)0, vX.size()/2, vX.size()-1})
+        {
+            if (!isVectorised)
+                break;
+
+            _defVars.vValue[nCoord][0] = mu::Value(vX[x]);
+            vResults = _parser.Eval(_pInfo.nFunctions);
+
+            for (int i = 0; i < _pInfo.nFunctions && isVectorised; i++)
+            {
+                isVectorised = isSameResult(vY[i][x], vResults[i].get().front().getNum().asCF64());
+            }
+        }
+
+        if (isVectorised)
+            return;
+    }
+
+    vY.clear();
+
+    for (size_t x = 0; x < vX.size(); x++)
+    {
+        _defVars.vValue[nCoord][0] = mu::Value(vX[x]);
+        vResults = _parser.Eval(_pInfo.nFunctions);
+
+        if (vY.size() != (size_t)_pInfo.nFunctions)
+            vY.resize(_pInfo.nFunctions, std::vector<std::complex<double>>(vX.size(), NAN));
+
+        for (int i = 0; i < _pInfo.nFunctions; i++)
+        {
+            vY[i][x] = vResults[i].get().front().getNum().asCF64();
+        }
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief This member function samples the
+/// current 1D plotting expression adaptively.
+/// Starting from a coarse uniform grid, those
+/// intervals are subdivided, which show a strong
+/// bend or a discontinuity of the curve in the
+/// normalized plotting box, until the sample
+/// budget is used up. The number of samples
+/// corresponds to the usual number of samples.
+///
+/// \param vX std::vector<double>&
+/// \param vY std::vector<std::vector<std::complex<double>>>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void Plot::sampleAdaptively1D(std::vector<double>& vX, std::vector<std::vector<std::complex<double>>>& vY)
+{
+    size_t nBudget = _pInfo.nSamples;
+    size_t nInitial = std::max({nBudget / 4, std::min(nBudget, (size_t)ADAPTIVE_INITIAL_SAMPLES), (size_t)2});
+    double dMinWidth = 1.0 / (double)(nBudget * ADAPTIVE_MAX_REFINEMENT);
+    bool isLog = _pData.getLogscale(XRANGE);
+    double dFront = _pInfo.ranges[XRANGE].front().real();
+    double dBack = _pInfo.ranges[XRANGE].back().real();
+
+    // The refinement works on the normalized
+    // parameter u in [0,1]
+    auto toX = [=](double u)
+        {
+            if (isLog)
+                return dFront * std::pow(dBack / dFront, u);
+
+            return dFront + (dBack - dFront) * u;
+        };
+
+    std::vector<double> vU(nInitial);
+
+    for (size_t n = 0; n < nInitial; n++)
+    {
+        vU[n] = n / (double)(nInitial-1);
+    }
+
+    vX.resize(nInitial);
+
+    for (size_t n = 0; n < nInitial; n++)
+    {
+        vX[n] = toX(vU[n]);
+    }
+
+    evalSamples(XCOORD, vX, vY);
+
+    std::vector<double> vScore;
+    std::vector<size_t> vOrder;
+
+    while (vU.size() < nBudget)
+    {
+        // Determine the scale of the curves to
+        // normalize the slopes
+        double dMin = INFINITY;
+        double dMax = -INFINITY;
+
+        for (const auto& func : vY)
+        {
+            for (const auto& val : func)
+            {
+                if (std::isfinite(val.real()) && std::isfinite(val.imag()))
+                {
+                    dMin = std::min({dMin, val.real(), val.imag()});
+                    dMax = std::max({dMax, val.real(), val.imag()});
+                }
+            }
+        }
+
+        double dScale = dMax > dMin ? dMax - dMin : 1.0;
+        size_t nIntervals = vU.size()-1;
+        std::vector<double> vAngle(vU.size(), 0.0);
+        std::vector<double> vJump(nIntervals, 0.0);
+
+        // Calculate the bending angles at all inner points
+        // and mark the discontinuities of the intervals
+        for (const auto& func : vY)
+        {
+            for (int part = 0; part < 2; part++)
+            {
+                auto y = [&](size_t n){return part ? func[n].imag() : func[n].real();};
+
+                for (size_t n = 0; n < nIntervals; n++)
+                {
+                    if (std::isfinite(y(n)) != std::isfinite(y(n+1)))
+                        vJump[n] = M_PI;
+
+                    if (!n || !std::isfinite(y(n-1)) || !std::isfinite(y(n)) || !std::isfinite(y(n+1)))
+                        continue;
+
+                    double dSlopeLeft = (y(n) - y(n-1)) / dScale / (vU[n] - vU[n-1]);
+                    double dSlopeRight = (y(n+1) - y(n)) / dScale / (vU[n+1] - vU[n]);
+                    vAngle[n] = std::max(vAngle[n], std::abs(std::atan(dSlopeRight) - std::atan(dSlopeLeft)));
+                }
+            }
+        }
+
+        // Score the intervals: strongly bent or
+        // discontinuous and wide intervals first. The
+        // small offset ensures that straight lines are
+        // sampled uniformly
+        vScore.assign(nIntervals, 0.0);
+        double dMeanScore = 0.0;
+
+        for (size_t n = 0; n < nIntervals; n++)
+        {
+            double dWidth = vU[n+1] - vU[n];
+
+            if (dWidth < 2.0 * dMinWidth)
+                continue;
+
+            vScore[n] = dWidth * (std::max({vAngle[n], vAngle[n+1], vJump[n]}) + 1e-3);
+            dMeanScore += vScore[n] / nIntervals;
+        }
+
+        vOrder.resize(nIntervals);
+
+        for (size_t n = 0; n < nIntervals; n++)
+        {
+            vOrder[n] = n;
+        }
+
+        std::sort(vOrder.begin(), vOrder.end(), [&](size_t a, size_t b){return vScore[a] > vScore[b];});
+
+        // Refine all intervals above the mean score as
+        // long as the budget is not exhausted
+        size_t nRefine = 0;
+
+        while (nRefine < nIntervals
+               && vU.size() + nRefine < nBudget
+               && vScore[vOrder[nRefine]] > 0.0
+               && (vScore[vOrder[nRefine]] >= dMeanScore || !nRefine))
+        {
+            nRefine++;
+        }
+
+        if (!nRefine)
+            break;
+
+        std::sort(vOrder.begin(), vOrder.begin()+nRefine);
+
+        std::vector<double> vNewU(nRefine);
+        std::vector<double> vNewX(nRefine);
+        std::vector<std::vector<std::complex<double>>> vNewY;
+
+        for (size_t n = 0; n < nRefine; n++)
+        {
+            vNewU[n] = 0.5 * (vU[vOrder[n]] + vU[vOrder[n]+1]);
+            vNewX[n] = toX(vNewU[n]);
+        }
+
+        evalSamples(XCOORD, vNewX, vNewY);
+
+        // Merge the new samples into the sorted ones
+        std::vector<double> vMergedU;
+        std::vector<std::vector<std::complex<double>>> vMergedY(vY.size());
+        vMergedU.reserve(vU.size() + nRefine);
+
+        for (size_t n = 0, r = 0; n < vU.size(); n++)
+        {
+            vMergedU.push_back(vU[n]);
+
+            for (size_t i = 0; i < vY.size(); i++)
+            {
+                vMergedY[i].push_back(vY[i][n]);
+            }
+
+            if (r < nRefine && vOrder[r] == n)
+            {
+                vMergedU.push_back(vNewU[r]);
+
+                for (size_t i = 0; i < vY.size(); i++)
+                {
+                    vMergedY[i].push_back(i < vNewY.size() ? vNewY[i][r] : NAN);
+                }
+
+                r++;
+            }
+        }
+
+        vU.swap(vMergedU);
+        vY.swap(vMergedY);
+    }
+
+    vX.resize(vU.size());
+
+    for (size_t n = 0; n < vU.size(); n++)
+    {
+        vX[n] = toX(vU[n]);
+    }
+
+    // Ensure that the x variable contains the last
+    // x value for the legend entries
+    _defVars.vValue[XCOORD][0] = mu::Value(vX.back());
+}
+
+
 /////////////////////////////////////////////////
 /// \brief This member function calculates the
 /// plotting data points from usual expressions.
@@ -5000,25 +5395,34 @@ void Plot::fillData(double dt_max, int t_animate)
         // Necessary, because of evaluatio of the legend entries
         _parser.SetExpr(sFunc);
 
-        for (int x = 0; x < _pInfo.nSamples; x++)
+        std::vector<double> vX;
+        std::vector<std::vector<std::complex<double>>> vY;
+
+        // Adaptive sampling is only possible for usual
+        // intervals and not for explicit lists of samples
+        if (_pData.getSettings(PlotData::LOG_ADAPTIVE) && !_pInfo.ranges[XRANGE].getSamples())
+            sampleAdaptively1D(vX, vY);
+        else
         {
-            if (x != 0)
-            {
-                if (_pData.getLogscale(XRANGE))
-                    _defVars.vValue[XCOORD][0] = _pInfo.ranges[XRANGE].log(x, _pInfo.nSamples);
-                else
-                    _defVars.vValue[XCOORD][0] = _pInfo.ranges[XRANGE](x, _pInfo.nSamples);
-            }
+            vX = getSampleAxis(XRANGE);
+            evalSamples(XCOORD, vX, vY);
+        }
 
-            vResults = _parser.Eval(_pInfo.nFunctions);
+        if ((size_t)_pInfo.nFunctions != vFuncMap.size())
+            throw SyntaxError(SyntaxError::PLOT_ERROR, sCurrentExpr, sCurrentExpr.find(' ')+1);
 
-            if ((size_t)_pInfo.nFunctions != vFuncMap.size())
-                throw SyntaxError(SyntaxError::PLOT_ERROR, sCurrentExpr, sCurrentExpr.find(' ')+1);
+        for (int i = 0; i < _pInfo.nFunctions; i++)
+        {
+            for (size_t x = 0; x < vX.size(); x++)
+            {
+                m_manager.assets[vFuncMap[i]].writeAxis(vX[x], x, XCOORD);
+                m_manager.assets[vFuncMap[i]].writeData(vY[i][x], 0, x);
+            }
 
-            for (int i = 0; i < _pInfo.nFunctions; i++)
+            for (int x = vX.size(); x < _pInfo.nSamples; x++)
             {
-                m_manager.assets[vFuncMap[i]].writeAxis(_defVars.vValue[XCOORD][0].front().getNum().asF64(), x, XCOORD);
-                m_manager.assets[vFuncMap[i]].writeData(vResults[i].get().front().getNum().asCF64(), 0, x);
+                m_manager.assets[vFuncMap[i]].writeAxis(vX.back(), x, XCOORD);
+                m_manager.assets[vFuncMap[i]].writeData(NAN, 0, x);
             }
         }
     }
@@ -5106,6 +5510,9 @@ void Plot::fillData(double dt_max, int t_animate)
         // Necessary, because of evaluatio of the legend entries
         _parser.SetExpr(sFunc);
 
+        std::vector<double> vYAxis = getSampleAxis(YRANGE);
+        std::vector<std::vector<std::complex<double>>> vZ;
+
         for (int x = 0; x < _pInfo.nSamples; x++)
         {
             if (x != 0)
@@ -5116,23 +5523,19 @@ void Plot::fillData(double dt_max, int t_animate)
                     _defVars.vValue[XCOORD][0] = _pInfo.ranges[XRANGE](x, _pInfo.nSamples);
             }
 
-            for (int y = 0; y < _pInfo.nSamples; y++)
-            {
-                if (_pData.getLogscale(YRANGE))
-                    _defVars.vValue[YCOORD][0] = _pInfo.ranges[YRANGE].log(y, _pInfo.nSamples);
-                else
-                    _defVars.vValue[YCOORD][0] = _pInfo.ranges[YRANGE](y, _pInfo.nSamples);
-
-                vResults = _parser.Eval(_pInfo.nFunctions);
+            // Evaluate a whole line at once
+            evalSamples(YCOORD, vYAxis, vZ);
 
-                if ((size_t)_pInfo.nFunctions != vFuncMap.size())
-                    throw SyntaxError(SyntaxError::PLOT_ERROR, sCurrentExpr, sCurrentExpr.find(' ')+1);
+            if ((size_t)_pInfo.nFunctions != vFuncMap.size())
+                throw SyntaxError(SyntaxError::PLOT_ERROR, sCurrentExpr, sCurrentExpr.find(' ')+1);
 
-                for (size_t i = 0; i < vFuncMap.size(); i++)
+            for (size_t i = 0; i < vFuncMap.size(); i++)
+            {
+                for (int y = 0; y < _pInfo.nSamples; y++)
                 {
                     m_manager.assets[vFuncMap[i]].writeAxis(_defVars.vValue[XCOORD][0].front().getNum().asF64(), x, XCOORD);
-                    m_manager.assets[vFuncMap[i]].writeAxis(_defVars.vValue[YCOORD][0].front().getNum().asF64(), y, YCOORD);
-                    m_manager.assets[vFuncMap[i]].writeData(vResults[i].get().front().getNum().asCF64(), 0, x, y);
+                    m_manager.assets[vFuncMap[i]].writeAxis(vYAxis[y], y, YCOORD);
+                    m_manager.assets[vFuncMap[i]].writeData(vZ[i][y], 0, x, y);
                 }
             }
         }
@@ -5145,6 +5548,9 @@ void Plot::fillData(double dt_max, int t_animate)
         // Necessary, because of evaluatio of the legend entries
         _parser.SetExpr(sFunc);
 
+        std::vector<double> vZAxis = getSampleAxis(ZRANGE);
+        std::vector<std::vector<std::complex<double>>> vData;
+
         for (int x = 0; x < _pInfo.nSamples; x++)
         {
             if (x != 0)
@@ -5162,24 +5568,20 @@ void Plot::fillData(double dt_max, int t_animate)
                 else
                     _defVars.vValue[YCOORD][0] = _pInfo.ranges[YRANGE](y, _pInfo.nSamples);
 
-                for (int z = 0; z < _pInfo.nSamples; z++)
-                {
-                    if (_pData.getLogscale(ZRANGE))
-                        _defVars.vValue[ZCOORD][0] = _pInfo.ranges[ZRANGE].log(z, _pInfo.nSamples);
-                    else
-                        _defVars.vValue[ZCOORD][0] = _pInfo.ranges[ZRANGE](z, _pInfo.nSamples);
+                // Evaluate a whole line at once
+                evalSamples(ZCOORD, vZAxis, vData);
 
-                    vResults = _parser.Eval(_pInfo.nFunctions);
-
-                    if ((size_t)_pInfo.nFunctions != vFuncMap.size())
-                        throw SyntaxError(SyntaxError::PLOT_ERROR, sCurrentExpr, sCurrentExpr.find(' ')+1);
+                if ((size_t)_pInfo.nFunctions != vFuncMap.size())
+                    throw SyntaxError(SyntaxError::PLOT_ERROR, sCurrentExpr, sCurrentExpr.find(' ')+1);
 
-                    for (size_t i = 0; i < vFuncMap.size(); i++)
+                for (size_t i = 0; i < vFuncMap.size(); i++)
+                {
+                    for (int z = 0; z < _pInfo.nSamples; z++)
                     {
                         m_manager.assets[vFuncMap[i]].writeAxis(_defVars.vValue[XCOORD][0].front().getNum().asF64(), x, XCOORD);
                         m_manager.assets[vFuncMap[i]].writeAxis(_defVars.vValue[YCOORD][0].front().getNum().asF64(), y, YCOORD);
-                        m_manager.assets[vFuncMap[i]].writeAxis(_defVars.vValue[ZCOORD][0].front().getNum().asF64(), z, ZCOORD);
-                        m_manager.assets[vFuncMap[i]].writeData(vResults[i].get().front().getNum().asCF64(), 0, x, y, z);
+                        m_manager.assets[vFuncMap[i]].writeAxis(vZAxis[z], z, ZCOORD);
+                        m_manager.assets[vFuncMap[i]].writeData(vData[i][z], 0, x, y, z);
                     }
                 }
             }
@@ -100,6 +100,9 @@ class Plot
         size_t countValidElements(const mglData& _mData);
         void prepareMemory();
         void defaultRanges(size_t nPlotCompose, bool bNewSubPlot);
+        std::vector<double> getSampleAxis(int nRange);
+        void evalSamples(int nCoord, const std::vector<double>& vX, std::vector<std::vector<std::complex<double>>>& vY);
+        void sampleAdaptively1D(std::vector<double>& vX, std::vector<std::vector<std::complex<double>>>& vY);
         void fillData(double dt_max, int t_animate);
         void fitPlotRanges(size_t nPlotCompose, bool bNewSubPlot);
         void clearData();
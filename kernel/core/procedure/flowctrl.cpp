@@ -3108,6 +3108,10 @@ int FlowCtrl::calc(StringView sLine, int nthCmd)
     // Get the current bytecode for this command
     int nCurrentCalcType = nCalcType[nthCmd];
 
+    // Measure the run time of this line, if the
+    // profiler is active
+    ProfilerLineScope _lineScope(NumeReKernel::getInstance()->getProfiler(), vCmdArray[nthCmd].nInputLine, !nCurrentCalcType);
+
     // If the current line has no bytecode attached, then
     // change the function and calculate it. Using the determined
     // bytecode, we can omit many checks at the next
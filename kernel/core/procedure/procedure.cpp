@@ -569,6 +569,10 @@ Returnvalue Procedure::execute(StringView sProc, string sVarList, mu::Parser& _p
     NumeReDebugger& _debugger = NumeReKernel::getInstance()->getDebugger();
     _debugger.pushStackItem(sProc + "(" + sVarList + ")", this);
 
+    // Record this call, if the profiler is active
+    NumeReProfiler& _profiler = NumeReKernel::getInstance()->getProfiler();
+    ProfilerProcedureScope _procedureScope(_profiler, "$" + sProc, sCurrentProcedureName);
+
     // Prepare the var factory and obtain the current procedure file
     if (_varFactory)
         delete _varFactory;
@@ -841,6 +845,10 @@ Returnvalue Procedure::execute(StringView sProc, string sVarList, mu::Parser& _p
             }
         }
 
+        // Measure the run time of the current line,
+        // if the profiler is active
+        ProfilerLineScope _lineScope(_profiler, nCurrentLine, nCurrentByteCode == ProcedureCommandLine::BYTECODE_NOT_PARSED);
+
         // define the current command to be a flow control statement,
         // if the procedure was not parsed already
         if (nCurrentByteCode == ProcedureCommandLine::BYTECODE_NOT_PARSED
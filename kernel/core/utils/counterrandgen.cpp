@@ -0,0 +1,392 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "counterrandgen.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <ctime>
+
+// Constants of the Philox4x32 bijection
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+// Constants of the FNV-1a hash of the call sites
+#define FNV_OFFSET 0xCBF29CE484222325ull
+#define FNV_PRIME 0x100000001B3ull
+
+/// The global seed of all counter-based random
+/// number draws. Initialized with the current time
+static std::atomic<uint64_t> randSeed(time(0));
+
+/// The number of draws since the last call to
+/// setRandSeed()
+static std::atomic<uint64_t> randDraws(0);
+
+/////////////////////////////////////////////////
+/// \brief The call site of the random function,
+/// which is evaluated next on this thread.
+/////////////////////////////////////////////////
+struct RandCallSite
+{
+    uint64_t site;
+    uint64_t draw;
+    uint64_t element;
+    bool isSet;
+};
+
+static thread_local RandCallSite randCallSite = {0, 0, 0, false};
+
+
+/////////////////////////////////////////////////
+/// \brief Scrambles the bits of the passed value
+/// using the SplitMix64 finalizer.
+///
+/// \param val uint64_t
+/// \return uint64_t
+///
+/////////////////////////////////////////////////
+static uint64_t mixBits(uint64_t val)
+{
+    val += 0x9E3779B97F4A7C15ull;
+    val = (val ^ (val >> 30)) * 0xBF58476D1CE4E5B9ull;
+    val = (val ^ (val >> 27)) * 0x94D049BB133111EBull;
+    return val ^ (val >> 31);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Applies the Philox4x32-10 bijection to
+/// the passed counter using the passed key. The
+/// result is stored in the counter.
+///
+/// \param counter uint32_t[4]
+/// \param key const uint32_t[2]
+/// \return void
+///
+/////////////////////////////////////////////////
+void philox4x32(uint32_t counter[4], const uint32_t key[2])
+{
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+
+    for (int r = 0; r < PHILOX_ROUNDS; r++)
+    {
+        uint64_t prod0 = (uint64_t)PHILOX_M0 * counter[0];
+        uint64_t prod1 = (uint64_t)PHILOX_M1 * counter[2];
+
+        uint32_t c0 = (uint32_t)(prod1 >> 32) ^ counter[1] ^ k0;
+        uint32_t c1 = (uint32_t)prod1;
+        uint32_t c2 = (uint32_t)(prod0 >> 32) ^ counter[3] ^ k1;
+        uint32_t c3 = (uint32_t)prod0;
+
+        counter[0] = c0;
+        counter[1] = c1;
+        counter[2] = c2;
+        counter[3] = c3;
+
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the global seed of the
+/// counter-based random number draws.
+///
+/// \return uint64_t
+///
+/////////////////////////////////////////////////
+uint64_t getRandSeed()
+{
+    return randSeed;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Sets the global seed of the
+/// counter-based random number draws and resets
+/// the draw counter. The following sequence of
+/// draws is therefore reproducible.
+///
+/// \param seed uint64_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void setRandSeed(uint64_t seed)
+{
+    randSeed = seed;
+    randDraws = 0;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Identifies a call site of a random
+/// function by the expression and the position
+/// of the function within it. The identifier
+/// does not depend on the platform or on memory
+/// addresses and is never zero, because zero
+/// denotes the anonymous call site. It is
+/// computed once, when the expression is
+/// compiled.
+///
+/// \param sExpr const std::string&
+/// \param nPos size_t
+/// \return uint64_t
+///
+/////////////////////////////////////////////////
+uint64_t getRandCallSite(const std::string& sExpr, size_t nPos)
+{
+    uint64_t hash = FNV_OFFSET;
+
+    for (char c : sExpr)
+    {
+        hash ^= (unsigned char)c;
+        hash *= FNV_PRIME;
+    }
+
+    return mixBits(hash ^ nPos) | 1;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the number of the next draw.
+/// Combined with the call site, it identifies
+/// the draw uniquely without any locking.
+///
+/// \return uint64_t
+///
+/////////////////////////////////////////////////
+uint64_t reserveRandDraw()
+{
+    return randDraws++;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Announces the call site of the random
+/// function, which is evaluated next on this
+/// thread. The element denotes the index within
+/// a vectorised evaluation of the expression.
+///
+/// \param site uint64_t
+/// \param draw uint64_t
+/// \param element uint64_t
+/// \return void
+///
+/////////////////////////////////////////////////
+void setRandCallSite(uint64_t site, uint64_t draw, uint64_t element)
+{
+    randCallSite = {site, draw, element, true};
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the random stream for a single
+/// (possibly parallel) draw. The stream is
+/// derived from the call site announced by
+/// setRandCallSite() and consumes it. Draws
+/// without an announced call site use the
+/// anonymous call site zero.
+///
+/// \return uint64_t
+///
+/////////////////////////////////////////////////
+uint64_t reserveRandStream()
+{
+    RandCallSite callSite = randCallSite;
+    randCallSite.isSet = false;
+
+    if (!callSite.isSet)
+        callSite = {0, reserveRandDraw(), 0, true};
+
+    return mixBits(callSite.site ^ mixBits(callSite.draw ^ mixBits(callSite.element)));
+}
+
+
+/////////////////////////////////////////////////
+/// \brief GSL adapter: returns the next 32
+/// random bits.
+///
+/// \param state void*
+/// \return unsigned long int
+///
+/////////////////////////////////////////////////
+static unsigned long int gslGet(void* state)
+{
+    return (*static_cast<CounterRandGen*>(state))();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief GSL adapter: returns a random value in
+/// the interval [0,1).
+///
+/// \param state void*
+/// \return double
+///
+/////////////////////////////////////////////////
+static double gslGetDouble(void* state)
+{
+    return static_cast<CounterRandGen*>(state)->uniform();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief GSL adapter: seeding is done during
+/// construction of the CounterRandGen instance,
+/// therefore this is a no-op.
+///
+/// \param void*
+/// \param unsigned long int
+/// \return void
+///
+/////////////////////////////////////////////////
+static void gslSet(void*, unsigned long int)
+{
+}
+
+
+/// The GSL generator type, which redirects all
+/// calls to the CounterRandGen instance
+static const gsl_rng_type gslCounterRandGenType =
+{
+    "philox4x32",
+    0xFFFFFFFFul,
+    0,
+    sizeof(CounterRandGen),
+    &gslSet,
+    &gslGet,
+    &gslGetDouble
+};
+
+
+/////////////////////////////////////////////////
+/// \brief Constructor. Prepares the sequence of
+/// the selected element within the selected
+/// stream. The upper 32 bits of the stream are
+/// combined with the key.
+///
+/// \param seed uint64_t
+/// \param stream uint64_t
+/// \param element uint64_t
+///
+/////////////////////////////////////////////////
+CounterRandGen::CounterRandGen(uint64_t seed, uint64_t stream, uint64_t element) : m_pos(4)
+{
+    m_key[0] = (uint32_t)seed;
+    m_key[1] = (uint32_t)(seed >> 32) ^ (uint32_t)(stream >> 32);
+
+    m_counter[0] = (uint32_t)element;
+    m_counter[1] = (uint32_t)(element >> 32);
+    m_counter[2] = (uint32_t)stream;
+    m_counter[3] = 0;
+
+    m_gslRng.type = &gslCounterRandGenType;
+    m_gslRng.state = this;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Calculates the next block of four
+/// random values and increments the block
+/// counter.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void CounterRandGen::nextBlock()
+{
+    for (int i = 0; i < 4; i++)
+    {
+        m_buffer[i] = m_counter[i];
+    }
+
+    philox4x32(m_buffer, m_key);
+    m_counter[3]++;
+    m_pos = 0;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns a uniformly distributed random
+/// value in the interval [0,1) with 53 bits of
+/// resolution.
+///
+/// \return double
+///
+/////////////////////////////////////////////////
+double CounterRandGen::uniform()
+{
+    uint64_t a = (*this)() >> 5;
+    uint64_t b = (*this)() >> 6;
+
+    return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns a uniformly distributed random
+/// value in the interval (0,1).
+///
+/// \return double
+///
+/////////////////////////////////////////////////
+double CounterRandGen::uniformPos()
+{
+    uint64_t a = (*this)() >> 5;
+    uint64_t b = (*this)() >> 6;
+
+    return (a * 67108864.0 + b + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns a standard normally
+/// distributed random value using the
+/// Box-Muller transform.
+///
+/// \return double
+///
+/////////////////////////////////////////////////
+double CounterRandGen::normal()
+{
+    double u1 = uniformPos();
+    double u2 = uniform();
+
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns a GSL random number generator,
+/// which draws its values from this instance.
+/// Can be passed to all gsl_ran_* functions.
+///
+/// \return const gsl_rng*
+///
+/////////////////////////////////////////////////
+const gsl_rng* CounterRandGen::gsl()
+{
+    return &m_gslRng;
+}
+
@@ -0,0 +1,112 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2024  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef COUNTERRANDGEN_HPP
+#define COUNTERRANDGEN_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <gsl/gsl_rng.h>
+
+/////////////////////////////////////////////////
+/// \brief This class implements a counter-based
+/// random number generator based upon the
+/// Philox4x32-10 bijection. The generated
+/// sequence is a pure function of the seed, the
+/// stream and the element index, i.e. every
+/// element of a parallel draw gets its own
+/// independent sequence and the results do not
+/// depend on the number of threads or their
+/// scheduling.
+///
+/// \note Instances must not be copied, because
+/// the GSL adapter references this instance.
+/////////////////////////////////////////////////
+class CounterRandGen
+{
+    private:
+        uint32_t m_key[2];
+        uint32_t m_counter[4];
+        uint32_t m_buffer[4];
+        size_t m_pos;
+        gsl_rng m_gslRng;
+
+        void nextBlock();
+
+    public:
+        typedef uint32_t result_type;
+
+        CounterRandGen(uint64_t seed, uint64_t stream, uint64_t element);
+        CounterRandGen(const CounterRandGen&) = delete;
+        CounterRandGen& operator=(const CounterRandGen&) = delete;
+
+        double uniform();
+        double uniformPos();
+        double normal();
+        const gsl_rng* gsl();
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the next 32 random bits.
+        ///
+        /// \return result_type
+        ///
+        /////////////////////////////////////////////////
+        result_type operator()()
+        {
+            if (m_pos >= 4)
+                nextBlock();
+
+            return m_buffer[m_pos++];
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Minimal value of this generator.
+        ///
+        /// \return result_type
+        ///
+        /////////////////////////////////////////////////
+        static constexpr result_type min()
+        {
+            return 0u;
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Maximal value of this generator.
+        ///
+        /// \return result_type
+        ///
+        /////////////////////////////////////////////////
+        static constexpr result_type max()
+        {
+            return 0xFFFFFFFFu;
+        }
+};
+
+
+void philox4x32(uint32_t counter[4], const uint32_t key[2]);
+
+uint64_t getRandSeed();
+void setRandSeed(uint64_t seed);
+uint64_t getRandCallSite(const std::string& sExpr, size_t nPos);
+uint64_t reserveRandDraw();
+void setRandCallSite(uint64_t site, uint64_t draw, uint64_t element);
+uint64_t reserveRandStream();
+
+#endif // COUNTERRANDGEN_HPP
+
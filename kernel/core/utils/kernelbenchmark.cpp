@@ -0,0 +1,395 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "kernelbenchmark.hpp"
+#include "../../kernel.hpp"
+#include "../datamanagement/memory.hpp"
+#include "../maths/fitcontroller.hpp"
+#include "../io/file.hpp"
+
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <omp.h>
+
+
+/////////////////////////////////////////////////
+/// \brief Returns a vector of reproducible
+/// random values.
+///
+/// \param nElements size_t
+/// \param gen std::mt19937_64&
+/// \return std::vector<double>
+///
+/////////////////////////////////////////////////
+static std::vector<double> getRandomValues(size_t nElements, std::mt19937_64& gen)
+{
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+    std::vector<double> vValues(nElements);
+
+    for (double& val : vValues)
+    {
+        val = dist(gen);
+    }
+
+    return vValues;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Fills the passed table with
+/// KERNELBENCHMARK_COLS columns of reproducible
+/// random values.
+///
+/// \param _mem Memory&
+/// \return void
+///
+/////////////////////////////////////////////////
+static void fillTable(Memory& _mem)
+{
+    std::mt19937_64 gen(KERNELBENCHMARK_SEED);
+    std::vector<mu::Array> vColumns;
+
+    for (size_t j = 0; j < KERNELBENCHMARK_COLS; j++)
+    {
+        vColumns.push_back(mu::Array(getRandomValues(KERNELBENCHMARK_ROWS, gen)));
+    }
+
+    _mem.appendRows(vColumns);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Constructor.
+///
+/// \param sFilter const std::string&
+/// \param nRepetitions size_t
+///
+/////////////////////////////////////////////////
+KernelBenchmark::KernelBenchmark(const std::string& sFilter, size_t nRepetitions) : m_sFilter(sFilter), m_nRepetitions(std::max(nRepetitions, (size_t)1))
+{
+    //
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Runs the passed benchmark once for
+/// warming up and afterwards the selected
+/// number of times. The median and the minimal
+/// run time are stored.
+///
+/// \param sName const std::string&
+/// \param nElements size_t
+/// \param func const std::function<void()>&
+/// \return void
+///
+/////////////////////////////////////////////////
+void KernelBenchmark::run(const std::string& sName, size_t nElements, const std::function<void()>& func)
+{
+    if (m_sFilter.length() && sName.find(m_sFilter) == std::string::npos)
+        return;
+
+    func();
+
+    std::vector<double> vTimes;
+
+    for (size_t i = 0; i < m_nRepetitions; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        vTimes.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    std::sort(vTimes.begin(), vTimes.end());
+
+    Result res;
+    res.sName = sName;
+    res.nElements = nElements;
+    res.dMedian = vTimes[vTimes.size() / 2];
+    res.dMin = vTimes.front();
+    m_results.push_back(res);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Benchmarks of the table operations:
+/// appending rows, the aggregates, sorting and
+/// reading the values.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void KernelBenchmark::benchmarkTables()
+{
+    Memory _mem;
+    fillTable(_mem);
+
+    const size_t nElements = KERNELBENCHMARK_ROWS * KERNELBENCHMARK_COLS;
+    VectorIndex vRows(0, KERNELBENCHMARK_ROWS-1);
+    VectorIndex vCols(0, KERNELBENCHMARK_COLS-1);
+
+    // Filling a new table row by row
+    run("table.append", KERNELBENCHMARK_ROWS / 10, [&]()
+        {
+            Memory _appended;
+            std::vector<mu::Array> vRow(KERNELBENCHMARK_COLS);
+
+            for (size_t i = 0; i < KERNELBENCHMARK_ROWS / 10; i++)
+            {
+                for (size_t j = 0; j < KERNELBENCHMARK_COLS; j++)
+                {
+                    vRow[j] = mu::Array(mu::Value((double)(i+j)));
+                }
+
+                _appended.appendRows(vRow);
+            }
+        });
+
+    // The aggregates of the whole table
+    run("table.aggregates", 6 * nElements, [&]()
+        {
+            volatile double dSink = 0;
+            dSink += _mem.sum(vRows, vCols).real();
+            dSink += _mem.avg(vRows, vCols).real();
+            dSink += _mem.std(vRows, vCols).real();
+            dSink += _mem.med(vRows, vCols).real();
+            dSink += _mem.min(vRows, vCols).real();
+            dSink += _mem.max(vRows, vCols).real();
+        });
+
+    // Sorting all columns of a copy of the table.
+    // The copy is part of the timing, because the
+    // sorting changes the table
+    run("table.sort", nElements, [&]()
+        {
+            Memory _sorted;
+            _sorted = _mem;
+            _sorted.sortElements(vRows, vCols);
+        });
+
+    // Reading the whole table at once
+    run("table.readmem", nElements, [&]()
+        {
+            mu::Array vValues = _mem.readMem(vRows, vCols);
+        });
+
+    // Reading the table element by element
+    run("table.readmem.single", nElements, [&]()
+        {
+            volatile double dSink = 0;
+
+            for (size_t j = 0; j < KERNELBENCHMARK_COLS; j++)
+            {
+                for (size_t i = 0; i < KERNELBENCHMARK_ROWS; i++)
+                {
+                    dSink += _mem.readMem(i, j).getNum().asF64();
+                }
+            }
+        });
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Benchmarks of saving and loading the
+/// table as CSV and NDAT file. The files are
+/// created in the save path and removed
+/// afterwards.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void KernelBenchmark::benchmarkFiles()
+{
+    Memory _mem;
+    fillTable(_mem);
+
+    const size_t nElements = KERNELBENCHMARK_ROWS * KERNELBENCHMARK_COLS;
+    std::string sPath = NumeReKernel::getInstance()->getSettings().getSavePath() + "/benchmark.";
+
+    for (std::string sExt : {"csv", "ndat"})
+    {
+        std::string sFileName = sPath + sExt;
+
+        run("file." + sExt + ".save", nElements, [&]()
+            {
+                _mem.save(sFileName, "benchmark", 7, sExt);
+            });
+
+        // Ensure that the file exists, even if the
+        // saving benchmark has been filtered out
+        if (!fileExists(sFileName))
+            _mem.save(sFileName, "benchmark", 7, sExt);
+
+        run("file." + sExt + ".load", nElements, [&]()
+            {
+                NumeRe::GenericFile* file = NumeRe::getFileByType(sFileName);
+
+                if (!file)
+                    throw SyntaxError(SyntaxError::DATAFILE_NOT_EXIST, sFileName, SyntaxError::invalid_position, sFileName);
+
+                try
+                {
+                    file->read();
+                }
+                catch (...)
+                {
+                    delete file;
+                    throw;
+                }
+
+                delete file;
+            });
+
+        std::remove(sFileName.c_str());
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Benchmark of a 1D fit of an
+/// exponential decay. The fitting parameters are
+/// defined only during the benchmark and the
+/// value of "x" is restored afterwards.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void KernelBenchmark::benchmarkFitting()
+{
+    if (m_sFilter.length() && std::string("fit.exponential").find(m_sFilter) == std::string::npos)
+        return;
+
+    mu::Parser& _parser = NumeReKernel::getInstance()->getParser();
+    mu::varmap_type mVars = _parser.GetVar();
+    mu::Variable xBackup(*mVars["x"]);
+
+    std::mt19937_64 gen(KERNELBENCHMARK_SEED);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    FitVector vx(KERNELBENCHMARK_FITSAMPLES);
+    FitVector vy(KERNELBENCHMARK_FITSAMPLES);
+
+    for (size_t i = 0; i < KERNELBENCHMARK_FITSAMPLES; i++)
+    {
+        vx[i] = 10.0 * i / (KERNELBENCHMARK_FITSAMPLES - 1);
+        vy[i] = 3.0 * std::exp(-0.5 * vx[i]) + 1.0 + noise(gen);
+    }
+
+    mu::Variable a, b, c;
+    _parser.DefineVar("benchmark_a", &a);
+    _parser.DefineVar("benchmark_b", &b);
+    _parser.DefineVar("benchmark_c", &c);
+
+    mu::varmap_type mParams;
+    mParams["benchmark_a"] = &a;
+    mParams["benchmark_b"] = &b;
+    mParams["benchmark_c"] = &c;
+
+    try
+    {
+        run("fit.exponential", KERNELBENCHMARK_FITSAMPLES, [&]()
+            {
+                a = mu::Value(1.0);
+                b = mu::Value(1.0);
+                c = mu::Value(0.0);
+                Fitcontroller _fControl(&_parser);
+                _fControl.fit(vx, vy, "benchmark_a*exp(-benchmark_b*x)+benchmark_c", "", mParams, 1e-4, 1e-4);
+            });
+    }
+    catch (...)
+    {
+        _parser.RemoveVar("benchmark_a");
+        _parser.RemoveVar("benchmark_b");
+        _parser.RemoveVar("benchmark_c");
+        *mVars["x"] = xBackup;
+        throw;
+    }
+
+    _parser.RemoveVar("benchmark_a");
+    _parser.RemoveVar("benchmark_b");
+    _parser.RemoveVar("benchmark_c");
+    *mVars["x"] = xBackup;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Runs all benchmarks, which match the
+/// filter. Previous results are discarded.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void KernelBenchmark::runAll()
+{
+    m_results.clear();
+    benchmarkTables();
+    benchmarkFiles();
+    benchmarkFitting();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the results as lines of text
+/// for the terminal.
+///
+/// \return std::vector<std::string>
+///
+/////////////////////////////////////////////////
+std::vector<std::string> KernelBenchmark::getReport() const
+{
+    std::vector<std::string> vReport;
+
+    for (const Result& res : m_results)
+    {
+        vReport.push_back(res.sName + ": " + toString(res.dMedian * 1e3, 5) + " ms, "
+                          + toString(res.nElements / res.dMedian, 5) + " elem/s");
+    }
+
+    return vReport;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the results as JSON using the
+/// same layout as the Benchmark_x64 target.
+///
+/// \return std::string
+///
+/////////////////////////////////////////////////
+std::string KernelBenchmark::toJson() const
+{
+    std::string sJson = "{\n  \"threads\": " + std::to_string(omp_get_max_threads())
+        + ",\n  \"repetitions\": " + std::to_string(m_nRepetitions)
+        + ",\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < m_results.size(); i++)
+    {
+        const Result& res = m_results[i];
+
+        sJson += std::string(i ? ",\n" : "\n")
+            + "    {\"name\": \"" + res.sName
+            + "\", \"elements\": " + std::to_string(res.nElements)
+            + ", \"median_s\": " + toString(res.dMedian, 9)
+            + ", \"min_s\": " + toString(res.dMin, 9)
+            + ", \"throughput\": " + toString(res.nElements / res.dMedian, 9) + "}";
+    }
+
+    sJson += "\n  ]\n}\n";
+    return sJson;
+}
+
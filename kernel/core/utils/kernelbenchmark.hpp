@@ -0,0 +1,80 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef KERNELBENCHMARK_HPP
+#define KERNELBENCHMARK_HPP
+
+#include <string>
+#include <vector>
+#include <functional>
+
+// Default number of timed repetitions of each benchmark
+#define KERNELBENCHMARK_REPETITIONS 5
+// Seed of the random values filled into the benchmark table
+#define KERNELBENCHMARK_SEED 42
+// Number of rows of the benchmark table
+#define KERNELBENCHMARK_ROWS 200000
+// Number of columns of the benchmark table
+#define KERNELBENCHMARK_COLS 4
+// Number of samples used by the fitting benchmark
+#define KERNELBENCHMARK_FITSAMPLES 1000
+
+
+/////////////////////////////////////////////////
+/// \brief This class implements the benchmarks
+/// of the kernel's tables, file formats and the
+/// fitting. In contrast to the Benchmark_x64
+/// target, these depend on a running kernel
+/// instance and are therefore started with the
+/// "benchmark" command. Allocations are not
+/// counted here.
+/////////////////////////////////////////////////
+class KernelBenchmark
+{
+    public:
+        /////////////////////////////////////////////////
+        /// \brief The timing of a single benchmark.
+        /////////////////////////////////////////////////
+        struct Result
+        {
+            std::string sName;
+            size_t nElements;
+            double dMedian;
+            double dMin;
+        };
+
+    private:
+        std::vector<Result> m_results;
+        std::string m_sFilter;
+        size_t m_nRepetitions;
+
+        void run(const std::string& sName, size_t nElements, const std::function<void()>& func);
+        void benchmarkTables();
+        void benchmarkFiles();
+        void benchmarkFitting();
+
+    public:
+        KernelBenchmark(const std::string& sFilter = "", size_t nRepetitions = KERNELBENCHMARK_REPETITIONS);
+
+        void runAll();
+        std::vector<std::string> getReport() const;
+        std::string toJson() const;
+};
+
+#endif // KERNELBENCHMARK_HPP
+
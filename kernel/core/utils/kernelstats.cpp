@@ -0,0 +1,204 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#include "kernelstats.hpp"
+
+#include <filesystem>
+
+KernelStatistics g_kernelStats;
+
+
+/////////////////////////////////////////////////
+/// \brief Constructor.
+/////////////////////////////////////////////////
+KernelStatistics::KernelStatistics()
+{
+    for (size_t i = 0; i < KC_COUNTER_COUNT; i++)
+    {
+        m_counters[i] = 0;
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the name of the selected
+/// counter, which is used for reports and the
+/// JSON dump.
+///
+/// \param counter KernelCounter
+/// \return std::string
+///
+/////////////////////////////////////////////////
+std::string KernelStatistics::getName(KernelCounter counter)
+{
+    switch (counter)
+    {
+        case KC_PARSER_BYTECODE_HITS:
+            return "parser.bytecode_hits";
+        case KC_PARSER_STATECACHE_HITS:
+            return "parser.statecache_hits";
+        case KC_PARSER_MISSES:
+            return "parser.misses";
+        case KC_PARSER_RPN_COMPILATIONS:
+            return "parser.rpn_compilations";
+        case KC_CACHEDACCESS_COPIES:
+            return "tables.cached_access_copies";
+        case KC_CACHEDACCESS_BYTES:
+            return "tables.cached_access_bytes";
+        case KC_COLUMN_ALLOCATIONS:
+            return "tables.column_allocations";
+        case KC_COLUMN_CONVERSIONS:
+            return "tables.column_conversions";
+        case KC_DEFINITION_EXPANSIONS:
+            return "definitions.expansions";
+        case KC_COUNTER_COUNT:
+            break;
+    }
+
+    return "";
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Counts a completed read or write
+/// operation of the passed file. The size of the
+/// file is used as number of transferred bytes.
+///
+/// \param sFormat const std::string&
+/// \param sFileName const std::string&
+/// \param isWrite bool
+/// \return void
+///
+/////////////////////////////////////////////////
+void KernelStatistics::countFileIo(const std::string& sFormat, const std::string& sFileName, bool isWrite)
+{
+    std::error_code ec;
+    uintmax_t nSize = std::filesystem::file_size(sFileName, ec);
+
+    if (ec)
+        nSize = 0;
+
+    std::lock_guard<std::mutex> lock(m_ioMutex);
+    IoStats& stats = m_io[sFormat];
+
+    if (isWrite)
+    {
+        stats.nWrites++;
+        stats.nWrittenBytes += nSize;
+    }
+    else
+    {
+        stats.nReads++;
+        stats.nReadBytes += nSize;
+    }
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns a copy of the file I/O
+/// statistics.
+///
+/// \return std::map<std::string, KernelStatistics::IoStats>
+///
+/////////////////////////////////////////////////
+std::map<std::string, KernelStatistics::IoStats> KernelStatistics::getIoStats() const
+{
+    std::lock_guard<std::mutex> lock(m_ioMutex);
+    return m_io;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Resets all counters.
+///
+/// \return void
+///
+/////////////////////////////////////////////////
+void KernelStatistics::reset()
+{
+    for (size_t i = 0; i < KC_COUNTER_COUNT; i++)
+    {
+        m_counters[i].store(0, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(m_ioMutex);
+    m_io.clear();
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the counters as a list of
+/// "name: value" lines.
+///
+/// \return std::vector<std::string>
+///
+/////////////////////////////////////////////////
+std::vector<std::string> KernelStatistics::getReport() const
+{
+    std::vector<std::string> vReport;
+
+    for (size_t i = 0; i < KC_COUNTER_COUNT; i++)
+    {
+        vReport.push_back(getName((KernelCounter)i) + ": " + std::to_string(get((KernelCounter)i)));
+    }
+
+    for (const auto& iter : getIoStats())
+    {
+        vReport.push_back("io." + iter.first + ": " + std::to_string(iter.second.nReads) + " reads ("
+                          + std::to_string(iter.second.nReadBytes) + " bytes), "
+                          + std::to_string(iter.second.nWrites) + " writes ("
+                          + std::to_string(iter.second.nWrittenBytes) + " bytes)");
+    }
+
+    return vReport;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns all counters as a JSON object.
+///
+/// \return std::string
+///
+/////////////////////////////////////////////////
+std::string KernelStatistics::toJson() const
+{
+    std::string sJson = "{\n  \"counters\": {";
+
+    for (size_t i = 0; i < KC_COUNTER_COUNT; i++)
+    {
+        sJson += std::string(i ? "," : "") + "\n    \"" + getName((KernelCounter)i) + "\": "
+            + std::to_string(get((KernelCounter)i));
+    }
+
+    sJson += "\n  },\n  \"io\": {";
+    bool isFirst = true;
+
+    for (const auto& iter : getIoStats())
+    {
+        sJson += std::string(isFirst ? "" : ",") + "\n    \"" + iter.first + "\": {"
+            + "\"reads\": " + std::to_string(iter.second.nReads)
+            + ", \"read_bytes\": " + std::to_string(iter.second.nReadBytes)
+            + ", \"writes\": " + std::to_string(iter.second.nWrites)
+            + ", \"written_bytes\": " + std::to_string(iter.second.nWrittenBytes) + "}";
+        isFirst = false;
+    }
+
+    sJson += "\n  }\n}\n";
+    return sJson;
+}
+
@@ -0,0 +1,120 @@
+/*****************************************************************************
+    NumeRe: Framework fuer Numerische Rechnungen
+    Copyright (C) 2025  Erik Haenel et al.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+#ifndef KERNELSTATS_HPP
+#define KERNELSTATS_HPP
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+
+/////////////////////////////////////////////////
+/// \brief The counted kernel events.
+/////////////////////////////////////////////////
+enum KernelCounter
+{
+    KC_PARSER_BYTECODE_HITS,
+    KC_PARSER_STATECACHE_HITS,
+    KC_PARSER_MISSES,
+    KC_PARSER_RPN_COMPILATIONS,
+    KC_CACHEDACCESS_COPIES,
+    KC_CACHEDACCESS_BYTES,
+    KC_COLUMN_ALLOCATIONS,
+    KC_COLUMN_CONVERSIONS,
+    KC_DEFINITION_EXPANSIONS,
+    KC_COUNTER_COUNT
+};
+
+
+/////////////////////////////////////////////////
+/// \brief This class contains always active
+/// counters of kernel events. The counters are
+/// relaxed atomics, i.e. they are safe to be
+/// incremented from multiple threads but do not
+/// impose any ordering. The file I/O is counted
+/// per file format.
+/////////////////////////////////////////////////
+class KernelStatistics
+{
+    public:
+        /////////////////////////////////////////////////
+        /// \brief Statistics of the file I/O of a
+        /// single file format.
+        /////////////////////////////////////////////////
+        struct IoStats
+        {
+            uint64_t nReads = 0;
+            uint64_t nWrites = 0;
+            uint64_t nReadBytes = 0;
+            uint64_t nWrittenBytes = 0;
+        };
+
+    private:
+        std::atomic<uint64_t> m_counters[KC_COUNTER_COUNT];
+        std::map<std::string, IoStats> m_io;
+        mutable std::mutex m_ioMutex;
+
+    public:
+        KernelStatistics();
+        KernelStatistics(const KernelStatistics&) = delete;
+        KernelStatistics& operator=(const KernelStatistics&) = delete;
+
+        /////////////////////////////////////////////////
+        /// \brief Increments the selected counter.
+        ///
+        /// \param counter KernelCounter
+        /// \param nCount uint64_t
+        /// \return void
+        ///
+        /////////////////////////////////////////////////
+        void count(KernelCounter counter, uint64_t nCount = 1)
+        {
+            m_counters[counter].fetch_add(nCount, std::memory_order_relaxed);
+        }
+
+        /////////////////////////////////////////////////
+        /// \brief Returns the current value of the
+        /// selected counter.
+        ///
+        /// \param counter KernelCounter
+        /// \return uint64_t
+        ///
+        /////////////////////////////////////////////////
+        uint64_t get(KernelCounter counter) const
+        {
+            return m_counters[counter].load(std::memory_order_relaxed);
+        }
+
+        static std::string getName(KernelCounter counter);
+
+        void countFileIo(const std::string& sFormat, const std::string& sFileName, bool isWrite);
+        std::map<std::string, IoStats> getIoStats() const;
+
+        void reset();
+        std::vector<std::string> getReport() const;
+        std::string toJson() const;
+};
+
+extern KernelStatistics g_kernelStats;
+
+#endif // KERNELSTATS_HPP
+
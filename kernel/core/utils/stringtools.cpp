@@ -23,17 +23,181 @@
 #include "../../../common/markup.hpp"
 
 #include <fast_float/fast_float.h>
+#include <charconv>
 #include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <iterator>
 #include <boost/tokenizer.hpp>
 
+// The floating point overloads of std::to_chars are
+// only available from GCC 11 on
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 11
+#error "NumeRe requires GCC 11 or newer (floating point std::to_chars)."
+#endif
+
+// Size of the stack buffers for formatting numbers
+#define NUMBER_BUFFER_SIZE 128
+
 // Forward declarations
 std::string getNextArgument(std::string& sArgList, bool bCut);
 double intPower(double, int64_t);
 bool isInt(const std::complex<double>& number);
 
+
+/////////////////////////////////////////////////
+/// \brief Formats a double into the passed
+/// character range. The result is identical to
+/// the default formatting of a std::ostream with
+/// the passed precision (i.e. "%.*g") but avoids
+/// any stream or memory allocation overhead.
+///
+/// \param first char*
+/// \param last char*
+/// \param dNumber double
+/// \param nPrecision int
+/// \return char*
+///
+/// \remark Returns the end of the formatted
+/// number or a nullptr, if the range is too
+/// small.
+/////////////////////////////////////////////////
+char* formatNumber(char* first, char* last, double dNumber, int nPrecision)
+{
+    std::to_chars_result res = std::to_chars(first, last, dNumber, std::chars_format::general, nPrecision < 0 ? 6 : nPrecision);
+
+    if (res.ec != std::errc())
+        return nullptr;
+
+    return res.ptr;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Static helper to copy a zero-
+/// terminated string into the passed character
+/// range.
+///
+/// \param first char*
+/// \param last char*
+/// \param sString const char*
+/// \return char*
+///
+/////////////////////////////////////////////////
+static char* copyChars(char* first, char* last, const char* sString)
+{
+    size_t nLen = std::strlen(sString);
+
+    if (!first || (size_t)(last - first) < nLen)
+        return nullptr;
+
+    std::memcpy(first, sString, nLen);
+    return first + nLen;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Formats a complex number into the
+/// passed character range. The result is
+/// identical to toString().
+///
+/// \param first char*
+/// \param last char*
+/// \param dNumber const std::complex<double>&
+/// \param nPrecision int
+/// \return char*
+///
+/////////////////////////////////////////////////
+char* formatNumber(char* first, char* last, const std::complex<double>& dNumber, int nPrecision)
+{
+    if (std::isnan(dNumber.real()) && std::isnan(dNumber.imag()))
+        return copyChars(first, last, "nan");
+
+    nPrecision = std::rint(nPrecision / (dNumber.real() != 0.0 && dNumber.imag() != 0.0 && !std::isnan(dNumber.imag()) ? 2 : 1));
+
+    if (dNumber.real() || !dNumber.imag())
+        first = formatNumber(first, last, dNumber.real(), nPrecision);
+
+    if (dNumber.imag() && first)
+    {
+        if ((dNumber.imag() > 0.0 || std::isnan(dNumber.imag())) && dNumber.real() != 0.0)
+            first = copyChars(first, last, "+");
+
+        if (first)
+            first = formatNumber(first, last, dNumber.imag(), nPrecision);
+
+        first = copyChars(first, last, std::isnan(dNumber.imag()) || std::isinf(dNumber.imag()) ? " i" : "i");
+    }
+
+    return first;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Returns the maximal number of
+/// characters needed to format a complex number
+/// with the selected precision.
+///
+/// \param nPrecision int
+/// \return size_t
+///
+/////////////////////////////////////////////////
+static size_t getFormattedSize(int nPrecision)
+{
+    return 2 * std::max(nPrecision, 17) + 32;
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Appends the formatted double to the
+/// passed buffer. Use this function to format
+/// many values into a reused buffer.
+///
+/// \param sBuffer std::string&
+/// \param dNumber double
+/// \param nPrecision int
+/// \return void
+///
+/////////////////////////////////////////////////
+void appendNumber(std::string& sBuffer, double dNumber, int nPrecision)
+{
+    appendNumber(sBuffer, std::complex<double>(dNumber, 0.0), nPrecision);
+}
+
+
+/////////////////////////////////////////////////
+/// \brief Appends the formatted complex number
+/// to the passed buffer. Use this function to
+/// format many values into a reused buffer.
+///
+/// \param sBuffer std::string&
+/// \param dNumber const std::complex<double>&
+/// \param nPrecision int
+/// \return void
+///
+/////////////////////////////////////////////////
+void appendNumber(std::string& sBuffer, const std::complex<double>& dNumber, int nPrecision)
+{
+    size_t nSize = getFormattedSize(nPrecision);
+
+    if (nSize <= NUMBER_BUFFER_SIZE)
+    {
+        char buffer[NUMBER_BUFFER_SIZE];
+        char* end = formatNumber(buffer, buffer + NUMBER_BUFFER_SIZE, dNumber, nPrecision);
+
+        if (end)
+        {
+            sBuffer.append(buffer, end);
+            return;
+        }
+    }
+
+    size_t nPos = sBuffer.length();
+    sBuffer.resize(nPos + nSize);
+    char* end = formatNumber(sBuffer.data() + nPos, sBuffer.data() + sBuffer.length(), dNumber, nPrecision);
+    sBuffer.resize(end ? end - sBuffer.data() : nPos);
+}
+
 // toString function implementations
 // There's an overwrite for mostly every variable type
 //
@@ -77,10 +241,9 @@ std::string toString(double dNumber, const Settings& _option)
 /////////////////////////////////////////////////
 std::string toString(double dNumber, int nPrecision)
 {
-    std::ostringstream Temp;
-    Temp.precision(nPrecision);
-    Temp << dNumber;
-    return Temp.str();
+    std::string sNumber;
+    appendNumber(sNumber, dNumber, nPrecision);
+    return sNumber;
 }
 
 /////////////////////////////////////////////////
@@ -94,24 +257,9 @@ std::string toString(double dNumber, int nPrecision)
 /////////////////////////////////////////////////
 std::string toString(const std::complex<double>& dNumber, int nPrecision)
 {
-    if (std::isnan(dNumber.real()) && std::isnan(dNumber.imag()))
-        return "nan";
-
-    std::ostringstream Temp;
-    Temp.precision(std::rint(nPrecision / (dNumber.real() != 0.0 && dNumber.imag() != 0.0 && !std::isnan(dNumber.imag()) ? 2 : 1)));
-
-    if (dNumber.real() || !dNumber.imag())
-        Temp << dNumber.real();
-
-    if (dNumber.imag())
-    {
-        if ((dNumber.imag() > 0.0 || std::isnan(dNumber.imag())) && dNumber.real() != 0.0)
-            Temp << "+";
-
-        Temp << dNumber.imag() << (std::isnan(dNumber.imag()) || std::isinf(dNumber.imag()) ? " i" : "i");
-    }
-
-    return Temp.str();
+    std::string sNumber;
+    appendNumber(sNumber, dNumber, nPrecision);
+    return sNumber;
 }
 
 
@@ -139,9 +287,8 @@ std::string toString(int nNumber)
 /////////////////////////////////////////////////
 std::string toString(size_t nNumber)
 {
-    std::ostringstream Temp;
-    Temp << nNumber;
-    return Temp.str();
+    char buffer[24];
+    return std::string(buffer, std::to_chars(buffer, buffer + sizeof(buffer), nNumber).ptr);
 }
 
 
@@ -254,9 +401,8 @@ std::string toString(sys_time_point tp, int timeStampFlags)
 /////////////////////////////////////////////////
 std::string toString(long long int nNumber)
 {
-    std::ostringstream Temp;
-    Temp << nNumber;
-    return Temp.str();
+    char buffer[24];
+    return std::string(buffer, std::to_chars(buffer, buffer + sizeof(buffer), nNumber).ptr);
 }
 
 
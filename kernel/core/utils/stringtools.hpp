@@ -427,6 +427,10 @@ struct NumberFormatsVoter
 };
 
 
+char* formatNumber(char* first, char* last, double dNumber, int nPrecision);
+char* formatNumber(char* first, char* last, const std::complex<double>& dNumber, int nPrecision);
+void appendNumber(std::string& sBuffer, double dNumber, int nPrecision);
+void appendNumber(std::string& sBuffer, const std::complex<double>& dNumber, int nPrecision);
 std::string toString(int nNumber, const Settings& _option);
 std::string toString(double dNumber, const Settings& _option);
 std::string toString(double dNumber, int nPrecision = 7);
@@ -24,7 +24,6 @@
 #include <cstdlib>
 #include <vector>
 #include <random>
-#include <gsl/gsl_rng.h>
 
 #include "../structures.hpp"
 #include "../ui/error.hpp"
@@ -156,7 +155,6 @@ inline bool isDimensionVar(const std::string& sVarName)
 #endif // PARSERSTANDALONE
 
 std::mt19937& getRandGenInstance();
-const gsl_rng* getGslRandGenInstance();
 
 /////////////////////////////////////////////////
 /// \brief Casts doubles to integers and avoids
@@ -166,7 +166,7 @@ void NumeReKernel::Autosave()
     if (!_memoryManager.getSaveStatus())
     {
         g_logger.info("Autosaving tables.");
-        _memoryManager.saveToCacheFile();
+        _memoryManager.saveToCacheFile(true);
     }
 }
 
@@ -533,19 +533,19 @@ void NumeReKernel::defineNumFunctions()
     // function search in the parser.
     /////////////////////////////////////////////////////////////////////
 
-    _parser.DefineFun("faculty", numfnc_Factorial);                              // faculty(n)
-    _parser.DefineFun("factorial", numfnc_Factorial);                            // factorial(n)
-    _parser.DefineFun("dblfacul", numfnc_doubleFactorial);                       // dblfacul(n)
-    _parser.DefineFun("dblfact", numfnc_doubleFactorial);                        // dblfact(n)
+    _parser.DefineElementwiseFun("faculty", numfnc_Factorial);                   // faculty(n)
+    _parser.DefineElementwiseFun("factorial", numfnc_Factorial);                 // factorial(n)
+    _parser.DefineElementwiseFun("dblfacul", numfnc_doubleFactorial);            // dblfacul(n)
+    _parser.DefineElementwiseFun("dblfact", numfnc_doubleFactorial);             // dblfact(n)
     _parser.DefineFun("binom", numfnc_Binom);                                    // binom(Wert1,Wert2)
     _parser.DefineFun("num", numfnc_Num);                                        // num(a,b,c,...)
     _parser.DefineFun("cnt", numfnc_Cnt);                                        // num(a,b,c,...)
     _parser.DefineFun("std", numfnc_Std);                                        // std(a,b,c,...)
     _parser.DefineFun("prd", numfnc_product);                                    // prd(a,b,c,...)
     _parser.DefineFun("round", numfnc_round);                                    // round(x,n)
-    _parser.DefineFun("rint", numfnc_rint);                                      // rint(x)
-    _parser.DefineFun("radian", numfnc_toRadian);                                // radian(alpha)
-    _parser.DefineFun("degree", numfnc_toDegree);                                // degree(x)
+    _parser.DefineElementwiseFun("rint", numfnc_rint);                           // rint(x)
+    _parser.DefineElementwiseFun("radian", numfnc_toRadian);                     // radian(alpha)
+    _parser.DefineElementwiseFun("degree", numfnc_toDegree);                     // degree(x)
     _parser.DefineFun("Y", numfnc_SphericalHarmonics);                           // Y(l,m,theta,phi)
     _parser.DefineFun("imY", numfnc_imSphericalHarmonics);                       // imY(l,m,theta,phi)
     _parser.DefineFun("Z", numfnc_Zernike);                                      // Z(n,m,rho,phi)
@@ -559,7 +559,7 @@ void NumeReKernel::defineNumFunctions()
     _parser.DefineFun("laguerre_a", numfnc_AssociatedLaguerrePolynomial);        // laguerre_a(n,k,x)
     _parser.DefineFun("hermite", numfnc_HermitePolynomial);                      // hermite(n,x)
     _parser.DefineFun("betheweizsaecker", numfnc_BetheWeizsaecker);              // betheweizsaecker(N,Z)
-    _parser.DefineFun("heaviside", numfnc_Heaviside);                            // heaviside(x)
+    _parser.DefineElementwiseFun("heaviside", numfnc_Heaviside);                 // heaviside(x)
     _parser.DefineFun("phi", numfnc_phi);                                        // phi(x,y)
     _parser.DefineFun("theta", numfnc_theta);                                    // theta(x,y,z)
     _parser.DefineFun("norm", numfnc_Norm);                                      // norm(x,y,z,...)
@@ -575,53 +575,53 @@ void NumeReKernel::defineNumFunctions()
     _parser.DefineFun("minpos", numfnc_MinPos);                                  // minpos(x,y,z,...)
     _parser.DefineFun("maxpos", numfnc_MaxPos);                                  // maxpos(x,y,z,...)
     _parser.DefineFun("polynomial", numfnc_polynomial);                          // polynomial(x,a0,a1,a2,a3,...)
-    _parser.DefineFun("erf", numfnc_erf);                                        // erf(x)
-    _parser.DefineFun("erfc", numfnc_erfc);                                      // erfc(x)
-    _parser.DefineFun("gamma", numfnc_gamma);                                    // gamma(x)
+    _parser.DefineElementwiseFun("erf", numfnc_erf);                             // erf(x)
+    _parser.DefineElementwiseFun("erfc", numfnc_erfc);                           // erfc(x)
+    _parser.DefineElementwiseFun("gamma", numfnc_gamma);                         // gamma(x)
     _parser.DefineFun("cmp", numfnc_compare);                                    // cmp(crit,a,b,c,...,type)
-    _parser.DefineFun("is_string", numfnc_is_string);                            // is_string(EXPR)
-    _parser.DefineFun("to_value", numfnc_Identity);                              // to_value(STRING)
+    _parser.DefineElementwiseFun("is_string", numfnc_is_string);                 // is_string(EXPR)
+    _parser.DefineElementwiseFun("to_value", numfnc_Identity);                   // to_value(STRING)
     _parser.DefineFun("sleep", numfnc_sleep, false);                             // sleep(millisecnds)
     _parser.DefineFun("version", numfnc_numereversion);                          // version()
     _parser.DefineFun("getompthreads", numfnc_omp_threads);                      // getompthreads()
     _parser.DefineFun("getdpiscale", numfnc_pixelscale);                         // getdpiscale()
-    _parser.DefineFun("is_nan", numfnc_isnan);                                   // is_nan(x)
+    _parser.DefineElementwiseFun("is_nan", numfnc_isnan);                        // is_nan(x)
     _parser.DefineFun("is_void", numfnc_isvoid);                                 // is_void(x)
     _parser.DefineFun("range", numfnc_interval);                                 // range(x,left,right)
-    _parser.DefineFun("Ai", numfnc_AiryA);                                       // Ai(x)
-    _parser.DefineFun("Bi", numfnc_AiryB);                                       // Bi(x)
+    _parser.DefineElementwiseFun("Ai", numfnc_AiryA);                            // Ai(x)
+    _parser.DefineElementwiseFun("Bi", numfnc_AiryB);                            // Bi(x)
     _parser.DefineFun("ellipticF", numfnc_EllipticF);                            // ellipticF(x,k)
     _parser.DefineFun("ellipticE", numfnc_EllipticE);                            // ellipticE(x,k)
     _parser.DefineFun("ellipticPi", numfnc_EllipticP);                           // ellipticPi(x,n,k)
     _parser.DefineFun("ellipticD", numfnc_EllipticD);                            // ellipticD(x,k)
-    _parser.DefineFun("floor", numfnc_floor);                                    // floor(x)
-    _parser.DefineFun("roof", numfnc_roof);                                      // roof(x)
-    _parser.DefineFun("ceil", numfnc_roof);                                      // ceil(x)
+    _parser.DefineElementwiseFun("floor", numfnc_floor);                         // floor(x)
+    _parser.DefineElementwiseFun("roof", numfnc_roof);                           // roof(x)
+    _parser.DefineElementwiseFun("ceil", numfnc_roof);                           // ceil(x)
     _parser.DefineFun("rect", numfnc_rect);                                      // rect(x,x0,x1)
     _parser.DefineFun("ivl", numfnc_ivl);                                        // ivl(x,x0,x1,lb,rb)
     _parser.DefineFun("student_t", numfnc_studentFactor);                        // student_t(number,confidence)
     _parser.DefineFun("gcd", numfnc_gcd);                                        // gcd(x,y)
     _parser.DefineFun("lcm", numfnc_lcm);                                        // lcm(x,y)
     _parser.DefineFun("beta", numfnc_beta);                                      // beta(x,y)
-    _parser.DefineFun("zeta", numfnc_zeta);                                      // zeta(n)
-    _parser.DefineFun("Cl2", numfnc_clausen);                                    // Cl2(x)
-    _parser.DefineFun("psi", numfnc_digamma);                                    // psi(x)
+    _parser.DefineElementwiseFun("zeta", numfnc_zeta);                           // zeta(n)
+    _parser.DefineElementwiseFun("Cl2", numfnc_clausen);                         // Cl2(x)
+    _parser.DefineElementwiseFun("psi", numfnc_digamma);                         // psi(x)
     _parser.DefineFun("psi_n", numfnc_polygamma);                                // psi_n(n,x)
-    _parser.DefineFun("Li2", numfnc_dilogarithm);                                // Li2(x)
-    _parser.DefineFun("exp", numfnc_exp);                                        // exp(x)
-    _parser.DefineFun("abs", numfnc_abs);                                        // abs(x)
-    _parser.DefineFun("sqrt", numfnc_sqrt);                                      // sqrt(x)
-    _parser.DefineFun("sign", numfnc_sign);                                      // sign(x)
-    _parser.DefineFun("log2", numfnc_log2);                                      // log2(x)
-    _parser.DefineFun("log10", numfnc_log10);                                    // log10(x)
-    _parser.DefineFun("log", numfnc_log10);                                      // log(x)
-    _parser.DefineFun("ln", numfnc_ln);                                          // ln(x)
+    _parser.DefineElementwiseFun("Li2", numfnc_dilogarithm);                     // Li2(x)
+    _parser.DefineElementwiseFun("exp", numfnc_exp);                             // exp(x)
+    _parser.DefineElementwiseFun("abs", numfnc_abs);                             // abs(x)
+    _parser.DefineElementwiseFun("sqrt", numfnc_sqrt);                           // sqrt(x)
+    _parser.DefineElementwiseFun("sign", numfnc_sign);                           // sign(x)
+    _parser.DefineElementwiseFun("log2", numfnc_log2);                           // log2(x)
+    _parser.DefineElementwiseFun("log10", numfnc_log10);                         // log10(x)
+    _parser.DefineElementwiseFun("log", numfnc_log10);                           // log(x)
+    _parser.DefineElementwiseFun("ln", numfnc_ln);                               // ln(x)
     _parser.DefineFun("log_b", numfnc_log_b);                                    // log_b(b,x)
-    _parser.DefineFun("real", numfnc_real);                                      // real(x)
-    _parser.DefineFun("imag", numfnc_imag);                                      // imag(x)
-    _parser.DefineFun("to_rect", numfnc_polar2rect);                             // to_rect(x)
-    _parser.DefineFun("to_polar", numfnc_rect2polar);                            // to_polar(x)
-    _parser.DefineFun("conj", numfnc_conj);                                      // conj(x)
+    _parser.DefineElementwiseFun("real", numfnc_real);                           // real(x)
+    _parser.DefineElementwiseFun("imag", numfnc_imag);                           // imag(x)
+    _parser.DefineElementwiseFun("to_rect", numfnc_polar2rect);                  // to_rect(x)
+    _parser.DefineElementwiseFun("to_polar", numfnc_rect2polar);                 // to_polar(x)
+    _parser.DefineElementwiseFun("conj", numfnc_conj);                           // conj(x)
     _parser.DefineFun("complex", numfnc_complex);                                // complex(re,im)
     _parser.DefineFun("logtoidx", numfnc_logtoidx);                              // logtoidx({x,y,z...})
     _parser.DefineFun("idxtolog", numfnc_idxtolog);                              // idxtolog({x,y,z...})
@@ -635,91 +635,92 @@ void NumeReKernel::defineNumFunctions()
     _parser.DefineFun("union", numfnc_union);                                    // union({x,y,z...}, {a,b,c,...})
     _parser.DefineFun("intersection", numfnc_intersection);                      // intersection({x,y,z...}, {a,b,c,...})
     _parser.DefineFun("getoverlap", numfnc_getOverlap);                          // getoverlap({x1,x2}, {y1,y2})
-    _parser.DefineFun("swapbytes", numfnc_swapBytes);                            // swapbytes(arr)
+    _parser.DefineElementwiseFun("swapbytes", numfnc_swapBytes);                 // swapbytes(arr)
 
     _parser.DefineFun("convertunit", unit_conversion, true, 1);                  // convertunit({x,y,..},{u1,u2,...}[,{m1,...}])
 
-    _parser.DefineFun("sinc", numfnc_SinusCardinalis);                           // sinc(x)
-    _parser.DefineFun("sin", numfnc_sin);                                        // sin(x)
-    _parser.DefineFun("cos", numfnc_cos);                                        // cos(x)
-    _parser.DefineFun("tan", numfnc_tan);                                        // tan(x)
-    _parser.DefineFun("cot", numfnc_cot);                                        // cot(x)
-    _parser.DefineFun("asin", numfnc_asin);                                      // asin(x)
-    _parser.DefineFun("acos", numfnc_acos);                                      // acos(x)
-    _parser.DefineFun("atan", numfnc_atan);                                      // atan(x)
-    _parser.DefineFun("arcsin", numfnc_asin);                                    // arcsin(x)
-    _parser.DefineFun("arccos", numfnc_acos);                                    // arccos(x)
-    _parser.DefineFun("arctan", numfnc_atan);                                    // arctan(x)
-    _parser.DefineFun("sinh", numfnc_sinh);                                      // sinh(x)
-    _parser.DefineFun("cosh", numfnc_cosh);                                      // cosh(x)
-    _parser.DefineFun("tanh", numfnc_tanh);                                      // tanh(x)
-    _parser.DefineFun("asinh", numfnc_asinh);                                    // asinh(x)
-    _parser.DefineFun("acosh", numfnc_acosh);                                    // acosh(x)
-    _parser.DefineFun("atanh", numfnc_atanh);                                    // atanh(x)
-    _parser.DefineFun("arsinh", numfnc_asinh);                                   // arsinh(x)
-    _parser.DefineFun("arcosh", numfnc_acosh);                                   // arcosh(x)
-    _parser.DefineFun("artanh", numfnc_atanh);                                   // artanh(x)
-    _parser.DefineFun("sec", numfnc_sec);                                        // sec(x)
-    _parser.DefineFun("csc", numfnc_csc);                                        // csc(x)
-    _parser.DefineFun("asec", numfnc_asec);                                      // asec(x)
-    _parser.DefineFun("acsc", numfnc_acsc);                                      // acsc(x)
-    _parser.DefineFun("sech", numfnc_sech);                                      // sech(x)
-    _parser.DefineFun("csch", numfnc_csch);                                      // csch(x)
-    _parser.DefineFun("asech", numfnc_asech);                                    // asech(x)
-    _parser.DefineFun("acsch", numfnc_acsch);                                    // acsch(x)
+    _parser.DefineElementwiseFun("sinc", numfnc_SinusCardinalis);                // sinc(x)
+    _parser.DefineElementwiseFun("sin", numfnc_sin);                             // sin(x)
+    _parser.DefineElementwiseFun("cos", numfnc_cos);                             // cos(x)
+    _parser.DefineElementwiseFun("tan", numfnc_tan);                             // tan(x)
+    _parser.DefineElementwiseFun("cot", numfnc_cot);                             // cot(x)
+    _parser.DefineElementwiseFun("asin", numfnc_asin);                           // asin(x)
+    _parser.DefineElementwiseFun("acos", numfnc_acos);                           // acos(x)
+    _parser.DefineElementwiseFun("atan", numfnc_atan);                           // atan(x)
+    _parser.DefineElementwiseFun("arcsin", numfnc_asin);                         // arcsin(x)
+    _parser.DefineElementwiseFun("arccos", numfnc_acos);                         // arccos(x)
+    _parser.DefineElementwiseFun("arctan", numfnc_atan);                         // arctan(x)
+    _parser.DefineElementwiseFun("sinh", numfnc_sinh);                           // sinh(x)
+    _parser.DefineElementwiseFun("cosh", numfnc_cosh);                           // cosh(x)
+    _parser.DefineElementwiseFun("tanh", numfnc_tanh);                           // tanh(x)
+    _parser.DefineElementwiseFun("asinh", numfnc_asinh);                         // asinh(x)
+    _parser.DefineElementwiseFun("acosh", numfnc_acosh);                         // acosh(x)
+    _parser.DefineElementwiseFun("atanh", numfnc_atanh);                         // atanh(x)
+    _parser.DefineElementwiseFun("arsinh", numfnc_asinh);                        // arsinh(x)
+    _parser.DefineElementwiseFun("arcosh", numfnc_acosh);                        // arcosh(x)
+    _parser.DefineElementwiseFun("artanh", numfnc_atanh);                        // artanh(x)
+    _parser.DefineElementwiseFun("sec", numfnc_sec);                             // sec(x)
+    _parser.DefineElementwiseFun("csc", numfnc_csc);                             // csc(x)
+    _parser.DefineElementwiseFun("asec", numfnc_asec);                           // asec(x)
+    _parser.DefineElementwiseFun("acsc", numfnc_acsc);                           // acsc(x)
+    _parser.DefineElementwiseFun("sech", numfnc_sech);                           // sech(x)
+    _parser.DefineElementwiseFun("csch", numfnc_csch);                           // csch(x)
+    _parser.DefineElementwiseFun("asech", numfnc_asech);                         // asech(x)
+    _parser.DefineElementwiseFun("acsch", numfnc_acsch);                         // acsch(x)
 
     _parser.DefineFun("time", timfnc_time, false);                               // time()
     _parser.DefineFun("clock", timfnc_clock, false);                             // clock()
     _parser.DefineFun("today", timfnc_today, false);                             // today()
     _parser.DefineFun("date", timfnc_date);                                      // date(TIME,TYPE)
-    _parser.DefineFun("datetime", timfnc_datetime);                              // datetime(x)
-    _parser.DefineFun("weeknum", timfnc_weeknum);                                // weeknum(tDate)
+    _parser.DefineElementwiseFun("datetime", timfnc_datetime);                   // datetime(x)
+    _parser.DefineElementwiseFun("weeknum", timfnc_weeknum);                     // weeknum(tDate)
     _parser.DefineFun("as_date", timfnc_as_date, true, 2);                       // as_date(nYear, nMounth, nDay)
     _parser.DefineFun("as_time", timfnc_as_time, true, 4);                       // as_time(nHours, nMinutes, nSeconds, nMilli, nMicro)
     _parser.DefineFun("get_utc_offset", timfnc_get_utc_offset, false);           // get_utc_offset()
-    _parser.DefineFun("is_leapyear", timfnc_is_leap_year);                       // is_leap_year(nDate)
-    _parser.DefineFun("is_daylightsavingtime", timfnc_is_daylightsavingtime);    // is_daylightsavingtime(nDate)
+    _parser.DefineElementwiseFun("is_leapyear", timfnc_is_leap_year);            // is_leap_year(nDate)
+    _parser.DefineElementwiseFun("is_daylightsavingtime", timfnc_is_daylightsavingtime); // is_daylightsavingtime(nDate)
 
     _parser.DefineFun("perlin", rndfnc_perlin, true, 6);                         // perlin(x,y,z,seed,freq,oct,pers)
     _parser.DefineFun("ridgedmulti", rndfnc_rigedmultifractal, true, 5);         // ridgedmulti(x,y,z,seed,freq,oct)
     _parser.DefineFun("billownoise", rndfnc_billow, true, 6);                    // billownoise(x,y,z,seed,freq,oct,pers)
     _parser.DefineFun("voronoinoise", rndfnc_voronoi, true, 6);                  // voronoinoise(x,y,z,seed,freq,displ,dist)
-    _parser.DefineFun("rand", rndfnc_Random, false, 1);                          // rand(left,right,n)
-    _parser.DefineFun("gauss", rndfnc_gRandom, false, 1);                        // gauss(mean,std,n)
-    _parser.DefineFun("laplace_rd", rndfnc_laplace_rd, false, 1);                // laplace_rd(sigma,n)
+    _parser.DefineRandomFun("rand", rndfnc_Random, 1);                           // rand(left,right,n)
+    _parser.DefineRandomFun("gauss", rndfnc_gRandom, 1);                         // gauss(mean,std,n)
+    _parser.DefineFun("setseed", rndfnc_setseed, false);                         // setseed(seed)
+    _parser.DefineRandomFun("laplace_rd", rndfnc_laplace_rd, 1);                 // laplace_rd(sigma,n)
     _parser.DefineFun("laplace_pdf", rndfnc_laplace_pdf);                        // laplace_pdf(x, sigma)
     _parser.DefineFun("laplace_cdf_p", rndfnc_laplace_cdf_p);                    // laplace_cdf_p(x, sigma)
     _parser.DefineFun("laplace_cdf_q", rndfnc_laplace_cdf_q);                    // laplace_cdf_q(x, sigma)
     _parser.DefineFun("laplace_inv_p", rndfnc_laplace_inv_p);                    // laplace_inv_p(p, sigma)
     _parser.DefineFun("laplace_inv_q", rndfnc_laplace_inv_q);                    // laplace_inv_q(q, sigma)
-    _parser.DefineFun("cauchy_rd", rndfnc_cauchy_rd, false, 1);                  // cauchy_rd(a,n)
+    _parser.DefineRandomFun("cauchy_rd", rndfnc_cauchy_rd, 1);                   // cauchy_rd(a,n)
     _parser.DefineFun("cauchy_pdf", rndfnc_cauchy_pdf);                          // cauchy_pdf(x, a)
     _parser.DefineFun("cauchy_cdf_p", rndfnc_cauchy_cdf_p);                      // cauchy_cdf_p(x, a)
     _parser.DefineFun("cauchy_cdf_q", rndfnc_cauchy_cdf_q);                      // cauchy_cdf_q(x, a)
     _parser.DefineFun("cauchy_inv_p", rndfnc_cauchy_inv_p);                      // cauchy_inv_p(p, a)
     _parser.DefineFun("cauchy_inv_q", rndfnc_cauchy_inv_q);                      // cauchy_inv_q(q, a)
-    _parser.DefineFun("rayleigh_rd", rndfnc_rayleigh_rd, false, 1);              // rayleigh_rd(sigma,n)
+    _parser.DefineRandomFun("rayleigh_rd", rndfnc_rayleigh_rd, 1);               // rayleigh_rd(sigma,n)
     _parser.DefineFun("rayleigh_pdf", rndfnc_rayleigh_pdf);                      // rayleigh_pdf(x, sigma)
     _parser.DefineFun("rayleigh_cdf_p", rndfnc_rayleigh_cdf_p);                  // rayleigh_cdf_p(x, sigma)
     _parser.DefineFun("rayleigh_cdf_q", rndfnc_rayleigh_cdf_q);                  // rayleigh_cdf_q(x, sigma)
     _parser.DefineFun("rayleigh_inv_p", rndfnc_rayleigh_inv_p);                  // rayleigh_inv_p(p, sigma)
     _parser.DefineFun("rayleigh_inv_q", rndfnc_rayleigh_inv_q);                  // rayleigh_inv_q(q, sigma)
-    _parser.DefineFun("landau_rd", rndfnc_landau_rd, false, 1);                  // landau_rd(n)
+    _parser.DefineRandomFun("landau_rd", rndfnc_landau_rd, 1);                   // landau_rd(n)
     _parser.DefineFun("landau_pdf", rndfnc_landau_pdf);                          // landau_pdf(x)
-    _parser.DefineFun("alpha_stable_rd", rndfnc_levyAlphaStable_rd, false, 1);   // levyAlphaStable_rd(c, alpha,n)
-    _parser.DefineFun("fisher_f_rd", rndfnc_fisher_f_rd, false, 1);              // fisher_f_rd(nu1, nu2,n)
+    _parser.DefineRandomFun("alpha_stable_rd", rndfnc_levyAlphaStable_rd, 1);    // levyAlphaStable_rd(c, alpha,n)
+    _parser.DefineRandomFun("fisher_f_rd", rndfnc_fisher_f_rd, 1);               // fisher_f_rd(nu1, nu2,n)
     _parser.DefineFun("fisher_f_pdf", rndfnc_fisher_f_pdf);                      // fisher_f_pdf(x, nu1, nu2)
     _parser.DefineFun("fisher_f_cdf_p", rndfnc_fisher_f_cdf_p);                  // fisher_f_cdf_p(x, nu1, nu2)
     _parser.DefineFun("fisher_f_cdf_q", rndfnc_fisher_f_cdf_q);                  // fisher_f_cdf_q(x, nu1, nu2)
     _parser.DefineFun("fisher_f_inv_p", rndfnc_fisher_f_inv_p);                  // fisher_f_inv_p(p, nu1, nu2)
     _parser.DefineFun("fisher_f_inv_q", rndfnc_fisher_f_inv_q);                  // fisher_f_inv_q(q, nu1, nu2)
-    _parser.DefineFun("weibull_rd", rndfnc_weibull_rd, false, 1);                // weibull_rd(a, b,n)
+    _parser.DefineRandomFun("weibull_rd", rndfnc_weibull_rd, 1);                 // weibull_rd(a, b,n)
     _parser.DefineFun("weibull_pdf", rndfnc_weibull_pdf);                        // weibull_pdf(x, a, b)
     _parser.DefineFun("weibull_cdf_p", rndfnc_weibull_cdf_p);                    // weibull_cdf_p(x, a, b)
     _parser.DefineFun("weibull_cdf_q", rndfnc_weibull_cdf_q);                    // weibull_cdf_q(x, a, b)
     _parser.DefineFun("weibull_inv_p", rndfnc_weibull_inv_p);                    // weibull_inv_p(p, a, b)
     _parser.DefineFun("weibull_inv_q", rndfnc_weibull_inv_q);                    // weibull_inv_q(q, a, b)
-    _parser.DefineFun("student_t_rd", rndfnc_student_t_rd, false, 1);            // student_t_rd(nu,n)
+    _parser.DefineRandomFun("student_t_rd", rndfnc_student_t_rd, 1);             // student_t_rd(nu,n)
     _parser.DefineFun("student_t_pdf", rndfnc_student_t_pdf);                    // student_t_pdf(x, nu)
     _parser.DefineFun("student_t_cdf_p", rndfnc_student_t_cdf_p);                // student_t_cdf_p(x, nu)
     _parser.DefineFun("student_t_cdf_q", rndfnc_student_t_cdf_q);                // student_t_cdf_q(x, nu)
@@ -733,12 +734,12 @@ void NumeReKernel::defineNumFunctions()
     _parser.DefineFun("queue", cast_queue, true, 1);                             // queue(vals)
     _parser.DefineFun("stack", cast_stack, true, 1);                             // stack(vals)
     _parser.DefineFun("path", cast_path, true, 2);                               // path(paths,separator)
-    _parser.DefineFun("seconds", cast_seconds);                                  // seconds(val)
-    _parser.DefineFun("minutes", cast_minutes);                                  // minutes(val)
-    _parser.DefineFun("hours", cast_hours);                                      // hours(val)
-    _parser.DefineFun("days", cast_days);                                        // days(val)
-    _parser.DefineFun("weeks", cast_weeks);                                      // weeks(val)
-    _parser.DefineFun("years", cast_years);                                      // years(val)
+    _parser.DefineElementwiseFun("seconds", cast_seconds);                       // seconds(val)
+    _parser.DefineElementwiseFun("minutes", cast_minutes);                       // minutes(val)
+    _parser.DefineElementwiseFun("hours", cast_hours);                           // hours(val)
+    _parser.DefineElementwiseFun("days", cast_days);                             // days(val)
+    _parser.DefineElementwiseFun("weeks", cast_weeks);                           // weeks(val)
+    _parser.DefineElementwiseFun("years", cast_years);                           // years(val)
     _parser.DefineFun("i8", cast_numerical<int8_t>);                             // i8(x)
     _parser.DefineFun("ui8", cast_numerical<uint8_t>);                           // ui8(x)
     _parser.DefineFun("i16", cast_numerical<int16_t>);                           // i16(x)
@@ -853,7 +854,7 @@ void NumeReKernel::defineStrFunctions()
     _parser.DefineFun("decode_base_n", strfnc_decode_base_n, true, 1);               // decode_base_n(str,n)
     _parser.DefineFun("startswith", strfnc_startswith);                              // startswith(str,str)
     _parser.DefineFun("endswith", strfnc_endswith);                                  // endswith(str,str)
-    _parser.DefineFun("to_value", strfnc_to_value);                                  // to_value(str)
+    _parser.DefineElementwiseFun("to_value", strfnc_to_value);                       // to_value(str)
     _parser.DefineFun("to_string", strfnc_to_string);                                // to_string(val)
     _parser.DefineFun("getindices", strfnc_getindices, false, 1);                    // getindices(str,n) <- tables/clusters may change
     _parser.DefineFun("is_data", strfnc_is_data, false);                             // is_data(str) <- tables/clusters may change
@@ -1048,6 +1049,10 @@ NumeReKernel::KernelStatus NumeReKernel::MainLoop(const std::string& sCommand)
             if (!handleCommandLineSource(sLine, sKeep))
                 continue;
 
+            // Measure the run time of the current line,
+            // if the profiler is active
+            ProfilerLineScope _lineScope(_profiler, (_script.isValid() && _script.isOpen()) ? _script.getCurrentLine()-1 : 0, false);
+
             // Search for the "assert" command decoration
             if (findCommand(sLine, "assert").sString == "assert" && !_procedure.getCurrentBlockDepth())
             {
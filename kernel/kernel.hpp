@@ -34,6 +34,7 @@
 #include "core/datamanagement/memorymanager.hpp"
 
 #include "core/debugger/debugger.hpp"
+#include "core/debugger/profiler.hpp"
 
 #include "core/io/output.hpp"
 
@@ -135,6 +136,7 @@ class NumeReKernel
         Script _script;
         Procedure _procedure;
         NumeReDebugger _debugger;
+        NumeReProfiler _profiler;
         NumeRe::WindowManager _manager;
 
         // private member functions for special tasks
@@ -290,6 +292,11 @@ class NumeReKernel
             return _debugger;
         }
 
+        NumeReProfiler& getProfiler()
+        {
+            return _profiler;
+        }
+
         NumeRe::WindowManager& getWindowManager()
         {
             return _manager;